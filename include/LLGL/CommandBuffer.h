@@ -19,6 +19,7 @@
 #include "ResourceHeap.h"
 #include "PipelineLayoutFlags.h"
 #include "Constants.h"
+#include "Container/ArrayView.h"
 
 #include "RenderPass.h"
 #include "RenderTarget.h"
@@ -68,6 +69,16 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void End() = 0;
 
+        /**
+        \brief Returns the number of commands that were removed by the command optimizer when this command buffer was last encoded.
+        \remarks The optimizer removes redundant state changes and coalesces buffer updates of command buffers
+        that have been created with the CommandBufferFlags::MultiSubmit flag.
+        This is also accumulated in FrameProfile::removedCommands by the debug layer. By default 0.
+        \note Only supported with: OpenGL, Null.
+        \see End
+        */
+        virtual std::uint32_t GetNumRemovedCommands() const;
+
         /**
         \brief Executes the specified deferred command buffer.
         \param[in] deferredCommandBuffer Specifies the deferred command buffer which is meant to be executed.
@@ -87,8 +98,8 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         This offset plus the data block size (i.e. <code>dstOffset + dataSize</code>) must be less than or equal to the size of the buffer.
         \param[in] data Raw pointer to the data with which the buffer is to be updated. This <b>must not</b> be null!
         \param[in] dataSize Specifies the size (in bytes) of the data block which is to be updated.
-        This is limited to 2^16 = 65536 bytes, because it may be written to the command buffer itself before it is copied to the destination buffer (depending on the backend).
-        \remarks To update buffers larger than 65536 bytes, use RenderSystem::WriteBuffer or RenderSystem::MapBuffer.
+        Depending on the backend, the data is either written to the command buffer itself or to a per-command-buffer upload buffer before it is copied to the destination buffer.
+        \remarks To update large buffers outside of command buffer encoding, RenderSystem::WriteBuffer or RenderSystem::MapBuffer can be used as well.
         For performance reasons, it is recommended to encode this command outside of a render pass.
         Otherwise, render pass interruptions might be inserted by LLGL.
         */
@@ -96,7 +107,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) = 0;
 
         /**
@@ -364,6 +375,35 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) = 0;
 
+        /**
+        \brief Binds the specified resource heap to the respective pipeline with dynamic offsets for its constant buffers.
+        \param[in] resourceHeap Specifies the resource heap that contains all shader resources that will be bound to the shader pipeline.
+        \param[in] firstSet Specifies the zero-based index of the first set of layout descriptors. This \b must be in the half-open range <code>[0, ResourceHeap::GetNumDescriptorSets)</code>.
+        \param[in] bindPoint Specifies to which pipeline the resource heap is meant be bound. See the other version of this function for details.
+        \param[in] dynamicOffsets Specifies the offsets (in bytes) that are added to the buffer ranges of all bindings with dynamic offsets.
+        This must contain one offset for each binding where BindingDescriptor::dynamicOffset is true, in the same order as the bindings appear in the pipeline layout.
+        Each offset must be a multiple of RenderingLimits::minConstantBufferAlignment.
+        \remarks This allows drawing many objects with their constants in a single ring buffer and only one resource heap:
+        \code
+        for (std::uint32_t i = 0; i < numObjects; ++i)
+        {
+            const std::uint32_t offset = i * objectConstantsStride;
+            myCmdBuffer->SetResourceHeap(*myResourceHeap, 0, LLGL::PipelineBindPoint::Graphics, { &offset, 1 });
+            myCmdBuffer->DrawIndexed(numIndices, 0);
+        }
+        \endcode
+        \remarks The bound range of a dynamic binding keeps the size of its resource view. If the resource view covers the whole buffer, the range ends at the end of the buffer.
+        \note Only supported with: OpenGL, Vulkan, Null. The other backends bind the resource heap without offsets (see RenderingFeatures::hasDynamicBufferOffsets).
+        \see BindingDescriptor::dynamicOffset
+        \see SetResourceHeap(ResourceHeap&, std::uint32_t, const PipelineBindPoint)
+        */
+        virtual void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) = 0;
+
         /**
         \brief Sets the specified resource to a binding slot.
         \param[in] resource Specifies the resource to set.
@@ -596,6 +636,11 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] dataSize Specifies the size (in bytes) of the input buffer \c data. This must be a multiple of 4.
         \remarks This function must only be called after a graphics or compute pipeline has been set.
         The order of uniforms that come after the first one can be determined by the ShaderReflection::uniform container returned by Shader::Reflect.
+        \remarks For Vulkan, the uniforms are push constants that are recorded directly into the command buffer, so no buffer update or barrier is required.
+        The location is the byte offset within the push constant block and \c dataSize bytes are written from there, i.e. \c count is ignored.
+        All pipeline layouts share a single push constant range of 128 bytes for all shader stages.
+        \remarks For the Null renderer, the uniforms are a 128-byte storage of the command buffer that is passed to the vertex callback (see NullVertexBatch::uniforms).
+        Writes beyond these 128 bytes are ignored.
         \note Only supported with: OpenGL, Vulkan, Direct3D 12.
         \see Shader::FindUniformLocation
         \see Shader::Reflect
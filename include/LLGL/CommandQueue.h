@@ -45,19 +45,23 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         myCmdBuffer->End();
         myCmdQueue->Submit(*myCmdBuffer);
         \endcode
+        \note Some backends (such as Vulkan) defer the submission to the GPU queue and hand all deferred command buffers over at once
+        when a fence is submitted, the queue is waited on, query results are retrieved, or a swap-chain is presented.
         \see CommandBuffer::Begin
         \see CommandBuffer::End
         \see Submit(std::uint32_t, CommandBuffer* const *)
         */
         virtual void Submit(CommandBuffer& commandBuffer) = 0;
 
-        #if 0
         /**
         \brief Submits all command buffers in the specified array to the command queue at once.
+        \param[in] numCommandBuffers Specifies the number of command buffers in the array \c commandBuffers.
+        \param[in] commandBuffers Pointer to an array of command buffers that are to be submitted in the specified order.
+        \remarks By default, this is equivalent to calling <code>Submit(CommandBuffer&)</code> for each command buffer,
+        but backends such as Vulkan hand all command buffers to the GPU queue with a single submission.
         \see Submit(CommandBuffer&)
         */
         virtual void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers);
-        #endif
 
         /* ----- Queries ----- */
 
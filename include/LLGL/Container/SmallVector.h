@@ -361,9 +361,9 @@ class LLGL_EXPORT SmallVector
                 {
                     /* Destroy range, move trail backwards, and reduce container size */
                     destroy_range(const_cast<iterator>(from), const_cast<iterator>(to));
-                    move_trail(const_cast<iterator>(from), to, end());
+                    move_trail(const_cast<iterator>(from), const_cast<iterator>(to), end());
                     size_ -= count;
-                    return const_cast<iterator>(to);
+                    return const_cast<iterator>(from);
                 }
             }
             return end();
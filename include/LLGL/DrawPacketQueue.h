@@ -0,0 +1,161 @@
+/*
+ * DrawPacketQueue.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DRAW_PACKET_QUEUE_H
+#define LLGL_DRAW_PACKET_QUEUE_H
+
+
+#include "Export.h"
+#include "ForwardDecls.h"
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Draw packet structure with all states that are required to encode a single draw command.
+\see DrawPacketQueue::Append
+*/
+struct DrawPacket
+{
+    //! Graphics pipeline state for this draw command. This must not be null.
+    PipelineState*        pipelineState   = nullptr;
+
+    /**
+    \brief Pipeline layout the pipeline state was created with. By default null.
+    \remarks The bound resource heap is only kept across a change of the pipeline state if both pipeline states have the same non-null pipeline layout.
+    If this is null, the resource heap is bound again whenever the pipeline state changes.
+    \see GraphicsPipelineDescriptor::pipelineLayout
+    */
+    const PipelineLayout* pipelineLayout  = nullptr;
+
+    //! Optional resource heap for this draw command. If this is null, no resource heap is bound for this draw command.
+    ResourceHeap*         resourceHeap    = nullptr;
+
+    //! Zero-based index of the descriptor set within the resource heap. By default 0.
+    std::uint32_t         descriptorSet   = 0;
+
+    //! Optional vertex buffer for this draw command. If this is null, no vertex buffer is bound for this draw command.
+    Buffer*               vertexBuffer    = nullptr;
+
+    /**
+    \brief Optional index buffer for this draw command. If this is null, the draw command is not indexed.
+    \remarks The index buffer must have been created with a valid index format (see BufferDescriptor::format).
+    \see CommandBuffer::SetIndexBuffer(Buffer&)
+    */
+    Buffer*               indexBuffer     = nullptr;
+
+    //! Number of vertices, or number of indices if \c indexBuffer is not null.
+    std::uint32_t         numVertices     = 0;
+
+    //! Zero-based index of the first vertex, or index of the first index if \c indexBuffer is not null.
+    std::uint32_t         firstVertex     = 0;
+
+    //! Base vertex offset that is added to each index. Only used if \c indexBuffer is not null. By default 0.
+    std::int32_t          vertexOffset    = 0;
+
+    //! Number of instances to draw. By default 1.
+    std::uint32_t         numInstances    = 1;
+
+    //! Zero-based index of the first instance. By default 0.
+    std::uint32_t         firstInstance   = 0;
+};
+
+/**
+\brief Statistics about the commands that were encoded by a draw packet queue.
+\see DrawPacketQueue::Flush
+*/
+struct DrawPacketStatistics
+{
+    //! Number of encoded draw commands.
+    std::uint32_t numDrawCommands           = 0;
+
+    //! Number of encoded CommandBuffer::SetPipelineState calls.
+    std::uint32_t numPipelineStateBindings  = 0;
+
+    //! Number of encoded CommandBuffer::SetResourceHeap calls.
+    std::uint32_t numResourceHeapBindings   = 0;
+
+    //! Number of encoded CommandBuffer::SetVertexBuffer calls.
+    std::uint32_t numVertexBufferBindings   = 0;
+
+    //! Number of encoded CommandBuffer::SetIndexBuffer calls.
+    std::uint32_t numIndexBufferBindings    = 0;
+};
+
+/**
+\brief Utility class to collect draw packets and encode them into a command buffer with a minimal number of state changes.
+\remarks All draw packets are sorted by a 64-bit state key, which is composed of (from most to least significant)
+the pipeline state, the resource heap and its descriptor set, the vertex buffer, and the index buffer.
+The sort is stable, i.e. draw packets with the same states are encoded in the order they were appended.
+Since the order between draw packets with different states is not preserved, this should only be used for draw commands
+whose result does not depend on their order, e.g. opaque geometry with depth testing.
+\remarks This class only records calls into the CommandBuffer interface and therefore works with all renderers.
+\note This class is not thread-safe, i.e. a single queue must not be used by multiple threads at the same time.
+*/
+class LLGL_EXPORT DrawPacketQueue
+{
+
+    public:
+
+        DrawPacketQueue(const DrawPacketQueue&) = delete;
+        DrawPacketQueue& operator = (const DrawPacketQueue&) = delete;
+
+        /**
+        \brief Initializes the draw packet queue.
+        \param[in] numThreads Specifies the number of worker threads that are used to sort large amounts of draw packets.
+        If this is 0, the number of hardware threads is used. If this is 1, the draw packets are always sorted on the calling thread.
+        The worker threads are only created when they are needed for the first time.
+        */
+        DrawPacketQueue(std::uint32_t numThreads = 0);
+
+        //! Releases the internal data and joins the worker threads.
+        ~DrawPacketQueue();
+
+        /**
+        \brief Appends the specified draw packet to this queue.
+        \throws std::invalid_argument If \c packet.pipelineState is null.
+        */
+        void Append(const DrawPacket& packet);
+
+        //! Removes all draw packets from this queue.
+        void Clear();
+
+        //! Returns the number of draw packets that have been appended since the last call to Flush or Clear.
+        std::size_t GetNumPackets() const;
+
+        /**
+        \brief Encodes all draw packets into the specified command buffer and clears this queue afterwards.
+        \param[in] commandBuffer Specifies the command buffer to encode the commands into.
+        This must be inside a render pass that is compatible with the pipeline states of all draw packets.
+        \param[in] sortPackets Specifies whether the draw packets are sorted by their state key. If this is false,
+        the draw packets are encoded in the order they were appended and only redundant consecutive state changes are omitted.
+        \return Statistics about the commands that were encoded.
+        \remarks A state is only encoded when it differs from the previous draw packet.
+        The states of the command buffer before this call are not taken into account, so the first draw packet always encodes all its states.
+        */
+        DrawPacketStatistics Flush(CommandBuffer& commandBuffer, bool sortPackets = true);
+
+    private:
+
+        struct Pimpl;
+        Pimpl* pimpl_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
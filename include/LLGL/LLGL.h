@@ -21,6 +21,7 @@
 #include <LLGL/RenderSystem.h>
 #include <LLGL/Log.h>
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/DrawPacketQueue.h>
 #include <LLGL/ImageFlags.h>
 
 
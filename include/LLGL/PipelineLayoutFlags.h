@@ -107,6 +107,18 @@ struct BindingDescriptor
     \note For Vulkan, this number specifies the size of an array of resources (e.g. an array of uniform buffers).
     */
     std::uint32_t   arraySize   = 1;
+
+    /**
+    \brief Specifies whether the buffer range of this binding is offset dynamically when the resource heap is bound. By default false.
+    \remarks If this is true, each call to CommandBuffer::SetResourceHeap with dynamic offsets must provide one offset (in bytes) for this binding.
+    This allows many objects to source their constants from different ranges of one large constant buffer with a single resource heap.
+    The offsets must be a multiple of RenderingLimits::minConstantBufferAlignment.
+    \note This can only be used for constant buffer bindings, i.e. \c type must be ResourceType::Buffer and \c bindFlags must contain BindFlags::ConstantBuffer.
+    \note Only supported with: OpenGL, Vulkan, Null.
+    \see CommandBuffer::SetResourceHeap(ResourceHeap&, std::uint32_t, const PipelineBindPoint, const ArrayView<std::uint32_t>&)
+    \see RenderingFeatures::hasDynamicBufferOffsets
+    */
+    bool            dynamicOffset   = false;
 };
 
 /**
@@ -36,6 +36,16 @@ class LLGL_EXPORT PipelineState : public RenderSystemChild
         */
         virtual const Report* GetReport() const = 0;
 
+        /**
+        \brief Returns true if this pipeline state has been fully created and can be used without blocking.
+        \remarks Pipeline states created with RenderSystem::CreatePipelineStateAsync might still have their shaders compiled and linked in the background.
+        Binding such a PSO or querying its report before it is ready blocks the calling thread until the creation has finished.
+        By default, this always returns true.
+        \see RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor&)
+        \see RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor&)
+        */
+        virtual bool IsReady() const;
+
 };
 
 
@@ -238,7 +238,7 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[in] data Raw pointer to the data with which the buffer is to be updated. This must not be null!
         \param[in] dataSize Specifies the size (in bytes) of the data block which is to be updated.
         This must be less then or equal to the size of the buffer.
-        \remarks To update a small buffer (maximum of 65536 bytes) during encoding a command buffer, use CommandBuffer::UpdateBuffer.
+        \remarks To update a buffer during encoding a command buffer, use CommandBuffer::UpdateBuffer.
         \see ReadBuffer
         */
         virtual void WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize) = 0;
@@ -351,6 +351,55 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Enqueues an asynchronous read operation of the image data from the specified texture.
+        \param[in] texture Specifies the texture object to read from.
+        \param[in] textureRegion Specifies the region where the texture data is to be read. The field TextureRegion::numMipLevels \b must be 1.
+        \param[in] format Specifies the image format the texture data is to be converted to.
+        \param[in] dataType Specifies the data type the texture data is to be converted to.
+        \return Non-zero ticket that identifies the read operation for the MapTextureReadback and UnmapTextureReadback functions.
+        \remarks In contrast to ReadTexture, this function does not stall the pipeline if the backend supports asynchronous readback (e.g. OpenGL with pixel pack buffers).
+        Only a limited number of read operations can be in flight at the same time (see RendererConfigurationOpenGL::numReadbackBuffers).
+        Enqueuing more read operations than that invalidates the oldest ticket. The following example illustrates a triple-buffered readback:
+        \code
+        // Enqueue read operation for the current frame
+        myTickets[myFrame % 3] = myRenderSystem->ReadTextureAsync(*myTexture, myRegion, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8);
+
+        // Resolve read operation from two frames ago
+        if (auto myTicket = myTickets[(myFrame + 1) % 3])
+        {
+            std::size_t myDataSize = 0;
+            if (auto myData = myRenderSystem->MapTextureReadback(myTicket, true, &myDataSize))
+            {
+                // Process image data ...
+                myRenderSystem->UnmapTextureReadback(myTicket);
+            }
+        }
+        \endcode
+        The default implementation reads the texture data synchronously via ReadTexture and stores it in CPU memory until the ticket is unmapped.
+        It keeps at most 3 read operations, i.e. the default of RendererConfigurationOpenGL::numReadbackBuffers, and also invalidates the oldest ticket beyond that.
+        \see MapTextureReadback
+        \see UnmapTextureReadback
+        */
+        virtual std::uint64_t ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType);
+
+        /**
+        \brief Maps the image data of the specified asynchronous read operation into CPU memory space.
+        \param[in] ticket Specifies the ticket that was returned by ReadTextureAsync.
+        \param[in] wait Specifies whether to wait until the read operation has been completed. If this is false and the data is not available yet, the return value is null.
+        \param[out] dataSize Optional pointer to the output size (in bytes) of the mapped image data.
+        \return Raw pointer to the image data or null if the ticket is invalid or the read operation has not been completed yet.
+        \see ReadTextureAsync
+        */
+        virtual const void* MapTextureReadback(std::uint64_t ticket, bool wait = true, std::size_t* dataSize = nullptr);
+
+        /**
+        \brief Unmaps the image data of the specified asynchronous read operation and releases its ticket.
+        \remarks After this call, the ticket is invalid and the memory that was returned by MapTextureReadback must no longer be used.
+        \see MapTextureReadback
+        */
+        virtual void UnmapTextureReadback(std::uint64_t ticket);
+
         /* ----- Samplers ---- */
 
         /**
@@ -378,6 +427,29 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Releases the specified ResourceHeap object. After this call, the specified object must no longer be used.
         virtual void Release(ResourceHeap& resourceHeap) = 0;
 
+        /**
+        \brief Writes new resource views into the specified resource heap.
+        \param[in] resourceHeap Specifies the resource heap whose descriptors are to be updated.
+        \param[in] firstDescriptor Specifies the zero-based index of the first descriptor that is to be written.
+        This is an index into the ResourceHeapDescriptor::resourceViews array the resource heap was created with,
+        i.e. <code>descriptorSet * numBindings + binding</code> where \c numBindings is the number of bindings in the pipeline layout.
+        \param[in] resourceViews Specifies the new resource views. Resource views with a null pointer as resource are skipped,
+        so the respective descriptors keep their previous resource.
+        \return Number of descriptors that have been written. Resource views beyond the end of the resource heap are ignored.
+        \remarks Only the specified descriptors are updated, which is considerably cheaper than creating a new resource heap.
+        Each resource must be compatible to the binding it is written to, just like for CreateResourceHeap.
+        For OpenGL, a buffer view with a custom range can only be written to a descriptor set that was already created with buffer ranges for the same type of buffer.
+        \remarks The resource heap must not be in use by any command buffer that has been encoded but not yet completed by the GPU.
+        The written descriptors only take effect for commands that are encoded after this call.
+        \throws std::invalid_argument If a resource does not match the type of the binding it is written to.
+        \see CreateResourceHeap
+        */
+        virtual std::uint32_t WriteResourceHeap(
+            ResourceHeap&                               resourceHeap,
+            std::uint32_t                               firstDescriptor,
+            const ArrayView<ResourceViewDescriptor>&    resourceViews
+        ) = 0;
+
         /* ----- Render Passes ----- */
 
         /**
@@ -500,6 +572,27 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) = 0;
 
+        /**
+        \brief Creates a new graphics pipeline state object (PSO) whose shaders are compiled and linked in the background.
+        \param[in] pipelineStateDesc Specifies the graphics PSO descriptor. All objects this descriptor refers to must stay alive until the PSO is ready.
+        \remarks The returned PSO can be used immediately, but binding it before it is ready blocks until its creation has finished.
+        Use PipelineState::IsReady to poll the completion, e.g. to overlap many PSO creations with a loading screen.
+        By default, this is equivalent to <code>CreatePipelineState(pipelineStateDesc)</code>,
+        but the Vulkan backend creates the PSO on a worker thread and the OpenGL backend uses \c GL_KHR_parallel_shader_compile if it is supported.
+        \see PipelineState::IsReady
+        \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc);
+
+        /**
+        \brief Creates a new compute pipeline state object (PSO) whose shader is compiled in the background.
+        \param[in] pipelineStateDesc Specifies the compute PSO descriptor. All objects this descriptor refers to must stay alive until the PSO is ready.
+        \remarks The same rules apply as for the graphics PSO version of this function.
+        \see CreatePipelineStateAsync(const GraphicsPipelineDescriptor&)
+        \see CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
+        */
+        virtual PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc);
+
         //! Releases the specified PipelineState object. After this call, the specified object must no longer be used.
         virtual void Release(PipelineState& pipelineState) = 0;
 
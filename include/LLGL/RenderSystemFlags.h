@@ -441,7 +441,7 @@ struct RenderingFeatures
 
     /**
     \brief Specifies whether individual shader uniforms are supported.
-    \note Only supported with: OpenGL.
+    \note Only supported with: OpenGL, Vulkan.
     \see CommandBuffer::SetUniform
     \see CommandBuffer::SetUniforms
     */
@@ -541,6 +541,13 @@ struct RenderingFeatures
     \see CommandBuffer:BeginRenderCondition
     */
     bool hasRenderCondition             = false;
+
+    /**
+    \brief Specifies whether dynamic offsets for constant buffer bindings in resource heaps are supported.
+    \remarks If this is false, the dynamic offsets passed to CommandBuffer::SetResourceHeap are ignored.
+    \see BindingDescriptor::dynamicOffset
+    */
+    bool hasDynamicBufferOffsets        = false;
 };
 
 /**
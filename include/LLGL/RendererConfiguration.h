@@ -9,7 +9,9 @@
 #define LLGL_RENDERER_CONFIGURATION_H
 
 
+#include <LLGL/ForwardDecls.h>
 #include <LLGL/Container/ArrayView.h>
+#include <functional>
 #include <cstdint>
 
 
@@ -106,21 +108,48 @@ struct RendererConfigurationVulkan
 struct RendererConfigurationOpenGL
 {
     //! Specifies the requested OpenGL context profile. By default OpenGLContextProfile::CoreProfile.
-    OpenGLContextProfile    contextProfile  = OpenGLContextProfile::CoreProfile;
+    OpenGLContextProfile    contextProfile      = OpenGLContextProfile::CoreProfile;
 
     /**
     \brief Specifies the requested OpenGL context major version. By default 0.
     \remarks If both \c majorVersion and \c minorVersion are 0, the highest OpenGL version that is available on the host system will be choosen.
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
-    int                     majorVersion    = 0;
+    int                     majorVersion        = 0;
 
     /**
     \brief Specifies the requested OpenGL context minor version. By default 0.
     \remarks If both \c majorVersion and \c minorVersion are 0, the highest OpenGL version that is available on the host system will be choosen.
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
-    int                     minorVersion    = 0;
+    int                     minorVersion        = 0;
+
+    /**
+    \brief Specifies the number of pixel pack buffers used for asynchronous texture readback. By default 3.
+    \remarks This determines how many asynchronous texture read operations can be in flight at the same time,
+    e.g. 2 for double-buffered and 3 for triple-buffered readback. Enqueuing more read operations invalidates the oldest one.
+    \see RenderSystem::ReadTextureAsync
+    */
+    std::uint32_t           numReadbackBuffers  = 3;
+
+    /**
+    \brief Specifies whether to create a headless OpenGL context that does not require a window system. By default false.
+    \remarks If enabled, the OpenGL context is created with EGL, either with the \c EGL_MESA_platform_surfaceless extension or with a pbuffer surface,
+    so no X server is required. Only offscreen render targets can be rendered into and swap-chains cannot be created in this mode.
+    \note Only supported on: GNU/Linux, if LLGL was built with \c LLGL_GL_ENABLE_EGL.
+    */
+    bool                    headless            = false;
+
+    /**
+    \brief Specifies whether to run all OpenGL work on a dedicated render thread that owns the GL context. By default false.
+    \remarks If enabled, all functions of the render system, command queue, and swap-chains can be called from any thread.
+    They are marshaled onto the render thread and block until they have been executed, except for CommandQueue::Submit(CommandBuffer&) and SwapChain::Present,
+    which are scheduled asynchronously. Deferred command buffers can then be encoded on multiple application threads simultaneously,
+    but each command buffer must only be encoded by one thread at a time. A command buffer waits for its pending submissions in CommandBuffer::Begin.
+    \remarks Immediate command buffers (i.e. CommandBufferFlags::ImmediateSubmit) cannot be created in this mode.
+    \note On GNU/Linux, swap-chain windows are created on the render thread, so the application must call \c XInitThreads if it accesses Xlib itself.
+    */
+    bool                    renderThread        = false;
 };
 
 /**
@@ -136,6 +165,163 @@ struct RendererConfigurationOpenGLES3
     int minorVersion = 0;
 };
 
+/**
+\brief Vertex input stream structure for the CPU vertex processing of the Null renderer.
+\see NullVertexBatch::inputs
+*/
+struct NullVertexInput
+{
+    //! Vertex attribute from the bound vertex buffer this input stream was fetched from.
+    const VertexAttribute*  attribute   = nullptr;
+
+    /**
+    \brief Tightly packed attribute data of all vertices in the batch.
+    \remarks Each element has the size of <code>attribute->GetSize()</code> bytes and is stored in the format of \c attribute->format, i.e. no conversion takes place.
+    Attributes that lie outside of their vertex buffer are fetched as zeros.
+    */
+    const void*             data        = nullptr;
+};
+
+/**
+\brief Vertex output stream structure for the CPU vertex processing of the Null renderer.
+\see NullVertexBatch::outputs
+*/
+struct NullVertexOutput
+{
+    /**
+    \brief Pointer into the stream-output buffer where the first vertex of the batch must be written to.
+    This is null if no stream-output buffer is bound for this output slot or if the buffer is already full.
+    */
+    void*           data    = nullptr;
+
+    /**
+    \brief Stride (in bytes) between two consecutive output vertices.
+    \remarks This is determined by the vertex output attributes of the vertex shader (see VertexShaderAttributes::outputAttribs).
+    */
+    std::uint32_t   stride  = 0;
+};
+
+/**
+\brief Constant buffer binding structure for the CPU vertex processing of the Null renderer.
+\see NullVertexBatch::constantBuffers
+*/
+struct NullConstantBuffer
+{
+    //! Binding slot of the constant buffer as specified in the pipeline layout (see BindingDescriptor::slot).
+    std::uint32_t   slot    = 0;
+
+    /**
+    \brief Pointer to the bound range of the constant buffer.
+    \remarks For bindings with dynamic offsets (see BindingDescriptor::dynamicOffset), the offset that was passed to CommandBuffer::SetResourceHeap is already applied.
+    This is null if the bound range lies outside of the buffer.
+    */
+    const void*     data    = nullptr;
+
+    //! Size (in bytes) of the bound range.
+    std::uint64_t   size    = 0;
+};
+
+/**
+\brief Batch of vertices that is passed to the vertex callback of the Null renderer.
+\see RendererConfigurationNull::vertexCallback
+*/
+struct NullVertexBatch
+{
+    //! Graphics pipeline state of the draw command this batch belongs to.
+    const PipelineState*            pipelineState   = nullptr;
+
+    //! Number of vertices in this batch.
+    std::uint32_t                   numVertices     = 0;
+
+    //! Zero-based index of the instance all vertices of this batch belong to. This does not include the first instance of the draw command.
+    std::uint32_t                   instanceID      = 0;
+
+    //! Array of \c numVertices vertex IDs. For indexed draw commands, these are the fetched indices plus the vertex offset.
+    const std::uint32_t*            vertexIDs       = nullptr;
+
+    //! Vertex input streams, one for each vertex attribute of the bound vertex buffers in the order they are bound.
+    ArrayView<NullVertexInput>      inputs;
+
+    /**
+    \brief Vertex output streams, one for each bound stream-output buffer.
+    \remarks The callback must write \c numVertices vertices into each output stream whose \c data pointer is not null.
+    This is empty if no stream-output section is active.
+    */
+    ArrayView<NullVertexOutput>     outputs;
+
+    /**
+    \brief Constant buffers of the descriptor set that is bound with CommandBuffer::SetResourceHeap.
+    \remarks There is one entry for each constant buffer binding in the pipeline layout of the resource heap, in the order they appear in the pipeline layout.
+    This is empty if no resource heap is bound.
+    */
+    ArrayView<NullConstantBuffer>   constantBuffers;
+
+    /**
+    \brief Pointer to the 128 bytes of uniform data that have been written with CommandBuffer::SetUniforms.
+    \remarks The uniform location is the byte offset into this storage. The uniforms are state of the command buffer that is being executed,
+    i.e. they are not reset when the pipeline state changes and they are initialized with zeros at the beginning of each command buffer.
+    */
+    const void*                     uniforms        = nullptr;
+
+    /**
+    \brief Output array of \c numVertices clip-space positions with four components (X, Y, Z, W) each.
+    \remarks This is only non-null if the triangles of this batch are rasterized (see RendererConfigurationNull::softwareRasterizer).
+    The positions are initialized with zeros, so vertices whose position is not written are discarded.
+    The depth range of the clip space is [0, W], i.e. the same as for Direct3D and Vulkan.
+    */
+    float*                          positions       = nullptr;
+
+    /**
+    \brief Output array of \c numVertices colors with four components (R, G, B, A) each.
+    \remarks This is only non-null if \c positions is non-null. The colors are initialized with white, i.e. (1, 1, 1, 1).
+    The colors are interpolated with perspective correction and written into all color attachments of the active render target.
+    */
+    float*                          colors          = nullptr;
+};
+
+/**
+\brief Vertex callback interface for the CPU vertex processing of the Null renderer.
+\see RendererConfigurationNull::vertexCallback
+*/
+using NullVertexCallback = std::function<void(const NullVertexBatch& batch)>;
+
+/**
+\brief Structure for a Null renderer specific configuration.
+*/
+struct RendererConfigurationNull
+{
+    /**
+    \brief Optional callback that processes the vertices of each draw command on the CPU. By default null.
+    \remarks If this is set, the command queue fetches the vertices and indices of each draw command from the bound vertex and index buffers
+    and passes them to this callback in batches of up to \c vertexBatchSize vertices. This callback is invoked on the thread that executes the command buffers.
+    \remarks While a stream-output section is active, strip topologies are expanded into lists and the output vertices are written into the stream-output buffers.
+    Stream-output buffers are filled from their beginning with each call to CommandBuffer::BeginStreamOutput and the vertices that do not fit into a buffer are discarded.
+    If this is null, draw commands only contribute to pipeline statistics queries and RenderingFeatures::hasStreamOutputs is false.
+    */
+    NullVertexCallback  vertexCallback;
+
+    //! Specifies the maximum number of vertices per batch. By default 256.
+    std::uint32_t       vertexBatchSize     = 256;
+
+    /**
+    \brief Specifies whether render targets are rasterized on the CPU. By default false.
+    \remarks If enabled, clear commands and triangles are written into the textures of render targets that are created with this render system.
+    Triangles are only rasterized if \c vertexCallback is set, since the callback provides the clip-space positions and colors (see NullVertexBatch::positions).
+    Each render pass is rasterized in tiles of 64x64 pixels, which are distributed among the worker threads.
+    Depth tests, depth writes, face culling, scissor tests, and color write masks are supported. Blending, stencil tests, and multi-sampling are ignored.
+    Triangles with a vertex behind the viewer (i.e. W less than or equal to zero) are discarded as a whole, since they are not clipped.
+    \remarks Swap-chains are not rasterized, since their content cannot be read back.
+    */
+    bool                softwareRasterizer  = false;
+
+    /**
+    \brief Specifies the number of worker threads for the software rasterizer. By default 0.
+    \remarks If this is 0, the number of hardware threads is used. If this is 1, the rasterizer runs on the thread that executes the command buffers.
+    This is ignored if \c softwareRasterizer is false.
+    */
+    std::uint32_t       rasterizerThreads   = 0;
+};
+
 
 } // /namespace LLGL
 
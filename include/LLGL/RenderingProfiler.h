@@ -258,6 +258,12 @@ struct FrameProfile
             */
             std::uint32_t commandBufferEncodings;
 
+            /**
+            \brief Counter for all commands that were removed by the command optimizer of multi-submit command buffers.
+            \see CommandBuffer::GetNumRemovedCommands
+            */
+            std::uint32_t removedCommands;
+
             /**
             \brief Counter for all fences that were submitted to the queue.
             \see CommandQueue::Submit(Fence&)
@@ -99,6 +99,7 @@ struct ResourceHeapDescriptor
     \remarks These resources must be specified in the same order as they were specified when the pipeline layout was created.
     The number of resource views \b must be a multiple of the bindings in the pipeline layout.
     \see PipelineLayoutDescriptor::bindings
+    \see RenderSystem::WriteResourceHeap
     */
     std::vector<ResourceViewDescriptor> resourceViews;
 };
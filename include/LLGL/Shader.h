@@ -71,8 +71,9 @@ class LLGL_EXPORT Shader : public RenderSystemChild
         \remarks This is a helper function when only one or a few number of uniform locations are meant to be determined.
         If more uniforms are involved, use the Reflect function.
         \remarks Default implementation always returns Constants::invalidLocation.
+        \remarks For Vulkan, uniforms are the fields of the push constant block (i.e. <code>layout(push_constant)</code>) and their location is the byte offset of the field.
         \see Reflect
-        \note Only supported with: OpenGL.
+        \note Only supported with: OpenGL, Vulkan.
         */
         virtual UniformLocation FindUniformLocation(const char* name) const;
 
@@ -0,0 +1,94 @@
+/*
+ * ThreadPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers_.emplace_back(&ThreadPool::RunWorkerThread, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        quit_ = true;
+    }
+    wakeSignal_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::Enqueue(Task task)
+{
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        tasks_.push(std::move(task));
+    }
+    wakeSignal_.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    idleSignal_.wait(lock, [this]{ return (tasks_.empty() && numActiveTasks_ == 0); });
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::RunWorkerThread()
+{
+    for (;;)
+    {
+        Task task;
+
+        /* Wait for next task; remaining tasks are still finished before the worker quits */
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            wakeSignal_.wait(lock, [this]{ return (quit_ || !tasks_.empty()); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            ++numActiveTasks_;
+        }
+
+        task();
+
+        /* Notify threads waiting for idle state after the last task has been finished */
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            --numActiveTasks_;
+            if (tasks_.empty() && numActiveTasks_ == 0)
+                idleSignal_.notify_all();
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,80 @@
+/*
+ * ThreadPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <queue>
+
+
+namespace LLGL
+{
+
+
+// Thread pool class to run independent tasks on a fixed number of worker threads.
+class LLGL_EXPORT ThreadPool
+{
+
+    public:
+
+        using Task = std::function<void()>;
+
+    public:
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        // Initializes the thread pool with the specified amount of worker threads. If this is 0, the number of hardware threads is used.
+        ThreadPool(std::size_t threadCount = 0);
+
+        // Finishes all pending tasks and joins the worker threads.
+        ~ThreadPool();
+
+        // Schedules the specified task to be run on one of the worker threads. The task must not throw any exceptions.
+        void Enqueue(Task task);
+
+        // Blocks the current thread until all scheduled tasks have been finished.
+        void WaitIdle();
+
+        // Returns the number of worker threads.
+        inline std::size_t GetThreadCount() const
+        {
+            return workers_.size();
+        }
+
+    private:
+
+        void RunWorkerThread();
+
+    private:
+
+        std::vector<std::thread>    workers_;
+        std::queue<Task>            tasks_;
+        std::size_t                 numActiveTasks_ = 0;
+        bool                        quit_           = false;
+        std::mutex                  mutex_;
+        std::condition_variable     wakeSignal_;
+        std::condition_variable     idleSignal_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
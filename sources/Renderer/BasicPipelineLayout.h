@@ -11,6 +11,7 @@
 
 #include <LLGL/PipelineLayout.h>
 #include <LLGL/PipelineLayoutFlags.h>
+#include "ResourceBindingIterator.h"
 #include <vector>
 
 
@@ -18,7 +19,7 @@ namespace LLGL
 {
 
 
-// This class only holds a copy of the binding descriptor list.
+// This class only holds a copy of the binding descriptor list and its binding points bucketed by resource type and stage.
 class LLGL_EXPORT BasicPipelineLayout : public PipelineLayout
 {
 
@@ -36,9 +37,16 @@ class LLGL_EXPORT BasicPipelineLayout : public PipelineLayout
             return bindings_;
         }
 
+        // Returns the binding points bucketed by resource type and stage, which are shared by all resource heaps of this layout.
+        inline const ResourceBindingBuckets& GetBindingBuckets() const
+        {
+            return bindingBuckets_;
+        }
+
     private:
 
-        std::vector<BindingDescriptor> bindings_;
+        std::vector<BindingDescriptor>  bindings_;
+        ResourceBindingBuckets          bindingBuckets_;
 
 };
 
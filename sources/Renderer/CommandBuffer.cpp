@@ -0,0 +1,25 @@
+/*
+ * CommandBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandBuffer.h>
+
+
+namespace LLGL
+{
+
+
+std::uint32_t CommandBuffer::GetNumRemovedCommands() const
+{
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -366,6 +366,7 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
     caps.features.hasLogicOp                        = (featureLevel >= D3D_FEATURE_LEVEL_11_1);
     caps.features.hasPipelineStatistics             = true;
     caps.features.hasRenderCondition                = true;
+    caps.features.hasDynamicBufferOffsets           = false; // not supported by D3D11 and D3D12 backends
 
     /* Query limits */
     caps.limits.lineWidthRange[0]                   = 1.0f;
@@ -17,6 +17,7 @@
 #include "RenderState/DbgQueryHeap.h"
 #include "RenderState/DbgPipelineState.h"
 #include "RenderState/DbgResourceHeap.h"
+#include "RenderState/DbgPipelineLayout.h"
 #include "Shader/DbgShader.h"
 #include "Texture/DbgTexture.h"
 #include "Texture/DbgRenderTarget.h"
@@ -100,12 +101,18 @@ void DbgCommandBuffer::End()
     if (debugger_)
         EnableRecording(false);
     instance.End();
+    profile_.removedCommands += instance.GetNumRemovedCommands();
 
     /* Resolve timer query results for performance profiler */
     if (perfProfilerEnabled_)
         timerMngr_.TakeRecords(profile_.timeRecords);
 }
 
+std::uint32_t DbgCommandBuffer::GetNumRemovedCommands() const
+{
+    return instance.GetNumRemovedCommands();
+}
+
 void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, deferredCommandBuffer);
@@ -134,7 +141,7 @@ void DbgCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
 
@@ -514,6 +521,27 @@ void DbgCommandBuffer::SetResourceHeap(
     profile_.resourceHeapBindings++;
 }
 
+void DbgCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    auto& resourceHeapDbg = LLGL_CAST(DbgResourceHeap&, resourceHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+        ValidateDescriptorSetIndex(firstSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
+        ValidateDynamicOffsets(resourceHeapDbg, dynamicOffsets);
+    }
+
+    LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, firstSet, bindPoint, dynamicOffsets) );
+
+    profile_.resourceHeapBindings++;
+}
+
 void DbgCommandBuffer::SetResource(
     Resource&       resource,
     std::uint32_t   slot,
@@ -789,6 +817,12 @@ void DbgCommandBuffer::SetUniform(
     const void*     data,
     std::uint32_t   dataSize)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateUniforms(location, dataSize);
+    }
+
     LLGL_DBG_COMMAND( "SetUniform", instance.SetUniform(location, data, dataSize) );
 }
 
@@ -798,6 +832,12 @@ void DbgCommandBuffer::SetUniforms(
     const void*     data,
     std::uint32_t   dataSize)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateUniforms(location, dataSize);
+    }
+
     LLGL_DBG_COMMAND( "SetUniforms", instance.SetUniforms(location, count, data, dataSize) );
 }
 
@@ -1609,6 +1649,57 @@ void DbgCommandBuffer::ValidateDescriptorSetIndex(std::uint32_t setIndex, std::u
     }
 }
 
+void DbgCommandBuffer::ValidateDynamicOffsets(DbgResourceHeap& resourceHeapDbg, const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    /* Count bindings with dynamic offsets in the pipeline layout of the resource heap */
+    std::size_t numDynamicBindings = 0;
+    if (auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, resourceHeapDbg.desc.pipelineLayout))
+    {
+        for (const auto& binding : pipelineLayoutDbg->desc.bindings)
+        {
+            if (binding.dynamicOffset)
+                ++numDynamicBindings;
+        }
+    }
+
+    if (dynamicOffsets.size() != numDynamicBindings)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "mismatch between number of dynamic offsets (" + std::to_string(dynamicOffsets.size()) +
+            ") and dynamic bindings in pipeline layout (" + std::to_string(numDynamicBindings) + ")"
+        );
+    }
+
+    for (auto offset : dynamicOffsets)
+        ValidateAddressAlignment(offset, limits_.minConstantBufferAlignment, "dynamic buffer offset");
+
+    /* Backends without support for dynamic offsets bind the resource heap as if all offsets were zero */
+    if (!features_.hasDynamicBufferOffsets)
+    {
+        for (auto offset : dynamicOffsets)
+        {
+            if (offset != 0)
+            {
+                LLGL_DBG_WARN(WarningType::VaryingBehavior, "non-zero dynamic buffer offsets are ignored because the renderer does not support dynamic buffer offsets");
+                break;
+            }
+        }
+    }
+}
+
+void DbgCommandBuffer::ValidateUniforms(UniformLocation location, std::uint32_t dataSize)
+{
+    AssertRecording();
+
+    if (bindings_.pipelineState == nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "no pipeline is bound: missing call to <LLGL::CommandBuffer::SetPipelineState> before setting uniforms");
+    if (location < 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid uniform location: " + std::to_string(location));
+    if (dataSize == 0 || dataSize % 4 != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "uniform data size must be a non-zero multiple of 4, but " + std::to_string(dataSize) + " was specified");
+}
+
 static const char* BindFlagToString(long bindFlag)
 {
     switch (bindFlag)
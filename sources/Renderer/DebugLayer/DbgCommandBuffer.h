@@ -29,6 +29,7 @@ class DbgTexture;
 class DbgSwapChain;
 class DbgRenderTarget;
 class DbgPipelineState;
+class DbgResourceHeap;
 class DbgShader;
 class RenderingDebugger;
 class RenderingProfiler;
@@ -55,6 +56,8 @@ class DbgCommandBuffer final : public CommandBuffer
         void Begin() override;
         void End() override;
 
+        std::uint32_t GetNumRemovedCommands() const override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -63,7 +66,7 @@ class DbgCommandBuffer final : public CommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -134,6 +137,13 @@ class DbgCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -265,6 +275,8 @@ class DbgCommandBuffer final : public CommandBuffer
         void ValidateThreadGroupLimit(std::uint32_t size, std::uint32_t limit);
         void ValidateAttachmentLimit(std::uint32_t attachmentIndex, std::uint32_t attachmentUpperBound);
         void ValidateDescriptorSetIndex(std::uint32_t setIndex, std::uint32_t setUpperBound, const char* resourceHeapName = nullptr);
+        void ValidateDynamicOffsets(DbgResourceHeap& resourceHeapDbg, const ArrayView<std::uint32_t>& dynamicOffsets);
+        void ValidateUniforms(UniformLocation location, std::uint32_t dataSize);
 
         void ValidateBindFlags(long resourceFlags, long bindFlags, long validFlags, const char* resourceName = nullptr);
         void ValidateBindBufferFlags(DbgBuffer& bufferDbg, long bindFlags);
@@ -11,6 +11,7 @@
 #include "../CheckedCast.h"
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/Container/SmallVector.h>
 
 
 namespace LLGL
@@ -33,13 +34,27 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
     instance.Submit(commandBufferDbg.instance);
 
     if (profiler_)
+        AccumulateProfile(commandBufferDbg);
+}
+
+void DbgCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Forward all command buffer instances at once, so the backend can batch the submission */
+    SmallVector<CommandBuffer*> commandBufferInstances;
+    commandBufferInstances.reserve(numCommandBuffers);
+
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
     {
-        /* Merge frame profile values into rendering profiler */
-        FrameProfile profile;
-        commandBufferDbg.NextProfile(profile);
-        profile.commandBufferSubmittions++;
+        auto commandBufferDbg = LLGL_CAST(DbgCommandBuffer*, commandBuffers[i]);
+        commandBufferInstances.push_back(&(commandBufferDbg->instance));
+    }
+
+    instance.Submit(numCommandBuffers, commandBufferInstances.data());
 
-        profiler_->Accumulate(profile);
+    if (profiler_)
+    {
+        for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+            AccumulateProfile(LLGL_CAST(DbgCommandBuffer&, *commandBuffers[i]));
     }
 }
 
@@ -123,6 +138,16 @@ void DbgCommandQueue::ValidateQueryResult(
     }
 }
 
+void DbgCommandQueue::AccumulateProfile(DbgCommandBuffer& commandBufferDbg)
+{
+    /* Merge frame profile values into rendering profiler */
+    FrameProfile profile;
+    commandBufferDbg.NextProfile(profile);
+    profile.commandBufferSubmittions++;
+
+    profiler_->Accumulate(profile);
+}
+
 
 } // /namespace LLGL
 
@@ -18,6 +18,7 @@ namespace LLGL
 
 class RenderingProfiler;
 class RenderingDebugger;
+class DbgCommandBuffer;
 class DbgQueryHeap;
 
 class DbgCommandQueue final : public CommandQueue
@@ -36,6 +37,7 @@ class DbgCommandQueue final : public CommandQueue
         /* ----- Command Buffers ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
 
         /* ----- Queries ----- */
 
@@ -70,6 +72,9 @@ class DbgCommandQueue final : public CommandQueue
             std::size_t     dataSize
         );
 
+        // Merges the frame profile of the specified submitted command buffer into the rendering profiler.
+        void AccumulateProfile(DbgCommandBuffer& commandBufferDbg);
+
     private:
 
         RenderingProfiler* profiler_ = nullptr;
@@ -314,6 +314,42 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
         profiler_->frameProfile.textureReads++;
 }
 
+std::uint64_t DbgRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateTextureRegion(textureDbg, textureRegion);
+    }
+
+    const auto ticket = instance_->ReadTextureAsync(textureDbg.instance, textureRegion, format, dataType);
+
+    if (profiler_)
+        profiler_->frameProfile.textureReads++;
+
+    return ticket;
+}
+
+const void* DbgRenderSystem::MapTextureReadback(std::uint64_t ticket, bool wait, std::size_t* dataSize)
+{
+    auto data = instance_->MapTextureReadback(ticket, wait, dataSize);
+
+    if (debugger_ && data == nullptr && wait)
+    {
+        LLGL_DBG_SOURCE;
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid or expired texture readback ticket: " + std::to_string(ticket));
+    }
+
+    return data;
+}
+
+void DbgRenderSystem::UnmapTextureReadback(std::uint64_t ticket)
+{
+    instance_->UnmapTextureReadback(ticket);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
@@ -346,24 +382,8 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
 
         for (auto& resourceView : instanceDesc.resourceViews)
         {
-            if (auto resource = resourceView.resource)
-            {
-                switch (resource->GetResourceType())
-                {
-                    case ResourceType::Buffer:
-                        resourceView.resource = &(LLGL_CAST(DbgBuffer*, resourceView.resource)->instance);
-                        break;
-                    case ResourceType::Texture:
-                        resourceView.resource = &(LLGL_CAST(DbgTexture*, resourceView.resource)->instance);
-                        break;
-                    case ResourceType::Sampler:
-                        //TODO: DbgSampler
-                        break;
-                    default:
-                        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid resource type passed to <ResourceViewDescriptor>");
-                        break;
-                }
-            }
+            if (resourceView.resource != nullptr)
+                ConvertResourceViewToInstance(resourceView);
             else
                 LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to <ResourceViewDescriptor>");
         }
@@ -379,6 +399,34 @@ void DbgRenderSystem::Release(ResourceHeap& resourceHeap)
     return instance_->Release(resourceHeap);
 }
 
+std::uint32_t DbgRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resourceHeapDbg = LLGL_CAST(DbgResourceHeap&, resourceHeap);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateResourceHeapRange(resourceHeapDbg, firstDescriptor, resourceViews);
+    }
+
+    /* Keep debug information up to date and create copy of resource views to pass native renderer object references */
+    std::vector<ResourceViewDescriptor> instanceResourceViews(resourceViews.begin(), resourceViews.end());
+
+    for_range(i, instanceResourceViews.size())
+    {
+        auto& resourceView = instanceResourceViews[i];
+        if (resourceView.resource != nullptr)
+        {
+            const auto descriptor = static_cast<std::size_t>(firstDescriptor) + i;
+            if (descriptor < resourceHeapDbg.desc.resourceViews.size())
+                resourceHeapDbg.desc.resourceViews[descriptor] = resourceView;
+            ConvertResourceViewToInstance(resourceView);
+        }
+    }
+
+    return instance_->WriteResourceHeap(resourceHeapDbg.instance, firstDescriptor, instanceResourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* DbgRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
@@ -468,13 +516,9 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const Blob& serializedCache)
     return nullptr;//TODO
 }
 
-PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+// Returns a copy of the specified graphics PSO descriptor with all debug layer objects replaced by their instances.
+static GraphicsPipelineDescriptor GetInstanceGraphicsPipelineDesc(const GraphicsPipelineDescriptor& pipelineStateDesc)
 {
-    LLGL_DBG_SOURCE;
-
-    if (debugger_)
-        ValidateGraphicsPipelineDesc(pipelineStateDesc);
-
     auto instanceDesc = pipelineStateDesc;
     {
         if (pipelineStateDesc.pipelineLayout != nullptr)
@@ -486,6 +530,30 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescri
         instanceDesc.geometryShader         = GetInstanceShader(pipelineStateDesc.geometryShader);
         instanceDesc.fragmentShader         = GetInstanceShader(pipelineStateDesc.fragmentShader);
     }
+    return instanceDesc;
+}
+
+// Returns a copy of the specified compute PSO descriptor with all debug layer objects replaced by their instances.
+static ComputePipelineDescriptor GetInstanceComputePipelineDesc(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    auto instanceDesc = pipelineStateDesc;
+    {
+        if (pipelineStateDesc.pipelineLayout != nullptr)
+            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
+
+        instanceDesc.computeShader = GetInstanceShader(pipelineStateDesc.computeShader);
+    }
+    return instanceDesc;
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
+
+    const auto instanceDesc = GetInstanceGraphicsPipelineDesc(pipelineStateDesc);
     return TakeOwnership(
         pipelineStates_,
         MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc)
@@ -499,19 +567,41 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const ComputePipelineDescrip
     if (debugger_)
         ValidateComputePipelineDesc(pipelineStateDesc);
 
-    auto instanceDesc = pipelineStateDesc;
-    {
-        if (pipelineStateDesc.pipelineLayout != nullptr)
-            instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, pipelineStateDesc.pipelineLayout)->instance);
-
-        instanceDesc.computeShader = GetInstanceShader(pipelineStateDesc.computeShader);
-    }
+    const auto instanceDesc = GetInstanceComputePipelineDesc(pipelineStateDesc);
     return TakeOwnership(
         pipelineStates_,
         MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), pipelineStateDesc)
     );
 }
 
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateGraphicsPipelineDesc(pipelineStateDesc);
+
+    const auto instanceDesc = GetInstanceGraphicsPipelineDesc(pipelineStateDesc);
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineStateAsync(instanceDesc), pipelineStateDesc)
+    );
+}
+
+PipelineState* DbgRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    LLGL_DBG_SOURCE;
+
+    if (debugger_)
+        ValidateComputePipelineDesc(pipelineStateDesc);
+
+    const auto instanceDesc = GetInstanceComputePipelineDesc(pipelineStateDesc);
+    return TakeOwnership(
+        pipelineStates_,
+        MakeUnique<DbgPipelineState>(*instance_->CreatePipelineStateAsync(instanceDesc), pipelineStateDesc)
+    );
+}
+
 void DbgRenderSystem::Release(PipelineState& pipelineState)
 {
     ReleaseDbg(pipelineStates_, pipelineState);
@@ -1316,6 +1406,45 @@ void DbgRenderSystem::ValidateResourceHeapDesc(const ResourceHeapDescriptor& res
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "pipeline layout must not be null");
 }
 
+void DbgRenderSystem::ValidateResourceHeapRange(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    const auto numDescriptors = resourceHeapDbg.desc.resourceViews.size();
+
+    if (firstDescriptor >= numDescriptors)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "first descriptor (" + std::to_string(firstDescriptor) + ") out of range for resource heap with " +
+            std::to_string(numDescriptors) + " descriptor(s)"
+        );
+        return;
+    }
+
+    if (resourceViews.empty())
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "no resource views specified to write into resource heap");
+    else if (resourceViews.size() > numDescriptors - firstDescriptor)
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperArgument,
+            "resource views [" + std::to_string(firstDescriptor) + ", " + std::to_string(firstDescriptor + resourceViews.size()) +
+            ") exceed resource heap with " + std::to_string(numDescriptors) + " descriptor(s); remaining resource views are ignored"
+        );
+    }
+
+    /* Validate all resource view descriptors within range against their respective binding descriptor */
+    auto pipelineLayoutDbg = LLGL_CAST(const DbgPipelineLayout*, resourceHeapDbg.desc.pipelineLayout);
+    const auto& bindings = pipelineLayoutDbg->desc.bindings;
+
+    if (!bindings.empty())
+    {
+        for_range(i, std::min(resourceViews.size(), numDescriptors - firstDescriptor))
+        {
+            if (resourceViews[i].resource != nullptr)
+                ValidateResourceViewForBinding(resourceViews[i], bindings[(firstDescriptor + i) % bindings.size()]);
+        }
+    }
+}
+
 void DbgRenderSystem::ValidateResourceViewForBinding(const ResourceViewDescriptor& rvDesc, const BindingDescriptor& bindingDesc)
 {
     /* Validate stage flags against shader program */
@@ -1560,6 +1689,25 @@ void DbgRenderSystem::AssertMultiSampleTextures()
         LLGL_DBG_ERROR_NOT_SUPPORTED("multi-sample textures");
 }
 
+void DbgRenderSystem::ConvertResourceViewToInstance(ResourceViewDescriptor& resourceView)
+{
+    switch (resourceView.resource->GetResourceType())
+    {
+        case ResourceType::Buffer:
+            resourceView.resource = &(LLGL_CAST(DbgBuffer*, resourceView.resource)->instance);
+            break;
+        case ResourceType::Texture:
+            resourceView.resource = &(LLGL_CAST(DbgTexture*, resourceView.resource)->instance);
+            break;
+        case ResourceType::Sampler:
+            //TODO: DbgSampler
+            break;
+        default:
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid resource type passed to <ResourceViewDescriptor>");
+            break;
+    }
+}
+
 template <typename T, typename TBase>
 void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
 {
@@ -81,6 +81,10 @@ class DbgRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        std::uint64_t ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType) override;
+        const void* MapTextureReadback(std::uint64_t ticket, bool wait = true, std::size_t* dataSize = nullptr) override;
+        void UnmapTextureReadback(std::uint64_t ticket) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -93,6 +97,8 @@ class DbgRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
@@ -122,6 +128,8 @@ class DbgRenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const Blob& serializedCache) override;
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc) override;
 
         void Release(PipelineState& pipelineState) override;
 
@@ -175,6 +183,7 @@ class DbgRenderSystem final : public RenderSystem
         void ValidateAttachmentDesc(const AttachmentDescriptor& attachmentDesc);
 
         void ValidateResourceHeapDesc(const ResourceHeapDescriptor& resourceHeapDesc);
+        void ValidateResourceHeapRange(const DbgResourceHeap& resourceHeapDbg, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
         void ValidateResourceViewForBinding(const ResourceViewDescriptor& rvDesc, const BindingDescriptor& bindingDesc);
         void ValidateBufferForBinding(const DbgBuffer& bufferDbg, const BindingDescriptor& bindingDesc);
         void ValidateTextureForBinding(const DbgTexture& textureDbg, const BindingDescriptor& bindingDesc);
@@ -190,6 +199,9 @@ class DbgRenderSystem final : public RenderSystem
         void AssertCubeArrayTextures();
         void AssertMultiSampleTextures();
 
+        // Replaces the debug layer resource of the specified resource view by its native renderer object reference.
+        void ConvertResourceViewToInstance(ResourceViewDescriptor& resourceView);
+
         template <typename T, typename TBase>
         void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
 
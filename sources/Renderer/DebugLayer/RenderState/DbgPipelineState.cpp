@@ -42,6 +42,11 @@ const Report* DbgPipelineState::GetReport() const
     return instance.GetReport();
 }
 
+bool DbgPipelineState::IsReady() const
+{
+    return instance.IsReady();
+}
+
 
 } // /namespace LLGL
 
@@ -25,6 +25,7 @@ class DbgPipelineState final : public PipelineState
 
         void SetName(const char* name) override;
         const Report* GetReport() const override;
+        bool IsReady() const override;
 
     public:
 
@@ -37,7 +37,7 @@ class DbgResourceHeap final : public ResourceHeap
     public:
 
         ResourceHeap&                   instance;
-        const ResourceHeapDescriptor    desc;
+        ResourceHeapDescriptor          desc;
         std::string                     label;
         const std::uint32_t             numBindings = 1;
 
@@ -20,6 +20,7 @@
 #include "../TextureUtils.h"
 #include <algorithm>
 #include <codecvt>
+#include <stdexcept>
 
 #include "RenderState/D3D11StateManager.h"
 #include "RenderState/D3D11PipelineState.h"
@@ -105,8 +106,12 @@ void D3D11CommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
+    /* D3D11 addresses buffer ranges with 32-bit values only */
+    if (dataSize > UINT_MAX || dstOffset > UINT_MAX - dataSize)
+        throw std::out_of_range("cannot update D3D11 buffer with range exceeding 32-bit limit");
+
     auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
     dstBufferD3D.UpdateSubresource(context_.Get(), data, static_cast<UINT>(dataSize), static_cast<UINT>(dstOffset));
 }
@@ -777,6 +782,16 @@ void D3D11CommandBuffer::SetResourceHeap(
     }
 }
 
+void D3D11CommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& /*dynamicOffsets*/)
+{
+    /* Dynamic offsets are not supported by the D3D11 backend */
+    SetResourceHeap(resourceHeap, firstSet, bindPoint);
+}
+
 void D3D11CommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
 {
     switch (resource.GetResourceType())
@@ -55,7 +55,7 @@ class D3D11CommandBuffer final : public CommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -126,6 +126,13 @@ class D3D11CommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
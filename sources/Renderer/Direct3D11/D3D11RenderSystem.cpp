@@ -353,6 +353,12 @@ void D3D11RenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t D3D11RenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
+    return resourceHeapD3D.WriteResourceViews(firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* D3D11RenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
@@ -17,7 +17,7 @@
 #include "../../TextureUtils.h"
 #include "../../BufferUtils.h"
 #include "../../../Core/Helper.h"
-#include <LLGL/ResourceHeapFlags.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -112,65 +112,59 @@ static const UINT g_cbufferRegisterSize = 16;
  * D3D11ResourceHeap class
  */
 
-D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc, bool hasDeviceContextD3D11_1)
+D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc, bool hasDeviceContextD3D11_1) :
+    resourceViews_           { desc.resourceViews      },
+    hasDeviceContextD3D11_1_ { hasDeviceContextD3D11_1 }
 {
     /* Get pipeline layout object */
-    auto pipelineLayoutD3D = LLGL_CAST(D3D11PipelineLayout*, desc.pipelineLayout);
-    if (!pipelineLayoutD3D)
+    pipelineLayout_ = LLGL_CAST(D3D11PipelineLayout*, desc.pipelineLayout);
+    if (!pipelineLayout_)
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
     /* Validate binding descriptors */
-    const auto& bindings            = pipelineLayoutD3D->GetBindings();
-    const auto  numBindings         = bindings.size();
-    const auto  numResourceViews    = desc.resourceViews.size();
+    const auto numBindings = pipelineLayout_->GetBindings().size();
 
     if (numBindings == 0)
         throw std::invalid_argument("cannot create resource heap without bindings in pipeline layout");
-    if (numResourceViews % numBindings != 0)
+    if (resourceViews_.size() % numBindings != 0)
         throw std::invalid_argument("failed to create resource heap because due to mismatch between number of resources and bindings");
 
-    /* Build buffer segments (stage after stage, so the internal buffer is constructed in the correct order) */
-    for (std::size_t i = 0; i < numResourceViews; i += numBindings)
-    {
-        /* Reset segment header, only one is required */
-        ResourceBindingIterator resourceIterator { desc.resourceViews, bindings, i };
-        InitMemory(segmentation_);
-
-        /* Build resource view segments for GRAPHICS stages in current descriptor set */
-        BuildSegmentsForStage(resourceIterator, StageFlags::VertexStage);
-        BuildSegmentsForStage(resourceIterator, StageFlags::TessControlStage);
-        BuildSegmentsForStage(resourceIterator, StageFlags::TessEvaluationStage);
-        BuildSegmentsForStage(resourceIterator, StageFlags::GeometryStage);
-        BuildSegmentsForStage(resourceIterator, StageFlags::FragmentStage);
+    /* Build internal buffer and resource views */
+    BuildResourceViewHeap();
+}
 
-        /* Build resource view segments for COMPUTE stage in current descriptor set */
-        if (i == 0)
-        {
-            if (buffer_.size() > UINT16_MAX)
-                throw std::out_of_range("internal buffer for resource heap exceeded limit of 2^16 (65536) bytes");
-            bufferOffsetCS_ = static_cast<std::uint16_t>(buffer_.size());
-        }
+std::uint32_t D3D11ResourceHeap::GetNumDescriptorSets() const
+{
+    return static_cast<std::uint32_t>(stride_ > 0 ? buffer_.size() / stride_ : 0);
+}
 
-        BuildSegmentsForStage(resourceIterator, StageFlags::ComputeStage);
-    }
+std::uint32_t D3D11ResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    if (firstDescriptor >= resourceViews_.size())
+        return 0;
 
-    /* Store buffer stride */
-    stride_ = buffer_.size() / (numResourceViews / numBindings);
+    /* Replace resource views within the range of this heap; null resources keep their previous descriptor */
+    const auto numResourceViews = std::min(resourceViews.size(), resourceViews_.size() - firstDescriptor);
 
-    /* Store resource usage bits in segmentation header */
-    StoreResourceUsage();
+    std::uint32_t numWritten = 0;
 
-    /* Validate feature level supports all enabled features */
-    if (!hasDeviceContextD3D11_1)
+    for (std::size_t i = 0; i < numResourceViews; ++i)
     {
-        if (HasCbufferRanges())
-            throw std::runtime_error("cannot create constant-buffer range for Direct3D API version prior to 11.1");
+        const auto& rvDesc = resourceViews[i];
+        if (auto resource = rvDesc.resource)
+        {
+            auto& prevRVDesc = resourceViews_[firstDescriptor + i];
+            if (prevRVDesc.resource != nullptr && resource->GetResourceType() != prevRVDesc.resource->GetResourceType())
+                throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
+            prevRVDesc = rvDesc;
+            ++numWritten;
+        }
     }
-}
 
-std::uint32_t D3D11ResourceHeap::GetNumDescriptorSets() const
-{
-    return static_cast<std::uint32_t>(stride_ > 0 ? buffer_.size() / stride_ : 0);
+    if (numWritten > 0)
+        BuildResourceViewHeap();
+
+    return numWritten;
 }
 
 void D3D11ResourceHeap::BindForGraphicsPipeline(ID3D11DeviceContext* context, std::uint32_t firstSet)
@@ -247,6 +241,57 @@ bool D3D11ResourceHeap::HasCbufferRanges() const
  * ======= Private: =======
  */
 
+void D3D11ResourceHeap::BuildResourceViewHeap()
+{
+    const auto& bindings            = pipelineLayout_->GetBindings();
+    const auto& bindingBuckets      = pipelineLayout_->GetBindingBuckets();
+    const auto  numBindings         = bindings.size();
+    const auto  numResourceViews    = resourceViews_.size();
+
+    /* Release previous buffer and resource views */
+    buffer_.clear();
+    srvs_.clear();
+    uavs_.clear();
+
+    /* Build buffer segments (stage after stage, so the internal buffer is constructed in the correct order) */
+    for (std::size_t i = 0; i < numResourceViews; i += numBindings)
+    {
+        /* Reset segment header, only one is required */
+        ResourceBindingIterator resourceIterator { resourceViews_, bindings, bindingBuckets, i };
+        InitMemory(segmentation_);
+
+        /* Build resource view segments for GRAPHICS stages in current descriptor set */
+        BuildSegmentsForStage(resourceIterator, StageFlags::VertexStage);
+        BuildSegmentsForStage(resourceIterator, StageFlags::TessControlStage);
+        BuildSegmentsForStage(resourceIterator, StageFlags::TessEvaluationStage);
+        BuildSegmentsForStage(resourceIterator, StageFlags::GeometryStage);
+        BuildSegmentsForStage(resourceIterator, StageFlags::FragmentStage);
+
+        /* Build resource view segments for COMPUTE stage in current descriptor set */
+        if (i == 0)
+        {
+            if (buffer_.size() > UINT16_MAX)
+                throw std::out_of_range("internal buffer for resource heap exceeded limit of 2^16 (65536) bytes");
+            bufferOffsetCS_ = static_cast<std::uint16_t>(buffer_.size());
+        }
+
+        BuildSegmentsForStage(resourceIterator, StageFlags::ComputeStage);
+    }
+
+    /* Store buffer stride */
+    stride_ = buffer_.size() / (numResourceViews / numBindings);
+
+    /* Store resource usage bits in segmentation header */
+    StoreResourceUsage();
+
+    /* Validate feature level supports all enabled features */
+    if (!hasDeviceContextD3D11_1_)
+    {
+        if (HasCbufferRanges())
+            throw std::runtime_error("cannot create constant-buffer range for Direct3D API version prior to 11.1");
+    }
+}
+
 using D3DResourceBindingFunc = std::function<
     bool(
         D3DResourceBinding&             binding,
@@ -11,6 +11,8 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/Container/ArrayView.h>
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
 #include <functional>
@@ -23,8 +25,8 @@ namespace LLGL
 
 class D3D11Texture;
 class D3D11BufferWithRV;
+class D3D11PipelineLayout;
 class ResourceBindingIterator;
-struct ResourceHeapDescriptor;
 struct TextureViewDescriptor;
 struct BufferViewDescriptor;
 struct D3DResourceBinding;
@@ -57,11 +59,20 @@ class D3D11ResourceHeap final : public ResourceHeap
         // Returns true if this resource heap contains non-default constant-buffer ranges (requires feature level D3D_FEATURE_LEVEL_11_1).
         bool HasCbufferRanges() const;
 
+        /*
+        Replaces the specified resource views and returns the number of written descriptors.
+        Since this heap only emulates a descriptor heap, the internal buffer is rebuilt from the updated list of resource views.
+        */
+        std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
     private:
 
         using D3DResourceBindingIter = std::vector<D3DResourceBinding>::const_iterator;
         using BuildSegmentFunc = std::function<void(D3DResourceBindingIter begin, UINT count)>;
 
+        // Builds the internal buffer and resource views from the stored list of resource views.
+        void BuildResourceViewHeap();
+
         void BuildSegmentsForStage(ResourceBindingIterator& resourceIterator, long stage);
         void BuildConstantBufferRangeSegments(ResourceBindingIterator& resourceIterator, long stage);
         void BuildConstantBufferSegments(ResourceBindingIterator& resourceIterator, long stage);
@@ -180,6 +191,10 @@ class D3D11ResourceHeap final : public ResourceHeap
 
     private:
 
+        const D3D11PipelineLayout*                      pipelineLayout_ = nullptr;
+        std::vector<ResourceViewDescriptor>             resourceViews_;
+        bool                                            hasDeviceContextD3D11_1_ = false;
+
         BufferSegmentation                              segmentation_;
 
         std::size_t                                     stride_         = 0;
@@ -89,7 +89,7 @@ void D3D12CommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
     stagingBufferPool_.WriteStaged(commandContext_, dstBufferD3D.GetResource(), dstOffset, data, dataSize);
@@ -555,6 +555,16 @@ void D3D12CommandBuffer::SetResourceHeap(
     }
 }
 
+void D3D12CommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& /*dynamicOffsets*/)
+{
+    /* Dynamic offsets are not supported by the D3D12 backend */
+    SetResourceHeap(resourceHeap, firstSet, bindPoint);
+}
+
 void D3D12CommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
 {
     //TODOL: use "SetGraphicsRootShaderResourceView" etc.
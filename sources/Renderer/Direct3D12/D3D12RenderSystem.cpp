@@ -365,6 +365,12 @@ void D3D12RenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t D3D12RenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
+    return resourceHeapD3D.WriteResourceViews(device_.GetNative(), firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* D3D12RenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
@@ -107,6 +107,8 @@ class D3D12RenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
@@ -18,6 +18,7 @@
 #include "../../BufferUtils.h"
 #include <LLGL/Resource.h>
 #include <LLGL/ResourceHeapFlags.h>
+#include <algorithm>
 #include <functional>
 
 
@@ -117,6 +118,8 @@ D3D12ResourceHeap::D3D12ResourceHeap(ID3D12Device* device, const ResourceHeapDes
 
     const auto& rootParameterLayout = pipelineLayoutD3D->GetRootParameterLayout();
 
+    locations_.resize(desc.resourceViews.size());
+
     descriptorHandleStrides_[0] =
     (
         rootParameterLayout.numBufferCBV  +
@@ -160,7 +163,10 @@ D3D12ResourceHeap::D3D12ResourceHeap(ID3D12Device* device, const ResourceHeapDes
                 for (std::size_t j = 0; j < numBindings; ++j)
                 {
                     if (auto resource = GetD3DResourceWithUAV(desc.resourceViews[i + j]))
+                    {
+                        locations_[i + j].barrierIndex = static_cast<UINT>(barriers_.size());
                         AppendUAVBarrier(resource);
+                    }
                 }
             }
             barrierOffsets_.push_back(barrierOffset);
@@ -182,6 +188,33 @@ void D3D12ResourceHeap::InsertResourceBarriers(ID3D12GraphicsCommandList* comman
     }
 }
 
+std::uint32_t D3D12ResourceHeap::WriteResourceViews(
+    ID3D12Device*                               device,
+    std::uint32_t                               firstDescriptor,
+    const ArrayView<ResourceViewDescriptor>&    resourceViews)
+{
+    if (firstDescriptor >= locations_.size())
+        return 0;
+
+    /* Only update the descriptors within the range of this heap */
+    const auto numResourceViews = std::min(resourceViews.size(), locations_.size() - firstDescriptor);
+
+    std::uint32_t numWritten = 0;
+
+    for (std::size_t i = 0; i < numResourceViews; ++i)
+    {
+        /* Skip over null resources; they keep their previous descriptor */
+        const auto& rvDesc = resourceViews[i];
+        if (auto resource = rvDesc.resource)
+        {
+            WriteResourceView(device, locations_[firstDescriptor + i], *resource, rvDesc);
+            ++numWritten;
+        }
+    }
+
+    return numWritten;
+}
+
 void D3D12ResourceHeap::SetName(const char* name)
 {
     D3D12SetObjectNameSubscript(heapTypeCbvSrvUav_.Get(), name, ".CbvSrvUav");
@@ -343,6 +376,7 @@ void D3D12ResourceHeap::CreateConstantBufferViews(
             auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
             if (MatchBindFlags(*pipelineLayoutD3D, bufferD3D.GetBindFlags(), BindFlags::ConstantBuffer, bindingIndex))
             {
+                StoreDescriptorLocation(desc, rvDesc, DescriptorType::BufferCBV, cpuDescHandle);
                 if (IsBufferViewEnabled(rvDesc.bufferView))
                     bufferD3D.CreateConstantBufferView(device, cpuDescHandle, rvDesc.bufferView);
                 else
@@ -378,6 +412,7 @@ void D3D12ResourceHeap::CreateShaderResourceViews(
             auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
             if (MatchBindFlags(*pipelineLayoutD3D, bufferD3D.GetBindFlags(), BindFlags::Sampled, bindingIndex))
             {
+                StoreDescriptorLocation(desc, rvDesc, DescriptorType::BufferSRV, cpuDescHandle);
                 if (IsBufferViewEnabled(rvDesc.bufferView))
                     bufferD3D.CreateShaderResourceView(device, cpuDescHandle, rvDesc.bufferView);
                 else
@@ -400,6 +435,7 @@ void D3D12ResourceHeap::CreateShaderResourceViews(
             auto& textureD3D = LLGL_CAST(D3D12Texture&, resource);
             if (MatchBindFlags(*pipelineLayoutD3D, textureD3D.GetBindFlags(), BindFlags::Sampled, bindingIndex))
             {
+                StoreDescriptorLocation(desc, rvDesc, DescriptorType::TextureSRV, cpuDescHandle);
                 if (IsTextureViewEnabled(rvDesc.textureView))
                     textureD3D.CreateShaderResourceView(device, cpuDescHandle, rvDesc.textureView);
                 else
@@ -435,6 +471,7 @@ void D3D12ResourceHeap::CreateUnorderedAccessViews(
             auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
             if (MatchBindFlags(*pipelineLayoutD3D, bufferD3D.GetBindFlags(), BindFlags::Storage, bindingIndex))
             {
+                StoreDescriptorLocation(desc, rvDesc, DescriptorType::BufferUAV, cpuDescHandle);
                 if (IsBufferViewEnabled(rvDesc.bufferView))
                     bufferD3D.CreateUnorderedAccessView(device, cpuDescHandle, rvDesc.bufferView);
                 else
@@ -457,6 +494,7 @@ void D3D12ResourceHeap::CreateUnorderedAccessViews(
             auto& textureD3D = LLGL_CAST(D3D12Texture&, resource);
             if (MatchBindFlags(*pipelineLayoutD3D, textureD3D.GetBindFlags(), BindFlags::Storage, bindingIndex))
             {
+                StoreDescriptorLocation(desc, rvDesc, DescriptorType::TextureUAV, cpuDescHandle);
                 if (IsTextureViewEnabled(rvDesc.textureView))
                     textureD3D.CreateUnorderedAccessView(device, cpuDescHandle, rvDesc.textureView);
                 else
@@ -484,8 +522,9 @@ void D3D12ResourceHeap::CreateSamplers(
         ResourceType::Sampler,
         firstResourceIndex,
         rootParameterLayout.numSamplers,
-        [&](Resource& resource, const ResourceViewDescriptor& /*rvDesc*/) -> bool
+        [&](Resource& resource, const ResourceViewDescriptor& rvDesc) -> bool
         {
+            StoreDescriptorLocation(desc, rvDesc, DescriptorType::Sampler, cpuDescHandle);
             auto& samplerD3D = LLGL_CAST(D3D12Sampler&, resource);
             samplerD3D.CreateResourceView(device, cpuDescHandle);
             cpuDescHandle.ptr += descHandleStride;
@@ -495,6 +534,110 @@ void D3D12ResourceHeap::CreateSamplers(
     );
 }
 
+void D3D12ResourceHeap::StoreDescriptorLocation(
+    const ResourceHeapDescriptor&       desc,
+    const ResourceViewDescriptor&       rvDesc,
+    DescriptorType                      type,
+    const D3D12_CPU_DESCRIPTOR_HANDLE&  cpuDescHandle)
+{
+    auto& location = locations_[static_cast<std::size_t>(&rvDesc - desc.resourceViews.data())];
+    location.type           = type;
+    location.cpuDescHandle  = cpuDescHandle;
+}
+
+// Throws an exception if the specified resource does not match the resource type of a descriptor
+static void ValidateResourceType(const Resource& resource, const ResourceType type)
+{
+    if (resource.GetResourceType() != type)
+        throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
+}
+
+void D3D12ResourceHeap::WriteResourceView(
+    ID3D12Device*                   device,
+    DescriptorLocation&             location,
+    Resource&                       resource,
+    const ResourceViewDescriptor&   rvDesc)
+{
+    switch (location.type)
+    {
+        case DescriptorType::BufferCBV:
+        {
+            ValidateResourceType(resource, ResourceType::Buffer);
+            auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+            if (IsBufferViewEnabled(rvDesc.bufferView))
+                bufferD3D.CreateConstantBufferView(device, location.cpuDescHandle, rvDesc.bufferView);
+            else
+                bufferD3D.CreateConstantBufferView(device, location.cpuDescHandle);
+        }
+        break;
+
+        case DescriptorType::BufferSRV:
+        {
+            ValidateResourceType(resource, ResourceType::Buffer);
+            auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+            if (IsBufferViewEnabled(rvDesc.bufferView))
+                bufferD3D.CreateShaderResourceView(device, location.cpuDescHandle, rvDesc.bufferView);
+            else
+                bufferD3D.CreateShaderResourceView(device, location.cpuDescHandle);
+        }
+        break;
+
+        case DescriptorType::TextureSRV:
+        {
+            ValidateResourceType(resource, ResourceType::Texture);
+            auto& textureD3D = LLGL_CAST(D3D12Texture&, resource);
+            if (IsTextureViewEnabled(rvDesc.textureView))
+                textureD3D.CreateShaderResourceView(device, location.cpuDescHandle, rvDesc.textureView);
+            else
+                textureD3D.CreateShaderResourceView(device, location.cpuDescHandle);
+        }
+        break;
+
+        case DescriptorType::BufferUAV:
+        {
+            ValidateResourceType(resource, ResourceType::Buffer);
+            auto& bufferD3D = LLGL_CAST(D3D12Buffer&, resource);
+            if (IsBufferViewEnabled(rvDesc.bufferView))
+                bufferD3D.CreateUnorderedAccessView(device, location.cpuDescHandle, rvDesc.bufferView);
+            else
+                bufferD3D.CreateUnorderedAccessView(device, location.cpuDescHandle);
+        }
+        break;
+
+        case DescriptorType::TextureUAV:
+        {
+            ValidateResourceType(resource, ResourceType::Texture);
+            auto& textureD3D = LLGL_CAST(D3D12Texture&, resource);
+            if (IsTextureViewEnabled(rvDesc.textureView))
+                textureD3D.CreateUnorderedAccessView(device, location.cpuDescHandle, rvDesc.textureView);
+            else
+                textureD3D.CreateUnorderedAccessView(device, location.cpuDescHandle);
+        }
+        break;
+
+        case DescriptorType::Sampler:
+        {
+            ValidateResourceType(resource, ResourceType::Sampler);
+            auto& samplerD3D = LLGL_CAST(D3D12Sampler&, resource);
+            samplerD3D.CreateResourceView(device, location.cpuDescHandle);
+        }
+        break;
+
+        default:
+        {
+            throw std::invalid_argument("cannot write resource into resource heap descriptor that has no binding in the pipeline layout");
+        }
+        break;
+    }
+
+    /* Replace the resource of the UAV barrier that was created for this descriptor */
+    if (location.barrierIndex != ~0u)
+    {
+        if (auto resourceWithUAV = GetD3DResourceWithUAV(rvDesc))
+            barriers_[location.barrierIndex].UAV.pResource = resourceWithUAV;
+    }
+}
+
 void D3D12ResourceHeap::AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap)
 {
     descriptorHeaps_[numDescriptorHeaps_++] = descriptorHeap;
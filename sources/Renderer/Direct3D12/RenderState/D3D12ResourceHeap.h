@@ -10,6 +10,7 @@
 
 
 #include <LLGL/ResourceHeap.h>
+#include <LLGL/Container/ArrayView.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <vector>
@@ -20,7 +21,9 @@ namespace LLGL
 {
 
 
+class Resource;
 struct ResourceHeapDescriptor;
+struct ResourceViewDescriptor;
 struct D3D12RootParameterLayout;
 
 class D3D12ResourceHeap final : public ResourceHeap
@@ -39,6 +42,13 @@ class D3D12ResourceHeap final : public ResourceHeap
         // Inserts the resource barriers for the specified descritpor set into the command list.
         void InsertResourceBarriers(ID3D12GraphicsCommandList* commandList, UINT firstSet);
 
+        // Re-creates the views of the specified descriptors in place and returns the number of written descriptors.
+        std::uint32_t WriteResourceViews(
+            ID3D12Device*                               device,
+            std::uint32_t                               firstDescriptor,
+            const ArrayView<ResourceViewDescriptor>&    resourceViews
+        );
+
         // Returns the array of D3D descriptor heaps.
         inline ID3D12DescriptorHeap* const* GetDescriptorHeaps() const
         {
@@ -69,6 +79,27 @@ class D3D12ResourceHeap final : public ResourceHeap
             return hasComputeDescriptors_;
         }
 
+    private:
+
+        enum class DescriptorType : std::uint8_t
+        {
+            Undefined,
+            BufferCBV,
+            BufferSRV,
+            TextureSRV,
+            BufferUAV,
+            TextureUAV,
+            Sampler,
+        };
+
+        // Location of a resource view within the D3D descriptor heaps, stored for each entry in the resource view list.
+        struct DescriptorLocation
+        {
+            DescriptorType              type            = DescriptorType::Undefined;
+            UINT                        barrierIndex    = ~0u;  // Index into the barrier array or ~0 if this descriptor has no UAV barrier
+            D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle   = {};
+        };
+
     private:
 
         D3D12_CPU_DESCRIPTOR_HANDLE CreateHeapTypeCbvSrvUav(ID3D12Device* device, const ResourceHeapDescriptor& desc);
@@ -110,6 +141,21 @@ class D3D12ResourceHeap final : public ResourceHeap
             const D3D12RootParameterLayout& rootParameterLayout
         );
 
+        // Stores the location of the specified resource view, which must be an element of the resource view list in 'desc'.
+        void StoreDescriptorLocation(
+            const ResourceHeapDescriptor&       desc,
+            const ResourceViewDescriptor&       rvDesc,
+            DescriptorType                      type,
+            const D3D12_CPU_DESCRIPTOR_HANDLE&  cpuDescHandle
+        );
+
+        void WriteResourceView(
+            ID3D12Device*                   device,
+            DescriptorLocation&             location,
+            Resource&                       resource,
+            const ResourceViewDescriptor&   rvDesc
+        );
+
         void AppendDescriptorHeapToArray(ID3D12DescriptorHeap* descriptorHeap);
 
         void AppendUAVBarrier(ID3D12Resource* resource);
@@ -130,6 +176,8 @@ class D3D12ResourceHeap final : public ResourceHeap
         std::vector<D3D12_RESOURCE_BARRIER> barriers_;                          // UAV barriers (TODO: also transition barriers)
         std::vector<UINT>                   barrierOffsets_;                    // Offsets into the barrier array for each descriptor set; array is either empty or has N+1 elements
 
+        std::vector<DescriptorLocation>     locations_;                         // Descriptor locations for each resource view
+
         bool                                hasGraphicsDescriptors_     = false;
         bool                                hasComputeDescriptors_      = false;
 
@@ -0,0 +1,444 @@
+/*
+ * DrawPacketQueue.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/DrawPacketQueue.h>
+#include <LLGL/CommandBuffer.h>
+#include "../Core/ThreadPool.h"
+#include "../Core/Helper.h"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Number of bits per radix sort pass
+static const std::uint32_t  g_radixBits             = 8;
+static const std::size_t    g_radixSize             = (1u << g_radixBits);
+
+// Minimal number of draw packets per worker thread; smaller queues are sorted on the calling thread only
+static const std::size_t    g_minPacketsPerThread   = 16384;
+
+// Bit fields of the 64-bit state key (from most to least significant)
+static const std::uint32_t  g_keyBitsPipelineState  = 16;
+static const std::uint32_t  g_keyBitsResourceHeap   = 16;
+static const std::uint32_t  g_keyBitsDescriptorSet  = 8;
+static const std::uint32_t  g_keyBitsVertexBuffer   = 12;
+static const std::uint32_t  g_keyBitsIndexBuffer    = 12;
+
+static_assert(
+    g_keyBitsPipelineState + g_keyBitsResourceHeap + g_keyBitsDescriptorSet + g_keyBitsVertexBuffer + g_keyBitsIndexBuffer == 64,
+    "bit fields of draw packet state key must add up to 64 bits"
+);
+
+// Dense ranks of state objects in the order of their first appearance; rank 0 is reserved for null
+class StateRanks
+{
+
+    public:
+
+        std::uint64_t Get(const void* object, std::uint32_t numBits)
+        {
+            if (object == nullptr)
+                return 0;
+
+            /* Consecutive packets often share the same objects */
+            if (object == lastObject_)
+                return Saturate(lastRank_, numBits);
+
+            /* Grow hash table to keep load factor below 1/2 */
+            if ((count_ + 1) * 2 > table_.size())
+                Grow();
+
+            /* Find object with linear probing; the table size is always a power of two */
+            const std::size_t mask = table_.size() - 1;
+            for (std::size_t i = Hash(object) & mask;; i = (i + 1) & mask)
+            {
+                auto& entry = table_[i];
+                if (entry.object == object)
+                {
+                    lastRank_ = entry.rank;
+                    break;
+                }
+                if (entry.object == nullptr)
+                {
+                    entry.object    = object;
+                    entry.rank      = static_cast<std::uint32_t>(++count_);
+                    lastRank_       = entry.rank;
+                    break;
+                }
+            }
+
+            lastObject_ = object;
+            return Saturate(lastRank_, numBits);
+        }
+
+        void Clear()
+        {
+            std::fill(table_.begin(), table_.end(), Entry{});
+            count_      = 0;
+            lastObject_ = nullptr;
+            lastRank_   = 0;
+        }
+
+    private:
+
+        struct Entry
+        {
+            const void*     object  = nullptr;
+            std::uint32_t   rank    = 0;
+        };
+
+    private:
+
+        static std::size_t Hash(const void* object)
+        {
+            /* Fibonacci hashing of the pointer; the lower bits are mostly zero due to alignment */
+            const auto value = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(object));
+            return static_cast<std::size_t>((value * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        // Saturates the rank if there are more objects than the bit field can hold; the encoding remains correct, only less optimal
+        static std::uint64_t Saturate(std::uint32_t rank, std::uint32_t numBits)
+        {
+            return std::min<std::uint64_t>(rank, (1ull << numBits) - 1);
+        }
+
+        void Grow()
+        {
+            std::vector<Entry> oldTable(std::max(std::size_t(64), table_.size() * 2));
+            oldTable.swap(table_);
+            const std::size_t mask = table_.size() - 1;
+            for (const auto& entry : oldTable)
+            {
+                if (entry.object != nullptr)
+                {
+                    std::size_t i = Hash(entry.object) & mask;
+                    while (table_[i].object != nullptr)
+                        i = (i + 1) & mask;
+                    table_[i] = entry;
+                }
+            }
+        }
+
+    private:
+
+        std::vector<Entry>  table_;
+        std::size_t         count_      = 0;
+        const void*         lastObject_ = nullptr;
+        std::uint32_t       lastRank_   = 0;
+
+};
+
+struct DrawPacketQueue::Pimpl
+{
+    std::vector<DrawPacket>     packets;
+    std::vector<DrawPacket>     sortedPackets;
+
+    std::vector<std::uint64_t>  keys[2];        // Sort keys (double buffered for radix sort)
+    std::vector<std::uint32_t>  indices[2];     // Packet indices (double buffered for radix sort)
+    std::vector<std::size_t>    histograms;     // Histogram for each chunk: histograms[chunk * g_radixSize + digit]
+
+    StateRanks                  pipelineStateRanks;
+    StateRanks                  resourceHeapRanks;
+    StateRanks                  bufferRanks;
+
+    std::size_t                 numThreads      = 1;
+    std::size_t                 numChunks       = 1;
+    std::unique_ptr<ThreadPool> threadPool;
+
+    void BuildSortKeys();
+    void RadixSort();
+    void GatherSortedPackets();
+    void ForEachChunk(const std::function<void(std::size_t chunk)>& task);
+};
+
+void DrawPacketQueue::Pimpl::BuildSortKeys()
+{
+    const std::size_t n = packets.size();
+    keys[0].resize(n);
+    keys[1].resize(n);
+    indices[0].resize(n);
+    indices[1].resize(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto& packet = packets[i];
+        std::uint64_t key = 0;
+        key = (key << g_keyBitsPipelineState) | pipelineStateRanks.Get(packet.pipelineState, g_keyBitsPipelineState);
+        key = (key << g_keyBitsResourceHeap ) | resourceHeapRanks.Get(packet.resourceHeap, g_keyBitsResourceHeap);
+        key = (key << g_keyBitsDescriptorSet) | std::min<std::uint64_t>(packet.descriptorSet, (1ull << g_keyBitsDescriptorSet) - 1);
+        key = (key << g_keyBitsVertexBuffer ) | bufferRanks.Get(packet.vertexBuffer, g_keyBitsVertexBuffer);
+        key = (key << g_keyBitsIndexBuffer  ) | bufferRanks.Get(packet.indexBuffer, g_keyBitsIndexBuffer);
+        keys[0][i]      = key;
+        indices[0][i]   = static_cast<std::uint32_t>(i);
+    }
+
+    pipelineStateRanks.Clear();
+    resourceHeapRanks.Clear();
+    bufferRanks.Clear();
+}
+
+void DrawPacketQueue::Pimpl::ForEachChunk(const std::function<void(std::size_t chunk)>& task)
+{
+    if (numChunks > 1)
+    {
+        for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+            threadPool->Enqueue(std::bind(task, chunk));
+        threadPool->WaitIdle();
+    }
+    else
+        task(0);
+}
+
+/*
+Stable LSD radix sort of the packet indices by their keys.
+Each pass splits the keys into equally sized chunks: every chunk builds its own histogram,
+then the chunks scatter their keys in parallel into disjoint ranges of the output, which keeps the sort stable.
+Passes in which all keys have the same digit are skipped, which is the common case for the upper bits of each key field.
+*/
+void DrawPacketQueue::Pimpl::RadixSort()
+{
+    const std::size_t n = keys[0].size();
+
+    /* Determine number of chunks and create worker threads on demand */
+    numChunks = std::max(std::size_t(1), std::min(numThreads, n / g_minPacketsPerThread));
+    if (numChunks > 1 && !threadPool)
+        threadPool = MakeUnique<ThreadPool>(numThreads);
+
+    const std::size_t chunkSize = (n + numChunks - 1) / numChunks;
+    histograms.resize(numChunks * g_radixSize);
+
+    std::size_t src = 0;
+    for (std::uint32_t shift = 0; shift < 64; shift += g_radixBits)
+    {
+        /* Build histogram of current digit for each chunk */
+        ForEachChunk(
+            [&](std::size_t chunk)
+            {
+                auto        hist    = &histograms[chunk * g_radixSize];
+                const auto& srcKeys = keys[src];
+                std::fill(hist, hist + g_radixSize, std::size_t(0));
+                for (std::size_t i = chunk * chunkSize, end = std::min(n, i + chunkSize); i < end; ++i)
+                    ++hist[(srcKeys[i] >> shift) & (g_radixSize - 1)];
+            }
+        );
+
+        /* Skip this pass if all keys have the same digit */
+        bool uniformDigit = false;
+        for (std::size_t digit = 0; digit < g_radixSize && !uniformDigit; ++digit)
+        {
+            std::size_t count = 0;
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+                count += histograms[chunk * g_radixSize + digit];
+            uniformDigit = (count == n);
+        }
+        if (uniformDigit)
+            continue;
+
+        /* Convert histograms into output offsets: all chunks for digit 0 first, then all chunks for digit 1 etc. */
+        std::size_t offset = 0;
+        for (std::size_t digit = 0; digit < g_radixSize; ++digit)
+        {
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                auto& entry = histograms[chunk * g_radixSize + digit];
+                const std::size_t count = entry;
+                entry = offset;
+                offset += count;
+            }
+        }
+
+        /* Scatter keys and indices of each chunk */
+        const std::size_t dst = 1 - src;
+        ForEachChunk(
+            [&](std::size_t chunk)
+            {
+                auto        offsets     = &histograms[chunk * g_radixSize];
+                const auto& srcKeys     = keys[src];
+                const auto& srcIndices  = indices[src];
+                auto&       dstKeys     = keys[dst];
+                auto&       dstIndices  = indices[dst];
+                for (std::size_t i = chunk * chunkSize, end = std::min(n, i + chunkSize); i < end; ++i)
+                {
+                    const std::size_t pos = offsets[(srcKeys[i] >> shift) & (g_radixSize - 1)]++;
+                    dstKeys[pos]    = srcKeys[i];
+                    dstIndices[pos] = srcIndices[i];
+                }
+            }
+        );
+        src = dst;
+    }
+
+    /* Sorted indices must always end up in the first buffer */
+    if (src != 0)
+    {
+        keys[0].swap(keys[1]);
+        indices[0].swap(indices[1]);
+    }
+}
+
+/*
+Copies the packets into sorted order with a separate loop, so the random reads do not depend on each other
+and are not interleaved with the virtual calls into the command buffer while encoding.
+*/
+void DrawPacketQueue::Pimpl::GatherSortedPackets()
+{
+    const std::size_t n = packets.size();
+    const std::size_t chunkSize = (n + numChunks - 1) / numChunks;
+    sortedPackets.resize(n);
+
+    ForEachChunk(
+        [&](std::size_t chunk)
+        {
+            for (std::size_t i = chunk * chunkSize, end = std::min(n, i + chunkSize); i < end; ++i)
+                sortedPackets[i] = packets[indices[0][i]];
+        }
+    );
+}
+
+
+/*
+ * DrawPacketQueue class
+ */
+
+DrawPacketQueue::DrawPacketQueue(std::uint32_t numThreads) :
+    pimpl_ { new Pimpl{} }
+{
+    pimpl_->numThreads = (numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency()));
+}
+
+DrawPacketQueue::~DrawPacketQueue()
+{
+    delete pimpl_;
+}
+
+void DrawPacketQueue::Append(const DrawPacket& packet)
+{
+    if (packet.pipelineState == nullptr)
+        throw std::invalid_argument("cannot append draw packet without pipeline state");
+    pimpl_->packets.push_back(packet);
+}
+
+void DrawPacketQueue::Clear()
+{
+    pimpl_->packets.clear();
+}
+
+std::size_t DrawPacketQueue::GetNumPackets() const
+{
+    return pimpl_->packets.size();
+}
+
+// Encodes the draw command of the specified packet
+static void EncodeDrawCommand(CommandBuffer& commandBuffer, const DrawPacket& packet)
+{
+    if (packet.indexBuffer != nullptr)
+    {
+        if (packet.firstInstance != 0)
+            commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset, packet.firstInstance);
+        else if (packet.numInstances != 1)
+            commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset);
+        else
+            commandBuffer.DrawIndexed(packet.numVertices, packet.firstVertex, packet.vertexOffset);
+    }
+    else
+    {
+        if (packet.firstInstance != 0)
+            commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances, packet.firstInstance);
+        else if (packet.numInstances != 1)
+            commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances);
+        else
+            commandBuffer.Draw(packet.numVertices, packet.firstVertex);
+    }
+}
+
+DrawPacketStatistics DrawPacketQueue::Flush(CommandBuffer& commandBuffer, bool sortPackets)
+{
+    DrawPacketStatistics stats;
+
+    const std::size_t numPackets = pimpl_->packets.size();
+    const DrawPacket* packets = pimpl_->packets.data();
+
+    if (sortPackets)
+    {
+        pimpl_->BuildSortKeys();
+        pimpl_->RadixSort();
+        pimpl_->GatherSortedPackets();
+        packets = pimpl_->sortedPackets.data();
+    }
+
+    /*
+    Encode packets and only change states that differ from the currently bound ones.
+    A resource heap only remains bound when the pipeline state changes if the pipeline layout stays the same,
+    because binding a PSO with a different layout invalidates the bound resources on some renderers (e.g. Vulkan and Direct3D 12).
+    */
+    PipelineState*          boundPipelineState  = nullptr;
+    const PipelineLayout*   boundPipelineLayout = nullptr;
+    ResourceHeap*           boundResourceHeap   = nullptr;
+    std::uint32_t           boundDescriptorSet  = 0;
+    Buffer*                 boundVertexBuffer   = nullptr;
+    Buffer*                 boundIndexBuffer    = nullptr;
+
+    for (std::size_t i = 0; i < numPackets; ++i)
+    {
+        const auto& packet = packets[i];
+
+        if (packet.pipelineState != boundPipelineState)
+        {
+            commandBuffer.SetPipelineState(*packet.pipelineState);
+            boundPipelineState = packet.pipelineState;
+            ++stats.numPipelineStateBindings;
+
+            /* Rebind resource heap if the pipeline layout is unknown or has changed */
+            if (packet.pipelineLayout == nullptr || packet.pipelineLayout != boundPipelineLayout)
+                boundResourceHeap = nullptr;
+            boundPipelineLayout = packet.pipelineLayout;
+        }
+
+        if (packet.resourceHeap != nullptr && (packet.resourceHeap != boundResourceHeap || packet.descriptorSet != boundDescriptorSet))
+        {
+            commandBuffer.SetResourceHeap(*packet.resourceHeap, packet.descriptorSet);
+            boundResourceHeap   = packet.resourceHeap;
+            boundDescriptorSet  = packet.descriptorSet;
+            ++stats.numResourceHeapBindings;
+        }
+
+        if (packet.vertexBuffer != nullptr && packet.vertexBuffer != boundVertexBuffer)
+        {
+            commandBuffer.SetVertexBuffer(*packet.vertexBuffer);
+            boundVertexBuffer = packet.vertexBuffer;
+            ++stats.numVertexBufferBindings;
+        }
+
+        if (packet.indexBuffer != nullptr && packet.indexBuffer != boundIndexBuffer)
+        {
+            commandBuffer.SetIndexBuffer(*packet.indexBuffer);
+            boundIndexBuffer = packet.indexBuffer;
+            ++stats.numIndexBufferBindings;
+        }
+
+        EncodeDrawCommand(commandBuffer, packet);
+        ++stats.numDrawCommands;
+    }
+
+    Clear();
+
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
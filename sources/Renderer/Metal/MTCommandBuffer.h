@@ -51,7 +51,7 @@ class MTCommandBuffer final : public CommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -122,6 +122,13 @@ class MTCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
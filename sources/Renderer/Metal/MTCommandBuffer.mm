@@ -103,7 +103,7 @@ void MTCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto& dstBufferMT = LLGL_CAST(MTBuffer&, dstBuffer);
 
@@ -432,6 +432,16 @@ void MTCommandBuffer::SetResourceHeap(
         encoderScheduler_.SetComputeResourceHeap(&resourceHeapMT, firstSet);
 }
 
+void MTCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& /*dynamicOffsets*/)
+{
+    /* Dynamic offsets are not supported by the Metal backend */
+    SetResourceHeap(resourceHeap, firstSet, bindPoint);
+}
+
 void MTCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long /*bindFlags*/, long stageFlags)
 {
     #if 0//TODO: store direct binding in <MTEncoderScheduler>
@@ -100,6 +100,8 @@ class MTRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
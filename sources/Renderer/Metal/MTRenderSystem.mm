@@ -197,6 +197,12 @@ void MTRenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t MTRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resourceHeapMT = LLGL_CAST(MTResourceHeap&, resourceHeap);
+    return resourceHeapMT.WriteResourceViews(firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* MTRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
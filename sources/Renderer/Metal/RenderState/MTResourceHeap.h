@@ -13,6 +13,8 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/Container/ArrayView.h>
 #include <vector>
 #include <functional>
 
@@ -22,9 +24,9 @@ namespace LLGL
 
 
 class MTTexture;
+class MTPipelineLayout;
 class ResourceBindingIterator;
 struct MTResourceBinding;
-struct ResourceHeapDescriptor;
 struct TextureViewDescriptor;
 
 /*
@@ -49,11 +51,22 @@ class MTResourceHeap final : public ResourceHeap
         bool HasGraphicsResources() const;
         bool HasComputeResources() const;
 
+        /*
+        Replaces the specified resource views and returns the number of written descriptors.
+        Since this heap only emulates a descriptor set, the internal buffer is rebuilt from the updated list of resource views.
+        */
+        std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
     private:
 
         using MTResourceBindingIter = std::vector<MTResourceBinding>::const_iterator;
         using BuildSegmentFunc = std::function<void(MTResourceBindingIter begin, NSUInteger count)>;
 
+        // Builds the internal buffer and texture views from the stored list of resource views.
+        void BuildResourceViewHeap();
+
+        void ReleaseTextureViews();
+
         void BuildBufferSegments(ResourceBindingIterator& resourceIterator, long stage, std::uint8_t& numSegments);
         void BuildTextureSegments(ResourceBindingIterator& resourceIterator, long stage, std::uint8_t& numSegments);
         void BuildSamplerSegments(ResourceBindingIterator& resourceIterator, long stage, std::uint8_t& numSegments);
@@ -101,6 +114,9 @@ class MTResourceHeap final : public ResourceHeap
 
     private:
 
+        const MTPipelineLayout*             pipelineLayout_     = nullptr;
+        std::vector<ResourceViewDescriptor> resourceViews_;
+
         BufferSegmentation          segmentation_;
 
         std::size_t                 stride_             = 0;    // Buffer stride (in bytes) per descriptor set
@@ -15,7 +15,7 @@
 #include "../../CheckedCast.h"
 #include "../../ResourceBindingIterator.h"
 #include "../../../Core/Helper.h"
-#include <LLGL/ResourceHeapFlags.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -75,67 +75,29 @@ struct MTResourceBinding
  * MTResourceHeap class
  */
 
-MTResourceHeap::MTResourceHeap(const ResourceHeapDescriptor& desc)
+MTResourceHeap::MTResourceHeap(const ResourceHeapDescriptor& desc) :
+    resourceViews_ { desc.resourceViews }
 {
     /* Get pipeline layout object */
-    auto pipelineLayoutMT = LLGL_CAST(MTPipelineLayout*, desc.pipelineLayout);
-    if (!pipelineLayoutMT)
+    pipelineLayout_ = LLGL_CAST(MTPipelineLayout*, desc.pipelineLayout);
+    if (!pipelineLayout_)
         throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
 
     /* Validate binding descriptors */
-    const auto& bindings            = pipelineLayoutMT->GetBindings();
-    const auto  numBindings         = bindings.size();
-    const auto  numResourceViews    = desc.resourceViews.size();
+    const auto numBindings = pipelineLayout_->GetBindings().size();
 
     if (numBindings == 0)
         throw std::invalid_argument("cannot create resource heap without bindings in pipeline layout");
-    if (numResourceViews % numBindings != 0)
+    if (resourceViews_.size() % numBindings != 0)
         throw std::invalid_argument("failed to create resource heap because due to mismatch between number of resources and bindings");
 
-    /* Build buffer segments */
-    static const long vertexStages = (StageFlags::VertexStage | StageFlags::TessEvaluationStage);
-    static const long fragmentStages = (StageFlags::FragmentStage);
-    static const long kernelStages = (StageFlags::ComputeStage | StageFlags::TessControlStage);
-
-    for (std::size_t i = 0; i < numResourceViews; i += numBindings)
-    {
-        ResourceBindingIterator resourceIterator { desc.resourceViews, bindings, i };
-        InitMemory(segmentation_);
-
-        /* Build vertex resource segments */
-        BuildBufferSegments(resourceIterator, vertexStages, segmentation_.numVertexBufferSegments);
-        BuildTextureSegments(resourceIterator, vertexStages, segmentation_.numVertexTextureSegments);
-        BuildSamplerSegments(resourceIterator, vertexStages, segmentation_.numVertexSamplerSegments);
-
-        /* Build fragment resource segments */
-        BuildBufferSegments(resourceIterator, fragmentStages, segmentation_.numFragmentBufferSegments);
-        BuildTextureSegments(resourceIterator, fragmentStages, segmentation_.numFragmentTextureSegments);
-        BuildSamplerSegments(resourceIterator, fragmentStages, segmentation_.numFragmentSamplerSegments);
-
-        /* Build kernel resource segments (and store buffer offset to kernel segments) */
-        if (i == 0)
-        {
-            if (buffer_.size() > UINT16_MAX)
-                throw std::out_of_range("internal buffer for resource heap exceeded limit of 2^16 (65536) bytes");
-            bufferOffsetKernel_ = static_cast<std::uint16_t>(buffer_.size());
-        }
-
-        BuildBufferSegments(resourceIterator, kernelStages, segmentation_.numKernelBufferSegments);
-        BuildTextureSegments(resourceIterator, kernelStages, segmentation_.numKernelTextureSegments);
-        BuildSamplerSegments(resourceIterator, kernelStages, segmentation_.numKernelSamplerSegments);
-    }
-
-    /* Store buffer stride */
-    stride_ = buffer_.size() / (numResourceViews / numBindings);
-
-    /* Store resource usage bits in segmentation header */
-    StoreResourceUsage();
+    /* Build internal buffer and texture views */
+    BuildResourceViewHeap();
 }
 
 MTResourceHeap::~MTResourceHeap()
 {
-    for (auto& tex : textureViews_)
-        [tex release];
+    ReleaseTextureViews();
 }
 
 std::uint32_t MTResourceHeap::GetNumDescriptorSets() const
@@ -171,11 +133,98 @@ bool MTResourceHeap::HasComputeResources() const
     return (segmentation_.hasKernelResources != 0);
 }
 
+std::uint32_t MTResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    if (firstDescriptor >= resourceViews_.size())
+        return 0;
+
+    /* Replace resource views within the range of this heap; null resources keep their previous descriptor */
+    const auto numResourceViews = std::min(resourceViews.size(), resourceViews_.size() - firstDescriptor);
+
+    std::uint32_t numWritten = 0;
+
+    for (std::size_t i = 0; i < numResourceViews; ++i)
+    {
+        const auto& rvDesc = resourceViews[i];
+        if (auto resource = rvDesc.resource)
+        {
+            auto& prevRVDesc = resourceViews_[firstDescriptor + i];
+            if (prevRVDesc.resource != nullptr && resource->GetResourceType() != prevRVDesc.resource->GetResourceType())
+                throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
+            prevRVDesc = rvDesc;
+            ++numWritten;
+        }
+    }
+
+    if (numWritten > 0)
+        BuildResourceViewHeap();
+
+    return numWritten;
+}
+
 
 /*
  * ======= Private: =======
  */
 
+void MTResourceHeap::BuildResourceViewHeap()
+{
+    const auto& bindings            = pipelineLayout_->GetBindings();
+    const auto& bindingBuckets      = pipelineLayout_->GetBindingBuckets();
+    const auto  numBindings         = bindings.size();
+    const auto  numResourceViews    = resourceViews_.size();
+
+    /* Release previous buffer and texture views */
+    buffer_.clear();
+    ReleaseTextureViews();
+
+    /* Build buffer segments */
+    static const long vertexStages = (StageFlags::VertexStage | StageFlags::TessEvaluationStage);
+    static const long fragmentStages = (StageFlags::FragmentStage);
+    static const long kernelStages = (StageFlags::ComputeStage | StageFlags::TessControlStage);
+
+    for (std::size_t i = 0; i < numResourceViews; i += numBindings)
+    {
+        ResourceBindingIterator resourceIterator { resourceViews_, bindings, bindingBuckets, i };
+        InitMemory(segmentation_);
+
+        /* Build vertex resource segments */
+        BuildBufferSegments(resourceIterator, vertexStages, segmentation_.numVertexBufferSegments);
+        BuildTextureSegments(resourceIterator, vertexStages, segmentation_.numVertexTextureSegments);
+        BuildSamplerSegments(resourceIterator, vertexStages, segmentation_.numVertexSamplerSegments);
+
+        /* Build fragment resource segments */
+        BuildBufferSegments(resourceIterator, fragmentStages, segmentation_.numFragmentBufferSegments);
+        BuildTextureSegments(resourceIterator, fragmentStages, segmentation_.numFragmentTextureSegments);
+        BuildSamplerSegments(resourceIterator, fragmentStages, segmentation_.numFragmentSamplerSegments);
+
+        /* Build kernel resource segments (and store buffer offset to kernel segments) */
+        if (i == 0)
+        {
+            if (buffer_.size() > UINT16_MAX)
+                throw std::out_of_range("internal buffer for resource heap exceeded limit of 2^16 (65536) bytes");
+            bufferOffsetKernel_ = static_cast<std::uint16_t>(buffer_.size());
+        }
+
+        BuildBufferSegments(resourceIterator, kernelStages, segmentation_.numKernelBufferSegments);
+        BuildTextureSegments(resourceIterator, kernelStages, segmentation_.numKernelTextureSegments);
+        BuildSamplerSegments(resourceIterator, kernelStages, segmentation_.numKernelSamplerSegments);
+    }
+
+    /* Store buffer stride */
+    stride_ = buffer_.size() / (numResourceViews / numBindings);
+
+    /* Store resource usage bits in segmentation header */
+    StoreResourceUsage();
+}
+
+void MTResourceHeap::ReleaseTextureViews()
+{
+    for (auto& tex : textureViews_)
+        [tex release];
+    textureViews_.clear();
+}
+
 using MTResourceBindingFunc = std::function<
     void(
         MTResourceBinding&              binding,
@@ -8,31 +8,125 @@
 #include "NullBuffer.h"
 #include "../../ResourceUtils.h"
 #include "../../../Core/Helper.h"
-#include <algorithm>
+#include <LLGL/Platform/Platform.h>
+#include <new>
 #include <string.h>
 
+#ifdef LLGL_OS_WIN32
+#   include <Windows.h>
+#else
+#   include <unistd.h> // sysconf
+#   include <sys/mman.h> // mmap
+#endif
+
 
 namespace LLGL
 {
 
 
-constexpr NullBuffer::WordType g_uninitializedBufferWord = 0xDEADBEEF;
+/*
+Buffers of at least this size are allocated with virtual memory, whose pages are only committed when they are touched first.
+Smaller buffers are allocated on the heap to avoid wasting a whole page each.
+*/
+static const std::size_t g_minVirtualAllocSize = 0x10000;
+
+#ifdef LLGL_OS_WIN32
+
+static std::size_t GetVirtualPageSize()
+{
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return static_cast<std::size_t>(systemInfo.dwAllocationGranularity);
+}
+
+static char* AllocVirtualMemory(std::size_t size)
+{
+    /* Committed pages are zero-initialized and only backed by physical memory once they are accessed */
+    return reinterpret_cast<char*>(VirtualAlloc(nullptr, size, (MEM_RESERVE | MEM_COMMIT), PAGE_READWRITE));
+}
+
+static void FreeVirtualMemory(char* addr, std::size_t /*size*/)
+{
+    VirtualFree(addr, 0, MEM_RELEASE);
+}
+
+static void DiscardVirtualMemory(char* addr, std::size_t size)
+{
+    VirtualAlloc(addr, size, MEM_RESET, PAGE_READWRITE);
+}
+
+#else
+
+static std::size_t GetVirtualPageSize()
+{
+    return static_cast<std::size_t>(sysconf(_SC_PAGE_SIZE));
+}
+
+static char* AllocVirtualMemory(std::size_t size)
+{
+    /* Anonymous mappings are zero-initialized and only backed by physical memory once they are accessed */
+    void* addr = ::mmap(
+        nullptr,
+        size,
+        (PROT_READ | PROT_WRITE),
+        (MAP_PRIVATE | MAP_ANONYMOUS),
+        -1, // must be -1 if MAP_ANONYMOUS is used
+        0
+    );
+    return (addr != MAP_FAILED ? reinterpret_cast<char*>(addr) : nullptr);
+}
+
+static void FreeVirtualMemory(char* addr, std::size_t size)
+{
+    ::munmap(addr, size);
+}
+
+static void DiscardVirtualMemory(char* addr, std::size_t size)
+{
+    ::madvise(addr, size, MADV_DONTNEED);
+}
+
+#endif
+
+static BufferDescriptor CopyBufferDescWithNewVertexAttribs(const BufferDescriptor& inDesc, const ArrayView<VertexAttribute>& inVertexAttribs)
+{
+    auto outDesc = inDesc;
+    outDesc.vertexAttribs = inVertexAttribs;
+    return outDesc;
+}
 
 NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData) :
-    Buffer { desc.bindFlags },
-    desc   { desc           }
+    Buffer         { desc.bindFlags                                           },
+    vertexAttribs_ { desc.vertexAttribs.begin(), desc.vertexAttribs.end()     },
+    desc           { CopyBufferDescWithNewVertexAttribs(desc, vertexAttribs_) }
 {
-    /* Allocate word-aligned buffer and initialize with hex code as debug information */
-    const std::size_t wordAlignedSize = GetAlignedSize(static_cast<std::size_t>(desc.size), sizeof(WordType));
-    data_.resize(wordAlignedSize, g_uninitializedBufferWord);
+    const std::size_t size = static_cast<std::size_t>(desc.size);
 
-    /* Allocate mapped buffer if CPU access flags are specified */
-    if (desc.cpuAccessFlags != 0)
-        mappedData_.resize(wordAlignedSize, g_uninitializedBufferWord);
+    if (size >= g_minVirtualAllocSize)
+    {
+        /* Reserve virtual memory for large buffers, so only touched pages cost physical memory */
+        dataSize_   = GetAlignedSize(size, GetVirtualPageSize());
+        data_       = AllocVirtualMemory(dataSize_);
+        if (data_ == nullptr)
+            throw std::bad_alloc();
+    }
+    else
+    {
+        /* Allocate small buffers on the heap */
+        smallData_.resize(size, 0);
+        data_       = smallData_.data();
+        dataSize_   = size;
+    }
 
     /* Initialize buffer with initial data */
     if (initialData != nullptr)
-        Write(0, initialData, static_cast<std::size_t>(desc.size));
+        Write(0, initialData, desc.size);
+}
+
+NullBuffer::~NullBuffer()
+{
+    if (dataSize_ >= g_minVirtualAllocSize)
+        FreeVirtualMemory(data_, dataSize_);
 }
 
 void NullBuffer::SetName(const char* name)
@@ -70,6 +164,23 @@ bool NullBuffer::Write(std::uint64_t offset, const void* data, std::uint64_t siz
     return false;
 }
 
+bool NullBuffer::Fill(std::uint64_t offset, std::uint32_t value, std::uint64_t size)
+{
+    /* Check for out-of-bounds and ensure there's no integer overflow with offset+size */
+    if (offset < desc.size && offset + size <= desc.size && offset + size > offset)
+    {
+        auto dst = GetBytesAt(offset);
+        std::uint64_t i = 0;
+        for (; i + sizeof(value) <= size; i += sizeof(value))
+            ::memcpy(dst + i, &value, sizeof(value));
+
+        /* Fill remaining bytes with the leading bytes of the value */
+        ::memcpy(dst + i, &value, static_cast<std::size_t>(size - i));
+        return true;
+    }
+    return false;
+}
+
 bool NullBuffer::CpuAccessRead(std::uint64_t offset, void* data, std::uint64_t size)
 {
     if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0)
@@ -89,54 +200,45 @@ bool NullBuffer::CpuAccessWrite(std::uint64_t offset, const void* data, std::uin
 void* NullBuffer::Map(const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
     /* Cannot map while data is already mapped */
-    if (mapLength_ > 0)
+    if (mapped_)
         return nullptr;
 
     /* Check for out-of-bounds and ensure there's no integer overflow with offset+length */
-    if (offset < desc.size && offset + length <= desc.size && offset + length > offset)
+    if (!(offset < desc.size && offset + length <= desc.size && offset + length > offset))
         return nullptr;
 
     const bool isWriteAccess = HasWriteAccess(access);
     const bool isReadAccess = HasReadAccess(access);
 
     if ((isWriteAccess && (desc.cpuAccessFlags & CPUAccessFlags::Write) == 0) ||
-        (isReadAccess  && (desc.cpuAccessFlags & CPUAccessFlags::Read )) == 0)
+        (isReadAccess  && (desc.cpuAccessFlags & CPUAccessFlags::Read ) == 0))
     {
         /* Wrong CPU access for this buffer */
         return nullptr;
     }
 
-    if (access == CPUAccess::WriteDiscard)
+    if (access == CPUAccess::WriteDiscard && dataSize_ >= g_minVirtualAllocSize)
     {
-        /* Discard all buffer content by filling buffer with uninitialized word */
-        std::fill(data_.begin(), data_.end(), g_uninitializedBufferWord);
+        /*
+        Discard the content of the mapped range by releasing the physical pages that lie entirely inside of it.
+        Pages that are only partially covered keep their content, so the bytes outside the range are preserved.
+        */
+        const std::size_t pageSize  = GetVirtualPageSize();
+        const std::size_t pageBegin = GetAlignedSize(static_cast<std::size_t>(offset), pageSize);
+        const std::size_t pageEnd   = static_cast<std::size_t>(offset + length) / pageSize * pageSize;
+        if (pageBegin < pageEnd)
+            DiscardVirtualMemory(data_ + pageBegin, pageEnd - pageBegin);
     }
 
-    /* Map internal buffer to output data */
-    mapAccess_ = access;
-    mapOffset_ = static_cast<std::size_t>(offset);
-    mapLength_ = static_cast<std::size_t>(length);
-
-    if (isReadAccess)
-    {
-        /* Map buffer for reading */
-        ::memcpy(GetMappedBytes(), GetBytesAt(mapOffset_), mapLength_);
-    }
+    /* Return pointer directly into the buffer storage; no copy is required for reading or writing */
+    mapped_ = true;
 
-    return GetMappedBytes();
+    return GetBytesAt(offset);
 }
 
 void NullBuffer::Unmap()
 {
-    if (mapLength_ > 0)
-    {
-        if (HasWriteAccess(mapAccess_))
-        {
-            /* Map buffer for writing */
-            ::memcpy(GetBytesAt(mapOffset_), GetMappedBytes(), mapLength_);
-        }
-        mapLength_ = 0;
-    }
+    mapped_ = false;
 }
 
 
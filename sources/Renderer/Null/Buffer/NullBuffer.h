@@ -10,6 +10,8 @@
 
 
 #include <LLGL/Buffer.h>
+#include <LLGL/VertexAttribute.h>
+#include <LLGL/Container/SmallVector.h>
 #include <vector>
 #include <string>
 
@@ -21,6 +23,8 @@ namespace LLGL
 class NullBuffer final : public Buffer
 {
 
+        const SmallVector<VertexAttribute> vertexAttribs_;
+
     public:
 
         void SetName(const char* name) override;
@@ -30,48 +34,44 @@ class NullBuffer final : public Buffer
     public:
 
         NullBuffer(const BufferDescriptor& desc, const void* initialData);
+        ~NullBuffer();
 
         bool Read(std::uint64_t offset, void* data, std::uint64_t size);
         bool Write(std::uint64_t offset, const void* data, std::uint64_t size);
 
+        // Fills the specified range with a 32-bit value. If the size is not a multiple of 4, the trailing bytes are filled with the leading bytes of the value.
+        bool Fill(std::uint64_t offset, std::uint32_t value, std::uint64_t size);
+
         bool CpuAccessRead(std::uint64_t offset, void* data, std::uint64_t size);
         bool CpuAccessWrite(std::uint64_t offset, const void* data, std::uint64_t size);
 
+        // Returns a pointer directly into the buffer storage. Mapped memory is coherent with all commands that access this buffer.
         void* Map(const CPUAccess access, std::uint64_t offset, std::uint64_t length);
         void Unmap();
 
-    public:
-
-        // Data type for the internal buffer data.
-        using WordType = std::uint32_t;
-
-        const BufferDescriptor desc;
-
-    private:
-
-        inline char* GetBytes()
-        {
-            return reinterpret_cast<char*>(data_.data());
-        }
-
+        // Returns a pointer to the buffer storage at the specified byte offset. The offset is not checked for out-of-bounds.
         inline char* GetBytesAt(std::uint64_t offset)
         {
-            return (reinterpret_cast<char*>(data_.data()) + static_cast<std::size_t>(offset));
+            return (data_ + static_cast<std::size_t>(offset));
         }
 
-        inline char* GetMappedBytes()
+        // Returns a constant pointer to the buffer storage at the specified byte offset. The offset is not checked for out-of-bounds.
+        inline const char* GetBytesAt(std::uint64_t offset) const
         {
-            return (reinterpret_cast<char*>(mappedData_.data()) + mapOffset_);
+            return (data_ + static_cast<std::size_t>(offset));
         }
 
+    public:
+
+        const BufferDescriptor desc;
+
     private:
 
-        std::string             label_;
-        std::vector<WordType>   data_;
-        std::vector<WordType>   mappedData_;
-        std::size_t             mapOffset_  = 0;
-        std::size_t             mapLength_  = 0;
-        CPUAccess               mapAccess_  = CPUAccess::ReadOnly;
+        std::string         label_;
+        char*               data_       = nullptr;  // Points either into 'smallData_' or into lazily committed virtual memory.
+        std::size_t         dataSize_   = 0;
+        std::vector<char>   smallData_;
+        bool                mapped_     = false;
 
 };
 
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/PipelineStateFlags.h>
 #include <cstddef>
 #include <cstdint>
 
@@ -20,6 +22,11 @@ namespace LLGL
 
 class NullBuffer;
 class NullTexture;
+class NullPipelineState;
+class NullQueryHeap;
+class NullResourceHeap;
+class NullRenderTarget;
+class NullRenderPass;
 
 
 struct NullCmdBufferWrite
@@ -30,6 +37,14 @@ struct NullCmdBufferWrite
 //  std::int8_t data[dataSize];
 };
 
+struct NullCmdBufferFill
+{
+    NullBuffer*     buffer;
+    std::size_t     offset;
+    std::size_t     size;
+    std::uint32_t   value;
+};
+
 struct NullCmdCopySubresource
 {
     Resource*       srcResource;
@@ -58,18 +73,75 @@ struct NullCmdGenerateMips
     std::uint32_t   numMipLevels;
 };
 
+struct NullCmdSetViewport
+{
+    Viewport viewport;
+};
+
+struct NullCmdSetScissor
+{
+    Scissor scissor;
+};
+
 //TODO...
 
+struct NullCmdBeginRenderPass
+{
+    NullRenderTarget*       renderTarget;
+    const NullRenderPass*   renderPass;
+    std::uint32_t           numClearValues;
+//  ClearValue              clearValues[numClearValues];
+};
+
+//struct NullCmdEndRenderPass {};
+
+struct NullCmdClear
+{
+    long        flags;
+    ClearValue  clearValue;
+};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t   numAttachments;
+//  AttachmentClear attachments[numAttachments];
+};
+
+struct NullCmdSetResourceHeap
+{
+    const NullResourceHeap* resourceHeap;
+    std::uint32_t           descriptorSet;
+    std::uint32_t           numDynamicOffsets;
+//  std::uint32_t           dynamicOffsets[numDynamicOffsets];
+};
+
+struct NullCmdSetUniforms
+{
+    std::uint32_t       offset;
+    std::uint32_t       size;
+//  std::int8_t         data[size];
+};
+
+struct NullCmdBeginStreamOutput
+{
+    std::uint32_t   numBuffers;
+//  NullBuffer*     buffers[numBuffers];
+};
+
+//struct NullCmdEndStreamOutput {};
+
 struct NullCmdDraw
 {
-    DrawIndirectArguments   args;
-    std::size_t             numVertexBuffers;
-//  const NullBuffer*       vertexBuffers[numVertexBuffers];
+    DrawIndirectArguments       args;
+    const NullPipelineState*    pipelineState;
+    std::size_t                 numVertexBuffers;
+//  const NullBuffer*           vertexBuffers[numVertexBuffers];
 };
 
 struct NullCmdDrawIndexed
 {
     DrawIndexedIndirectArguments    args;
+    const NullPipelineState*        pipelineState;
     const NullBuffer*               indexBuffer;
     Format                          indexBufferFormat;
     std::uint64_t                   indexBufferOffset;
@@ -85,6 +157,12 @@ struct NullCmdPushDebugGroup
 
 //struct NullCmdPopDebugGroup {};
 
+struct NullCmdQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
 
 } // /namespace LLGL
 
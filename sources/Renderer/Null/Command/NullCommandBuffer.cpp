@@ -6,7 +6,10 @@
  */
 
 #include "NullCommandBuffer.h"
+#include "NullCommandQueue.h"
 #include "NullCommandExecutor.h"
+#include "NullCommandOptimizer.h"
+#include "NullVertexProcessor.h"
 #include "NullCommand.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
@@ -18,33 +21,58 @@
 #include "../RenderState/NullQueryHeap.h"
 #include "../RenderState/NullPipelineState.h"
 #include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullRenderPass.h"
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullRenderTarget.h"
 
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
+#include <thread>
 
 
 namespace LLGL
 {
 
 
-NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
-    desc { desc }
+NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandQueue& commandQueue, const NullRasterizerContext* rasterizerContext) :
+    desc               { desc              },
+    commandQueue_      { commandQueue      },
+    rasterizerContext_ { rasterizerContext }
 {
 }
 
+NullCommandBuffer::~NullCommandBuffer()
+{
+    WaitPendingSubmits();
+}
+
 /* ----- Encoding ----- */
 
 void NullCommandBuffer::Begin()
 {
+    /* Multi-submit commands are executed by reference, so they must not be modified while the command queue still executes them */
+    WaitPendingSubmits();
     buffer_.Clear();
+    recordedQueries_.clear();
+    numRemovedCommands_ = 0;
 }
 
 void NullCommandBuffer::End()
 {
     if ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
-        ExecuteVirtualCommands();
+        commandQueue_.SubmitCommandBuffer(*this);
+    else if ((desc.flags & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        /* Remove redundant commands if command buffer will be submitted multiple times */
+        numRemovedCommands_ = static_cast<std::uint32_t>(OptimizeNullVirtualCommandBuffer(buffer_));
+    }
+}
+
+std::uint32_t NullCommandBuffer::GetNumRemovedCommands() const
+{
+    return numRemovedCommands_;
 }
 
 void NullCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
@@ -60,15 +88,15 @@ void NullCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto dstBufferNull = LLGL_CAST(NullBuffer*, &dstBuffer);
-    auto cmd = AllocCommand<NullCmdBufferWrite>(NullOpcodeBufferWrite, dataSize);
+    auto cmd = AllocCommand<NullCmdBufferWrite>(NullOpcodeBufferWrite, static_cast<std::size_t>(dataSize));
     {
         cmd->buffer = dstBufferNull;
         cmd->offset = static_cast<std::size_t>(dstOffset);
-        cmd->size   = dataSize;
-        ::memcpy(cmd + 1, data, dataSize);
+        cmd->size   = static_cast<std::size_t>(dataSize);
+        ::memcpy(cmd + 1, data, cmd->size);
     }
 }
 
@@ -150,8 +178,20 @@ void NullCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
-    //auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
-    //todo
+    auto dstBufferNull = LLGL_CAST(NullBuffer*, &dstBuffer);
+    if (fillSize == Constants::wholeSize)
+    {
+        /* Fill entire buffer with 32-bit value */
+        dstOffset   = 0;
+        fillSize    = dstBufferNull->desc.size;
+    }
+    auto cmd = AllocCommand<NullCmdBufferFill>(NullOpcodeBufferFill);
+    {
+        cmd->buffer = dstBufferNull;
+        cmd->offset = static_cast<std::size_t>(dstOffset);
+        cmd->size   = static_cast<std::size_t>(fillSize);
+        cmd->value  = value;
+    }
 }
 
 void NullCommandBuffer::CopyTexture(
@@ -244,21 +284,25 @@ void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
 void NullCommandBuffer::SetViewport(const Viewport& viewport)
 {
     renderState_.viewports = { viewport };
+    AllocViewportCommand(1, &viewport);
 }
 
 void NullCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
     renderState_.viewports = SmallVector<Viewport>(viewports, viewports + numViewports);
+    AllocViewportCommand(numViewports, viewports);
 }
 
 void NullCommandBuffer::SetScissor(const Scissor& scissor)
 {
     renderState_.scissors = { scissor };
+    AllocScissorCommand(1, &scissor);
 }
 
 void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
     renderState_.scissors = SmallVector<Scissor>(scissors, scissors + numScissors);
+    AllocScissorCommand(numScissors, scissors);
 }
 
 /* ----- Buffers ------ */
@@ -298,8 +342,28 @@ void NullCommandBuffer::SetResourceHeap(
     std::uint32_t           firstSet,
     const PipelineBindPoint bindPoint)
 {
-    //auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
-    //todo
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap       = LLGL_CAST(const NullResourceHeap*, &resourceHeap);
+        cmd->descriptorSet      = firstSet;
+        cmd->numDynamicOffsets  = 0;
+    }
+}
+
+void NullCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    const auto numDynamicOffsets = static_cast<std::uint32_t>(dynamicOffsets.size());
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap, numDynamicOffsets * sizeof(std::uint32_t));
+    {
+        cmd->resourceHeap       = LLGL_CAST(const NullResourceHeap*, &resourceHeap);
+        cmd->descriptorSet      = firstSet;
+        cmd->numDynamicOffsets  = numDynamicOffsets;
+        ::memcpy(cmd + 1, dynamicOffsets.data(), numDynamicOffsets * sizeof(std::uint32_t));
+    }
 }
 
 void NullCommandBuffer::SetResource(
@@ -336,32 +400,57 @@ void NullCommandBuffer::BeginRenderPass(
     }
     else
     {
-        //auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
-        //todo
+        /* Only render targets of the software rasterizer have any content to render into */
+        auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
+        if (renderTargetNull.GetRasterizerContext() != nullptr)
+        {
+            auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass, sizeof(ClearValue) * numClearValues);
+            {
+                cmd->renderTarget   = &renderTargetNull;
+                cmd->renderPass     = LLGL_CAST(const NullRenderPass*, renderPass);
+                cmd->numClearValues = numClearValues;
+                std::copy(clearValues, clearValues + numClearValues, reinterpret_cast<ClearValue*>(cmd + 1));
+            }
+        }
     }
 }
 
 void NullCommandBuffer::EndRenderPass()
 {
-    //todo
+    if (rasterizerContext_ != nullptr)
+        AllocOpcode(NullOpcodeEndRenderPass);
 }
 
 void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
-    //todo
+    if (rasterizerContext_ != nullptr)
+    {
+        auto cmd = AllocCommand<NullCmdClear>(NullOpcodeClear);
+        {
+            cmd->flags      = flags;
+            cmd->clearValue = clearValue;
+        }
+    }
 }
 
 void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
-    //todo
+    if (rasterizerContext_ != nullptr)
+    {
+        auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments, sizeof(AttachmentClear) * numAttachments);
+        {
+            cmd->numAttachments = numAttachments;
+            std::copy(attachments, attachments + numAttachments, reinterpret_cast<AttachmentClear*>(cmd + 1));
+        }
+    }
 }
 
 /* ----- Pipeline States ----- */
 
 void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    //auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
-    //todo
+    auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
+    renderState_.pipelineState = &pipelineStateNull;
 }
 
 void NullCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
@@ -379,30 +468,54 @@ void NullCommandBuffer::SetUniform(
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //todo
+    NullCommandBuffer::SetUniforms(location, 1, data, dataSize);
 }
 
 void NullCommandBuffer::SetUniforms(
     UniformLocation location,
-    std::uint32_t   count,
+    std::uint32_t   /*count*/,
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //todo
+    /* Data size must be a multiple of 4 bytes and the range must fit into the uniform storage */
+    if (location < 0 || dataSize == 0 || dataSize % 4 != 0)
+        return;
+    if (static_cast<std::uint32_t>(location) > NullVertexProcessor::maxUniformSize ||
+        dataSize > NullVertexProcessor::maxUniformSize - static_cast<std::uint32_t>(location))
+    {
+        return;
+    }
+
+    /* Copy uniform data into command; the location is the byte offset within the uniform storage of the command buffer */
+    auto cmd = AllocCommand<NullCmdSetUniforms>(NullOpcodeSetUniforms, dataSize);
+    {
+        cmd->offset         = static_cast<std::uint32_t>(location);
+        cmd->size           = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
 }
 
 /* ----- Queries ----- */
 
 void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    recordedQueries_.push_back(RecordedQuery{ &queryHeapNull, query });
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = &queryHeapNull;
+        cmd->query      = query;
+    }
 }
 
 void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeEndQuery);
+    {
+        cmd->queryHeap  = &queryHeapNull;
+        cmd->query      = query;
+    }
 }
 
 void NullCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
@@ -420,12 +533,19 @@ void NullCommandBuffer::EndRenderCondition()
 
 void NullCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
 {
-    // dummy
+    numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+    auto cmd = AllocCommand<NullCmdBeginStreamOutput>(NullOpcodeBeginStreamOutput, sizeof(NullBuffer*) * numBuffers);
+    {
+        cmd->numBuffers = numBuffers;
+        auto bufferPtrs = reinterpret_cast<NullBuffer**>(cmd + 1);
+        for_range(i, numBuffers)
+            bufferPtrs[i] = LLGL_CAST(NullBuffer*, buffers[i]);
+    }
 }
 
 void NullCommandBuffer::EndStreamOutput()
 {
-    // dummy
+    AllocOpcode(NullOpcodeEndStreamOutput);
 }
 
 /* ----- Drawing ----- */
@@ -618,6 +738,27 @@ void NullCommandBuffer::ExecuteVirtualCommands()
         buffer_.Clear();
 }
 
+void NullCommandBuffer::SwapVirtualCommands(NullVirtualCommandBuffer& virtualCmdBuffer)
+{
+    buffer_.Swap(virtualCmdBuffer);
+}
+
+void NullCommandBuffer::BeginPendingSubmit()
+{
+    numPendingSubmits_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NullCommandBuffer::EndPendingSubmit()
+{
+    numPendingSubmits_.fetch_sub(1, std::memory_order_release);
+}
+
+void NullCommandBuffer::ResetQueries()
+{
+    for (const auto& recordedQuery : recordedQueries_)
+        recordedQuery.queryHeap->ResetQuery(recordedQuery.query);
+}
+
 
 /*
  * ======= Private: =======
@@ -634,11 +775,36 @@ TCommand* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t p
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
 
+void NullCommandBuffer::AllocViewportCommand(std::uint32_t numViewports, const Viewport* viewports)
+{
+    if (rasterizerContext_ != nullptr && numViewports > 0)
+    {
+        auto cmd = AllocCommand<NullCmdSetViewport>(NullOpcodeSetViewport);
+        cmd->viewport = viewports[0];
+    }
+}
+
+void NullCommandBuffer::AllocScissorCommand(std::uint32_t numScissors, const Scissor* scissors)
+{
+    if (rasterizerContext_ != nullptr && numScissors > 0)
+    {
+        auto cmd = AllocCommand<NullCmdSetScissor>(NullOpcodeSetScissor);
+        cmd->scissor = scissors[0];
+    }
+}
+
+void NullCommandBuffer::WaitPendingSubmits()
+{
+    while (numPendingSubmits_.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+}
+
 void NullCommandBuffer::AllocDrawCommand(const DrawIndirectArguments& args)
 {
     auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
     {
         cmd->args               = args;
+        cmd->pipelineState      = renderState_.pipelineState;
         cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
         ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
     }
@@ -649,6 +815,7 @@ void NullCommandBuffer::AllocDrawIndexedCommand(const DrawIndexedIndirectArgumen
     auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
     {
         cmd->args               = args;
+        cmd->pipelineState      = renderState_.pipelineState;
         cmd->indexBuffer        = renderState_.indexBuffer;
         cmd->indexBufferFormat  = renderState_.indexBufferFormat;
         cmd->indexBufferOffset  = renderState_.indexBufferOffset;
@@ -13,6 +13,8 @@
 #include <LLGL/Container/SmallVector.h>
 #include "NullCommandOpcode.h"
 #include "../../VirtualCommandBuffer.h"
+#include <atomic>
+#include <vector>
 
 
 namespace LLGL
@@ -20,6 +22,11 @@ namespace LLGL
 
 
 class NullBuffer;
+class NullPipelineState;
+class NullResourceHeap;
+class NullQueryHeap;
+class NullCommandQueue;
+struct NullRasterizerContext;
 
 using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode>;
 
@@ -30,13 +37,16 @@ class NullCommandBuffer final : public CommandBuffer
 
         /* ----- Common ----- */
 
-        NullCommandBuffer(const CommandBufferDescriptor& desc);
+        NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandQueue& commandQueue, const NullRasterizerContext* rasterizerContext = nullptr);
+        ~NullCommandBuffer();
 
         /* ----- Encoding ----- */
 
         void Begin() override;
         void End() override;
 
+        std::uint32_t GetNumRemovedCommands() const override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -45,7 +55,7 @@ class NullCommandBuffer final : public CommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -116,6 +126,13 @@ class NullCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -216,6 +233,18 @@ class NullCommandBuffer final : public CommandBuffer
         // Executes the internal virtual command buffer.
         void ExecuteVirtualCommands();
 
+        // Swaps the internal virtual command buffer with the specified one. This is used to hand over one-time submit commands to the command queue.
+        void SwapVirtualCommands(NullVirtualCommandBuffer& virtualCmdBuffer);
+
+        // Increments the number of pending submissions. Begin() waits until all pending submissions have been executed.
+        void BeginPendingSubmit();
+
+        // Decrements the number of pending submissions. This is called by the executor thread of the command queue.
+        void EndPendingSubmit();
+
+        // Invalidates the results of all queries that are begun in this command buffer. This is called when the command buffer is submitted.
+        void ResetQueries();
+
     public:
 
         const CommandBufferDescriptor desc;
@@ -226,12 +255,19 @@ class NullCommandBuffer final : public CommandBuffer
         {
             SmallVector<Viewport>           viewports;
             SmallVector<Scissor>            scissors;
+            NullPipelineState*              pipelineState       = nullptr;
             SmallVector<const NullBuffer*>  vertexBuffers;
             const NullBuffer*               indexBuffer;
             Format                          indexBufferFormat;
             std::uint64_t                   indexBufferOffset;
         };
 
+        struct RecordedQuery
+        {
+            NullQueryHeap*  queryHeap;
+            std::uint32_t   query;
+        };
+
     private:
 
         // Allocates only an opcode for empty commands.
@@ -241,13 +277,25 @@ class NullCommandBuffer final : public CommandBuffer
         template <typename TCommand>
         TCommand* AllocCommand(const NullOpcode opcode, std::size_t payloadSize = 0);
 
+        // Records the first viewport and scissor for the software rasterizer.
+        void AllocViewportCommand(std::uint32_t numViewports, const Viewport* viewports);
+        void AllocScissorCommand(std::uint32_t numScissors, const Scissor* scissors);
+
         void AllocDrawCommand(const DrawIndirectArguments& args);
         void AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args);
 
+        // Waits until all pending submissions of this command buffer have been executed.
+        void WaitPendingSubmits();
+
     private:
 
-        NullVirtualCommandBuffer    buffer_;
-        RenderState                 renderState_;
+        NullVirtualCommandBuffer        buffer_;
+        RenderState                     renderState_;
+        std::vector<RecordedQuery>      recordedQueries_;
+        NullCommandQueue&               commandQueue_;                 // Immediate-submit commands are executed in order with all other submissions
+        const NullRasterizerContext*    rasterizerContext_  = nullptr; // Render passes, viewports, and clears are only recorded for the software rasterizer
+        std::atomic_uint32_t            numPendingSubmits_  { 0 };
+        std::uint32_t                   numRemovedCommands_ = 0;
 
 };
 
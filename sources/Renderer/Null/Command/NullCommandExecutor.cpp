@@ -7,6 +7,8 @@
 
 #include "NullCommandExecutor.h"
 #include "NullCommand.h"
+#include "NullVertexProcessor.h"
+#include "NullRasterizer.h"
 
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullSampler.h"
@@ -19,12 +21,79 @@
 #include "../RenderState/NullRenderPass.h"
 #include "../RenderState/NullQueryHeap.h"
 
+#include <LLGL/Container/SmallVector.h>
+#include <algorithm>
+
 
 namespace LLGL
 {
 
 
-static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+// Query that is active during the execution of a virtual command buffer.
+struct NullActiveQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
+// Execution state of a virtual command buffer.
+struct NullExecutionState
+{
+    SmallVector<NullActiveQuery>    statisticsQueries;
+    NullVertexProcessor             vertexProcessor;
+    NullRasterizer                  rasterizer;
+};
+
+// Returns the number of primitives that are assembled from the specified number of vertices.
+static std::uint64_t GetPrimitiveCount(const PrimitiveTopology topology, std::uint64_t numVertices)
+{
+    switch (topology)
+    {
+        case PrimitiveTopology::PointList:              return numVertices;
+        case PrimitiveTopology::LineList:               return numVertices / 2;
+        case PrimitiveTopology::LineStrip:              return (numVertices >= 2 ? numVertices - 1 : 0);
+        case PrimitiveTopology::LineListAdjacency:      return numVertices / 4;
+        case PrimitiveTopology::LineStripAdjacency:     return (numVertices >= 4 ? numVertices - 3 : 0);
+        case PrimitiveTopology::TriangleList:           return numVertices / 3;
+        case PrimitiveTopology::TriangleStrip:          return (numVertices >= 3 ? numVertices - 2 : 0);
+        case PrimitiveTopology::TriangleListAdjacency:  return numVertices / 6;
+        case PrimitiveTopology::TriangleStripAdjacency: return (numVertices >= 6 ? numVertices / 2 - 2 : 0);
+        default:                                        return numVertices / GetPrimitiveTopologyPatchSize(topology);
+    }
+}
+
+// Accumulates the pipeline statistics of a draw command for all active statistics queries.
+static void AccumulateDrawStatistics(
+    NullExecutionState&         state,
+    const NullPipelineState*    pipelineState,
+    std::uint32_t               numVertices,
+    std::uint32_t               numInstances)
+{
+    if (state.statisticsQueries.empty())
+        return;
+
+    const PrimitiveTopology topology =
+    (
+        pipelineState != nullptr && pipelineState->isGraphicsPSO
+            ? pipelineState->graphicsDesc.primitiveTopology
+            : PrimitiveTopology::TriangleList
+    );
+
+    /* Vertices are neither clipped nor rasterized, so all assembled primitives pass the clipping stage */
+    QueryPipelineStatistics statistics;
+    {
+        statistics.inputAssemblyVertices    = static_cast<std::uint64_t>(numVertices) * numInstances;
+        statistics.inputAssemblyPrimitives  = GetPrimitiveCount(topology, numVertices) * numInstances;
+        statistics.vertexShaderInvocations  = statistics.inputAssemblyVertices;
+        statistics.clippingInvocations      = statistics.inputAssemblyPrimitives;
+        statistics.clippingPrimitives       = statistics.inputAssemblyPrimitives;
+    }
+
+    for (const auto& activeQuery : state.statisticsQueries)
+        activeQuery.queryHeap->AccumulateStatistics(activeQuery.query, statistics);
+}
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullExecutionState& state)
 {
     switch (opcode)
     {
@@ -34,6 +103,12 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
             return (sizeof(*cmd) + cmd->size);
         }
+        case NullOpcodeBufferFill:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBufferFill*>(pc);
+            cmd->buffer->Fill(cmd->offset, cmd->value, cmd->size);
+            return sizeof(*cmd);
+        }
         case NullOpcodeCopySubresource:
         {
             auto cmd = reinterpret_cast<const NullCmdCopySubresource*>(pc);
@@ -47,17 +122,101 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             cmd->texture->GenerateMips(&subresource);
             return sizeof(*cmd);
         }
+        case NullOpcodeSetViewport:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetViewport*>(pc);
+            state.rasterizer.SetViewport(cmd->viewport);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetScissor:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetScissor*>(pc);
+            state.rasterizer.SetScissor(cmd->scissor);
+            return sizeof(*cmd);
+        }
         //TODO...
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            state.rasterizer.BeginRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
+            return (sizeof(*cmd) + cmd->numClearValues * sizeof(ClearValue));
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            state.rasterizer.EndRenderPass();
+            return 0;
+        }
+        case NullOpcodeClear:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClear*>(pc);
+            state.rasterizer.Clear(cmd->flags, cmd->clearValue);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            state.rasterizer.ClearAttachments(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+            return (sizeof(*cmd) + cmd->numAttachments * sizeof(AttachmentClear));
+        }
+        case NullOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResourceHeap*>(pc);
+            state.vertexProcessor.BindResourceHeap(*cmd->resourceHeap, cmd->descriptorSet, reinterpret_cast<const std::uint32_t*>(cmd + 1), cmd->numDynamicOffsets);
+            return (sizeof(*cmd) + cmd->numDynamicOffsets * sizeof(std::uint32_t));
+        }
+        case NullOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetUniforms*>(pc);
+            state.vertexProcessor.WriteUniforms(cmd->offset, cmd + 1, cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case NullOpcodeBeginStreamOutput:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginStreamOutput*>(pc);
+            state.vertexProcessor.BeginStreamOutput(cmd->numBuffers, reinterpret_cast<NullBuffer* const*>(cmd + 1));
+            return (sizeof(*cmd) + cmd->numBuffers * sizeof(NullBuffer*));
+        }
+        case NullOpcodeEndStreamOutput:
+        {
+            state.vertexProcessor.EndStreamOutput();
+            return 0;
+        }
         case NullOpcodeDraw:
         {
             auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
-            //TODO
+            AccumulateDrawStatistics(state, cmd->pipelineState, cmd->args.numVertices, cmd->args.numInstances);
+            NullDrawArguments drawArgs;
+            {
+                drawArgs.pipelineState      = cmd->pipelineState;
+                drawArgs.vertexBuffers      = reinterpret_cast<const NullBuffer* const*>(cmd + 1);
+                drawArgs.numVertexBuffers   = cmd->numVertexBuffers;
+                drawArgs.numVertices        = cmd->args.numVertices;
+                drawArgs.firstVertex        = cmd->args.firstVertex;
+                drawArgs.numInstances       = cmd->args.numInstances;
+                drawArgs.firstInstance      = cmd->args.firstInstance;
+            }
+            state.vertexProcessor.Draw(drawArgs, (state.rasterizer.IsActive() ? &state.rasterizer : nullptr));
             return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
         }
         case NullOpcodeDrawIndexed:
         {
             auto cmd = reinterpret_cast<const NullCmdDrawIndexed*>(pc);
-            //TODO
+            AccumulateDrawStatistics(state, cmd->pipelineState, cmd->args.numIndices, cmd->args.numInstances);
+            NullDrawArguments drawArgs;
+            {
+                drawArgs.pipelineState      = cmd->pipelineState;
+                drawArgs.vertexBuffers      = reinterpret_cast<const NullBuffer* const*>(cmd + 1);
+                drawArgs.numVertexBuffers   = cmd->numVertexBuffers;
+                drawArgs.indexBuffer        = cmd->indexBuffer;
+                drawArgs.indexFormat        = cmd->indexBufferFormat;
+                drawArgs.indexOffset        = cmd->indexBufferOffset;
+                drawArgs.numVertices        = cmd->args.numIndices;
+                drawArgs.firstVertex        = cmd->args.firstIndex;
+                drawArgs.vertexOffset       = cmd->args.vertexOffset;
+                drawArgs.numInstances       = cmd->args.numInstances;
+                drawArgs.firstInstance      = cmd->args.firstInstance;
+            }
+            state.vertexProcessor.Draw(drawArgs, (state.rasterizer.IsActive() ? &state.rasterizer : nullptr));
             return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
         }
         case NullOpcodePushDebugGroup:
@@ -71,6 +230,33 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
             //TODO
             return 0;
         }
+        case NullOpcodeBeginQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            cmd->queryHeap->BeginQuery(cmd->query);
+            if (cmd->queryHeap->IsStatisticsQuery())
+                state.statisticsQueries.push_back(NullActiveQuery{ cmd->queryHeap, cmd->query });
+            return sizeof(*cmd);
+        }
+        case NullOpcodeEndQuery:
+        {
+            auto cmd = reinterpret_cast<const NullCmdQuery*>(pc);
+            if (cmd->queryHeap->IsStatisticsQuery())
+            {
+                auto it = std::find_if(
+                    state.statisticsQueries.begin(),
+                    state.statisticsQueries.end(),
+                    [cmd](const NullActiveQuery& activeQuery)
+                    {
+                        return (activeQuery.queryHeap == cmd->queryHeap && activeQuery.query == cmd->query);
+                    }
+                );
+                if (it != state.statisticsQueries.end())
+                    state.statisticsQueries.erase(it);
+            }
+            cmd->queryHeap->EndQuery(cmd->query);
+            return sizeof(*cmd);
+        }
         default:
             return 0;
     }
@@ -78,6 +264,8 @@ static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
 
 void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer)
 {
+    NullExecutionState state;
+
     /* Initialize program counter to execute virtual GL commands */
     for (const auto& chunk : virtualCmdBuffer)
     {
@@ -91,9 +279,12 @@ void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdB
             pc += sizeof(NullOpcode);
 
             /* Execute command and increment program counter */
-            pc += ExecuteNullCommand(opcode, pc);
+            pc += ExecuteNullCommand(opcode, pc, state);
         }
     }
+
+    /* Store attachments of an unterminated render pass */
+    state.rasterizer.EndRenderPass();
 }
 
 
@@ -19,13 +19,26 @@ namespace LLGL
 enum NullOpcode : std::uint8_t
 {
     NullOpcodeBufferWrite = 1,
+    NullOpcodeBufferFill,
     NullOpcodeCopySubresource,
     NullOpcodeGenerateMips,
+    NullOpcodeSetViewport,
+    NullOpcodeSetScissor,
     //TODO
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClear,
+    NullOpcodeClearAttachments,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetUniforms,
+    NullOpcodeBeginStreamOutput,
+    NullOpcodeEndStreamOutput,
     NullOpcodeDraw,
     NullOpcodeDrawIndexed,
     NullOpcodePushDebugGroup,
     NullOpcodePopDebugGroup,
+    NullOpcodeBeginQuery,
+    NullOpcodeEndQuery,
 };
 
 
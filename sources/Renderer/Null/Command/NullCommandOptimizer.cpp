@@ -0,0 +1,443 @@
+/*
+ * NullCommandOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandOptimizer.h"
+#include "NullCommand.h"
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of the specified command including its payload, but excluding the opcode.
+static std::size_t GetNullCommandSize(const NullOpcode opcode, const char* pc)
+{
+    switch (opcode)
+    {
+        case NullOpcodeBufferWrite:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBufferWrite*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case NullOpcodeBufferFill:
+            return sizeof(NullCmdBufferFill);
+        case NullOpcodeCopySubresource:
+            return sizeof(NullCmdCopySubresource);
+        case NullOpcodeGenerateMips:
+            return sizeof(NullCmdGenerateMips);
+        case NullOpcodeSetViewport:
+            return sizeof(NullCmdSetViewport);
+        case NullOpcodeSetScissor:
+            return sizeof(NullCmdSetScissor);
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            return (sizeof(*cmd) + cmd->numClearValues * sizeof(ClearValue));
+        }
+        case NullOpcodeClear:
+            return sizeof(NullCmdClear);
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            return (sizeof(*cmd) + cmd->numAttachments * sizeof(AttachmentClear));
+        }
+        case NullOpcodeSetResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetResourceHeap*>(pc);
+            return (sizeof(*cmd) + cmd->numDynamicOffsets * sizeof(std::uint32_t));
+        }
+        case NullOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetUniforms*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case NullOpcodeBeginStreamOutput:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginStreamOutput*>(pc);
+            return (sizeof(*cmd) + cmd->numBuffers * sizeof(NullBuffer*));
+        }
+        case NullOpcodeDraw:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDraw*>(pc);
+            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+        }
+        case NullOpcodeDrawIndexed:
+        {
+            auto cmd = reinterpret_cast<const NullCmdDrawIndexed*>(pc);
+            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+        }
+        case NullOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const NullCmdPushDebugGroup*>(pc);
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case NullOpcodeBeginQuery:
+        case NullOpcodeEndQuery:
+            return sizeof(NullCmdQuery);
+        default:
+            return 0;
+    }
+}
+
+// Categories of states that are tracked by the optimizer.
+enum class NullOptimizerState
+{
+    Viewport,
+    Scissor,
+    ResourceHeap,
+    Num,
+};
+
+// Returns true if the specified opcode binds one of the tracked states. All of them replace the previous state entirely.
+static bool GetNullOptimizerState(const NullOpcode opcode, NullOptimizerState& state)
+{
+    switch (opcode)
+    {
+        case NullOpcodeSetViewport:     state = NullOptimizerState::Viewport;       return true;
+        case NullOpcodeSetScissor:      state = NullOptimizerState::Scissor;        return true;
+        case NullOpcodeSetResourceHeap: state = NullOptimizerState::ResourceHeap;   return true;
+        default:                                                                    return false;
+    }
+}
+
+class NullCommandOptimizer
+{
+
+    public:
+
+        std::size_t Optimize(NullVirtualCommandBuffer& virtualCmdBuffer);
+
+    private:
+
+        static const std::size_t invalidIndex = ~0u;
+        static const std::size_t numStates = static_cast<std::size_t>(NullOptimizerState::Num);
+
+        struct Command
+        {
+            NullOpcode      opcode;
+            const char*     data;
+            std::size_t     size;
+            bool            removed;
+            std::size_t     nextMerged; // Index of next buffer write that is merged into this one
+        };
+
+        // Uniform update that still determines the value of at least one uniform.
+        struct UniformUpdate
+        {
+            std::size_t     index;
+            bool            pending;    // True if no command has consumed this update yet
+        };
+
+    private:
+
+        void ParseCommands(const NullVirtualCommandBuffer& virtualCmdBuffer);
+
+        void ProcessStateCommand(std::size_t index, const NullOptimizerState state);
+        void ProcessUniformUpdate(std::size_t index);
+        void ProcessBufferWrite(std::size_t index);
+
+        bool IsStateEqual(const Command& lhs, const Command& rhs) const;
+
+        void CommitAllStates();
+
+        void RemoveCommand(std::size_t index);
+        void ResetBufferWrites();
+
+        void WriteMergedBufferWrite(NullVirtualCommandBuffer& virtualCmdBuffer, const Command& first);
+        void WriteCommands(NullVirtualCommandBuffer& virtualCmdBuffer);
+
+    private:
+
+        std::vector<Command>        commands_;
+        std::size_t                 numRemoved_                 = 0;
+
+        std::size_t                 pendingStates_[numStates];  // Commands that have not been consumed yet
+        std::size_t                 boundStates_[numStates];    // Commands that have been consumed
+
+        std::vector<UniformUpdate>  uniformUpdates_;
+
+        std::size_t                 writeFirst_                 = invalidIndex;
+        std::size_t                 writeLast_                  = invalidIndex;
+        const NullBuffer*           writeBuffer_                = nullptr;
+        std::size_t                 writeBegin_                 = 0;
+        std::size_t                 writeEnd_                   = 0;
+
+};
+
+std::size_t NullCommandOptimizer::Optimize(NullVirtualCommandBuffer& virtualCmdBuffer)
+{
+    ParseCommands(virtualCmdBuffer);
+
+    for (std::size_t i = 0; i < numStates; ++i)
+    {
+        pendingStates_[i]   = invalidIndex;
+        boundStates_[i]     = invalidIndex;
+    }
+
+    for (std::size_t i = 0; i < commands_.size(); ++i)
+    {
+        const auto opcode = commands_[i].opcode;
+
+        NullOptimizerState state;
+        if (GetNullOptimizerState(opcode, state))
+        {
+            ProcessStateCommand(i, state);
+        }
+        else if (opcode == NullOpcodeSetUniforms)
+        {
+            ProcessUniformUpdate(i);
+        }
+        else
+        {
+            /* All other commands are considered to consume the current states; none of them invalidates a state */
+            CommitAllStates();
+            if (opcode == NullOpcodeBufferWrite)
+            {
+                ProcessBufferWrite(i);
+                continue;
+            }
+        }
+
+        /* Buffer writes are only coalesced if they are adjacent in the final command buffer */
+        if (!commands_[i].removed)
+            ResetBufferWrites();
+    }
+
+    if (numRemoved_ > 0)
+        WriteCommands(virtualCmdBuffer);
+
+    return numRemoved_;
+}
+
+void NullCommandOptimizer::ParseCommands(const NullVirtualCommandBuffer& virtualCmdBuffer)
+{
+    for (const auto& chunk : virtualCmdBuffer)
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const NullOpcode opcode = *reinterpret_cast<const NullOpcode*>(pc);
+            pc += sizeof(NullOpcode);
+
+            /* Store command and increment program counter */
+            const std::size_t size = GetNullCommandSize(opcode, pc);
+            commands_.push_back(Command{ opcode, pc, size, false, invalidIndex });
+            pc += size;
+        }
+    }
+}
+
+void NullCommandOptimizer::ProcessStateCommand(std::size_t index, const NullOptimizerState state)
+{
+    const auto stateIndex = static_cast<std::size_t>(state);
+
+    /* Remove previous command of the same state if it has not been consumed */
+    if (pendingStates_[stateIndex] != invalidIndex)
+    {
+        RemoveCommand(pendingStates_[stateIndex]);
+        pendingStates_[stateIndex] = invalidIndex;
+    }
+
+    /* Remove command if the same state is already bound */
+    const auto boundIndex = boundStates_[stateIndex];
+    if (boundIndex != invalidIndex && IsStateEqual(commands_[boundIndex], commands_[index]))
+    {
+        RemoveCommand(index);
+        return;
+    }
+
+    pendingStates_[stateIndex] = index;
+}
+
+void NullCommandOptimizer::ProcessUniformUpdate(std::size_t index)
+{
+    auto cmd = reinterpret_cast<const NullCmdSetUniforms*>(commands_[index].data);
+
+    const std::uint32_t begin   = cmd->offset;
+    const std::uint32_t end     = cmd->offset + cmd->size;
+
+    /* Remove update if the latest update of an overlapping range has already written the same values */
+    for (auto it = uniformUpdates_.rbegin(); it != uniformUpdates_.rend(); ++it)
+    {
+        auto prevCmd = reinterpret_cast<const NullCmdSetUniforms*>(commands_[it->index].data);
+        if (prevCmd->offset < end && begin < prevCmd->offset + prevCmd->size)
+        {
+            if (prevCmd->offset == cmd->offset && prevCmd->size == cmd->size && ::memcmp(prevCmd + 1, cmd + 1, cmd->size) == 0)
+            {
+                RemoveCommand(index);
+                return;
+            }
+            break;
+        }
+    }
+
+    /* Remove pending updates that are entirely overridden; consumed updates are only no longer tracked */
+    for (auto it = uniformUpdates_.begin(); it != uniformUpdates_.end();)
+    {
+        auto prevCmd = reinterpret_cast<const NullCmdSetUniforms*>(commands_[it->index].data);
+        if (prevCmd->offset >= begin && prevCmd->offset + prevCmd->size <= end)
+        {
+            if (it->pending)
+                RemoveCommand(it->index);
+            it = uniformUpdates_.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    uniformUpdates_.push_back(UniformUpdate{ index, true });
+}
+
+void NullCommandOptimizer::ProcessBufferWrite(std::size_t index)
+{
+    auto& command = commands_[index];
+    auto cmd = reinterpret_cast<const NullCmdBufferWrite*>(command.data);
+
+    const std::size_t begin = cmd->offset;
+    const std::size_t end   = cmd->offset + cmd->size;
+
+    if (writeFirst_ != invalidIndex && writeBuffer_ == cmd->buffer)
+    {
+        if (begin == writeEnd_)
+        {
+            /* Append consecutive range to previous buffer write */
+            commands_[writeLast_].nextMerged = index;
+            command.removed = true;
+            ++numRemoved_;
+            writeLast_  = index;
+            writeEnd_   = end;
+            return;
+        }
+        if (begin <= writeBegin_ && end >= writeEnd_)
+        {
+            /* Remove previous buffer writes that are entirely overridden */
+            for (auto i = writeFirst_; i != invalidIndex; i = commands_[i].nextMerged)
+                RemoveCommand(i);
+        }
+    }
+
+    /* Start new sequence of buffer writes */
+    writeFirst_     = index;
+    writeLast_      = index;
+    writeBuffer_    = cmd->buffer;
+    writeBegin_     = begin;
+    writeEnd_       = end;
+}
+
+bool NullCommandOptimizer::IsStateEqual(const Command& lhs, const Command& rhs) const
+{
+    switch (lhs.opcode)
+    {
+        case NullOpcodeSetResourceHeap:
+        {
+            auto lhsCmd = reinterpret_cast<const NullCmdSetResourceHeap*>(lhs.data);
+            auto rhsCmd = reinterpret_cast<const NullCmdSetResourceHeap*>(rhs.data);
+            return
+            (
+                lhsCmd->resourceHeap        == rhsCmd->resourceHeap         &&
+                lhsCmd->descriptorSet       == rhsCmd->descriptorSet        &&
+                lhsCmd->numDynamicOffsets   == rhsCmd->numDynamicOffsets    &&
+                ::memcmp(lhsCmd + 1, rhsCmd + 1, sizeof(std::uint32_t)*lhsCmd->numDynamicOffsets) == 0
+            );
+        }
+        default:
+        {
+            /* Viewport and scissor commands are tightly packed POD structures */
+            return (lhs.size == rhs.size && ::memcmp(lhs.data, rhs.data, lhs.size) == 0);
+        }
+    }
+}
+
+void NullCommandOptimizer::CommitAllStates()
+{
+    for (std::size_t i = 0; i < numStates; ++i)
+    {
+        if (pendingStates_[i] != invalidIndex)
+        {
+            boundStates_[i] = pendingStates_[i];
+            pendingStates_[i] = invalidIndex;
+        }
+    }
+    for (auto& update : uniformUpdates_)
+        update.pending = false;
+}
+
+void NullCommandOptimizer::RemoveCommand(std::size_t index)
+{
+    if (!commands_[index].removed)
+    {
+        commands_[index].removed = true;
+        ++numRemoved_;
+    }
+}
+
+void NullCommandOptimizer::ResetBufferWrites()
+{
+    writeFirst_     = invalidIndex;
+    writeLast_      = invalidIndex;
+    writeBuffer_    = nullptr;
+}
+
+void NullCommandOptimizer::WriteMergedBufferWrite(NullVirtualCommandBuffer& virtualCmdBuffer, const Command& first)
+{
+    std::size_t size = 0;
+    for (auto next = &first; next != nullptr; next = (next->nextMerged != invalidIndex ? &commands_[next->nextMerged] : nullptr))
+        size += reinterpret_cast<const NullCmdBufferWrite*>(next->data)->size;
+
+    auto srcCmd = reinterpret_cast<const NullCmdBufferWrite*>(first.data);
+    auto cmd = virtualCmdBuffer.AllocCommand<NullCmdBufferWrite>(NullOpcodeBufferWrite, size);
+    {
+        cmd->buffer = srcCmd->buffer;
+        cmd->offset = srcCmd->offset;
+        cmd->size   = size;
+
+        auto dst = reinterpret_cast<char*>(cmd + 1);
+        for (auto next = &first; next != nullptr; next = (next->nextMerged != invalidIndex ? &commands_[next->nextMerged] : nullptr))
+        {
+            auto nextCmd = reinterpret_cast<const NullCmdBufferWrite*>(next->data);
+            ::memcpy(dst, nextCmd + 1, nextCmd->size);
+            dst += nextCmd->size;
+        }
+    }
+}
+
+void NullCommandOptimizer::WriteCommands(NullVirtualCommandBuffer& virtualCmdBuffer)
+{
+    NullVirtualCommandBuffer optimizedCmdBuffer{ virtualCmdBuffer.Size() };
+
+    for (const auto& command : commands_)
+    {
+        if (command.removed)
+            continue;
+        if (command.nextMerged != invalidIndex)
+            WriteMergedBufferWrite(optimizedCmdBuffer, command);
+        else if (command.size > 0)
+            ::memcpy(optimizedCmdBuffer.AllocRawCommand(command.opcode, command.size), command.data, command.size);
+        else
+            optimizedCmdBuffer.AllocOpcode(command.opcode);
+    }
+
+    virtualCmdBuffer.Swap(optimizedCmdBuffer);
+}
+
+std::size_t OptimizeNullVirtualCommandBuffer(NullVirtualCommandBuffer& virtualCmdBuffer)
+{
+    NullCommandOptimizer optimizer;
+    return optimizer.Optimize(virtualCmdBuffer);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
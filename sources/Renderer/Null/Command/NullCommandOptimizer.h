@@ -0,0 +1,36 @@
+/*
+ * NullCommandOptimizer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_OPTIMIZER_H
+#define LLGL_NULL_COMMAND_OPTIMIZER_H
+
+
+#include "NullCommandBuffer.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Peephole optimization pass over a recorded virtual command buffer.
+Removes viewport, scissor, resource heap, and uniform commands that are redundant (same state is already bound) or dead (overridden before any other command consumes them),
+coalesces adjacent buffer writes of consecutive ranges into a single write, and removes writes that are entirely overridden by the next one.
+Returns the number of commands that have been removed.
+*/
+std::size_t OptimizeNullVirtualCommandBuffer(NullVirtualCommandBuffer& virtualCmdBuffer);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include "NullCommandBuffer.h"
 #include "NullCommandExecutor.h"
 #include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
 #include "../../CheckedCast.h"
 
 
@@ -16,39 +17,185 @@ namespace LLGL
 {
 
 
+NullCommandQueue::NullCommandQueue() :
+    submissions_    { new Submission[numSubmissionSlots] },
+    writePos_       { 0                                  },
+    readPos_        { 0                                  },
+    executorThread_ { &NullCommandQueue::RunExecutorThread, this }
+{
+}
+
+NullCommandQueue::~NullCommandQueue()
+{
+    /* Finish all submissions and shut down executor thread */
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> guard{ wakeMutex_ };
+        quit_ = true;
+    }
+    wakeSignal_.notify_one();
+    executorThread_.join();
+}
+
 /* ----- Command Buffers ----- */
 
 void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
+    /* Immediate-submit command buffers have already been submitted in End() and secondary command buffers are only executed by primary ones */
     auto& commandBufferNull = LLGL_CAST(NullCommandBuffer&, commandBuffer);
     if ((commandBufferNull.desc.flags & (CommandBufferFlags::ImmediateSubmit | CommandBufferFlags::Secondary)) == 0)
-        commandBufferNull.ExecuteVirtualCommands();
+        SubmitCommandBuffer(commandBufferNull);
+}
+
+void NullCommandQueue::SubmitCommandBuffer(NullCommandBuffer& commandBuffer)
+{
+    /* Invalidate query results before the submission is visible to the executor, so QueryResult never reports a previous result for a re-submitted query */
+    commandBuffer.ResetQueries();
+
+    std::lock_guard<std::mutex> guard{ submitMutex_ };
+    auto& submission = BeginSubmission();
+    {
+        if ((commandBuffer.desc.flags & CommandBufferFlags::MultiSubmit) != 0)
+        {
+            /* Keep reference to command buffer; it must not be re-recorded until this submission has been executed */
+            commandBuffer.BeginPendingSubmit();
+            submission.commandBuffer = &commandBuffer;
+        }
+        else
+        {
+            /* Take over recorded commands and hand the executed commands of a previous submission back for recycling */
+            commandBuffer.SwapVirtualCommands(submission.virtualCmdBuffer);
+        }
+    }
+    EndSubmission();
 }
 
 /* ----- Queries ----- */
 
 bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
-    return false;
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+
+    /* Results are only available once the executor thread has processed the end query command */
+    if (!queryHeapNull.AreResultsAvailable(firstQuery, numQueries))
+        return false;
+
+    if (dataSize == numQueries * sizeof(std::uint32_t))
+    {
+        auto dst = reinterpret_cast<std::uint32_t*>(data);
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+            dst[i] = static_cast<std::uint32_t>(queryHeapNull.GetResult(firstQuery + i));
+    }
+    else if (dataSize == numQueries * sizeof(std::uint64_t))
+    {
+        auto dst = reinterpret_cast<std::uint64_t*>(data);
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+            dst[i] = queryHeapNull.GetResult(firstQuery + i);
+    }
+    else if (dataSize == numQueries * sizeof(QueryPipelineStatistics))
+    {
+        auto dst = reinterpret_cast<QueryPipelineStatistics*>(data);
+        for (std::uint32_t i = 0; i < numQueries; ++i)
+            dst[i] = queryHeapNull.GetStatistics(firstQuery + i);
+    }
+    else
+        return false;
+
+    return true;
 }
 
 /* ----- Fences ----- */
 
 void NullCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    std::lock_guard<std::mutex> guard{ submitMutex_ };
+    auto& submission = BeginSubmission();
+    {
+        submission.fence    = &fenceNull;
+        submission.signal   = fenceNull.NextSignal();
+    }
+    EndSubmission();
 }
 
 bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    return false; //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return fenceNull.Wait(timeout);
 }
 
 void NullCommandQueue::WaitIdle()
 {
-    //todo
+    const std::uint64_t writePos = writePos_.load(std::memory_order_relaxed);
+    while (readPos_.load(std::memory_order_acquire) < writePos)
+        std::this_thread::yield();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+NullCommandQueue::Submission& NullCommandQueue::BeginSubmission()
+{
+    /* Wait until the executor thread has released the oldest slot if the ring is full */
+    const std::uint64_t writePos = writePos_.load(std::memory_order_relaxed);
+    while (writePos - readPos_.load(std::memory_order_acquire) >= numSubmissionSlots)
+        std::this_thread::yield();
+    return submissions_[writePos % numSubmissionSlots];
+}
+
+void NullCommandQueue::EndSubmission()
+{
+    writePos_.fetch_add(1, std::memory_order_release);
+
+    /* Wake up executor thread; the mutex prevents the notification from getting lost before the executor waits */
+    {
+        std::lock_guard<std::mutex> guard{ wakeMutex_ };
+    }
+    wakeSignal_.notify_one();
+}
+
+void NullCommandQueue::ExecuteSubmission(Submission& submission)
+{
+    if (submission.commandBuffer != nullptr)
+    {
+        /* Execute multi-submit command buffer by reference */
+        submission.commandBuffer->ExecuteVirtualCommands();
+        submission.commandBuffer->EndPendingSubmit();
+        submission.commandBuffer = nullptr;
+    }
+    else if (!submission.virtualCmdBuffer.Empty())
+    {
+        /* Execute commands of one-time submit command buffer and keep memory for recycling */
+        ExecuteNullVirtualCommandBuffer(submission.virtualCmdBuffer);
+        submission.virtualCmdBuffer.Clear();
+    }
+
+    if (submission.fence != nullptr)
+    {
+        submission.fence->Signal(submission.signal);
+        submission.fence = nullptr;
+    }
+}
+
+void NullCommandQueue::RunExecutorThread()
+{
+    for (std::uint64_t readPos = 0;; ++readPos)
+    {
+        /* Wait for next submission */
+        if (readPos == writePos_.load(std::memory_order_acquire))
+        {
+            std::unique_lock<std::mutex> lock{ wakeMutex_ };
+            wakeSignal_.wait(lock, [this, readPos]() { return (quit_ || readPos != writePos_.load(std::memory_order_acquire)); });
+            if (readPos == writePos_.load(std::memory_order_acquire))
+                break;
+        }
+
+        /* Execute submission and release its slot */
+        ExecuteSubmission(submissions_[readPos % numSubmissionSlots]);
+        readPos_.store(readPos + 1, std::memory_order_release);
+    }
 }
 
 
@@ -10,12 +10,27 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include "NullCommandBuffer.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+class NullFence;
+
+/*
+Command queue that executes submitted command buffers and fences on a dedicated executor thread.
+Submissions are passed to the executor through a lock-free single-producer/single-consumer ring.
+Producers are serialized with a submission mutex, because immediate-submit command buffers can end on any thread.
+The executor never takes the submission mutex; the wake mutex only guards the wake-up signal of the idle executor.
+*/
 class NullCommandQueue final : public CommandQueue
 {
 
@@ -42,6 +57,51 @@ class NullCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+    public:
+
+        NullCommandQueue();
+        ~NullCommandQueue();
+
+        // Passes the specified command buffer to the executor thread. This is also used by immediate-submit command buffers when they end.
+        void SubmitCommandBuffer(NullCommandBuffer& commandBuffer);
+
+    private:
+
+        static const std::uint64_t numSubmissionSlots = 64;
+
+        struct Submission
+        {
+            NullCommandBuffer*          commandBuffer   = nullptr;  // Multi-submit command buffer; referenced until executed
+            NullVirtualCommandBuffer    virtualCmdBuffer;           // Commands of one-time submit command buffer; swapped with the command buffer
+            NullFence*                  fence           = nullptr;
+            std::uint64_t               signal          = 0;
+        };
+
+    private:
+
+        // Reserves the next submission slot and waits if the ring is full. The submission mutex must be locked.
+        Submission& BeginSubmission();
+
+        // Passes the current submission slot to the executor thread.
+        void EndSubmission();
+
+        void ExecuteSubmission(Submission& submission);
+
+        void RunExecutorThread();
+
+    private:
+
+        std::unique_ptr<Submission[]>   submissions_;
+        std::atomic_uint64_t            writePos_;
+        std::atomic_uint64_t            readPos_;
+
+        std::mutex                      submitMutex_;
+        std::mutex                      wakeMutex_;
+        std::condition_variable         wakeSignal_;
+        bool                            quit_           = false;
+
+        std::thread                     executorThread_;
+
 };
 
 
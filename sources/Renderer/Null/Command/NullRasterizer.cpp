@@ -0,0 +1,830 @@
+/*
+ * NullRasterizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRasterizer.h"
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullRenderTarget.h"
+#include "../RenderState/NullRenderPass.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../../TextureUtils.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#   define LLGL_NULL_RASTERIZER_SSE2
+#   include <emmintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Width and height (in pixels) of each tile. This must be a multiple of four, so pixel spans never cross tile boundaries.
+static const std::int32_t g_tileSize = 64;
+
+// Number of pending triangles after which a draw command flushes the tiles, to limit the memory of the triangle bins.
+static const std::size_t g_maxPendingTriangles = 65536;
+
+// Vertex positions are snapped to 1/256 pixels, so edge functions can be evaluated exactly with double precision.
+static const double g_subPixelScale = 256.0;
+
+NullRasterizerContext::NullRasterizerContext(std::uint32_t numThreads)
+{
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (numThreads > 1)
+        threadPool = MakeUnique<ThreadPool>(numThreads);
+}
+
+
+/*
+ * Internal functions
+ */
+
+// Returns the offset of the first pixel in the specified row of the attachment's MIP-map image.
+static Offset3D GetAttachmentRowOffset(const NullTexture& texture, std::int32_t y, std::uint32_t arrayLayer)
+{
+    return CalcTextureOffset(texture.GetType(), Offset3D{ 0, y, 0 }, arrayLayer);
+}
+
+// Returns the region of the specified attachment that is covered by the render area.
+static TextureRegion GetAttachmentRegion(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::int32_t width, std::int32_t height)
+{
+    return TextureRegion
+    {
+        TextureSubresource{ arrayLayer, 1, mipLevel, 1 },
+        Offset3D{},
+        Extent3D{ static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), 1u }
+    };
+}
+
+// Clamps the render area to the extent of the specified attachment.
+static void ClampRenderArea(std::int32_t& width, std::int32_t& height, const NullRenderTargetAttachment& attachment)
+{
+    const auto extent = attachment.texture->GetMipExtent(attachment.mipLevel);
+    const auto type = attachment.texture->GetType();
+    width = std::min(width, static_cast<std::int32_t>(extent.width));
+    if (type == TextureType::Texture1D || type == TextureType::Texture1DArray)
+        height = std::min(height, 1);
+    else
+        height = std::min(height, static_cast<std::int32_t>(extent.height));
+}
+
+// Returns the intersection of the two rectangles. Its width or height is zero if they do not overlap.
+static Scissor IntersectRects(const Scissor& a, const Scissor& b)
+{
+    const std::int32_t x0 = std::max(a.x, b.x);
+    const std::int32_t y0 = std::max(a.y, b.y);
+    const std::int32_t x1 = std::min(a.x + a.width, b.x + b.width);
+    const std::int32_t y1 = std::min(a.y + a.height, b.y + b.height);
+    return Scissor{ x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0) };
+}
+
+#ifndef LLGL_NULL_RASTERIZER_SSE2
+
+static bool CompareDepth(const CompareOp compareOp, float src, float dst)
+{
+    switch (compareOp)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (src <  dst);
+        case CompareOp::Equal:          return (src == dst);
+        case CompareOp::LessEqual:      return (src <= dst);
+        case CompareOp::Greater:        return (src >  dst);
+        case CompareOp::NotEqual:       return (src != dst);
+        case CompareOp::GreaterEqual:   return (src >= dst);
+        case CompareOp::AlwaysPass:     return true;
+    }
+    return true;
+}
+
+#endif // /LLGL_NULL_RASTERIZER_SSE2
+
+// Returns the mask of the four pixels (dx .. dx+3, dy) relative to the triangle origin whose centers are covered by the triangle.
+static unsigned ComputeCoverageMask(const NullRasterizer::Triangle& triangle, double dx, double dy)
+{
+    #ifdef LLGL_NULL_RASTERIZER_SSE2
+
+    const __m128d zero  = _mm_setzero_pd();
+    const __m128d x01   = _mm_setr_pd(dx, dx + 1.0);
+    const __m128d x23   = _mm_setr_pd(dx + 2.0, dx + 3.0);
+    __m128d inside01    = _mm_cmpeq_pd(zero, zero);
+    __m128d inside23    = inside01;
+
+    for_range(i, 3)
+    {
+        const double*   edge        = triangle.edges[i];
+        const __m128d   a           = _mm_set1_pd(edge[0]);
+        const __m128d   c           = _mm_set1_pd(edge[1] * dy + edge[2]);
+        const __m128d   inclusive   = _mm_castsi128_pd(_mm_set1_epi32(static_cast<int>(triangle.inclusive[i])));
+        const __m128d   e01         = _mm_add_pd(_mm_mul_pd(a, x01), c);
+        const __m128d   e23         = _mm_add_pd(_mm_mul_pd(a, x23), c);
+        inside01 = _mm_and_pd(inside01, _mm_or_pd(_mm_cmpgt_pd(e01, zero), _mm_and_pd(_mm_cmpeq_pd(e01, zero), inclusive)));
+        inside23 = _mm_and_pd(inside23, _mm_or_pd(_mm_cmpgt_pd(e23, zero), _mm_and_pd(_mm_cmpeq_pd(e23, zero), inclusive)));
+    }
+
+    return static_cast<unsigned>(_mm_movemask_pd(inside01) | (_mm_movemask_pd(inside23) << 2));
+
+    #else
+
+    unsigned mask = 0xF;
+    for_range(i, 3)
+    {
+        const double* edge = triangle.edges[i];
+        const double c = edge[1] * dy + edge[2];
+        for_range(lane, 4)
+        {
+            const double e = edge[0] * (dx + lane) + c;
+            if (!(e > 0.0 || (e == 0.0 && triangle.inclusive[i] != 0)))
+                mask &= ~(1u << lane);
+        }
+    }
+    return mask;
+
+    #endif
+}
+
+// Interpolates the depth of four pixels, clamps it to [0, 1], and returns the mask of pixels that pass the depth test against the destination depth values.
+static unsigned InterpolateAndTestDepth(
+    const float             plane[3],
+    float                   dx,
+    float                   dy,
+    const DepthDescriptor&  depthState,
+    const float*            dst,
+    float*                  outDepth)
+{
+    #ifdef LLGL_NULL_RASTERIZER_SSE2
+
+    const __m128 x = _mm_add_ps(_mm_set1_ps(dx), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+    __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), x), _mm_set1_ps(plane[1] * dy + plane[2]));
+    z = _mm_min_ps(_mm_max_ps(z, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    _mm_storeu_ps(outDepth, z);
+
+    if (!depthState.testEnabled)
+        return 0xF;
+
+    const __m128 d = _mm_loadu_ps(dst);
+    switch (depthState.compareOp)
+    {
+        case CompareOp::NeverPass:      return 0x0;
+        case CompareOp::Less:           return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(z, d)));
+        case CompareOp::Equal:          return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(z, d)));
+        case CompareOp::LessEqual:      return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(z, d)));
+        case CompareOp::Greater:        return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(z, d)));
+        case CompareOp::NotEqual:       return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpneq_ps(z, d)));
+        case CompareOp::GreaterEqual:   return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(z, d)));
+        case CompareOp::AlwaysPass:     return 0xF;
+    }
+    return 0xF;
+
+    #else
+
+    unsigned mask = 0;
+    const float c = plane[1] * dy + plane[2];
+    for_range(lane, 4)
+    {
+        const float z = std::min(std::max(plane[0] * (dx + lane) + c, 0.0f), 1.0f);
+        outDepth[lane] = z;
+        if (!depthState.testEnabled || CompareDepth(depthState.compareOp, z, dst[lane]))
+            mask |= (1u << lane);
+    }
+    return mask;
+
+    #endif
+}
+
+// Returns the value of the specified plane equation at the position (dx, dy) relative to the triangle origin.
+static float EvaluatePlane(const float plane[3], float dx, float dy)
+{
+    return plane[0] * dx + plane[1] * dy + plane[2];
+}
+
+// Returns true if the triangle is entirely outside of one of the clipping planes of the view frustum.
+static bool IsTriangleOutsideFrustum(const float* positions[3])
+{
+    for_range(axis, 3)
+    {
+        int numBelow = 0, numAbove = 0;
+        for_range(i, 3)
+        {
+            const float* v = positions[i];
+            if (v[axis] < (axis == 2 ? 0.0f : -v[3]))
+                ++numBelow;
+            if (v[axis] > v[3])
+                ++numAbove;
+        }
+        if (numBelow == 3 || numAbove == 3)
+            return true;
+    }
+    return false;
+}
+
+
+/*
+ * NullRasterizer class
+ */
+
+void NullRasterizer::BeginRenderPass(
+    NullRenderTarget&       renderTarget,
+    const NullRenderPass*   renderPass,
+    std::uint32_t           numClearValues,
+    const ClearValue*       clearValues)
+{
+    if (IsActive())
+        EndRenderPass();
+
+    context_        = renderTarget.GetRasterizerContext();
+    renderTarget_   = &renderTarget;
+
+    if (renderPass == nullptr)
+        renderPass = LLGL_CAST(const NullRenderPass*, renderTarget.GetRenderPass());
+
+    /* Determine render area from the resolution and all attachments */
+    const auto& colorAttachments        = renderTarget.GetColorAttachments();
+    const auto& depthStencilAttachment  = renderTarget.GetDepthStencilAttachment();
+
+    width_  = static_cast<std::int32_t>(renderTarget.GetResolution().width);
+    height_ = static_cast<std::int32_t>(renderTarget.GetResolution().height);
+
+    for (const auto& attachment : colorAttachments)
+        ClampRenderArea(width_, height_, attachment);
+    if (depthStencilAttachment.texture != nullptr)
+        ClampRenderArea(width_, height_, depthStencilAttachment);
+
+    depthRowStride_ = GetAlignedSize<std::int32_t>(width_, 4);
+    numTilesX_      = static_cast<std::uint32_t>((width_  + g_tileSize - 1) / g_tileSize);
+    numTilesY_      = static_cast<std::uint32_t>((height_ + g_tileSize - 1) / g_tileSize);
+    tileBins_.resize(numTilesX_ * numTilesY_);
+
+    /* Clear values are used in order of the attachments to be cleared, where the depth-stencil attachment appears last */
+    std::uint32_t clearValueIndex = 0;
+    auto NextClearValue = [&]() -> ClearValue
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : ClearValue{});
+    };
+
+    /* Load or clear color attachments */
+    colorTargets_.resize(colorAttachments.size());
+    for_range(i, colorAttachments.size())
+    {
+        const auto& attachment  = colorAttachments[i];
+        auto&       target      = colorTargets_[i];
+
+        /* Compressed and depth formats cannot be converted into RGBA floats, so they are not loaded nor stored */
+        const Format format = attachment.texture->GetFormat();
+        const bool isConvertible = !(IsCompressedFormat(format) || IsDepthFormat(format) || IsStencilFormat(format));
+
+        target.texture      = (isConvertible ? attachment.texture : nullptr);
+        target.mipLevel     = attachment.mipLevel;
+        target.arrayLayer   = attachment.arrayLayer;
+        target.pixels.resize(static_cast<std::size_t>(width_) * height_ * 4);
+
+        const AttachmentLoadOp loadOp =
+        (
+            renderPass != nullptr && i < LLGL_MAX_NUM_COLOR_ATTACHMENTS
+                ? renderPass->desc.colorAttachments[i].loadOp
+                : AttachmentLoadOp::Load
+        );
+
+        if (loadOp == AttachmentLoadOp::Clear)
+            ClearColorTarget(target, NextClearValue().color);
+        else if (target.texture != nullptr && !target.pixels.empty())
+        {
+            const DstImageDescriptor dstImageDesc{ ImageFormat::RGBA, DataType::Float32, target.pixels.data(), target.pixels.size() * sizeof(float) };
+            target.texture->Read(GetAttachmentRegion(target.mipLevel, target.arrayLayer, width_, height_), dstImageDesc);
+        }
+    }
+
+    /* Load or clear depth attachment */
+    depthTarget_.texture    = nullptr;
+    depthTarget_.pixels.clear();
+
+    if (depthStencilAttachment.texture != nullptr && IsDepthFormat(depthStencilAttachment.texture->GetFormat()))
+    {
+        depthTarget_.texture    = depthStencilAttachment.texture;
+        depthTarget_.mipLevel   = depthStencilAttachment.mipLevel;
+        depthTarget_.arrayLayer = depthStencilAttachment.arrayLayer;
+        depthTarget_.pixels.resize(static_cast<std::size_t>(depthRowStride_) * height_);
+
+        const AttachmentLoadOp depthLoadOp      = (renderPass != nullptr ? renderPass->desc.depthAttachment.loadOp   : AttachmentLoadOp::Load);
+        const AttachmentLoadOp stencilLoadOp    = (renderPass != nullptr ? renderPass->desc.stencilAttachment.loadOp : AttachmentLoadOp::Load);
+
+        if (depthLoadOp == AttachmentLoadOp::Clear || stencilLoadOp == AttachmentLoadOp::Clear)
+        {
+            const ClearValue clearValue = NextClearValue();
+            if (depthLoadOp == AttachmentLoadOp::Clear)
+                ClearDepthTarget(clearValue.depth);
+            else
+                LoadDepthTarget();
+        }
+        else
+            LoadDepthTarget();
+    }
+
+    /* Use entire render area if no viewport or scissor has been set yet */
+    if (!hasViewport_)
+        viewport_ = Viewport{ 0.0f, 0.0f, static_cast<float>(width_), static_cast<float>(height_) };
+    if (!hasScissor_)
+        scissor_ = Scissor{ 0, 0, width_, height_ };
+}
+
+void NullRasterizer::EndRenderPass()
+{
+    if (!IsActive())
+        return;
+
+    Flush();
+
+    /* Store attachments in their textures */
+    for (auto& target : colorTargets_)
+    {
+        if (target.texture != nullptr && !target.pixels.empty())
+        {
+            const SrcImageDescriptor srcImageDesc{ ImageFormat::RGBA, DataType::Float32, target.pixels.data(), target.pixels.size() * sizeof(float) };
+            target.texture->Write(GetAttachmentRegion(target.mipLevel, target.arrayLayer, width_, height_), srcImageDesc);
+        }
+    }
+
+    if (depthTarget_.texture != nullptr)
+        StoreDepthTarget();
+
+    renderTarget_ = nullptr;
+}
+
+void NullRasterizer::SetViewport(const Viewport& viewport)
+{
+    viewport_       = viewport;
+    hasViewport_    = true;
+}
+
+void NullRasterizer::SetScissor(const Scissor& scissor)
+{
+    scissor_    = scissor;
+    hasScissor_ = true;
+}
+
+void NullRasterizer::Clear(long flags, const ClearValue& clearValue)
+{
+    if (!IsActive())
+        return;
+
+    Flush();
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for (auto& target : colorTargets_)
+            ClearColorTarget(target, clearValue.color);
+    }
+
+    if ((flags & ClearFlags::Depth) != 0)
+        ClearDepthTarget(clearValue.depth);
+}
+
+void NullRasterizer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    if (!IsActive())
+        return;
+
+    Flush();
+
+    for_range(i, numAttachments)
+    {
+        const auto& attachment = attachments[i];
+        if ((attachment.flags & ClearFlags::Color) != 0)
+        {
+            if (attachment.colorAttachment < colorTargets_.size())
+                ClearColorTarget(colorTargets_[attachment.colorAttachment], attachment.clearValue.color);
+        }
+        else if ((attachment.flags & ClearFlags::Depth) != 0)
+            ClearDepthTarget(attachment.clearValue.depth);
+    }
+}
+
+void NullRasterizer::DrawTriangles(const NullPipelineState& pipelineState, std::uint32_t numVertices, const float* positions, const float* colors)
+{
+    if (!IsActive() || !pipelineState.isGraphicsPSO)
+        return;
+
+    const auto& desc = pipelineState.graphicsDesc;
+    if (desc.rasterizer.discardEnabled)
+        return;
+
+    /* Static viewports and scissors of the PSO take precedence over the dynamic ones */
+    const Viewport& viewport = (desc.viewports.empty() ? viewport_ : desc.viewports.front());
+
+    /* Only pixels inside the render area, the viewport, and the optional scissor rectangle are rasterized */
+    const std::int32_t viewportX0 = static_cast<std::int32_t>(std::floor(viewport.x));
+    const std::int32_t viewportY0 = static_cast<std::int32_t>(std::floor(viewport.y));
+    const std::int32_t viewportX1 = static_cast<std::int32_t>(std::ceil(viewport.x + viewport.width));
+    const std::int32_t viewportY1 = static_cast<std::int32_t>(std::ceil(viewport.y + viewport.height));
+
+    Scissor clipRect = IntersectRects(Scissor{ 0, 0, width_, height_ }, Scissor{ viewportX0, viewportY0, viewportX1 - viewportX0, viewportY1 - viewportY0 });
+    if (desc.rasterizer.scissorTestEnabled)
+        clipRect = IntersectRects(clipRect, (desc.scissors.empty() ? scissor_ : desc.scissors.front()));
+
+    if (clipRect.width <= 0 || clipRect.height <= 0)
+        return;
+
+    /* Capture depth state and color write masks for all triangles of this draw command */
+    RasterState state;
+    {
+        state.depth         = desc.depth;
+        state.colorMasks    = 0;
+
+        if (depthTarget_.texture == nullptr)
+        {
+            state.depth.testEnabled     = false;
+            state.depth.writeEnabled    = false;
+        }
+
+        for_range(i, std::min<std::size_t>(colorTargets_.size(), LLGL_MAX_NUM_COLOR_ATTACHMENTS))
+        {
+            const auto& colorMask = desc.blend.targets[desc.blend.independentBlendEnabled ? i : 0].colorMask;
+            const std::uint32_t mask =
+            (
+                (colorMask.r ? 0x1u : 0u) |
+                (colorMask.g ? 0x2u : 0u) |
+                (colorMask.b ? 0x4u : 0u) |
+                (colorMask.a ? 0x8u : 0u)
+            );
+            state.colorMasks |= (mask << (i * 4));
+        }
+    }
+    rasterStates_.push_back(state);
+
+    for (std::uint32_t i = 0; i + 3 <= numVertices; i += 3)
+    {
+        const float* trianglePositions[3]   = { positions + i*4, positions + (i + 1)*4, positions + (i + 2)*4 };
+        const float* triangleColors[3]      = { colors    + i*4, colors    + (i + 1)*4, colors    + (i + 2)*4 };
+        SetupTriangle(trianglePositions, triangleColors, viewport, clipRect, desc.rasterizer);
+    }
+
+    if (triangles_.size() >= g_maxPendingTriangles)
+        Flush();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullRasterizer::LoadDepthTarget()
+{
+    /* Only the depth component is loaded; it is stored as either 16-bit normalized integer or 32-bit float */
+    const Image&        image       = depthTarget_.texture->GetMipImage(depthTarget_.mipLevel);
+    const auto&         extent      = image.GetExtent();
+    const std::size_t   bpp         = image.GetBytesPerPixel();
+    const bool          isUNorm16   = (image.GetDataType() == DataType::UInt16);
+    const char*         data        = static_cast<const char*>(image.GetData());
+
+    for_range(y, static_cast<std::uint32_t>(height_))
+    {
+        const Offset3D  offset  = GetAttachmentRowOffset(*depthTarget_.texture, static_cast<std::int32_t>(y), depthTarget_.arrayLayer);
+        const char*     src     = data + ((static_cast<std::size_t>(offset.z) * extent.height + offset.y) * extent.width) * bpp;
+        float*          dst     = depthTarget_.pixels.data() + static_cast<std::size_t>(y) * depthRowStride_;
+
+        for_range(x, static_cast<std::uint32_t>(width_))
+        {
+            if (isUNorm16)
+            {
+                std::uint16_t value;
+                ::memcpy(&value, src + x * bpp, sizeof(value));
+                dst[x] = static_cast<float>(value) / 65535.0f;
+            }
+            else
+                ::memcpy(&dst[x], src + x * bpp, sizeof(float));
+        }
+    }
+}
+
+void NullRasterizer::StoreDepthTarget()
+{
+    Image&              image       = depthTarget_.texture->GetMipImage(depthTarget_.mipLevel);
+    const auto&         extent      = image.GetExtent();
+    const std::size_t   bpp         = image.GetBytesPerPixel();
+    const bool          isUNorm16   = (image.GetDataType() == DataType::UInt16);
+    char*               data        = static_cast<char*>(image.GetData());
+
+    for_range(y, static_cast<std::uint32_t>(height_))
+    {
+        const Offset3D  offset  = GetAttachmentRowOffset(*depthTarget_.texture, static_cast<std::int32_t>(y), depthTarget_.arrayLayer);
+        char*           dst     = data + ((static_cast<std::size_t>(offset.z) * extent.height + offset.y) * extent.width) * bpp;
+        const float*    src     = depthTarget_.pixels.data() + static_cast<std::size_t>(y) * depthRowStride_;
+
+        for_range(x, static_cast<std::uint32_t>(width_))
+        {
+            if (isUNorm16)
+            {
+                const auto value = static_cast<std::uint16_t>(src[x] * 65535.0f + 0.5f);
+                ::memcpy(dst + x * bpp, &value, sizeof(value));
+            }
+            else
+                ::memcpy(dst + x * bpp, &src[x], sizeof(float));
+        }
+    }
+}
+
+void NullRasterizer::ClearColorTarget(ColorTarget& colorTarget, const ColorRGBAf& color)
+{
+    const float rgba[4] = { color.r, color.g, color.b, color.a };
+    for (std::size_t i = 0, n = colorTarget.pixels.size(); i < n; i += 4)
+        ::memcpy(&colorTarget.pixels[i], rgba, sizeof(rgba));
+}
+
+void NullRasterizer::ClearDepthTarget(float depth)
+{
+    std::fill(depthTarget_.pixels.begin(), depthTarget_.pixels.end(), std::min(std::max(depth, 0.0f), 1.0f));
+}
+
+void NullRasterizer::SetupTriangle(
+    const float*                positions[3],
+    const float*                colors[3],
+    const Viewport&             viewport,
+    const Scissor&              clipRect,
+    const RasterizerDescriptor& rasterizerDesc)
+{
+    /* Discard triangles with a vertex behind the viewer, since they are not clipped */
+    for_range(i, 3)
+    {
+        if (!(positions[i][3] > 0.0f))
+            return;
+    }
+
+    if (IsTriangleOutsideFrustum(positions))
+        return;
+
+    /* Transform vertices into screen space and snap them to the sub-pixel grid */
+    double sx[3], sy[3];
+    float sz[3], invW[3];
+
+    for_range(i, 3)
+    {
+        const float* v = positions[i];
+        invW[i] = 1.0f / v[3];
+
+        const double ndcX = static_cast<double>(v[0]) * invW[i];
+        const double ndcY = static_cast<double>(v[1]) * invW[i];
+        const double ndcZ = static_cast<double>(v[2]) * invW[i];
+
+        sx[i] = std::floor((viewport.x + (ndcX*0.5 + 0.5)*viewport.width ) * g_subPixelScale + 0.5) / g_subPixelScale;
+        sy[i] = std::floor((viewport.y + (0.5 - ndcY*0.5)*viewport.height) * g_subPixelScale + 0.5) / g_subPixelScale;
+        sz[i] = static_cast<float>(viewport.minDepth + ndcZ*(viewport.maxDepth - viewport.minDepth));
+    }
+
+    /* Cull triangles by their winding order: counter-clockwise in normalized device coordinates is clockwise in screen space */
+    double area = (sx[1] - sx[0])*(sy[2] - sy[0]) - (sx[2] - sx[0])*(sy[1] - sy[0]);
+    if (!(area != 0.0))
+        return;
+
+    const bool isFrontFacing = (rasterizerDesc.frontCCW ? area < 0.0 : area > 0.0);
+    if ((rasterizerDesc.cullMode == CullMode::Back && !isFrontFacing) || (rasterizerDesc.cullMode == CullMode::Front && isFrontFacing))
+        return;
+
+    /* Reorder vertices so the area is positive */
+    std::uint32_t order[3] = { 0, 1, 2 };
+    if (area < 0.0)
+    {
+        std::swap(order[1], order[2]);
+        area = -area;
+    }
+
+    /* Determine bounding box within the clipping rectangle */
+    Triangle triangle;
+
+    const double minSX = std::min({ sx[0], sx[1], sx[2] });
+    const double minSY = std::min({ sy[0], sy[1], sy[2] });
+    const double maxSX = std::max({ sx[0], sx[1], sx[2] });
+    const double maxSY = std::max({ sy[0], sy[1], sy[2] });
+
+    triangle.minX = static_cast<std::int32_t>(std::max<double>(clipRect.x, std::floor(minSX)));
+    triangle.minY = static_cast<std::int32_t>(std::max<double>(clipRect.y, std::floor(minSY)));
+    triangle.maxX = static_cast<std::int32_t>(std::min<double>(clipRect.x + clipRect.width,  std::ceil(maxSX)));
+    triangle.maxY = static_cast<std::int32_t>(std::min<double>(clipRect.y + clipRect.height, std::ceil(maxSY)));
+
+    if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+        return;
+
+    /* Set up edge functions relative to the center of the first pixel in the bounding box */
+    const double originX = triangle.minX + 0.5;
+    const double originY = triangle.minY + 0.5;
+
+    double edgeOrigin[3];
+    for_range(i, 3)
+    {
+        const std::uint32_t a = order[i];
+        const std::uint32_t b = order[(i + 1) % 3];
+        const double edgeA = sy[a] - sy[b];
+        const double edgeB = sx[b] - sx[a];
+
+        edgeOrigin[i] = edgeA*(originX - sx[a]) + edgeB*(originY - sy[a]);
+
+        triangle.edges[i][0]    = edgeA;
+        triangle.edges[i][1]    = edgeB;
+        triangle.edges[i][2]    = edgeOrigin[i];
+        triangle.inclusive[i]   = ((edgeA > 0.0 || (edgeA == 0.0 && edgeB > 0.0)) ? ~0u : 0u);
+    }
+
+    /* Set up plane equations from the barycentric weights, where vertex i is weighted by the edge opposite to it */
+    auto SetupPlane = [&](float plane[3], const float values[3])
+    {
+        double ddx = 0.0, ddy = 0.0, origin = 0.0;
+        for_range(i, 3)
+        {
+            const std::uint32_t edge = (i + 1) % 3;
+            const double value = values[order[i]];
+            ddx     += triangle.edges[edge][0] * value;
+            ddy     += triangle.edges[edge][1] * value;
+            origin  += edgeOrigin[edge] * value;
+        }
+        plane[0] = static_cast<float>(ddx / area);
+        plane[1] = static_cast<float>(ddy / area);
+        plane[2] = static_cast<float>(origin / area);
+    };
+
+    SetupPlane(triangle.depth, sz);
+    SetupPlane(triangle.invW, invW);
+
+    for_range(c, 4)
+    {
+        const float values[3] = { colors[0][c] * invW[0], colors[1][c] * invW[1], colors[2][c] * invW[2] };
+        SetupPlane(triangle.colors[c], values);
+    }
+
+    triangle.state = static_cast<std::uint32_t>(rasterStates_.size() - 1);
+
+    triangles_.push_back(triangle);
+    BinTriangle(static_cast<std::uint32_t>(triangles_.size() - 1));
+}
+
+void NullRasterizer::BinTriangle(std::uint32_t index)
+{
+    const Triangle& triangle = triangles_[index];
+
+    const std::uint32_t tileX0 = static_cast<std::uint32_t>(triangle.minX / g_tileSize);
+    const std::uint32_t tileY0 = static_cast<std::uint32_t>(triangle.minY / g_tileSize);
+    const std::uint32_t tileX1 = static_cast<std::uint32_t>((triangle.maxX - 1) / g_tileSize);
+    const std::uint32_t tileY1 = static_cast<std::uint32_t>((triangle.maxY - 1) / g_tileSize);
+
+    for (std::uint32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+    {
+        for (std::uint32_t tileX = tileX0; tileX <= tileX1; ++tileX)
+        {
+            const std::uint32_t tile = tileY * numTilesX_ + tileX;
+            auto& bin = tileBins_[tile];
+            if (bin.empty())
+                binnedTiles_.push_back(tile);
+            bin.push_back(index);
+        }
+    }
+}
+
+void NullRasterizer::Flush()
+{
+    const std::size_t numTiles = binnedTiles_.size();
+
+    /* Distribute tiles among the worker threads, which fetch the next tile until all tiles are rasterized */
+    ThreadPool* threadPool = (context_ != nullptr ? context_->threadPool.get() : nullptr);
+    if (threadPool != nullptr && numTiles > 1)
+    {
+        std::atomic_size_t nextTile{ 0 };
+        const std::size_t numWorkers = std::min(threadPool->GetThreadCount(), numTiles);
+        for_range(i, numWorkers)
+        {
+            threadPool->Enqueue(
+                [this, &nextTile, numTiles]()
+                {
+                    for (std::size_t tile = nextTile++; tile < numTiles; tile = nextTile++)
+                        RasterizeTile(binnedTiles_[tile]);
+                }
+            );
+        }
+        threadPool->WaitIdle();
+    }
+    else
+    {
+        for (auto tile : binnedTiles_)
+            RasterizeTile(tile);
+    }
+
+    for (auto tile : binnedTiles_)
+        tileBins_[tile].clear();
+
+    binnedTiles_.clear();
+    triangles_.clear();
+    rasterStates_.clear();
+}
+
+void NullRasterizer::RasterizeTile(std::uint32_t tile)
+{
+    const std::int32_t tileX0 = static_cast<std::int32_t>(tile % numTilesX_) * g_tileSize;
+    const std::int32_t tileY0 = static_cast<std::int32_t>(tile / numTilesX_) * g_tileSize;
+    const std::int32_t tileX1 = std::min(tileX0 + g_tileSize, width_);
+    const std::int32_t tileY1 = std::min(tileY0 + g_tileSize, height_);
+
+    for (auto index : tileBins_[tile])
+        RasterizeTriangleInTile(triangles_[index], tileX0, tileY0, tileX1, tileY1);
+}
+
+void NullRasterizer::RasterizeTriangleInTile(
+    const Triangle& triangle,
+    std::int32_t    tileX0,
+    std::int32_t    tileY0,
+    std::int32_t    tileX1,
+    std::int32_t    tileY1)
+{
+    const std::int32_t minX = std::max(triangle.minX, tileX0);
+    const std::int32_t minY = std::max(triangle.minY, tileY0);
+    const std::int32_t maxX = std::min(triangle.maxX, tileX1);
+    const std::int32_t maxY = std::min(triangle.maxY, tileY1);
+
+    if (minX >= maxX || minY >= maxY)
+        return;
+
+    const RasterState&  state           = rasterStates_[triangle.state];
+    const bool          hasDepth        = (state.depth.testEnabled || state.depth.writeEnabled);
+    const bool          hasColor        = (state.colorMasks != 0 && !colorTargets_.empty());
+    const std::size_t   numColorTargets = std::min<std::size_t>(colorTargets_.size(), LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+
+    /* Spans are aligned to four pixels, so they never cross tile boundaries and depth rows are padded accordingly */
+    const std::int32_t spanX0 = (minX & ~3);
+
+    for (std::int32_t y = minY; y < maxY; ++y)
+    {
+        const float dy      = static_cast<float>(y - triangle.minY);
+        float*      depths  = (hasDepth ? depthTarget_.pixels.data() + static_cast<std::size_t>(y) * depthRowStride_ : nullptr);
+
+        for (std::int32_t x = spanX0; x < maxX; x += 4)
+        {
+            /* Mask out pixels outside of the bounding box */
+            unsigned mask = 0xF;
+            if (x < minX)
+                mask &= (0xFu << (minX - x)) & 0xFu;
+            if (maxX - x < 4)
+                mask &= (1u << (maxX - x)) - 1u;
+
+            const float dx = static_cast<float>(x - triangle.minX);
+            mask &= ComputeCoverageMask(triangle, dx, dy);
+            if (mask == 0)
+                continue;
+
+            float spanDepths[4];
+            if (hasDepth)
+            {
+                mask &= InterpolateAndTestDepth(triangle.depth, dx, dy, state.depth, depths + x, spanDepths);
+                if (mask == 0)
+                    continue;
+            }
+
+            for_range(lane, 4)
+            {
+                if ((mask & (1u << lane)) == 0)
+                    continue;
+
+                const std::int32_t px = x + static_cast<std::int32_t>(lane);
+
+                if (state.depth.writeEnabled)
+                    depths[px] = spanDepths[lane];
+
+                if (hasColor)
+                {
+                    /* Interpolate colors with perspective correction */
+                    const float pdx = dx + static_cast<float>(lane);
+                    const float w   = 1.0f / EvaluatePlane(triangle.invW, pdx, dy);
+
+                    float color[4];
+                    for_range(c, 4)
+                        color[c] = EvaluatePlane(triangle.colors[c], pdx, dy) * w;
+
+                    const std::size_t pixelOffset = (static_cast<std::size_t>(y) * width_ + px) * 4;
+                    for_range(i, numColorTargets)
+                    {
+                        const std::uint32_t colorMask = (state.colorMasks >> (i * 4)) & 0xFu;
+                        float* dst = colorTargets_[i].pixels.data() + pixelOffset;
+                        for_range(c, 4)
+                        {
+                            if ((colorMask & (1u << c)) != 0)
+                                dst[c] = color[c];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
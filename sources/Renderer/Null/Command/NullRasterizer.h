@@ -0,0 +1,180 @@
+/*
+ * NullRasterizer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_RASTERIZER_H
+#define LLGL_NULL_RASTERIZER_H
+
+
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/StaticLimits.h>
+#include "../../../Core/ThreadPool.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullTexture;
+class NullRenderTarget;
+class NullRenderPass;
+class NullPipelineState;
+
+// Shared state of the software rasterizer, which is owned by the render system.
+struct NullRasterizerContext
+{
+    // Initializes the context with the specified number of worker threads. If this is 0, the number of hardware threads is used.
+    NullRasterizerContext(std::uint32_t numThreads);
+
+    std::unique_ptr<ThreadPool> threadPool; // Null if all tiles are rasterized on the executing thread
+};
+
+/*
+Tile-based software rasterizer of the Null command executor.
+Triangles are set up and binned into tiles of 64x64 pixels when they are submitted.
+The tiles are rasterized in parallel when the render pass ends or an attachment is cleared,
+each tile processes its triangles in submission order, and pixels are evaluated in spans of four.
+Attachments are loaded into floating-point buffers when the render pass begins and written back into their textures when it ends.
+*/
+class NullRasterizer
+{
+
+    public:
+
+        NullRasterizer() = default;
+
+        NullRasterizer(const NullRasterizer&) = delete;
+        NullRasterizer& operator = (const NullRasterizer&) = delete;
+
+        // Loads the attachments of the specified render target and clears them according to the render pass.
+        void BeginRenderPass(
+            NullRenderTarget&       renderTarget,
+            const NullRenderPass*   renderPass,
+            std::uint32_t           numClearValues,
+            const ClearValue*       clearValues
+        );
+
+        // Rasterizes all pending triangles and stores the attachments in their textures.
+        void EndRenderPass();
+
+        void SetViewport(const Viewport& viewport);
+        void SetScissor(const Scissor& scissor);
+
+        void Clear(long flags, const ClearValue& clearValue);
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments);
+
+        // Sets up and bins triangles from the specified lists of clip-space positions and colors (four floats per vertex each).
+        void DrawTriangles(const NullPipelineState& pipelineState, std::uint32_t numVertices, const float* positions, const float* colors);
+
+        // Returns true if a render pass is active.
+        inline bool IsActive() const
+        {
+            return (renderTarget_ != nullptr);
+        }
+
+    public:
+
+        // Triangle after setup with plane equations relative to the origin of its bounding box.
+        struct Triangle
+        {
+            double          edges[3][3];    // Edge functions (A, B, C), inside is positive
+            std::uint32_t   inclusive[3];   // All bits set if pixel centers on the respective edge are covered (top-left rule)
+            float           depth[3];       // Plane equation (ddx, ddy, origin) of screen-space depth
+            float           invW[3];        // Plane equation of 1/W
+            float           colors[4][3];   // Plane equations of color/W
+            std::int32_t    minX;
+            std::int32_t    minY;
+            std::int32_t    maxX;           // Exclusive
+            std::int32_t    maxY;           // Exclusive
+            std::uint32_t   state;          // Index into the raster states
+        };
+
+        // Pipeline states that are captured per draw command.
+        struct RasterState
+        {
+            DepthDescriptor depth;
+            std::uint32_t   colorMasks; // Four bits per color attachment
+        };
+
+    private:
+
+        // Color attachment that is rasterized into a buffer of RGBA floats.
+        struct ColorTarget
+        {
+            NullTexture*        texture;
+            std::uint32_t       mipLevel;
+            std::uint32_t       arrayLayer;
+            std::vector<float>  pixels;
+        };
+
+        // Depth attachment that is rasterized into a buffer of floats with rows padded to a multiple of four pixels.
+        struct DepthTarget
+        {
+            NullTexture*        texture     = nullptr;
+            std::uint32_t       mipLevel    = 0;
+            std::uint32_t       arrayLayer  = 0;
+            std::vector<float>  pixels;
+        };
+
+    private:
+
+        void LoadDepthTarget();
+        void StoreDepthTarget();
+
+        void ClearColorTarget(ColorTarget& colorTarget, const ColorRGBAf& color);
+        void ClearDepthTarget(float depth);
+
+        void SetupTriangle(
+            const float*                positions[3],
+            const float*                colors[3],
+            const Viewport&             viewport,
+            const Scissor&              clipRect,
+            const RasterizerDescriptor& rasterizerDesc
+        );
+        void BinTriangle(std::uint32_t index);
+
+        void Flush();
+        void RasterizeTile(std::uint32_t tile);
+        void RasterizeTriangleInTile(const Triangle& triangle, std::int32_t tileX0, std::int32_t tileY0, std::int32_t tileX1, std::int32_t tileY1);
+
+    private:
+
+        const NullRasterizerContext*            context_            = nullptr;
+        NullRenderTarget*                       renderTarget_       = nullptr;
+        std::int32_t                            width_              = 0;
+        std::int32_t                            height_             = 0;
+        std::int32_t                            depthRowStride_     = 0;
+
+        std::vector<ColorTarget>                colorTargets_;
+        DepthTarget                             depthTarget_;
+
+        Viewport                                viewport_;
+        Scissor                                 scissor_;
+        bool                                    hasViewport_        = false;
+        bool                                    hasScissor_         = false;
+
+        std::vector<Triangle>                   triangles_;
+        std::vector<RasterState>                rasterStates_;
+        std::uint32_t                           numTilesX_          = 0;
+        std::uint32_t                           numTilesY_          = 0;
+        std::vector<std::vector<std::uint32_t>> tileBins_;
+        std::vector<std::uint32_t>              binnedTiles_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,472 @@
+/*
+ * NullVertexProcessor.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullVertexProcessor.h"
+#include "NullRasterizer.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Shader/NullShader.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullResourceHeap.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/Misc/ForRange.h>
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Alignment (in bytes) of each attribute stream within the fetch buffer.
+static const std::size_t g_fetchStreamAlignment = 16;
+
+// Returns the number of vertices that are assembled for the specified topology when strips are expanded into lists.
+static std::uint32_t GetNumListVertices(const PrimitiveTopology topology, std::uint32_t numVertices)
+{
+    switch (topology)
+    {
+        case PrimitiveTopology::LineList:       return numVertices - numVertices % 2;
+        case PrimitiveTopology::LineStrip:      return (numVertices >= 2 ? (numVertices - 1) * 2 : 0);
+        case PrimitiveTopology::TriangleList:   return numVertices - numVertices % 3;
+        case PrimitiveTopology::TriangleStrip:  return (numVertices >= 3 ? (numVertices - 2) * 3 : 0);
+        default:                                return numVertices;
+    }
+}
+
+// Returns the number of vertices per primitive when strips are expanded into lists.
+static std::uint32_t GetListPrimitiveSize(const PrimitiveTopology topology)
+{
+    switch (topology)
+    {
+        case PrimitiveTopology::LineList:
+        case PrimitiveTopology::LineStrip:
+            return 2;
+        case PrimitiveTopology::TriangleList:
+        case PrimitiveTopology::TriangleStrip:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+// Returns the stride (in bytes) of the specified stream-output slot from the vertex shader output attributes, or 0 if the slot is not used.
+static std::uint32_t GetStreamOutputStride(const std::vector<VertexAttribute>& outputAttribs, std::uint32_t slot)
+{
+    std::uint32_t stride = 0;
+    for (const auto& attrib : outputAttribs)
+    {
+        if (attrib.slot == slot)
+        {
+            if (attrib.stride > 0)
+                return attrib.stride;
+            stride = std::max(stride, attrib.offset + attrib.GetSize());
+        }
+    }
+    return stride;
+}
+
+// Writes the position within the draw command for each assembled vertex, i.e. strips are expanded into lists of lines or triangles.
+static void AssembleVertexPositions(std::uint32_t* positions, const PrimitiveTopology stripTopology, std::uint32_t first, std::uint32_t count)
+{
+    switch (stripTopology)
+    {
+        case PrimitiveTopology::LineStrip:
+        {
+            for_range(i, count)
+            {
+                const std::uint32_t vertex = first + i;
+                positions[i] = vertex / 2 + vertex % 2;
+            }
+        }
+        break;
+
+        case PrimitiveTopology::TriangleStrip:
+        {
+            /* Odd triangles swap their first two vertices to preserve the winding order */
+            static const std::uint32_t cornerOffsets[2][3] = { { 0, 1, 2 }, { 1, 0, 2 } };
+            for_range(i, count)
+            {
+                const std::uint32_t vertex      = first + i;
+                const std::uint32_t primitive   = vertex / 3;
+                positions[i] = primitive + cornerOffsets[primitive % 2][vertex % 3];
+            }
+        }
+        break;
+
+        default:
+        {
+            for_range(i, count)
+                positions[i] = first + i;
+        }
+        break;
+    }
+}
+
+// Replaces the positions by the indices from the index buffer. Indices outside of the index buffer are fetched as zero.
+template <typename TIndex>
+static void FetchIndices(
+    std::uint32_t*  ids,
+    const char*     indexData,
+    std::uint64_t   numIndices,
+    std::uint32_t   firstIndex,
+    std::int32_t    vertexOffset,
+    std::uint32_t   count)
+{
+    for_range(i, count)
+    {
+        const std::uint64_t position = static_cast<std::uint64_t>(firstIndex) + ids[i];
+        TIndex index = 0;
+        if (position < numIndices)
+            ::memcpy(&index, indexData + position * sizeof(TIndex), sizeof(TIndex));
+        ids[i] = static_cast<std::uint32_t>(index) + static_cast<std::uint32_t>(vertexOffset);
+    }
+}
+
+// Gathers one attribute of all specified vertices into a tightly packed array. Attributes outside of the buffer are fetched as zeros.
+template <std::size_t ElementSize>
+static void FetchVertexAttribute(
+    char*                   dst,
+    const char*             src,
+    std::uint64_t           srcSize,
+    std::uint64_t           stride,
+    const std::uint32_t*    ids,
+    std::uint32_t           count)
+{
+    for_range(i, count)
+    {
+        const std::uint64_t offset = ids[i] * stride;
+        if (offset + ElementSize <= srcSize)
+            ::memcpy(dst, src + offset, ElementSize);
+        else
+            ::memset(dst, 0, ElementSize);
+        dst += ElementSize;
+    }
+}
+
+// Same as FetchVertexAttribute but for element sizes that are only known at runtime.
+static void FetchVertexAttributeGeneric(
+    char*                   dst,
+    const char*             src,
+    std::uint64_t           srcSize,
+    std::uint64_t           stride,
+    const std::uint32_t*    ids,
+    std::uint32_t           count,
+    std::size_t             elementSize)
+{
+    for_range(i, count)
+    {
+        const std::uint64_t offset = ids[i] * stride;
+        if (offset + elementSize <= srcSize)
+            ::memcpy(dst, src + offset, elementSize);
+        else
+            ::memset(dst, 0, elementSize);
+        dst += elementSize;
+    }
+}
+
+// Dispatches the attribute fetch with a fixed element size for the most common vertex formats, so the copies can be inlined.
+static void FetchVertexAttribute(
+    char*                   dst,
+    const char*             src,
+    std::uint64_t           srcSize,
+    std::uint64_t           stride,
+    const std::uint32_t*    ids,
+    std::uint32_t           count,
+    std::size_t             elementSize)
+{
+    switch (elementSize)
+    {
+        case  4: FetchVertexAttribute< 4>(dst, src, srcSize, stride, ids, count); break;
+        case  8: FetchVertexAttribute< 8>(dst, src, srcSize, stride, ids, count); break;
+        case 12: FetchVertexAttribute<12>(dst, src, srcSize, stride, ids, count); break;
+        case 16: FetchVertexAttribute<16>(dst, src, srcSize, stride, ids, count); break;
+        default: FetchVertexAttributeGeneric(dst, src, srcSize, stride, ids, count, elementSize); break;
+    }
+}
+
+void NullVertexProcessor::BeginStreamOutput(std::uint32_t numBuffers, NullBuffer* const * buffers)
+{
+    numOutputStreams_ = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+    for_range(i, numOutputStreams_)
+        outputStreams_[i] = OutputStream{ buffers[i], 0 };
+}
+
+void NullVertexProcessor::EndStreamOutput()
+{
+    numOutputStreams_ = 0;
+}
+
+void NullVertexProcessor::BindResourceHeap(
+    const NullResourceHeap& resourceHeap,
+    std::uint32_t           descriptorSet,
+    const std::uint32_t*    dynamicOffsets,
+    std::uint32_t           numDynamicOffsets)
+{
+    resourceHeap.GetConstantBuffers(descriptorSet, dynamicOffsets, numDynamicOffsets, constantBuffers_);
+}
+
+void NullVertexProcessor::WriteUniforms(std::uint32_t offset, const void* data, std::uint32_t dataSize)
+{
+    ::memcpy(uniforms_ + offset, data, dataSize);
+}
+
+void NullVertexProcessor::Draw(const NullDrawArguments& args, NullRasterizer* rasterizer)
+{
+    const NullPipelineState* pipelineState = args.pipelineState;
+    if (pipelineState == nullptr || !pipelineState->isGraphicsPSO || pipelineState->vertexProcessingConfig == nullptr)
+        return;
+
+    if (args.numVertices == 0 || args.numInstances == 0)
+        return;
+
+    const RendererConfigurationNull& config = *(pipelineState->vertexProcessingConfig);
+    const PrimitiveTopology topology = pipelineState->graphicsDesc.primitiveTopology;
+
+    /* Only triangles are rasterized, and each batch must contain whole triangles */
+    const bool rasterize = (rasterizer != nullptr && (topology == PrimitiveTopology::TriangleList || topology == PrimitiveTopology::TriangleStrip));
+
+    std::uint32_t batchSize = config.vertexBatchSize;
+    if (rasterize)
+        batchSize = std::max(3u, batchSize - batchSize % 3);
+
+    BuildInputStreams(args, batchSize);
+
+    /* Strip topologies are only expanded into lists if the vertices are written to stream-outputs or rasterized */
+    PrimitiveTopology   stripTopology           = PrimitiveTopology::PointList;
+    std::uint32_t       numAssembledVertices    = args.numVertices;
+    std::uint64_t       numOutputVertices       = 0;
+
+    if (numOutputStreams_ > 0 || rasterize)
+    {
+        stripTopology           = topology;
+        numAssembledVertices    = GetNumListVertices(topology, args.numVertices);
+    }
+
+    if (numOutputStreams_ > 0)
+    {
+        /* Only write whole primitives into the stream-output buffers */
+        const std::uint32_t primitiveSize = GetListPrimitiveSize(topology);
+        numOutputVertices = BuildOutputStreams(*pipelineState);
+        numOutputVertices -= numOutputVertices % primitiveSize;
+    }
+
+    if (rasterize)
+    {
+        positions_.resize(static_cast<std::size_t>(batchSize) * 4);
+        colors_.resize(static_cast<std::size_t>(batchSize) * 4);
+    }
+
+    NullVertexBatch batch;
+    {
+        batch.pipelineState     = pipelineState;
+        batch.vertexIDs         = vertexIDs_.data();
+        batch.inputs            = ArrayView<NullVertexInput>{ vertexInputs_.data(), vertexInputs_.size() };
+        batch.outputs           = ArrayView<NullVertexOutput>{ vertexOutputs_.data(), (numOutputStreams_ > 0 ? vertexOutputs_.size() : 0u) };
+        batch.constantBuffers   = ArrayView<NullConstantBuffer>{ constantBuffers_.data(), constantBuffers_.size() };
+        batch.uniforms          = uniforms_;
+        batch.positions         = (rasterize ? positions_.data() : nullptr);
+        batch.colors            = (rasterize ? colors_.data() : nullptr);
+    }
+
+    for_range(instance, args.numInstances)
+    {
+        for (std::uint32_t firstVertex = 0; firstVertex < numAssembledVertices;)
+        {
+            std::uint32_t numVertices = std::min(batchSize, numAssembledVertices - firstVertex);
+
+            /* Split batch at the end of the stream-output buffers, so the remaining vertices are processed without output */
+            const bool writeOutput = (numOutputVertices > 0);
+            if (writeOutput)
+                numVertices = static_cast<std::uint32_t>(std::min<std::uint64_t>(numVertices, numOutputVertices));
+
+            for_range(i, numOutputStreams_)
+            {
+                auto& output = vertexOutputs_[i];
+                if (writeOutput && output.stride > 0)
+                    output.data = outputStreams_[i].buffer->GetBytesAt(outputStreams_[i].writeOffset);
+                else
+                    output.data = nullptr;
+            }
+
+            FetchVertexIDs(args, stripTopology, firstVertex, numVertices);
+            FetchInputStreams(args, instance, numVertices);
+
+            if (rasterize)
+            {
+                std::fill(positions_.begin(), positions_.begin() + numVertices * 4, 0.0f);
+                std::fill(colors_.begin(), colors_.begin() + numVertices * 4, 1.0f);
+            }
+
+            batch.numVertices   = numVertices;
+            batch.instanceID    = instance;
+            config.vertexCallback(batch);
+
+            if (rasterize)
+                rasterizer->DrawTriangles(*pipelineState, numVertices, positions_.data(), colors_.data());
+
+            if (writeOutput)
+            {
+                for_range(i, numOutputStreams_)
+                    outputStreams_[i].writeOffset += static_cast<std::uint64_t>(numVertices) * vertexOutputs_[i].stride;
+                numOutputVertices -= numVertices;
+            }
+
+            firstVertex += numVertices;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullVertexProcessor::BuildInputStreams(const NullDrawArguments& args, std::uint32_t batchSize)
+{
+    inputStreams_.clear();
+    vertexInputs_.clear();
+
+    /* Each vertex attribute gets its own stream within the fetch buffer */
+    std::size_t fetchBufferSize = 0;
+
+    for_range(i, args.numVertexBuffers)
+    {
+        const NullBuffer* vertexBuffer = args.vertexBuffers[i];
+        for (const auto& attrib : vertexBuffer->desc.vertexAttribs)
+        {
+            InputStream stream;
+            {
+                stream.attribute    = &attrib;
+                stream.elementSize  = attrib.GetSize();
+                stream.fetchOffset  = fetchBufferSize;
+                if (attrib.offset < vertexBuffer->desc.size)
+                {
+                    stream.data     = vertexBuffer->GetBytesAt(attrib.offset);
+                    stream.dataSize = vertexBuffer->desc.size - attrib.offset;
+                }
+                else
+                {
+                    stream.data     = nullptr;
+                    stream.dataSize = 0;
+                }
+            }
+            inputStreams_.push_back(stream);
+            fetchBufferSize += GetAlignedSize<std::size_t>(static_cast<std::size_t>(stream.elementSize) * batchSize, g_fetchStreamAlignment);
+        }
+    }
+
+    if (fetchBuffer_.size() < fetchBufferSize)
+        fetchBuffer_.resize(fetchBufferSize);
+    if (vertexIDs_.size() < batchSize)
+        vertexIDs_.resize(batchSize);
+
+    for (const auto& stream : inputStreams_)
+    {
+        NullVertexInput input;
+        {
+            input.attribute = stream.attribute;
+            input.data      = fetchBuffer_.data() + stream.fetchOffset;
+        }
+        vertexInputs_.push_back(input);
+    }
+}
+
+std::uint64_t NullVertexProcessor::BuildOutputStreams(const NullPipelineState& pipelineState)
+{
+    vertexOutputs_.resize(numOutputStreams_);
+
+    /* Get output layout from the vertex shader */
+    const std::vector<VertexAttribute>* outputAttribs = nullptr;
+    if (auto vertexShader = pipelineState.graphicsDesc.vertexShader)
+        outputAttribs = &(LLGL_CAST(const NullShader*, vertexShader)->desc.vertex.outputAttribs);
+
+    /* Determine how many vertices fit into all stream-output buffers */
+    std::uint64_t numVertices = 0;
+    bool hasOutput = false;
+
+    for_range(i, numOutputStreams_)
+    {
+        const std::uint32_t stride = (outputAttribs != nullptr ? GetStreamOutputStride(*outputAttribs, i) : 0);
+        vertexOutputs_[i].stride = stride;
+
+        if (stride > 0)
+        {
+            const auto& output = outputStreams_[i];
+            const std::uint64_t bufferSize = output.buffer->desc.size;
+            const std::uint64_t capacity = (output.writeOffset < bufferSize ? (bufferSize - output.writeOffset) / stride : 0);
+            numVertices = (hasOutput ? std::min(numVertices, capacity) : capacity);
+            hasOutput = true;
+        }
+    }
+
+    return numVertices;
+}
+
+void NullVertexProcessor::FetchVertexIDs(
+    const NullDrawArguments&    args,
+    const PrimitiveTopology     stripTopology,
+    std::uint32_t               firstVertex,
+    std::uint32_t               numVertices)
+{
+    std::uint32_t* ids = vertexIDs_.data();
+
+    AssembleVertexPositions(ids, stripTopology, firstVertex, numVertices);
+
+    if (args.indexBuffer != nullptr)
+    {
+        /* Determine how many indices are available after the index buffer offset */
+        const std::uint64_t indexBufferSize = args.indexBuffer->desc.size;
+        const char*         indexData       = nullptr;
+        std::uint64_t       numIndices      = 0;
+
+        const std::uint32_t indexSize = GetFormatAttribs(args.indexFormat).bitSize / 8;
+        if (indexSize > 0 && args.indexOffset < indexBufferSize)
+        {
+            indexData   = args.indexBuffer->GetBytesAt(args.indexOffset);
+            numIndices  = (indexBufferSize - args.indexOffset) / indexSize;
+        }
+
+        if (indexSize == 2)
+            FetchIndices<std::uint16_t>(ids, indexData, numIndices, args.firstVertex, args.vertexOffset, numVertices);
+        else
+            FetchIndices<std::uint32_t>(ids, indexData, (indexSize == 4 ? numIndices : 0), args.firstVertex, args.vertexOffset, numVertices);
+    }
+    else
+    {
+        for_range(i, numVertices)
+            ids[i] += args.firstVertex;
+    }
+}
+
+void NullVertexProcessor::FetchInputStreams(const NullDrawArguments& args, std::uint32_t instance, std::uint32_t numVertices)
+{
+    for (const auto& stream : inputStreams_)
+    {
+        char* dst = fetchBuffer_.data() + stream.fetchOffset;
+        const std::uint32_t instanceDivisor = stream.attribute->instanceDivisor;
+        const std::uint64_t stride          = stream.attribute->stride;
+
+        if (instanceDivisor > 0)
+        {
+            /* Fetch per-instance attribute once and replicate it for all vertices of this batch */
+            const std::uint32_t id = args.firstInstance + instance / instanceDivisor;
+            FetchVertexAttribute(dst, stream.data, stream.dataSize, stride, &id, 1, stream.elementSize);
+            for (std::uint32_t i = 1; i < numVertices; ++i)
+                ::memcpy(dst + i * stream.elementSize, dst, stream.elementSize);
+        }
+        else
+            FetchVertexAttribute(dst, stream.data, stream.dataSize, stride, vertexIDs_.data(), numVertices, stream.elementSize);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
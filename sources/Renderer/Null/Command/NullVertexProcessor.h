@@ -0,0 +1,134 @@
+/*
+ * NullVertexProcessor.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_VERTEX_PROCESSOR_H
+#define LLGL_NULL_VERTEX_PROCESSOR_H
+
+
+#include <LLGL/RendererConfiguration.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/StaticLimits.h>
+#include <LLGL/Format.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class NullBuffer;
+class NullPipelineState;
+class NullResourceHeap;
+class NullRasterizer;
+
+// Arguments of a draw command that is processed by the CPU vertex processor.
+struct NullDrawArguments
+{
+    const NullPipelineState*    pipelineState       = nullptr;
+    const NullBuffer* const*    vertexBuffers       = nullptr;
+    std::size_t                 numVertexBuffers    = 0;
+    const NullBuffer*           indexBuffer         = nullptr; // Null for non-indexed draw commands
+    Format                      indexFormat         = Format::Undefined;
+    std::uint64_t               indexOffset         = 0;
+    std::uint32_t               numVertices         = 0;       // Number of indices for indexed draw commands
+    std::uint32_t               firstVertex         = 0;       // First index for indexed draw commands
+    std::int32_t                vertexOffset        = 0;
+    std::uint32_t               numInstances        = 0;
+    std::uint32_t               firstInstance       = 0;
+};
+
+/*
+CPU vertex processor of the Null command executor.
+Fetches the vertices of draw commands from the bound vertex and index buffers in batches, one attribute at a time,
+and passes them to the vertex callback of the renderer configuration. Stream-output vertices are written directly into the bound buffers.
+Triangles are passed on to the software rasterizer with the clip-space positions and colors that the callback has written.
+*/
+class NullVertexProcessor
+{
+
+    public:
+
+        // Size (in bytes) of the uniform storage. This matches the push constant range of the Vulkan backend.
+        static const std::uint32_t maxUniformSize = 128;
+
+    public:
+
+        // Binds the specified stream-output buffers and resets their write offsets.
+        void BeginStreamOutput(std::uint32_t numBuffers, NullBuffer* const * buffers);
+
+        // Unbinds all stream-output buffers.
+        void EndStreamOutput();
+
+        // Resolves the constant buffers of the specified resource heap that are passed to the vertex callback.
+        void BindResourceHeap(
+            const NullResourceHeap& resourceHeap,
+            std::uint32_t           descriptorSet,
+            const std::uint32_t*    dynamicOffsets,
+            std::uint32_t           numDynamicOffsets
+        );
+
+        // Writes the specified uniform data at the specified byte offset into the uniform storage. The range must not exceed 'maxUniformSize'.
+        void WriteUniforms(std::uint32_t offset, const void* data, std::uint32_t dataSize);
+
+        // Processes the vertices of the specified draw command. This has no effect if the PSO has no vertex callback.
+        void Draw(const NullDrawArguments& args, NullRasterizer* rasterizer = nullptr);
+
+    private:
+
+        // Vertex attribute that is fetched from a bound vertex buffer.
+        struct InputStream
+        {
+            const VertexAttribute*  attribute;
+            const char*             data;           // Buffer storage at the attribute offset
+            std::uint64_t           dataSize;       // Remaining buffer size after the attribute offset
+            std::uint32_t           elementSize;
+            std::size_t             fetchOffset;    // Byte offset into the fetch buffer
+        };
+
+        // Stream-output buffer with its current write offset.
+        struct OutputStream
+        {
+            NullBuffer*             buffer;
+            std::uint64_t           writeOffset;
+        };
+
+    private:
+
+        void BuildInputStreams(const NullDrawArguments& args, std::uint32_t batchSize);
+        std::uint64_t BuildOutputStreams(const NullPipelineState& pipelineState);
+
+        void FetchVertexIDs(const NullDrawArguments& args, const PrimitiveTopology stripTopology, std::uint32_t firstVertex, std::uint32_t numVertices);
+        void FetchInputStreams(const NullDrawArguments& args, std::uint32_t instance, std::uint32_t numVertices);
+
+    private:
+
+        std::vector<InputStream>        inputStreams_;
+        std::vector<NullVertexInput>    vertexInputs_;
+        std::vector<NullVertexOutput>   vertexOutputs_;
+        std::vector<std::uint32_t>      vertexIDs_;
+        std::vector<char>               fetchBuffer_;
+        std::vector<float>              positions_;
+        std::vector<float>              colors_;
+        std::vector<NullConstantBuffer> constantBuffers_;
+        char                            uniforms_[maxUniformSize]   = {};
+
+        OutputStream                    outputStreams_[LLGL_MAX_NUM_SO_BUFFERS];
+        std::uint32_t                   numOutputStreams_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
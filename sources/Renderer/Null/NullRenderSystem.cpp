@@ -6,6 +6,7 @@
  */
 
 #include "NullRenderSystem.h"
+#include "../RenderSystemUtils.h"
 #include "../../Core/Helper.h"
 #include <LLGL/Misc/ForRange.h>
 #include <limits.h>
@@ -66,6 +67,7 @@ static void InitNullRendererFeatures(RenderingFeatures& features)
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = true;
     features.hasRenderCondition             = true;
+    features.hasDynamicBufferOffsets        = true;
 }
 
 static void InitNullRendererLimits(RenderingLimits& limits)
@@ -96,13 +98,17 @@ static void InitNullRendererLimits(RenderingLimits& limits)
     limits.minStorageBufferAlignment        = 1;
 }
 
-static RenderingCapabilities GetNullRenderingCaps()
+static RenderingCapabilities GetNullRenderingCaps(const RendererConfigurationNull& config)
 {
     RenderingCapabilities caps;
     InitNullRendererShadingLanguages(caps.shadingLanguages);
     InitNullRendererTextureFormats(caps.textureFormats);
     InitNullRendererFeatures(caps.features);
     InitNullRendererLimits(caps.limits);
+
+    /* Stream-outputs can only be written if the vertices are processed by a vertex callback */
+    caps.features.hasStreamOutputs = static_cast<bool>(config.vertexCallback);
+
     return caps;
 }
 
@@ -116,12 +122,32 @@ static RendererInfo GetNullRenderInfo()
     return info;
 }
 
+static RendererConfigurationNull GetNullConfigFromDesc(const RenderSystemDescriptor& renderSystemDesc)
+{
+    if (auto rendererConfigNull = GetRendererConfiguration<RendererConfigurationNull>(renderSystemDesc))
+    {
+        if (rendererConfigNull->vertexBatchSize == 0)
+            throw std::invalid_argument("vertex batch size for Null renderer must not be zero");
+        return *rendererConfigNull;
+    }
+    return RendererConfigurationNull{};
+}
+
 NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    desc_         { renderSystemDesc               },
-    commandQueue_ { MakeUnique<NullCommandQueue>() }
+    desc_         { renderSystemDesc                        },
+    config_       { GetNullConfigFromDesc(renderSystemDesc) },
+    commandQueue_ { MakeUnique<NullCommandQueue>()          }
 {
+    if (config_.softwareRasterizer)
+        rasterizerContext_ = MakeUnique<NullRasterizerContext>(config_.rasterizerThreads);
     SetRendererInfo(GetNullRenderInfo());
-    SetRenderingCaps(GetNullRenderingCaps());
+    SetRenderingCaps(GetNullRenderingCaps(config_));
+}
+
+NullRenderSystem::~NullRenderSystem()
+{
+    /* Finish all pending submissions before any resources are released */
+    commandQueue_->WaitIdle();
 }
 
 /* ----- Swap-chain ----- */
@@ -133,6 +159,7 @@ SwapChain* NullRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChai
 
 void NullRenderSystem::Release(SwapChain& swapChain)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(swapChains_, &swapChain);
 }
 
@@ -147,11 +174,12 @@ CommandQueue* NullRenderSystem::GetCommandQueue()
 
 CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(commandBufferDesc));
+    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(commandBufferDesc, *commandQueue_, rasterizerContext_.get()));
 }
 
 void NullRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
 }
 
@@ -172,34 +200,40 @@ BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffe
 
 void NullRenderSystem::Release(Buffer& buffer)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
 void NullRenderSystem::Release(BufferArray& bufferArray)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(bufferArrays_, &bufferArray);
 }
 
 void NullRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Write(offset, data, dataSize);
 }
 
 void NullRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Read(offset, data, dataSize);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, 0, bufferNull.desc.size);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, offset, length);
 }
@@ -219,17 +253,20 @@ Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, c
 
 void NullRenderSystem::Release(Texture& texture)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(textures_, &texture);
 }
 
 void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Write(textureRegion, imageDesc);
 }
 
 void NullRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Read(textureRegion, imageDesc);
 }
@@ -243,6 +280,7 @@ Sampler* NullRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 
 void NullRenderSystem::Release(Sampler& sampler)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(samplers_, &sampler);
 }
 
@@ -255,9 +293,17 @@ ResourceHeap* NullRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
 
 void NullRenderSystem::Release(ResourceHeap& resourceHeap)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t NullRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    commandQueue_->WaitIdle();
+    auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
+    return resourceHeapNull.WriteResourceViews(firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
@@ -267,6 +313,7 @@ RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& rende
 
 void NullRenderSystem::Release(RenderPass& renderPass)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(renderPasses_, &renderPass);
 }
 
@@ -274,11 +321,12 @@ void NullRenderSystem::Release(RenderPass& renderPass)
 
 RenderTarget* NullRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc)
 {
-    return TakeOwnership(renderTargets_, MakeUnique<NullRenderTarget>(renderTargetDesc));
+    return TakeOwnership(renderTargets_, MakeUnique<NullRenderTarget>(renderTargetDesc, rasterizerContext_.get()));
 }
 
 void NullRenderSystem::Release(RenderTarget& renderTarget)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
@@ -291,6 +339,7 @@ Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 
 void NullRenderSystem::Release(Shader& shader)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(shaders_, &shader);
 }
 
@@ -303,6 +352,7 @@ PipelineLayout* NullRenderSystem::CreatePipelineLayout(const PipelineLayoutDescr
 
 void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
 }
 
@@ -315,7 +365,9 @@ PipelineState* NullRenderSystem::CreatePipelineState(const Blob& serializedCache
 
 PipelineState* NullRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<NullPipelineState>(pipelineStateDesc));
+    /* Only pass the renderer configuration to the PSO if its vertices are processed on the CPU */
+    const RendererConfigurationNull* vertexProcessingConfig = (config_.vertexCallback ? &config_ : nullptr);
+    return TakeOwnership(pipelineStates_, MakeUnique<NullPipelineState>(pipelineStateDesc, vertexProcessingConfig));
 }
 
 PipelineState* NullRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
@@ -325,6 +377,7 @@ PipelineState* NullRenderSystem::CreatePipelineState(const ComputePipelineDescri
 
 void NullRenderSystem::Release(PipelineState& pipelineState)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(pipelineStates_, &pipelineState);
 }
 
@@ -337,6 +390,7 @@ QueryHeap* NullRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHea
 
 void NullRenderSystem::Release(QueryHeap& queryHeap)
 {
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(queryHeaps_, &queryHeap);
 }
 
@@ -349,6 +403,8 @@ Fence* NullRenderSystem::CreateFence()
 
 void NullRenderSystem::Release(Fence& fence)
 {
+    /* Fence might still be referenced by a pending submission */
+    commandQueue_->WaitIdle();
     RemoveFromUniqueSet(fences_, &fence);
 }
 
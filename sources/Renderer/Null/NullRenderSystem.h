@@ -10,9 +10,11 @@
 
 
 #include <LLGL/RenderSystem.h>
+#include <LLGL/RendererConfiguration.h>
 #include "NullSwapChain.h"
 #include "Command/NullCommandBuffer.h"
 #include "Command/NullCommandQueue.h"
+#include "Command/NullRasterizer.h"
 #include "Buffer/NullBuffer.h"
 #include "Buffer/NullBufferArray.h"
 #include "RenderState/NullFence.h"
@@ -39,6 +41,7 @@ class NullRenderSystem final : public RenderSystem
     public:
 
         NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
+        ~NullRenderSystem();
 
         /* ----- Swap-chain ------ */
 
@@ -92,6 +95,8 @@ class NullRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
@@ -141,6 +146,8 @@ class NullRenderSystem final : public RenderSystem
         /* ----- Common objects ----- */
 
         const RenderSystemDescriptor            desc_;
+        const RendererConfigurationNull         config_;
+        std::unique_ptr<NullRasterizerContext>  rasterizerContext_; // Null if the software rasterizer is disabled
 
         /* ----- Hardware object containers ----- */
 
@@ -22,19 +22,41 @@ void NullFence::SetName(const char* name)
         label_.clear();
 }
 
+std::uint64_t NullFence::NextSignal()
+{
+    return ++submittedSignal_;
+}
+
 void NullFence::Signal(std::uint64_t signal)
 {
-    signal_ = signal;
+    signal_.store(signal, std::memory_order_release);
 }
 
-void NullFence::WaitForSignal(std::uint64_t signal)
+bool NullFence::Wait(std::uint64_t timeout)
 {
-    while (signal_ != signal)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const std::uint64_t signal = submittedSignal_;
+
+    if (signal_.load(std::memory_order_acquire) >= signal)
+        return true;
+
+    /* Yield until the executor thread has reached the signal value; very large timeouts wait indefinitely */
+    const std::uint64_t maxTimeout = (std::uint64_t(1) << 62);
+    const bool hasDeadline = (timeout < maxTimeout);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(hasDeadline ? timeout : 0);
+
+    while (signal_.load(std::memory_order_acquire) < signal)
+    {
+        if (hasDeadline && std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::yield();
+    }
+
+    return true;
 }
 
 NullFence::NullFence(std::uint64_t initialSignal) :
-    signal_ { initialSignal }
+    submittedSignal_ { initialSignal },
+    signal_          { initialSignal }
 {
 }
 
@@ -28,14 +28,20 @@ class NullFence final : public Fence
     public:
     
         NullFence(std::uint64_t initialSignal = 0);
-    
+
+        // Returns the signal value for the next submission of this fence. Must only be called by the submitting thread.
+        std::uint64_t NextSignal();
+
+        // Signals this fence with the specified value. This is called by the executor thread of the command queue.
         void Signal(std::uint64_t signal);
 
-        void WaitForSignal(std::uint64_t signal);
+        // Waits until the last submitted signal value has been reached. Returns false if the timeout (in nanoseconds) has expired.
+        bool Wait(std::uint64_t timeout);
 
     private:
 
         std::string             label_;
+        std::uint64_t           submittedSignal_    = 0;
         std::atomic_uint64_t    signal_;
 
 };
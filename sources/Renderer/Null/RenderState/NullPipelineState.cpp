@@ -11,9 +11,10 @@ namespace LLGL
 {
 
 
-NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc) :
-    isGraphicsPSO { true },
-    graphicsDesc  { desc }
+NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc, const RendererConfigurationNull* vertexProcessingConfig) :
+    isGraphicsPSO          { true                   },
+    vertexProcessingConfig { vertexProcessingConfig },
+    graphicsDesc           { desc                   }
 {
 }
 
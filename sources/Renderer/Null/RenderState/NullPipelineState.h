@@ -11,6 +11,7 @@
 
 #include <LLGL/PipelineState.h>
 #include <LLGL/PipelineStateFlags.h>
+#include <LLGL/RendererConfiguration.h>
 #include <string>
 
 
@@ -28,13 +29,16 @@ class NullPipelineState final : public PipelineState
 
     public:
 
-        NullPipelineState(const GraphicsPipelineDescriptor& desc);
+        NullPipelineState(const GraphicsPipelineDescriptor& desc, const RendererConfigurationNull* vertexProcessingConfig = nullptr);
         NullPipelineState(const ComputePipelineDescriptor& desc);
         ~NullPipelineState();
 
     public:
 
-        const bool isGraphicsPSO;
+        const bool                          isGraphicsPSO;
+
+        // Renderer configuration with the vertex callback, or null if the vertices of this PSO are not processed on the CPU.
+        const RendererConfigurationNull*    vertexProcessingConfig  = nullptr;
 
         union
         {
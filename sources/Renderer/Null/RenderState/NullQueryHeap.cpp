@@ -6,6 +6,7 @@
  */
 
 #include "NullQueryHeap.h"
+#include <LLGL/Timer.h>
 
 
 namespace LLGL
@@ -13,8 +14,9 @@ namespace LLGL
 
 
 NullQueryHeap::NullQueryHeap(const QueryHeapDescriptor& desc) :
-    QueryHeap { desc.type },
-    desc      { desc      }
+    QueryHeap { desc.type                  },
+    desc      { desc                       },
+    queries_  { new Query[desc.numQueries] }
 {
 }
 
@@ -26,6 +28,87 @@ void NullQueryHeap::SetName(const char* name)
         label_.clear();
 }
 
+void NullQueryHeap::ResetQuery(std::uint32_t query)
+{
+    queries_[query].available.store(false, std::memory_order_relaxed);
+}
+
+void NullQueryHeap::BeginQuery(std::uint32_t query)
+{
+    auto& q = queries_[query];
+    q.available.store(false, std::memory_order_relaxed);
+    q.result        = 0;
+    q.statistics    = QueryPipelineStatistics{};
+    q.startTick     = Timer::Tick();
+}
+
+// Converts the specified number of timer ticks into nanoseconds.
+static std::uint64_t TicksToNanoseconds(std::uint64_t ticks)
+{
+    const std::uint64_t frequency = Timer::Frequency();
+    const std::uint64_t nanosecondsPerSecond = 1000000000ull;
+    if (frequency == nanosecondsPerSecond)
+        return ticks;
+    else
+        return static_cast<std::uint64_t>(static_cast<double>(ticks) * (static_cast<double>(nanosecondsPerSecond) / static_cast<double>(frequency)));
+}
+
+void NullQueryHeap::EndQuery(std::uint32_t query)
+{
+    auto& q = queries_[query];
+    if (IsTimerQuery())
+        q.result = TicksToNanoseconds(Timer::Tick() - q.startTick);
+    q.available.store(true, std::memory_order_release);
+}
+
+void NullQueryHeap::AccumulateStatistics(std::uint32_t query, const QueryPipelineStatistics& statistics)
+{
+    auto& dst = queries_[query].statistics;
+    dst.inputAssemblyVertices           += statistics.inputAssemblyVertices;
+    dst.inputAssemblyPrimitives         += statistics.inputAssemblyPrimitives;
+    dst.vertexShaderInvocations         += statistics.vertexShaderInvocations;
+    dst.geometryShaderInvocations       += statistics.geometryShaderInvocations;
+    dst.geometryShaderPrimitives        += statistics.geometryShaderPrimitives;
+    dst.clippingInvocations             += statistics.clippingInvocations;
+    dst.clippingPrimitives              += statistics.clippingPrimitives;
+    dst.fragmentShaderInvocations       += statistics.fragmentShaderInvocations;
+    dst.tessControlShaderInvocations    += statistics.tessControlShaderInvocations;
+    dst.tessEvaluationShaderInvocations += statistics.tessEvaluationShaderInvocations;
+    dst.computeShaderInvocations        += statistics.computeShaderInvocations;
+}
+
+bool NullQueryHeap::AreResultsAvailable(std::uint32_t firstQuery, std::uint32_t numQueries) const
+{
+    if (firstQuery + numQueries > desc.numQueries)
+        return false;
+    for (std::uint32_t i = firstQuery; i < firstQuery + numQueries; ++i)
+    {
+        if (!queries_[i].available.load(std::memory_order_acquire))
+            return false;
+    }
+    return true;
+}
+
+std::uint64_t NullQueryHeap::GetResult(std::uint32_t query) const
+{
+    return queries_[query].result;
+}
+
+const QueryPipelineStatistics& NullQueryHeap::GetStatistics(std::uint32_t query) const
+{
+    return queries_[query].statistics;
+}
+
+bool NullQueryHeap::IsTimerQuery() const
+{
+    return (desc.type == QueryType::TimeElapsed);
+}
+
+bool NullQueryHeap::IsStatisticsQuery() const
+{
+    return (desc.type == QueryType::PipelineStatistics);
+}
+
 
 } // /namespace LLGL
 
@@ -10,14 +10,23 @@
 
 
 #include <LLGL/QueryHeap.h>
-#include <vector>
+#include <LLGL/QueryHeapFlags.h>
+#include <memory>
+#include <atomic>
 #include <string>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+/*
+Query heap that is evaluated by the CPU executor of the Null command queue.
+Time elapsed queries measure the CPU execution time between the begin and end query commands with Timer::Tick.
+Pipeline statistics are accumulated from the draw commands that are executed while the query is active.
+Occlusion and stream-output queries always report zero, since the Null backend does not rasterize any primitives.
+*/
 class NullQueryHeap final : public QueryHeap
 {
 
@@ -29,13 +38,51 @@ class NullQueryHeap final : public QueryHeap
 
         NullQueryHeap(const QueryHeapDescriptor& desc);
 
+        // Invalidates the result of the specified query. This is called when a command buffer that begins this query is submitted.
+        void ResetQuery(std::uint32_t query);
+
+        // Starts the specified query. This is called by the executor thread.
+        void BeginQuery(std::uint32_t query);
+
+        // Ends the specified query and makes its result available. This is called by the executor thread.
+        void EndQuery(std::uint32_t query);
+
+        // Adds the specified pipeline statistics to the active query.
+        void AccumulateStatistics(std::uint32_t query, const QueryPipelineStatistics& statistics);
+
+        // Returns true if the results of all queries in the specified range are available.
+        bool AreResultsAvailable(std::uint32_t firstQuery, std::uint32_t numQueries) const;
+
+        // Returns the result of the specified query, i.e. the elapsed time in nanoseconds for time elapsed queries.
+        std::uint64_t GetResult(std::uint32_t query) const;
+
+        // Returns the pipeline statistics of the specified query.
+        const QueryPipelineStatistics& GetStatistics(std::uint32_t query) const;
+
+        // Returns true if this query heap measures time on the CPU.
+        bool IsTimerQuery() const;
+
+        // Returns true if this query heap accumulates pipeline statistics.
+        bool IsStatisticsQuery() const;
+
     public:
 
         const QueryHeapDescriptor desc;
 
     private:
 
-        std::string label_;
+        struct Query
+        {
+            std::uint64_t               startTick   = 0;
+            std::uint64_t               result      = 0;
+            QueryPipelineStatistics     statistics;
+            std::atomic_bool            available   { false };
+        };
+
+    private:
+
+        std::string                 label_;
+        std::unique_ptr<Query[]>    queries_;
 
 };
 
@@ -7,7 +7,10 @@
 
 #include "NullResourceHeap.h"
 #include "NullPipelineLayout.h"
+#include "../Buffer/NullBuffer.h"
 #include "../../CheckedCast.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -39,6 +42,109 @@ std::uint32_t NullResourceHeap::GetNumDescriptorSets() const
     return static_cast<std::uint32_t>(desc.resourceViews.size() / numBindings_);
 }
 
+// Throws an exception if the specified resource does not match the resource type of a descriptor
+static void ValidateResourceType(const Resource& resource, const ResourceType type)
+{
+    if (resource.GetResourceType() != type)
+        throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
+}
+
+std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    const std::size_t numDescriptors = desc.resourceViews.size();
+    if (firstDescriptor >= numDescriptors)
+        return 0;
+
+    /* Overwrite all resource views within the range of this heap; null resources keep their previous descriptor */
+    const std::size_t numResourceViews = std::min(resourceViews.size(), numDescriptors - firstDescriptor);
+
+    /* Validate all resource types before any descriptor is modified */
+    auto pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, desc.pipelineLayout);
+    const auto& bindings = pipelineLayoutNull->desc.bindings;
+    if (!bindings.empty())
+    {
+        for (std::size_t i = 0; i < numResourceViews; ++i)
+        {
+            if (resourceViews[i].resource != nullptr)
+                ValidateResourceType(*resourceViews[i].resource, bindings[(firstDescriptor + i) % bindings.size()].type);
+        }
+    }
+
+    std::uint32_t numWritten = 0;
+    for (std::size_t i = 0; i < numResourceViews; ++i)
+    {
+        if (resourceViews[i].resource != nullptr)
+        {
+            desc.resourceViews[firstDescriptor + i] = resourceViews[i];
+            ++numWritten;
+        }
+    }
+
+    return numWritten;
+}
+
+void NullResourceHeap::GetConstantBuffers(
+    std::uint32_t                       descriptorSet,
+    const std::uint32_t*                dynamicOffsets,
+    std::uint32_t                       numDynamicOffsets,
+    std::vector<NullConstantBuffer>&    outConstantBuffers) const
+{
+    outConstantBuffers.clear();
+
+    if (desc.pipelineLayout == nullptr || descriptorSet >= GetNumDescriptorSets())
+        return;
+
+    auto pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, desc.pipelineLayout);
+    const auto& bindings = pipelineLayoutNull->desc.bindings;
+
+    std::uint32_t dynamicOffsetIndex = 0;
+
+    for (std::size_t i = 0; i < bindings.size(); ++i)
+    {
+        const auto& binding = bindings[i];
+
+        /* Consume one offset per dynamic binding, even if its descriptor is not a constant buffer */
+        std::uint64_t dynamicOffset = 0;
+        if (binding.dynamicOffset)
+        {
+            if (dynamicOffsetIndex < numDynamicOffsets)
+                dynamicOffset = dynamicOffsets[dynamicOffsetIndex];
+            ++dynamicOffsetIndex;
+        }
+
+        if (binding.type != ResourceType::Buffer || (binding.bindFlags & BindFlags::ConstantBuffer) == 0)
+            continue;
+
+        const auto& resourceView = desc.resourceViews[descriptorSet * numBindings_ + i];
+        if (resourceView.resource == nullptr)
+            continue;
+
+        /* Determine buffer range of the view and shift it by the dynamic offset */
+        auto bufferNull = LLGL_CAST(const NullBuffer*, resourceView.resource);
+        const std::uint64_t bufferSize = bufferNull->desc.size;
+
+        std::uint64_t offset    = dynamicOffset;
+        std::uint64_t size      = bufferSize;
+
+        if (resourceView.bufferView.size != Constants::wholeSize)
+        {
+            offset  += resourceView.bufferView.offset;
+            size    = resourceView.bufferView.size;
+        }
+
+        NullConstantBuffer constantBuffer;
+        {
+            constantBuffer.slot = binding.slot;
+            if (offset < bufferSize)
+            {
+                constantBuffer.data = bufferNull->GetBytesAt(offset);
+                constantBuffer.size = std::min(size, bufferSize - offset);
+            }
+        }
+        outConstantBuffers.push_back(constantBuffer);
+    }
+}
+
 
 } // /namespace LLGL
 
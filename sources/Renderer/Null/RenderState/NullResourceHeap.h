@@ -11,7 +11,9 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/RendererConfiguration.h>
 #include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -31,9 +33,20 @@ class NullResourceHeap final : public ResourceHeap
 
         NullResourceHeap(const ResourceHeapDescriptor& desc);
 
+        // Overwrites the resource views starting at the specified descriptor and returns the number of written descriptors.
+        std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
+        // Resolves the constant buffer ranges of the specified descriptor set with one offset per dynamic binding.
+        void GetConstantBuffers(
+            std::uint32_t                       descriptorSet,
+            const std::uint32_t*                dynamicOffsets,
+            std::uint32_t                       numDynamicOffsets,
+            std::vector<NullConstantBuffer>&    outConstantBuffers
+        ) const;
+
     public:
 
-        const ResourceHeapDescriptor desc;
+        ResourceHeapDescriptor desc;
 
     private:
 
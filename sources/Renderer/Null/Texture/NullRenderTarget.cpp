@@ -15,8 +15,9 @@ namespace LLGL
 {
 
 
-NullRenderTarget::NullRenderTarget(const RenderTargetDescriptor& desc) :
-    desc { desc }
+NullRenderTarget::NullRenderTarget(const RenderTargetDescriptor& desc, const NullRasterizerContext* rasterizerContext) :
+    desc               { desc              },
+    rasterizerContext_ { rasterizerContext }
 {
     BuildAttachmentArray();
 }
@@ -56,7 +57,7 @@ bool NullRenderTarget::HasStencilAttachment() const
 
 const RenderPass* NullRenderTarget::GetRenderPass() const
 {
-    return nullptr; // TODO
+    return desc.renderPass;
 }
 
 
@@ -86,34 +87,46 @@ void NullRenderTarget::BuildAttachmentArray()
         if (attachment.type == AttachmentType::Color)
         {
             /* Cache color attachment */
+            NullRenderTargetAttachment colorAttachment;
             if (auto texture = attachment.texture)
             {
-                auto textureNull = LLGL_CAST(NullTexture*, texture);
-                colorAttachments_.push_back(textureNull);
+                colorAttachment.texture     = LLGL_CAST(NullTexture*, texture);
+                colorAttachment.mipLevel    = attachment.mipLevel;
+                colorAttachment.arrayLayer  = attachment.arrayLayer;
             }
             else
-                colorAttachments_.push_back(MakeIntermediateAttachment(attachment));
+                colorAttachment.texture = MakeIntermediateAttachment(attachment, Format::RGBA8UNorm);
+            colorAttachments_.push_back(colorAttachment);
         }
         else
         {
             /* Cache depth-stencil attachment */
             if (auto texture = attachment.texture)
             {
-                depthStencilAttachment_ = LLGL_CAST(NullTexture*, texture);
-                depthStencilFormat_     = depthStencilAttachment_->desc.format;
+                depthStencilAttachment_.texture     = LLGL_CAST(NullTexture*, texture);
+                depthStencilAttachment_.mipLevel    = attachment.mipLevel;
+                depthStencilAttachment_.arrayLayer  = attachment.arrayLayer;
+                depthStencilFormat_                 = depthStencilAttachment_.texture->desc.format;
             }
             else
+            {
                 depthStencilFormat_ = PickDepthStencilAttachmentFormat(attachment.type);
+
+                /* Depth buffer must persist between render passes if this render target is rasterized */
+                if (rasterizerContext_ != nullptr)
+                    depthStencilAttachment_.texture = MakeIntermediateAttachment(attachment, depthStencilFormat_);
+            }
         }
     }
 }
 
-NullTexture* NullRenderTarget::MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc)
+NullTexture* NullRenderTarget::MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc, const Format format)
 {
     TextureDescriptor textureDesc;
     {
         textureDesc.type            = (desc.samples > 1 ? TextureType::Texture2DMS : TextureType::Texture2D);
-        textureDesc.bindFlags       = BindFlags::ColorAttachment;
+        textureDesc.bindFlags       = (attachmentDesc.type == AttachmentType::Color ? BindFlags::ColorAttachment : BindFlags::DepthStencilAttachment);
+        textureDesc.format          = format;
         textureDesc.miscFlags       = MiscFlags::FixedSamples;
         textureDesc.extent.width    = desc.resolution.width;
         textureDesc.extent.height   = desc.resolution.height;
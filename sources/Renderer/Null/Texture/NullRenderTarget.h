@@ -19,6 +19,16 @@ namespace LLGL
 {
 
 
+struct NullRasterizerContext;
+
+// Texture subresource that is attached to a render target.
+struct NullRenderTargetAttachment
+{
+    NullTexture*    texture     = nullptr;
+    std::uint32_t   mipLevel    = 0;
+    std::uint32_t   arrayLayer  = 0;
+};
+
 class NullRenderTarget final : public RenderTarget
 {
 
@@ -37,7 +47,25 @@ class NullRenderTarget final : public RenderTarget
 
     public:
 
-        NullRenderTarget(const RenderTargetDescriptor& desc);
+        NullRenderTarget(const RenderTargetDescriptor& desc, const NullRasterizerContext* rasterizerContext = nullptr);
+
+        // Returns the color attachments including the intermediate ones.
+        inline const std::vector<NullRenderTargetAttachment>& GetColorAttachments() const
+        {
+            return colorAttachments_;
+        }
+
+        // Returns the depth-stencil attachment. Its texture is null if this render target has no depth-stencil attachment.
+        inline const NullRenderTargetAttachment& GetDepthStencilAttachment() const
+        {
+            return depthStencilAttachment_;
+        }
+
+        // Returns the context of the software rasterizer or null if this render target is not rasterized.
+        inline const NullRasterizerContext* GetRasterizerContext() const
+        {
+            return rasterizerContext_;
+        }
 
     public:
 
@@ -47,13 +75,14 @@ class NullRenderTarget final : public RenderTarget
 
         void BuildAttachmentArray();
 
-        NullTexture* MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc);
+        NullTexture* MakeIntermediateAttachment(const AttachmentDescriptor& attachmentDesc, const Format format);
 
     private:
 
         std::string                                 label_;
-        std::vector<NullTexture*>                   colorAttachments_;
-        NullTexture*                                depthStencilAttachment_     = nullptr;
+        const NullRasterizerContext*                rasterizerContext_          = nullptr;
+        std::vector<NullRenderTargetAttachment>     colorAttachments_;
+        NullRenderTargetAttachment                  depthStencilAttachment_;
         std::vector<std::unique_ptr<NullTexture>>   intermediateAttachments_;
         Format                                      depthStencilFormat_         = Format::Undefined;
 
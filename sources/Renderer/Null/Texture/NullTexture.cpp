@@ -6,6 +6,7 @@
  */
 
 #include "NullTexture.h"
+#include "../../TextureUtils.h"
 #include <LLGL/TextureFlags.h>
 #include <LLGL/Misc/ForRange.h>
 #include <algorithm>
@@ -30,7 +31,7 @@ NullTexture::NullTexture(const TextureDescriptor& desc, const SrcImageDescriptor
     AllocImages();
     if (imageDesc != nullptr)
     {
-        Write(TextureRegion{ Offset3D{}, extent_ }, *imageDesc);
+        Write(TextureRegion{ TextureSubresource{ 0, this->desc.arrayLayers, 0, 1 }, Offset3D{}, this->desc.extent }, *imageDesc);
         if ((desc.miscFlags & MiscFlags::GenerateMips) != 0)
             GenerateMips();
     }
@@ -66,12 +67,19 @@ std::uint32_t NullTexture::ClampMipLevel(std::uint32_t mipLevel) const
 
 void NullTexture::Write(const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    //todo
+    /* Array layers are stored along the Y-axis (1D arrays) or Z-axis (2D arrays) of each MIP-map image */
+    const auto mipLevel = ClampMipLevel(textureRegion.subresource.baseMipLevel);
+    const auto offset   = CalcTextureOffset(GetType(), textureRegion.offset, textureRegion.subresource.baseArrayLayer);
+    const auto extent   = CalcTextureExtent(GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers);
+    images_[mipLevel].WritePixels(offset, extent, imageDesc);
 }
 
 void NullTexture::Read(const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
-    //todo
+    const auto mipLevel = ClampMipLevel(textureRegion.subresource.baseMipLevel);
+    const auto offset   = CalcTextureOffset(GetType(), textureRegion.offset, textureRegion.subresource.baseArrayLayer);
+    const auto extent   = CalcTextureExtent(GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers);
+    images_[mipLevel].ReadPixels(offset, extent, imageDesc);
 }
 
 void NullTexture::GenerateMips(const TextureSubresource* subresource)
@@ -42,6 +42,12 @@ class NullTexture final : public Texture
         // Generates the MIP-map images for either the entire resource or a rubresource.
         void GenerateMips(const TextureSubresource* subresource = nullptr);
 
+        // Returns the image of the specified MIP-map level. Array layers are stored along the Y-axis (1D arrays) or Z-axis (2D arrays).
+        inline Image& GetMipImage(std::uint32_t mipLevel)
+        {
+            return images_[ClampMipLevel(mipLevel)];
+        }
+
         std::uint32_t PackSubresourceIndex(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
         void UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_t& outMipLevel, std::uint32_t& outArrayLayer) const;
 
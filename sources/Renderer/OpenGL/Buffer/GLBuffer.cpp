@@ -6,8 +6,10 @@
  */
 
 #include "GLBuffer.h"
+#include "GLStagingRing.h"
 #include "../GLProfile.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../GLTypes.h"
 #include "../Ext/GLExtensionRegistry.h"
@@ -63,11 +65,14 @@ GLBuffer::~GLBuffer()
 
 void GLBuffer::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     GLSetObjectLabel(GL_BUFFER, GetID(), name);
 }
 
 BufferDescriptor GLBuffer::GetDesc() const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(GetDesc());
+
     /* Get buffer parameters */
     GLint size = 0, usage = 0, storageFlags = 0;
     GetBufferParams(&size, &usage, &storageFlags);
@@ -127,6 +132,10 @@ void GLBuffer::BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags
 
 void GLBuffer::BufferSubData(GLintptr offset, GLsizeiptr size, const void* data)
 {
+    /* Stream data through staging ring to avoid implicit synchronization of glBufferSubData */
+    if (GLStagingRing::Get().WriteBuffer(*this, offset, size, data))
+        return;
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -182,6 +191,10 @@ void GLBuffer::ClearBufferData(std::uint32_t data)
 
         glGetBufferParameteriv(bufferTarget, GL_BUFFER_SIZE, &bufferSize);
 
+        /* Try to fill GPU buffer via staging ring first */
+        if (GLStagingRing::Get().FillBuffer(*this, 0, static_cast<GLsizeiptr>(bufferSize), data))
+            return;
+
         /* Allocate intermediate buffer to fill the GPU buffer with */
         std::vector<std::uint32_t> intermediateBuffer(static_cast<std::size_t>(bufferSize + 3) / 4, data);
 
@@ -210,6 +223,10 @@ void GLBuffer::ClearBufferSubData(GLintptr offset, GLsizeiptr size, std::uint32_
     else
     #endif // /GL_ARB_clear_buffer_object
     {
+        /* Try to fill GPU buffer via staging ring first */
+        if (GLStagingRing::Get().FillBuffer(*this, offset, size, data))
+            return;
+
         /* Emulate buffer fill operation */
         GLStateManager::Get().BindGLBuffer(*this);
 
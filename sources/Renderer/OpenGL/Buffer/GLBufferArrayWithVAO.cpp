@@ -8,6 +8,7 @@
 #include "GLBufferArrayWithVAO.h"
 #include "GLBufferWithVAO.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
@@ -37,6 +38,7 @@ GLBufferArrayWithVAO::GLBufferArrayWithVAO(std::uint32_t numBuffers, Buffer* con
 
 void GLBufferArrayWithVAO::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     #ifdef LLGL_GL_ENABLE_OPENGL2X
     if (HasNativeVAO())
     #endif
@@ -0,0 +1,263 @@
+/*
+ * GLStagingRing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStagingRing.h"
+#include "GLBuffer.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Size (in bytes) of each chunk in the staging ring
+static const GLsizeiptr g_stagingChunkSize      = 1024 * 1024;
+
+// Alignment (in bytes) of each range within the staging ring
+static const GLsizeiptr g_stagingRangeAlignment = 16;
+
+GLStagingRing::~GLStagingRing()
+{
+    Clear();
+}
+
+GLStagingRing& GLStagingRing::Get()
+{
+    static GLStagingRing instance;
+    return instance;
+}
+
+void GLStagingRing::Clear()
+{
+    if (buffer_ != 0)
+    {
+        if (isPersistent_)
+        {
+            GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+            glUnmapBuffer(GL_COPY_READ_BUFFER);
+        }
+        glDeleteBuffers(1, &buffer_);
+        GLStateManager::Get().NotifyBufferRelease(buffer_, GLBufferTarget::COPY_READ_BUFFER);
+    }
+
+    buffer_         = 0;
+    isAvailable_    = true;
+    isPersistent_   = false;
+    mappedData_     = nullptr;
+    chunkSize_      = 0;
+    chunkOffset_    = 0;
+    chunkIndex_     = 0;
+    chunks_.reset();
+}
+
+bool GLStagingRing::WriteBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data)
+{
+    if (size <= 0 || !CreateStagingBuffer())
+        return false;
+
+    GLintptr offset = 0;
+    if (auto dst = AllocRange(size, offset))
+    {
+        ::memcpy(dst, data, static_cast<std::size_t>(size));
+        CopyRange(dstBuffer, dstOffset, offset, size);
+        return true;
+    }
+
+    return false;
+}
+
+bool GLStagingRing::FillBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, std::uint32_t value)
+{
+    if (size <= 0 || !CreateStagingBuffer())
+        return false;
+
+    GLintptr offset = 0;
+    if (auto dst = AllocRange(size, offset))
+    {
+        /* Fill range with 32-bit value; the last word might only be partially copied */
+        for (GLsizeiptr i = 0; i < size; i += sizeof(value))
+            ::memcpy(dst + i, &value, static_cast<std::size_t>(std::min<GLsizeiptr>(sizeof(value), size - i)));
+        CopyRange(dstBuffer, dstOffset, offset, size);
+        return true;
+    }
+
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool GLStagingRing::CreateStagingBuffer()
+{
+    if (buffer_ != 0)
+        return true;
+    if (!isAvailable_)
+        return false;
+
+    /* Staging ring requires GPU side buffer copies and either persistent mapping or unsynchronized mapping */
+    #ifdef GL_ARB_copy_buffer
+    const bool hasCopyBuffer = HasExtension(GLExt::ARB_copy_buffer);
+    #else
+    const bool hasCopyBuffer = false;
+    #endif
+
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_map_buffer_range
+    const bool hasPersistentMapping = (HasExtension(GLExt::ARB_buffer_storage) && HasExtension(GLExt::ARB_map_buffer_range));
+    #else
+    const bool hasPersistentMapping = false;
+    #endif
+
+    #ifdef GL_ARB_map_buffer_range
+    const bool hasMapBufferRange = HasExtension(GLExt::ARB_map_buffer_range);
+    #else
+    const bool hasMapBufferRange = false;
+    #endif
+
+    if (!hasCopyBuffer || !hasMapBufferRange)
+    {
+        isAvailable_ = false;
+        return false;
+    }
+
+    const GLsizeiptr ringSize = g_stagingChunkSize * numChunks;
+
+    glGenBuffers(1, &buffer_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_map_buffer_range
+    if (hasPersistentMapping)
+    {
+        /* Allocate immutable storage and map it persistently and coherently (GL 4.4+) */
+        const GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        glBufferStorage(GL_COPY_READ_BUFFER, ringSize, nullptr, flags);
+        mappedData_     = reinterpret_cast<char*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, ringSize, flags));
+        isPersistent_   = (mappedData_ != nullptr);
+    }
+    #endif // /GL_ARB_buffer_storage
+
+    if (!isPersistent_)
+    {
+        if (mappedData_ == nullptr && hasPersistentMapping)
+        {
+            /* Immutable storage cannot be re-specified, so generate a new buffer for the orphaning fallback */
+            glDeleteBuffers(1, &buffer_);
+            GLStateManager::Get().NotifyBufferRelease(buffer_, GLBufferTarget::COPY_READ_BUFFER);
+            glGenBuffers(1, &buffer_);
+            GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+        }
+
+        /* Allocate mutable storage that is orphaned every time the ring wraps around */
+        glBufferData(GL_COPY_READ_BUFFER, ringSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    chunkSize_  = g_stagingChunkSize;
+    chunks_     = MakeUniqueArray<Chunk>(numChunks);
+
+    return true;
+}
+
+static GLsizeiptr AlignStagingRangeSize(GLsizeiptr size)
+{
+    return ((size + g_stagingRangeAlignment - 1) / g_stagingRangeAlignment) * g_stagingRangeAlignment;
+}
+
+char* GLStagingRing::AllocRange(GLsizeiptr size, GLintptr& offset)
+{
+    /* Large ranges are not streamed through the ring */
+    if (size > chunkSize_)
+        return nullptr;
+
+    /* Move on to next chunk if the current one is exhausted */
+    if (chunkOffset_ + size > chunkSize_)
+        AdvanceChunk();
+
+    offset = static_cast<GLintptr>(chunkSize_ * chunkIndex_ + chunkOffset_);
+    chunkOffset_ += AlignStagingRangeSize(size);
+
+    if (isPersistent_)
+        return mappedData_ + offset;
+
+    #ifdef GL_ARB_map_buffer_range
+    /* Map range without synchronization, since the range has not been used since the buffer was orphaned */
+    GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+    return reinterpret_cast<char*>(
+        glMapBufferRange(GL_COPY_READ_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT)
+    );
+    #else
+    return nullptr;
+    #endif
+}
+
+void GLStagingRing::CopyRange(GLBuffer& dstBuffer, GLintptr dstOffset, GLintptr offset, GLsizeiptr size)
+{
+    #ifdef GL_ARB_copy_buffer
+
+    GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+
+    if (!isPersistent_)
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+    /* Copy staging range into destination buffer on the GPU */
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glCopyNamedBufferSubData(buffer_, dstBuffer.GetID(), offset, dstOffset, size);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    {
+        GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBuffer.GetID());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, dstOffset, size);
+    }
+
+    #endif // /GL_ARB_copy_buffer
+}
+
+void GLStagingRing::AdvanceChunk()
+{
+    if (isPersistent_)
+    {
+        /* Guard all copy commands from the current chunk with a fence */
+        auto& currentChunk = chunks_[chunkIndex_];
+        currentChunk.fence.Submit();
+        currentChunk.pending = true;
+
+        /* Wait until the GPU has finished reading the next chunk from the previous cycle */
+        chunkIndex_ = (chunkIndex_ + 1) % numChunks;
+        auto& nextChunk = chunks_[chunkIndex_];
+        if (nextChunk.pending)
+        {
+            nextChunk.fence.Wait(~0ull);
+            nextChunk.pending = false;
+        }
+    }
+    else
+    {
+        chunkIndex_ = (chunkIndex_ + 1) % numChunks;
+        if (chunkIndex_ == 0)
+        {
+            /* Orphan buffer storage when the ring wraps around, so the driver can allocate new memory without synchronization */
+            GLStateManager::Get().BindBuffer(GLBufferTarget::COPY_READ_BUFFER, buffer_);
+            glBufferData(GL_COPY_READ_BUFFER, chunkSize_ * numChunks, nullptr, GL_STREAM_DRAW);
+        }
+    }
+    chunkOffset_ = 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
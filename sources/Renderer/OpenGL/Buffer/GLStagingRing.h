@@ -0,0 +1,103 @@
+/*
+ * GLStagingRing.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STAGING_RING_H
+#define LLGL_GL_STAGING_RING_H
+
+
+#include "../OpenGL.h"
+#include "../RenderState/GLFence.h"
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+
+/*
+Ring allocator for streaming buffer updates; used by <GLBuffer> for glBufferSubData and emulated glClearBufferSubData.
+Data is written into a staging buffer and copied on the GPU with glCopyBufferSubData.
+With GL_ARB_buffer_storage, the staging buffer is persistently mapped and each chunk of the ring is guarded by a fence.
+Otherwise, the staging buffer is orphaned every time the ring wraps around.
+*/
+class GLStagingRing
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLStagingRing& Get();
+
+    public:
+
+        GLStagingRing(const GLStagingRing&) = delete;
+        GLStagingRing& operator = (const GLStagingRing&) = delete;
+
+        GLStagingRing(GLStagingRing&&) = delete;
+        GLStagingRing& operator = (GLStagingRing&&) = delete;
+
+        ~GLStagingRing();
+
+        // Releases all resources for this singleton class.
+        void Clear();
+
+        // Writes the specified data into the destination buffer. Returns false if the data cannot be streamed through the ring.
+        bool WriteBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data);
+
+        // Fills the destination buffer with the specified value. Returns false if the data cannot be streamed through the ring.
+        bool FillBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, std::uint32_t value);
+
+    private:
+
+        GLStagingRing() = default;
+
+        // Returns true if the staging buffer is available, i.e. GL_ARB_copy_buffer is supported.
+        bool CreateStagingBuffer();
+
+        // Allocates a range of the specified size and returns a pointer to its CPU memory. The offset is returned via 'offset'.
+        char* AllocRange(GLsizeiptr size, GLintptr& offset);
+
+        // Finishes writing to the specified range and copies it into the destination buffer.
+        void CopyRange(GLBuffer& dstBuffer, GLintptr dstOffset, GLintptr offset, GLsizeiptr size);
+
+        void AdvanceChunk();
+
+    private:
+
+        static const std::uint32_t numChunks = 4;
+
+        struct Chunk
+        {
+            GLFence fence;
+            bool    pending = false;
+        };
+
+    private:
+
+        GLuint                      buffer_         = 0;
+        bool                        isAvailable_    = true;
+        bool                        isPersistent_   = false;
+        char*                       mappedData_     = nullptr;
+        GLsizeiptr                  chunkSize_      = 0;
+        GLsizeiptr                  chunkOffset_    = 0;
+        std::uint32_t               chunkIndex_     = 0;
+        std::unique_ptr<Chunk[]>    chunks_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
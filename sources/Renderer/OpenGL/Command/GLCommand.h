@@ -220,6 +220,8 @@ struct GLCmdBindResourceHeap
 {
     GLResourceHeap* resourceHeap;
     std::uint32_t   firstSet;
+    std::uint32_t   numDynamicOffsets;
+//  std::uint32_t   dynamicOffsets[numDynamicOffsets];
 };
 
 struct GLCmdBindRenderTarget
@@ -381,6 +383,16 @@ struct GLCmdMultiDrawElementsIndirect
     GLsizei         stride;
 };
 
+struct GLCmdMultiDrawElementsBaseVertex
+{
+    GLenum          mode;
+    GLenum          type;
+    GLsizei         drawcount;
+//  const GLvoid*   indices[drawcount];
+//  GLsizei         count[drawcount];
+//  GLint           basevertex[drawcount];
+};
+
 struct GLCmdDispatchCompute
 {
     GLuint numgroups[3];
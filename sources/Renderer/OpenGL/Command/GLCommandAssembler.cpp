@@ -248,8 +248,8 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
-            compiler.CallMember(&GLResourceHeap::Bind, cmd->resourceHeap, g_stateMngrArg, cmd->firstSet);
-            return sizeof(*cmd);
+            compiler.CallMember(&GLResourceHeap::Bind, cmd->resourceHeap, g_stateMngrArg, cmd->firstSet, cmd->numDynamicOffsets, reinterpret_cast<const std::uint32_t*>(cmd + 1));
+            return (sizeof(*cmd) + sizeof(std::uint32_t)*cmd->numDynamicOffsets);
         }
         case GLOpcodeBindRenderTarget:
         {
@@ -404,6 +404,17 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_multi_draw_indirect
+        #ifdef GL_ARB_draw_elements_base_vertex
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            auto indices    = reinterpret_cast<const GLvoid* const*>(cmd + 1);
+            auto counts     = reinterpret_cast<const GLsizei*>(indices + cmd->drawcount);
+            auto basevertex = reinterpret_cast<const GLint*>(counts + cmd->drawcount);
+            compiler.Call(glMultiDrawElementsBaseVertex, cmd->mode, counts, cmd->type, indices, cmd->drawcount, basevertex);
+            return (sizeof(*cmd) + (sizeof(const GLvoid*) + sizeof(GLsizei) + sizeof(GLint)) * cmd->drawcount);
+        }
+        #endif // /GL_ARB_draw_elements_base_vertex
         #ifdef GL_ARB_compute_shader
         case GLOpcodeDispatchCompute:
         {
@@ -245,8 +245,8 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
-            cmd->resourceHeap->Bind(*stateMngr, cmd->firstSet);
-            return sizeof(*cmd);
+            cmd->resourceHeap->Bind(*stateMngr, cmd->firstSet, cmd->numDynamicOffsets, reinterpret_cast<const std::uint32_t*>(cmd + 1));
+            return (sizeof(*cmd) + sizeof(std::uint32_t)*cmd->numDynamicOffsets);
         }
         case GLOpcodeBindRenderTarget:
         {
@@ -409,6 +409,17 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return sizeof(*cmd);
         }
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+            auto indices    = reinterpret_cast<const GLvoid* const*>(cmd + 1);
+            auto counts     = reinterpret_cast<const GLsizei*>(indices + cmd->drawcount);
+            auto basevertex = reinterpret_cast<const GLint*>(counts + cmd->drawcount);
+            glMultiDrawElementsBaseVertex(cmd->mode, counts, cmd->type, indices, cmd->drawcount, basevertex);
+            #endif
+            return (sizeof(*cmd) + (sizeof(const GLvoid*) + sizeof(GLsizei) + sizeof(GLint)) * cmd->drawcount);
+        }
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
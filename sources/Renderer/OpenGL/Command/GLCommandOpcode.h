@@ -69,6 +69,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawElementsIndirect,
     GLOpcodeMultiDrawArraysIndirect,
     GLOpcodeMultiDrawElementsIndirect,
+    GLOpcodeMultiDrawElementsBaseVertex,
     GLOpcodeDispatchCompute,
     GLOpcodeDispatchComputeIndirect,
     GLOpcodeBindTexture,
@@ -0,0 +1,599 @@
+/*
+ * GLCommandOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommand.h"
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of the specified command including its payload, but excluding the opcode. Returns false for unknown opcodes.
+static bool GetGLCommandSize(const GLOpcode opcode, const char* pc, std::size_t& size)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
+            size = (sizeof(*cmd) + static_cast<std::size_t>(cmd->size));
+            return true;
+        }
+        case GLOpcodeCopyBufferSubData:                             size = sizeof(GLCmdCopyBufferSubData);                              return true;
+        case GLOpcodeClearBufferData:                               size = sizeof(GLCmdClearBufferData);                                return true;
+        case GLOpcodeClearBufferSubData:                            size = sizeof(GLCmdClearBufferSubData);                             return true;
+        case GLOpcodeCopyImageSubData:                              size = sizeof(GLCmdCopyImageSubData);                               return true;
+        case GLOpcodeCopyImageToBuffer:                             size = sizeof(GLCmdCopyImageBuffer);                                return true;
+        case GLOpcodeCopyImageFromBuffer:                           size = sizeof(GLCmdCopyImageBuffer);                                return true;
+        case GLOpcodeGenerateMipmap:                                size = sizeof(GLCmdGenerateMipmap);                                 return true;
+        case GLOpcodeGenerateMipmapSubresource:                     size = sizeof(GLCmdGenerateMipmapSubresource);                      return true;
+        case GLOpcodeExecute:                                       size = sizeof(GLCmdExecute);                                        return true;
+        case GLOpcodeViewport:                                      size = sizeof(GLCmdViewport);                                       return true;
+        case GLOpcodeViewportArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+            size = (sizeof(*cmd) + (sizeof(GLViewport) + sizeof(GLDepthRange))*cmd->count);
+            return true;
+        }
+        case GLOpcodeScissor:                                       size = sizeof(GLCmdScissor);                                        return true;
+        case GLOpcodeScissorArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+            size = (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+            return true;
+        }
+        case GLOpcodeClearColor:                                    size = sizeof(GLCmdClearColor);                                     return true;
+        case GLOpcodeClearDepth:                                    size = sizeof(GLCmdClearDepth);                                     return true;
+        case GLOpcodeClearStencil:                                  size = sizeof(GLCmdClearStencil);                                   return true;
+        case GLOpcodeClear:                                         size = sizeof(GLCmdClear);                                          return true;
+        case GLOpcodeClearAttachmentsWithRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
+            size = (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+            return true;
+        }
+        case GLOpcodeClearBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+            size = (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+            return true;
+        }
+        case GLOpcodeBindVertexArray:                               size = sizeof(GLCmdBindVertexArray);                                return true;
+        #ifdef LLGL_GL_ENABLE_OPENGL2X
+        case GLOpcodeBindGL2XVertexArray:                           size = sizeof(GLCmdBindGL2XVertexArray);                            return true;
+        #endif
+        case GLOpcodeBindElementArrayBufferToVAO:                   size = sizeof(GLCmdBindElementArrayBufferToVAO);                    return true;
+        case GLOpcodeBindBufferBase:                                size = sizeof(GLCmdBindBufferBase);                                 return true;
+        case GLOpcodeBindBuffersBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+            size = (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+            return true;
+        }
+        case GLOpcodeBeginTransformFeedback:                        size = sizeof(GLCmdBeginTransformFeedback);                         return true;
+        case GLOpcodeBeginTransformFeedbackNV:                      size = sizeof(GLCmdBeginTransformFeedbackNV);                       return true;
+        case GLOpcodeEndTransformFeedback:                          size = 0;                                                           return true;
+        case GLOpcodeEndTransformFeedbackNV:                        size = 0;                                                           return true;
+        case GLOpcodeBindResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
+            size = (sizeof(*cmd) + sizeof(std::uint32_t)*cmd->numDynamicOffsets);
+            return true;
+        }
+        case GLOpcodeBindRenderTarget:                              size = sizeof(GLCmdBindRenderTarget);                               return true;
+        case GLOpcodeBindPipelineState:                             size = sizeof(GLCmdBindPipelineState);                              return true;
+        case GLOpcodeSetBlendColor:                                 size = sizeof(GLCmdSetBlendColor);                                  return true;
+        case GLOpcodeSetStencilRef:                                 size = sizeof(GLCmdSetStencilRef);                                  return true;
+        case GLOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+            size = (sizeof(*cmd) + static_cast<std::size_t>(cmd->size));
+            return true;
+        }
+        case GLOpcodeBeginQuery:                                    size = sizeof(GLCmdBeginQuery);                                     return true;
+        case GLOpcodeEndQuery:                                      size = sizeof(GLCmdEndQuery);                                       return true;
+        case GLOpcodeBeginConditionalRender:                        size = sizeof(GLCmdBeginConditionalRender);                         return true;
+        case GLOpcodeEndConditionalRender:                          size = 0;                                                           return true;
+        case GLOpcodeDrawArrays:                                    size = sizeof(GLCmdDrawArrays);                                     return true;
+        case GLOpcodeDrawArraysInstanced:                           size = sizeof(GLCmdDrawArraysInstanced);                            return true;
+        case GLOpcodeDrawArraysInstancedBaseInstance:               size = sizeof(GLCmdDrawArraysInstancedBaseInstance);                return true;
+        case GLOpcodeDrawArraysIndirect:                            size = sizeof(GLCmdDrawArraysIndirect);                             return true;
+        case GLOpcodeDrawElements:                                  size = sizeof(GLCmdDrawElements);                                   return true;
+        case GLOpcodeDrawElementsBaseVertex:                        size = sizeof(GLCmdDrawElementsBaseVertex);                         return true;
+        case GLOpcodeDrawElementsInstanced:                         size = sizeof(GLCmdDrawElementsInstanced);                          return true;
+        case GLOpcodeDrawElementsInstancedBaseVertex:               size = sizeof(GLCmdDrawElementsInstancedBaseVertex);                return true;
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:   size = sizeof(GLCmdDrawElementsInstancedBaseVertexBaseInstance);    return true;
+        case GLOpcodeDrawElementsIndirect:                          size = sizeof(GLCmdDrawElementsIndirect);                           return true;
+        case GLOpcodeMultiDrawArraysIndirect:                       size = sizeof(GLCmdMultiDrawArraysIndirect);                        return true;
+        case GLOpcodeMultiDrawElementsIndirect:                     size = sizeof(GLCmdMultiDrawElementsIndirect);                      return true;
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            size = (sizeof(*cmd) + (sizeof(const GLvoid*) + sizeof(GLsizei) + sizeof(GLint)) * cmd->drawcount);
+            return true;
+        }
+        case GLOpcodeDispatchCompute:                               size = sizeof(GLCmdDispatchCompute);                                return true;
+        case GLOpcodeDispatchComputeIndirect:                       size = sizeof(GLCmdDispatchComputeIndirect);                        return true;
+        case GLOpcodeBindTexture:                                   size = sizeof(GLCmdBindTexture);                                    return true;
+        case GLOpcodeBindImageTexture:                              size = sizeof(GLCmdBindImageTexture);                               return true;
+        case GLOpcodeBindSampler:                                   size = sizeof(GLCmdBindSampler);                                    return true;
+        #ifdef LLGL_GL_ENABLE_OPENGL2X
+        case GLOpcodeBindGL2XSampler:                               size = sizeof(GLCmdBindGL2XSampler);                                return true;
+        #endif
+        case GLOpcodeUnbindResources:                               size = sizeof(GLCmdUnbindResources);                                return true;
+        case GLOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            size = (sizeof(*cmd) + cmd->length + 1);
+            return true;
+        }
+        case GLOpcodePopDebugGroup:                                 size = 0;                                                           return true;
+        default:                                                                                                                        return false;
+    }
+}
+
+// Categories of states that are tracked by the optimizer.
+enum class GLOptimizerState
+{
+    PipelineState,
+    Viewport,
+    Scissor,
+    VertexArray,
+    ElementArrayBuffer,
+    ResourceHeap,
+    BlendColor,
+    StencilRef,
+    Num,
+};
+
+// Returns true if the specified opcode binds one of the tracked states.
+static bool GetGLOptimizerState(const GLOpcode opcode, GLOptimizerState& state)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBindPipelineState:             state = GLOptimizerState::PipelineState;        return true;
+        case GLOpcodeViewport:                      state = GLOptimizerState::Viewport;             return true;
+        case GLOpcodeScissor:                       state = GLOptimizerState::Scissor;              return true;
+        case GLOpcodeBindVertexArray:               state = GLOptimizerState::VertexArray;          return true;
+        case GLOpcodeBindElementArrayBufferToVAO:   state = GLOptimizerState::ElementArrayBuffer;   return true;
+        case GLOpcodeBindResourceHeap:              state = GLOptimizerState::ResourceHeap;         return true;
+        case GLOpcodeSetBlendColor:                 state = GLOptimizerState::BlendColor;           return true;
+        case GLOpcodeSetStencilRef:                 state = GLOptimizerState::StencilRef;           return true;
+        default:                                                                                    return false;
+    }
+}
+
+/*
+Returns true if a pending command of the specified state can be removed when it is overridden before it is consumed.
+Resource heaps and pipeline states cannot be removed this way, since the next command might only override a subset of their states.
+*/
+static bool IsGLOptimizerStateOverridable(const GLOptimizerState state)
+{
+    switch (state)
+    {
+        case GLOptimizerState::Viewport:
+        case GLOptimizerState::Scissor:
+        case GLOptimizerState::VertexArray:
+        case GLOptimizerState::ElementArrayBuffer:
+        case GLOptimizerState::BlendColor:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified command only reads the currently bound states, i.e. it does not invalidate any of them.
+static bool IsGLStateConsumerCommand(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        case GLOpcodeClearStencil:
+        case GLOpcodeBeginTransformFeedback:
+        case GLOpcodeBeginTransformFeedbackNV:
+        case GLOpcodeEndTransformFeedback:
+        case GLOpcodeEndTransformFeedbackNV:
+        case GLOpcodeSetUniforms:
+        case GLOpcodeBeginQuery:
+        case GLOpcodeEndQuery:
+        case GLOpcodeBeginConditionalRender:
+        case GLOpcodeEndConditionalRender:
+        case GLOpcodeDrawArrays:
+        case GLOpcodeDrawArraysInstanced:
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        case GLOpcodeDrawElements:
+        case GLOpcodeDrawElementsBaseVertex:
+        case GLOpcodeDrawElementsInstanced:
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        case GLOpcodeDispatchCompute:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified command modifies buffer contents. These commands might re-bind the element array buffer of the current VAO.
+static bool IsGLBufferCommand(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:
+        case GLOpcodeCopyBufferSubData:
+        case GLOpcodeClearBufferData:
+        case GLOpcodeClearBufferSubData:
+            return true;
+        default:
+            return false;
+    }
+}
+
+class GLCommandOptimizer
+{
+
+    public:
+
+        std::size_t Optimize(GLVirtualCommandBuffer& virtualCmdBuffer);
+
+    private:
+
+        static const std::size_t invalidIndex = ~0u;
+        static const std::size_t numStates = static_cast<std::size_t>(GLOptimizerState::Num);
+
+        struct Command
+        {
+            GLOpcode        opcode;
+            const char*     data;
+            std::size_t     size;
+            bool            removed;
+            std::size_t     nextMerged; // Index of next buffer update that is merged into this one
+        };
+
+    private:
+
+        bool ParseCommands(const GLVirtualCommandBuffer& virtualCmdBuffer);
+
+        void ProcessStateCommand(std::size_t index, const GLOptimizerState state);
+        void ProcessBufferUpdate(std::size_t index);
+
+        bool IsStateEqual(const Command& lhs, const Command& rhs) const;
+
+        void CommitState(const GLOptimizerState state);
+        void CommitAllStates();
+        void InvalidateState(const GLOptimizerState state);
+        void InvalidateAllStates();
+
+        void RemoveCommand(std::size_t index);
+        void ResetBufferUpdates();
+
+        void WriteCommands(GLVirtualCommandBuffer& virtualCmdBuffer);
+
+    private:
+
+        std::vector<Command>    commands_;
+        std::size_t             numRemoved_                 = 0;
+
+        std::size_t             pendingStates_[numStates];  // Commands that have not been consumed yet
+        std::size_t             boundStates_[numStates];    // Commands that have been consumed
+
+        std::size_t             updateFirst_                = invalidIndex;
+        std::size_t             updateLast_                 = invalidIndex;
+        const GLBuffer*         updateBuffer_               = nullptr;
+        GLintptr                updateBegin_                = 0;
+        GLintptr                updateEnd_                  = 0;
+
+};
+
+std::size_t GLCommandOptimizer::Optimize(GLVirtualCommandBuffer& virtualCmdBuffer)
+{
+    /* Decode all commands; leave command buffer unchanged if it contains unknown opcodes */
+    if (!ParseCommands(virtualCmdBuffer))
+        return 0;
+
+    InvalidateAllStates();
+
+    for (std::size_t i = 0; i < commands_.size(); ++i)
+    {
+        const auto opcode = commands_[i].opcode;
+
+        GLOptimizerState state;
+        if (GetGLOptimizerState(opcode, state))
+        {
+            ProcessStateCommand(i, state);
+        }
+        else if (IsGLStateConsumerCommand(opcode))
+        {
+            CommitAllStates();
+        }
+        else if (IsGLBufferCommand(opcode))
+        {
+            CommitAllStates();
+            InvalidateState(GLOptimizerState::VertexArray);
+            InvalidateState(GLOptimizerState::ElementArrayBuffer);
+            if (opcode == GLOpcodeBufferSubData)
+            {
+                ProcessBufferUpdate(i);
+                continue;
+            }
+        }
+        else
+        {
+            /* Unknown side effects, e.g. render target bindings or secondary command buffers */
+            CommitAllStates();
+            InvalidateAllStates();
+        }
+
+        /* Buffer updates are only coalesced if they are adjacent in the final command buffer */
+        if (!commands_[i].removed)
+            ResetBufferUpdates();
+    }
+
+    if (numRemoved_ > 0)
+        WriteCommands(virtualCmdBuffer);
+
+    return numRemoved_;
+}
+
+bool GLCommandOptimizer::ParseCommands(const GLVirtualCommandBuffer& virtualCmdBuffer)
+{
+    for (const auto& chunk : virtualCmdBuffer)
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            /* Store command and increment program counter */
+            std::size_t size = 0;
+            if (!GetGLCommandSize(opcode, pc, size))
+                return false;
+
+            commands_.push_back(Command{ opcode, pc, size, false, invalidIndex });
+            pc += size;
+        }
+    }
+    return true;
+}
+
+void GLCommandOptimizer::ProcessStateCommand(std::size_t index, const GLOptimizerState state)
+{
+    const auto stateIndex = static_cast<std::size_t>(state);
+
+    /* Remove previous command of the same state if it has not been consumed */
+    if (IsGLOptimizerStateOverridable(state) && pendingStates_[stateIndex] != invalidIndex)
+    {
+        RemoveCommand(pendingStates_[stateIndex]);
+        pendingStates_[stateIndex] = invalidIndex;
+    }
+
+    /* Remove command if the same state is already bound */
+    const auto boundIndex = boundStates_[stateIndex];
+    if (boundIndex != invalidIndex && IsStateEqual(commands_[boundIndex], commands_[index]))
+    {
+        RemoveCommand(index);
+        return;
+    }
+
+    /* Invalidate dependent states */
+    switch (state)
+    {
+        case GLOptimizerState::PipelineState:
+            /* Pipeline states can have static viewports, scissors, blend color, and stencil reference */
+            InvalidateState(GLOptimizerState::Viewport);
+            InvalidateState(GLOptimizerState::Scissor);
+            InvalidateState(GLOptimizerState::BlendColor);
+            InvalidateState(GLOptimizerState::StencilRef);
+            break;
+
+        case GLOptimizerState::Viewport:
+        case GLOptimizerState::Scissor:
+        case GLOptimizerState::BlendColor:
+        case GLOptimizerState::StencilRef:
+            /* Re-binding the same pipeline state would override these states again */
+            InvalidateState(GLOptimizerState::PipelineState);
+            break;
+
+        case GLOptimizerState::VertexArray:
+            /* Element array buffer is part of the VAO state */
+            InvalidateState(GLOptimizerState::ElementArrayBuffer);
+            break;
+
+        case GLOptimizerState::ElementArrayBuffer:
+            /* Element array buffer is bound to the current VAO, so the VAO binding is consumed */
+            CommitState(GLOptimizerState::VertexArray);
+            break;
+
+        default:
+            break;
+    }
+
+    if (IsGLOptimizerStateOverridable(state))
+        pendingStates_[stateIndex] = index;
+    else
+        boundStates_[stateIndex] = index;
+}
+
+void GLCommandOptimizer::ProcessBufferUpdate(std::size_t index)
+{
+    auto& command = commands_[index];
+    auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(command.data);
+
+    const GLintptr begin    = cmd->offset;
+    const GLintptr end      = cmd->offset + cmd->size;
+
+    if (updateFirst_ != invalidIndex && updateBuffer_ == cmd->buffer)
+    {
+        if (begin == updateEnd_)
+        {
+            /* Append consecutive range to previous buffer update */
+            commands_[updateLast_].nextMerged = index;
+            command.removed = true;
+            ++numRemoved_;
+            updateLast_ = index;
+            updateEnd_  = end;
+            return;
+        }
+        if (begin <= updateBegin_ && end >= updateEnd_)
+        {
+            /* Remove previous buffer updates that are entirely overridden */
+            for (auto i = updateFirst_; i != invalidIndex; i = commands_[i].nextMerged)
+                RemoveCommand(i);
+        }
+    }
+
+    /* Start new sequence of buffer updates */
+    updateFirst_    = index;
+    updateLast_     = index;
+    updateBuffer_   = cmd->buffer;
+    updateBegin_    = begin;
+    updateEnd_      = end;
+}
+
+bool GLCommandOptimizer::IsStateEqual(const Command& lhs, const Command& rhs) const
+{
+    switch (lhs.opcode)
+    {
+        case GLOpcodeBindElementArrayBufferToVAO:
+        {
+            auto lhsCmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(lhs.data);
+            auto rhsCmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(rhs.data);
+            return (lhsCmd->id == rhsCmd->id && lhsCmd->indexType16Bits == rhsCmd->indexType16Bits);
+        }
+        case GLOpcodeBindResourceHeap:
+        {
+            auto lhsCmd = reinterpret_cast<const GLCmdBindResourceHeap*>(lhs.data);
+            auto rhsCmd = reinterpret_cast<const GLCmdBindResourceHeap*>(rhs.data);
+            return
+            (
+                lhsCmd->resourceHeap        == rhsCmd->resourceHeap         &&
+                lhsCmd->firstSet            == rhsCmd->firstSet             &&
+                lhsCmd->numDynamicOffsets   == rhsCmd->numDynamicOffsets    &&
+                ::memcmp(lhsCmd + 1, rhsCmd + 1, sizeof(std::uint32_t)*lhsCmd->numDynamicOffsets) == 0
+            );
+        }
+        default:
+        {
+            /* All other state commands are tightly packed POD structures */
+            return (lhs.size == rhs.size && ::memcmp(lhs.data, rhs.data, lhs.size) == 0);
+        }
+    }
+}
+
+void GLCommandOptimizer::CommitState(const GLOptimizerState state)
+{
+    const auto stateIndex = static_cast<std::size_t>(state);
+    if (pendingStates_[stateIndex] != invalidIndex)
+    {
+        boundStates_[stateIndex] = pendingStates_[stateIndex];
+        pendingStates_[stateIndex] = invalidIndex;
+    }
+}
+
+void GLCommandOptimizer::CommitAllStates()
+{
+    for (std::size_t i = 0; i < numStates; ++i)
+        CommitState(static_cast<GLOptimizerState>(i));
+}
+
+void GLCommandOptimizer::InvalidateState(const GLOptimizerState state)
+{
+    /* Pending commands are kept, but no longer considered for removal */
+    const auto stateIndex = static_cast<std::size_t>(state);
+    pendingStates_[stateIndex]  = invalidIndex;
+    boundStates_[stateIndex]    = invalidIndex;
+}
+
+void GLCommandOptimizer::InvalidateAllStates()
+{
+    for (std::size_t i = 0; i < numStates; ++i)
+        InvalidateState(static_cast<GLOptimizerState>(i));
+}
+
+void GLCommandOptimizer::RemoveCommand(std::size_t index)
+{
+    if (!commands_[index].removed)
+    {
+        commands_[index].removed = true;
+        ++numRemoved_;
+    }
+}
+
+void GLCommandOptimizer::ResetBufferUpdates()
+{
+    updateFirst_    = invalidIndex;
+    updateLast_     = invalidIndex;
+    updateBuffer_   = nullptr;
+}
+
+void GLCommandOptimizer::WriteCommands(GLVirtualCommandBuffer& virtualCmdBuffer)
+{
+    GLVirtualCommandBuffer optimizedCmdBuffer{ virtualCmdBuffer.Size() };
+
+    for (const auto& command : commands_)
+    {
+        if (command.removed)
+            continue;
+
+        if (command.nextMerged != invalidIndex)
+        {
+            /* Write merged buffer updates into a single command */
+            auto srcCmd = reinterpret_cast<const GLCmdBufferSubData*>(command.data);
+
+            GLsizeiptr size = 0;
+            for (auto next = &command; next != nullptr; next = (next->nextMerged != invalidIndex ? &commands_[next->nextMerged] : nullptr))
+                size += reinterpret_cast<const GLCmdBufferSubData*>(next->data)->size;
+
+            auto cmd = optimizedCmdBuffer.AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, static_cast<std::size_t>(size));
+            {
+                cmd->buffer = srcCmd->buffer;
+                cmd->offset = srcCmd->offset;
+                cmd->size   = size;
+
+                auto dst = reinterpret_cast<char*>(cmd + 1);
+                for (auto next = &command; next != nullptr; next = (next->nextMerged != invalidIndex ? &commands_[next->nextMerged] : nullptr))
+                {
+                    auto nextCmd = reinterpret_cast<const GLCmdBufferSubData*>(next->data);
+                    ::memcpy(dst, nextCmd + 1, static_cast<std::size_t>(nextCmd->size));
+                    dst += nextCmd->size;
+                }
+            }
+        }
+        else if (command.size > 0)
+        {
+            /* Copy command as is */
+            ::memcpy(optimizedCmdBuffer.AllocRawCommand(command.opcode, command.size), command.data, command.size);
+        }
+        else
+            optimizedCmdBuffer.AllocOpcode(command.opcode);
+    }
+
+    virtualCmdBuffer.Swap(optimizedCmdBuffer);
+}
+
+std::size_t OptimizeGLVirtualCommandBuffer(GLVirtualCommandBuffer& virtualCmdBuffer)
+{
+    GLCommandOptimizer optimizer;
+    return optimizer.Optimize(virtualCmdBuffer);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
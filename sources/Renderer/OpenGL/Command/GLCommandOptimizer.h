@@ -0,0 +1,36 @@
+/*
+ * GLCommandOptimizer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include "GLDeferredCommandBuffer.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Peephole optimization pass over a recorded virtual command buffer.
+Removes state commands that are redundant (same state is already bound) or dead (overridden before any other command consumes them),
+and coalesces adjacent buffer updates of consecutive ranges into a single update.
+Returns the number of commands that have been removed.
+*/
+std::size_t OptimizeGLVirtualCommandBuffer(GLVirtualCommandBuffer& virtualCmdBuffer);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
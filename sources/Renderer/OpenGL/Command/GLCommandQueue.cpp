@@ -12,6 +12,7 @@
 #include "../RenderState/GLFence.h"
 #include "../RenderState/GLQueryHeap.h"
 #include "../RenderState/GLStateManager.h"
+#include "../GLRenderThread.h"
 #include "../../CheckedCast.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include <algorithm>
@@ -34,11 +35,22 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
     Only deferred command buffers can be submitted multiple times (via GLDeferredCommandBuffer),
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
     */
-    auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, commandBuffer);
+    auto& cmdBufferGL = LLGL_CAST(GLCommandBuffer&, commandBuffer);
     if (!cmdBufferGL.IsImmediateCmdBuffer())
     {
-        auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
-        ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
+        auto& deferredCmdBufferGL = LLGL_CAST(GLDeferredCommandBuffer&, cmdBufferGL);
+        if (GLRenderThread::Get().IsMarshalRequired())
+        {
+            /* Execute commands asynchronously on the render thread; the command buffer waits for them before it is encoded again */
+            deferredCmdBufferGL.PostPendingSubmit(
+                [this, &deferredCmdBufferGL]()
+                {
+                    ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
+                }
+            );
+        }
+        else
+            ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
     }
 }
 
@@ -158,6 +170,8 @@ bool GLCommandQueue::QueryResult(
     void*           data,
     std::size_t     dataSize)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(QueryResult(queryHeap, firstQuery, numQueries, data, dataSize));
+
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
 
     /* Multiply query range by the query group size */
@@ -184,18 +198,21 @@ bool GLCommandQueue::QueryResult(
 
 void GLCommandQueue::Submit(Fence& fence)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Submit(fence));
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     fenceGL.Submit();
 }
 
 bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(WaitFence(fence, timeout));
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     return fenceGL.Wait(timeout);
 }
 
 void GLCommandQueue::WaitIdle()
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(WaitIdle());
     glFinish();
 }
 
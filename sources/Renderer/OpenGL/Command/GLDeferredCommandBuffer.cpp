@@ -7,10 +7,12 @@
 
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommand.h"
+#include "GLCommandOptimizer.h"
 #include <LLGL/StaticLimits.h>
 
 #include "../../TextureUtils.h"
 #include "../GLSwapChain.h"
+#include "../GLRenderThread.h"
 #include "../GLTypes.h"
 #include "../GLCore.h"
 #include "../Ext/GLExtensions.h"
@@ -39,6 +41,7 @@
 #include <algorithm>
 #include <string.h>
 #include <cstring> // std::strlen
+#include <thread>
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
 #   include "GLCommandAssembler.h"
@@ -53,16 +56,52 @@ GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t initial
     flags_  { flags             },
     buffer_ { initialBufferSize }
 {
+    /* Determine how consecutive indexed draw commands can be merged into a single multi-draw command */
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+        drawBatchMode_ = GLDrawBatchMode::MultiDrawIndirect;
+    else
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    {
+        #ifdef LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+        if (HasExtension(GLExt::ARB_draw_elements_base_vertex))
+            drawBatchMode_ = GLDrawBatchMode::MultiDrawBaseVertex;
+        #endif // /LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+    }
+
+    /* Generate the indirect argument buffer up front, since encoding may happen on a thread without GL context */
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    if (drawBatchMode_ == GLDrawBatchMode::MultiDrawIndirect)
+        glGenBuffers(1, &drawIndirectBuffer_);
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+}
+
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    WaitPendingSubmits();
+    if (drawIndirectBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &drawIndirectBuffer_);
+        GLStateManager::Get().NotifyBufferRelease(drawIndirectBuffer_, GLBufferTarget::DRAW_INDIRECT_BUFFER);
+    }
 }
 
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
+    /* Commands are executed by reference, so they must not be modified while the render thread still executes them */
+    WaitPendingSubmits();
+
     /* Reset internal command buffer */
     buffer_.Clear();
+    numRemovedCommands_ = 0;
     boundShaderPipeline_ = nullptr;
 
+    /* Reset draw batches */
+    pendingDraws_.clear();
+    drawIndirectCommands_.clear();
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Reset states relevant to the GL command assembler */
@@ -75,6 +114,17 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
+    /* Merge last pending draw commands and upload arguments of all multi-draw-indirect batches */
+    FlushDrawBatch();
+    if (!drawIndirectCommands_.empty() && GLRenderThread::Get().IsMarshalRequired())
+        PostPendingSubmit([this]() { UploadDrawBatchIndirectBuffer(); });
+    else
+        UploadDrawBatchIndirectBuffer();
+
+    /* Remove redundant commands if command buffer will be submitted multiple times */
+    if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+        numRemovedCommands_ = static_cast<std::uint32_t>(OptimizeGLVirtualCommandBuffer(buffer_));
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Generate native assembly only if command buffer will be submitted multiple times */
@@ -90,6 +140,11 @@ void GLDeferredCommandBuffer::End()
     #endif // /LLGL_ENABLE_JIT_COMPILER
 }
 
+std::uint32_t GLDeferredCommandBuffer::GetNumRemovedCommands() const
+{
+    return numRemovedCommands_;
+}
+
 void GLDeferredCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     if (IsPrimary())
@@ -115,14 +170,14 @@ void GLDeferredCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
-    auto cmd = AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, dataSize);
+    auto cmd = AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, static_cast<std::size_t>(dataSize));
     {
         cmd->buffer = LLGL_CAST(GLBuffer*, &dstBuffer);
         cmd->offset = static_cast<GLintptr>(dstOffset);
         cmd->size   = static_cast<GLsizeiptr>(dataSize);
-        ::memcpy(cmd + 1, data, dataSize);
+        ::memcpy(cmd + 1, data, static_cast<std::size_t>(dataSize));
     }
 }
 
@@ -401,8 +456,25 @@ void GLDeferredCommandBuffer::SetResourceHeap(
     const PipelineBindPoint /*bindPoint*/)
 {
     auto cmd = AllocCommand<GLCmdBindResourceHeap>(GLOpcodeBindResourceHeap);
-    cmd->resourceHeap   = LLGL_CAST(GLResourceHeap*, &resourceHeap);
-    cmd->firstSet       = firstSet;
+    cmd->resourceHeap       = LLGL_CAST(GLResourceHeap*, &resourceHeap);
+    cmd->firstSet           = firstSet;
+    cmd->numDynamicOffsets  = 0;
+}
+
+void GLDeferredCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         /*bindPoint*/,
+    const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    const auto numDynamicOffsets = static_cast<std::uint32_t>(dynamicOffsets.size());
+    auto cmd = AllocCommand<GLCmdBindResourceHeap>(GLOpcodeBindResourceHeap, sizeof(std::uint32_t) * numDynamicOffsets);
+    {
+        cmd->resourceHeap       = LLGL_CAST(GLResourceHeap*, &resourceHeap);
+        cmd->firstSet           = firstSet;
+        cmd->numDynamicOffsets  = numDynamicOffsets;
+        ::memcpy(cmd + 1, dynamicOffsets.data(), sizeof(std::uint32_t) * numDynamicOffsets);
+    }
 }
 
 void GLDeferredCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
@@ -632,8 +704,8 @@ void GLDeferredCommandBuffer::SetUniforms(
     const void*     data,
     std::uint32_t   dataSize)
 {
-    /* Data size must be a multiple of 4 bytes */
-    if (dataSize == 0 || dataSize % 4 != 0)
+    /* Data size must be a multiple of 4 bytes and uniforms can only be set for a bound shader pipeline */
+    if (dataSize == 0 || dataSize % 4 != 0 || boundShaderPipeline_ == nullptr)
         return;
 
     /* Allocate GL command and copy data buffer */
@@ -753,27 +825,12 @@ void GLDeferredCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firs
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
-    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
-    {
-        cmd->mode       = renderState_.drawMode;
-        cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = renderState_.indexBufferDataType;
-        cmd->indices    = reinterpret_cast<const GLvoid*>(indices);
-    }
+    AllocDrawElements(GLOpcodeDrawElements, numIndices, 1, firstIndex, 0, 0);
 }
 
 void GLDeferredCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
-    {
-        cmd->mode       = renderState_.drawMode;
-        cmd->count      = static_cast<GLsizei>(numIndices);
-        cmd->type       = renderState_.indexBufferDataType;
-        cmd->indices    = reinterpret_cast<const GLvoid*>(indices);
-        cmd->basevertex = vertexOffset;
-    }
+    AllocDrawElements(GLOpcodeDrawElementsBaseVertex, numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
@@ -805,45 +862,18 @@ void GLDeferredCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
-    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
-    {
-        cmd->mode           = renderState_.drawMode;
-        cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
-        cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
-        cmd->instancecount  = static_cast<GLsizei>(numInstances);
-    }
+    AllocDrawElements(GLOpcodeDrawElementsInstanced, numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
-    {
-        cmd->mode           = renderState_.drawMode;
-        cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
-        cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
-        cmd->instancecount  = static_cast<GLsizei>(numInstances);
-        cmd->basevertex     = vertexOffset;
-    }
+    AllocDrawElements(GLOpcodeDrawElementsInstancedBaseVertex, numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void GLDeferredCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
     #ifndef __APPLE__
-    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
-    auto cmd = AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
-    {
-        cmd->mode           = renderState_.drawMode;
-        cmd->count          = static_cast<GLsizei>(numIndices);
-        cmd->type           = renderState_.indexBufferDataType;
-        cmd->indices        = reinterpret_cast<const GLvoid*>(indices);
-        cmd->instancecount  = static_cast<GLsizei>(numInstances);
-        cmd->basevertex     = vertexOffset;
-        cmd->baseinstance   = firstInstance;
-    }
+    AllocDrawElements(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
     #else
     ErrUnsupportedGLProc("glDrawElementsInstancedBaseVertexBaseInstance");
     #endif
@@ -1007,6 +1037,27 @@ bool GLDeferredCommandBuffer::IsPrimary() const
     return ((GetFlags() & CommandBufferFlags::Secondary) == 0);
 }
 
+void GLDeferredCommandBuffer::PostPendingSubmit(const std::function<void()>& task)
+{
+    BeginPendingSubmit();
+    GLRenderThread::Get().Post(
+        [this, task]()
+        {
+            /* Always end the pending submission; the render thread reports the exception after it has been rethrown */
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                EndPendingSubmit();
+                throw;
+            }
+            EndPendingSubmit();
+        }
+    );
+}
+
 
 /*
  * ======= Private: =======
@@ -1088,14 +1139,277 @@ void GLDeferredCommandBuffer::BindGL2XSampler(const GL2XSampler& samplerGL2X, st
 }
 #endif
 
+void GLDeferredCommandBuffer::AllocDrawElements(
+    const GLOpcode  opcode,
+    std::uint32_t   numIndices,
+    std::uint32_t   numInstances,
+    std::uint32_t   firstIndex,
+    std::int32_t    vertexOffset,
+    std::uint32_t   firstInstance)
+{
+    const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
+
+    GLPendingDrawElements draw;
+    {
+        draw.opcode         = opcode;
+        draw.mode           = renderState_.drawMode;
+        draw.type           = renderState_.indexBufferDataType;
+        draw.count          = static_cast<GLsizei>(numIndices);
+        draw.instanceCount  = static_cast<GLsizei>(numInstances);
+        draw.indices        = indices;
+        draw.firstIndex     = static_cast<GLuint>(indices / renderState_.indexBufferStride);
+        draw.baseVertex     = vertexOffset;
+        draw.baseInstance   = firstInstance;
+    }
+
+    if (IsDrawBatchCompatible(draw))
+    {
+        /* Defer draw command until the batch is interrupted by any other command */
+        pendingDraws_.push_back(draw);
+    }
+    else
+    {
+        FlushDrawBatch();
+        AllocDrawElementsCommand(draw);
+    }
+}
+
+bool GLDeferredCommandBuffer::IsDrawBatchCompatible(const GLPendingDrawElements& draw) const
+{
+    switch (drawBatchMode_)
+    {
+        case GLDrawBatchMode::MultiDrawIndirect:
+            /* Indirect commands can only address the index buffer with a multiple of the index size */
+            if (draw.indices % renderState_.indexBufferStride != 0)
+                return false;
+            break;
+
+        case GLDrawBatchMode::MultiDrawBaseVertex:
+            /* glMultiDrawElementsBaseVertex has no instancing */
+            if (draw.instanceCount != 1 || draw.baseInstance != 0)
+                return false;
+            break;
+
+        default:
+            return false;
+    }
+
+    /* Primitive topology and index format must be equal for all draws within a batch */
+    if (!pendingDraws_.empty())
+    {
+        const auto& front = pendingDraws_.front();
+        if (front.mode != draw.mode || front.type != draw.type)
+            return false;
+    }
+
+    return true;
+}
+
+void GLDeferredCommandBuffer::FlushDrawBatch()
+{
+    if (pendingDraws_.empty())
+        return;
+
+    const auto& front = pendingDraws_.front();
+
+    if (pendingDraws_.size() == 1)
+    {
+        /* Allocate single draw command as is */
+        AllocDrawElementsCommand(front);
+    }
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    else if (drawBatchMode_ == GLDrawBatchMode::MultiDrawIndirect)
+    {
+        /* Append indirect arguments; they are uploaded into the indirect buffer when the command buffer is ended */
+        const auto indirect = static_cast<GLintptr>(sizeof(GLDrawElementsIndirectCommand) * drawIndirectCommands_.size());
+
+        for (const auto& draw : pendingDraws_)
+        {
+            drawIndirectCommands_.push_back(
+                GLDrawElementsIndirectCommand
+                {
+                    static_cast<GLuint>(draw.count),
+                    static_cast<GLuint>(draw.instanceCount),
+                    draw.firstIndex,
+                    draw.baseVertex,
+                    draw.baseInstance
+                }
+            );
+        }
+
+        auto cmd = buffer_.AllocCommand<GLCmdMultiDrawElementsIndirect>(GLOpcodeMultiDrawElementsIndirect);
+        {
+            cmd->id         = drawIndirectBuffer_;
+            cmd->mode       = front.mode;
+            cmd->type       = front.type;
+            cmd->indirect   = reinterpret_cast<const GLvoid*>(indirect);
+            cmd->drawcount  = static_cast<GLsizei>(pendingDraws_.size());
+            cmd->stride     = 0;
+        }
+    }
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    #ifdef LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+    else if (drawBatchMode_ == GLDrawBatchMode::MultiDrawBaseVertex)
+    {
+        /* Store arrays of index offsets, index counts, and base vertices as payload of the command */
+        const auto drawcount = pendingDraws_.size();
+        auto cmd = buffer_.AllocCommand<GLCmdMultiDrawElementsBaseVertex>(
+            GLOpcodeMultiDrawElementsBaseVertex,
+            (sizeof(const GLvoid*) + sizeof(GLsizei) + sizeof(GLint)) * drawcount
+        );
+        {
+            cmd->mode       = front.mode;
+            cmd->type       = front.type;
+            cmd->drawcount  = static_cast<GLsizei>(drawcount);
+
+            auto indices    = reinterpret_cast<const GLvoid**>(cmd + 1);
+            auto counts     = reinterpret_cast<GLsizei*>(indices + drawcount);
+            auto basevertex = reinterpret_cast<GLint*>(counts + drawcount);
+
+            for (std::size_t i = 0; i < drawcount; ++i)
+            {
+                indices[i]      = reinterpret_cast<const GLvoid*>(pendingDraws_[i].indices);
+                counts[i]       = pendingDraws_[i].count;
+                basevertex[i]   = pendingDraws_[i].baseVertex;
+            }
+        }
+    }
+    #endif // /LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+    else
+    {
+        for (const auto& draw : pendingDraws_)
+            AllocDrawElementsCommand(draw);
+    }
+
+    pendingDraws_.clear();
+}
+
+void GLDeferredCommandBuffer::AllocDrawElementsCommand(const GLPendingDrawElements& draw)
+{
+    switch (draw.opcode)
+    {
+        case GLOpcodeDrawElements:
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElements>(GLOpcodeDrawElements);
+            {
+                cmd->mode       = draw.mode;
+                cmd->count      = draw.count;
+                cmd->type       = draw.type;
+                cmd->indices    = reinterpret_cast<const GLvoid*>(draw.indices);
+            }
+        }
+        break;
+
+        case GLOpcodeDrawElementsBaseVertex:
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsBaseVertex>(GLOpcodeDrawElementsBaseVertex);
+            {
+                cmd->mode       = draw.mode;
+                cmd->count      = draw.count;
+                cmd->type       = draw.type;
+                cmd->indices    = reinterpret_cast<const GLvoid*>(draw.indices);
+                cmd->basevertex = draw.baseVertex;
+            }
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstanced:
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsInstanced>(GLOpcodeDrawElementsInstanced);
+            {
+                cmd->mode           = draw.mode;
+                cmd->count          = draw.count;
+                cmd->type           = draw.type;
+                cmd->indices        = reinterpret_cast<const GLvoid*>(draw.indices);
+                cmd->instancecount  = draw.instanceCount;
+            }
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertex>(GLOpcodeDrawElementsInstancedBaseVertex);
+            {
+                cmd->mode           = draw.mode;
+                cmd->count          = draw.count;
+                cmd->type           = draw.type;
+                cmd->indices        = reinterpret_cast<const GLvoid*>(draw.indices);
+                cmd->instancecount  = draw.instanceCount;
+                cmd->basevertex     = draw.baseVertex;
+            }
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        {
+            auto cmd = buffer_.AllocCommand<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(GLOpcodeDrawElementsInstancedBaseVertexBaseInstance);
+            {
+                cmd->mode           = draw.mode;
+                cmd->count          = draw.count;
+                cmd->type           = draw.type;
+                cmd->indices        = reinterpret_cast<const GLvoid*>(draw.indices);
+                cmd->instancecount  = draw.instanceCount;
+                cmd->basevertex     = draw.baseVertex;
+                cmd->baseinstance   = draw.baseInstance;
+            }
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void GLDeferredCommandBuffer::UploadDrawBatchIndirectBuffer()
+{
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    if (!drawIndirectCommands_.empty())
+    {
+        /* Use static storage if the arguments are submitted multiple times, otherwise let the driver orphan the previous storage */
+        const GLenum usage = ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0 ? GL_STATIC_DRAW : GL_STREAM_DRAW);
+        GLStateManager::Get().BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, drawIndirectBuffer_);
+        glBufferData(
+            GL_DRAW_INDIRECT_BUFFER,
+            static_cast<GLsizeiptr>(sizeof(GLDrawElementsIndirectCommand) * drawIndirectCommands_.size()),
+            drawIndirectCommands_.data(),
+            usage
+        );
+    }
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+}
+
+void GLDeferredCommandBuffer::BeginPendingSubmit()
+{
+    std::lock_guard<std::mutex> guard{ pendingSubmitsMutex_ };
+    ++numPendingSubmits_;
+}
+
+void GLDeferredCommandBuffer::EndPendingSubmit()
+{
+    {
+        std::lock_guard<std::mutex> guard{ pendingSubmitsMutex_ };
+        --numPendingSubmits_;
+    }
+    pendingSubmitsSignal_.notify_all();
+}
+
+void GLDeferredCommandBuffer::WaitPendingSubmits()
+{
+    std::unique_lock<std::mutex> lock{ pendingSubmitsMutex_ };
+    pendingSubmitsSignal_.wait(lock, [this]() { return (numPendingSubmits_ == 0); });
+}
+
 void GLDeferredCommandBuffer::AllocOpcode(const GLOpcode opcode)
 {
+    FlushDrawBatch();
     buffer_.AllocOpcode(opcode);
 }
 
 template <typename TCommand>
 TCommand* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t payloadSize)
 {
+    /* Any other command interrupts the current draw batch */
+    FlushDrawBatch();
     return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
 }
 
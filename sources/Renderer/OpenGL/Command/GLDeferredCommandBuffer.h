@@ -16,6 +16,9 @@
 #include "../../VirtualCommandBuffer.h"
 #include <memory>
 #include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
 #   include "../../../JIT/JITProgram.h"
@@ -47,12 +50,15 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
     public:
 
         GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize = 1024);
+        ~GLDeferredCommandBuffer();
 
         /* ----- Encoding ----- */
 
         void Begin() override;
         void End() override;
 
+        std::uint32_t GetNumRemovedCommands() const override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -61,7 +67,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -132,6 +138,13 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags = StageFlags::AllStages) override;
 
         void ResetResourceSlots(
@@ -262,6 +275,45 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
         #endif // /LLGL_ENABLE_JIT_COMPILER
 
+        /*
+        Schedules the specified task on the render thread (see RendererConfigurationOpenGL::renderThread) as a pending submission of this command buffer.
+        Begin() and the destructor wait until all pending submissions have finished, even if a task throws an exception.
+        */
+        void PostPendingSubmit(const std::function<void()>& task);
+
+    private:
+
+        enum class GLDrawBatchMode
+        {
+            Disabled,
+            MultiDrawIndirect,      // Batch draws with glMultiDrawElementsIndirect (GL_ARB_multi_draw_indirect)
+            MultiDrawBaseVertex,    // Batch non-instanced draws with glMultiDrawElementsBaseVertex (GL_ARB_draw_elements_base_vertex)
+        };
+
+        // Indexed draw command that has been recorded but not allocated yet.
+        struct GLPendingDrawElements
+        {
+            GLOpcode    opcode;
+            GLenum      mode;
+            GLenum      type;
+            GLsizei     count;
+            GLsizei     instanceCount;
+            GLintptr    indices;
+            GLuint      firstIndex;
+            GLint       baseVertex;
+            GLuint      baseInstance;
+        };
+
+        // Same layout as the 'DrawElementsIndirectCommand' structure from the GL specification.
+        struct GLDrawElementsIndirectCommand
+        {
+            GLuint      count;
+            GLuint      instanceCount;
+            GLuint      firstIndex;
+            GLint       baseVertex;
+            GLuint      baseInstance;
+        };
+
     private:
 
         void BindBufferBase(const GLBufferTarget bufferTarget, const GLBuffer& bufferGL, std::uint32_t slot);
@@ -273,6 +325,35 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindGL2XSampler(const GL2XSampler& samplerGL2X, std::uint32_t slot);
         #endif
 
+        /* Appends an indexed draw command to the current draw batch, or allocates it directly if it cannot be batched */
+        void AllocDrawElements(
+            const GLOpcode  opcode,
+            std::uint32_t   numIndices,
+            std::uint32_t   numInstances,
+            std::uint32_t   firstIndex,
+            std::int32_t    vertexOffset,
+            std::uint32_t   firstInstance
+        );
+
+        /* Returns true if the specified draw command can be appended to the current draw batch */
+        bool IsDrawBatchCompatible(const GLPendingDrawElements& draw) const;
+
+        /* Allocates the commands for all pending draws of the current draw batch */
+        void FlushDrawBatch();
+
+        /* Allocates a single indexed draw command with its original opcode */
+        void AllocDrawElementsCommand(const GLPendingDrawElements& draw);
+
+        /* Uploads the indirect arguments of all multi-draw-indirect batches */
+        void UploadDrawBatchIndirectBuffer();
+
+        /* Increments and decrements the number of pending submissions */
+        void BeginPendingSubmit();
+        void EndPendingSubmit();
+
+        /* Waits until all pending submissions of this command buffer have been executed */
+        void WaitPendingSubmits();
+
         /* Allocates only an opcode for empty commands */
         void AllocOpcode(const GLOpcode opcode);
 
@@ -287,6 +368,16 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
         long                        flags_                  = 0;
         GLVirtualCommandBuffer      buffer_;
+        std::uint32_t               numRemovedCommands_     = 0;
+
+        GLDrawBatchMode                             drawBatchMode_          = GLDrawBatchMode::Disabled;
+        std::vector<GLPendingDrawElements>          pendingDraws_;
+        std::vector<GLDrawElementsIndirectCommand>  drawIndirectCommands_;
+        GLuint                                      drawIndirectBuffer_     = 0;
+
+        std::uint32_t                               numPendingSubmits_      = 0;
+        std::mutex                                  pendingSubmitsMutex_;
+        std::condition_variable                     pendingSubmitsSignal_;
 
         #ifdef LLGL_ENABLE_JIT_COMPILER
         std::unique_ptr<JITProgram> executable_;
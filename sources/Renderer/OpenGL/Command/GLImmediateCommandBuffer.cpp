@@ -76,7 +76,7 @@ void GLImmediateCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
@@ -327,7 +327,17 @@ void GLImmediateCommandBuffer::SetResourceHeap(
     const PipelineBindPoint /*bindPoint*/)
 {
     auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
-    resourceHeapGL.Bind(*stateMngr_, firstSet);
+    resourceHeapGL.Bind(*stateMngr_, firstSet, 0, nullptr);
+}
+
+void GLImmediateCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         /*bindPoint*/,
+    const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
+    resourceHeapGL.Bind(*stateMngr_, firstSet, static_cast<std::uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
 void GLImmediateCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long /*stageFlags*/)
@@ -77,6 +77,7 @@ enum class GLExt
 
     /* Khronos group extensions (KHR) */
     KHR_debug,
+    KHR_parallel_shader_compile,
 
     /* Multi-vendor extensions (EXT) */
     EXT_blend_color,
@@ -11,6 +11,10 @@
 #include <LLGL/Log.h>
 #include <functional>
 
+#if defined(__linux__) && defined(LLGL_GL_ENABLE_EGL)
+#   include <EGL/egl.h>
+#endif
+
 
 namespace LLGL
 {
@@ -28,6 +32,11 @@ bool LoadGLProc(T& procAddr, const char* procName)
     #if defined(_WIN32)
     procAddr = reinterpret_cast<T>(wglGetProcAddress(procName));
     #elif defined(__linux__)
+    #ifdef LLGL_GL_ENABLE_EGL
+    if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+        procAddr = reinterpret_cast<T>(eglGetProcAddress(procName));
+    else
+    #endif // /LLGL_GL_ENABLE_EGL
     procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #else
     Log::PostReport(Log::ReportType::Error, "OS not supported for loading OpenGL extensions");
@@ -232,6 +241,7 @@ static bool Load_GL_ARB_draw_elements_base_vertex(bool usePlaceholder)
 {
     LOAD_GLPROC( glDrawElementsBaseVertex          );
     LOAD_GLPROC( glDrawElementsInstancedBaseVertex );
+    LOAD_GLPROC( glMultiDrawElementsBaseVertex     );
     return true;
 }
 
@@ -244,6 +254,7 @@ static bool Load_GL_ARB_shader_objects(bool usePlaceholder)
     LOAD_GLPROC( glCompileShader      );
     LOAD_GLPROC( glGetShaderiv        );
     LOAD_GLPROC( glGetShaderInfoLog   );
+    LOAD_GLPROC( glGetShaderSource    );
     LOAD_GLPROC( glDeleteShader       );
     LOAD_GLPROC( glCreateProgram      );
     LOAD_GLPROC( glDeleteProgram      );
@@ -606,6 +617,12 @@ static bool Load_GL_KHR_debug(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_KHR_parallel_shader_compile(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsKHR );
+    return true;
+}
+
 static bool Load_GL_ARB_clip_control(bool usePlaceholder)
 {
     LOAD_GLPROC( glClipControl );
@@ -1155,6 +1172,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_multi_bind                   );
     LOAD_GLEXT( EXT_stencil_two_side             );
     LOAD_GLEXT( KHR_debug                        );
+    LOAD_GLEXT( KHR_parallel_shader_compile      );
     LOAD_GLEXT( ARB_clip_control                 );
     LOAD_GLEXT( ARB_draw_buffers                 );
     LOAD_GLEXT( EXT_draw_buffers2                );
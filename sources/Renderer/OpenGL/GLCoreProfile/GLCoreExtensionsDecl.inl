@@ -252,6 +252,7 @@ DECL_GLPROC(PFNGLDRAWELEMENTSINSTANCEDPROC,                         glDrawElemen
 
 DECL_GLPROC(PFNGLDRAWELEMENTSBASEVERTEXPROC,                        glDrawElementsBaseVertex,                       void,           (GLenum, GLsizei, GLenum, const void*, GLint));
 DECL_GLPROC(PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC,               glDrawElementsInstancedBaseVertex,              void,           (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint));
+DECL_GLPROC(PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC,                   glMultiDrawElementsBaseVertex,                  void,           (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei, const GLint*));
 
 /* GL_ARB_base_instance */
 
@@ -266,6 +267,7 @@ DECL_GLPROC(PFNGLSHADERSOURCEPROC,                                  glShaderSour
 DECL_GLPROC(PFNGLCOMPILESHADERPROC,                                 glCompileShader,                                void,           (GLuint));
 DECL_GLPROC(PFNGLGETSHADERIVPROC,                                   glGetShaderiv,                                  void,           (GLuint, GLenum, GLint*));
 DECL_GLPROC(PFNGLGETSHADERINFOLOGPROC,                              glGetShaderInfoLog,                             void,           (GLuint, GLsizei, GLsizei*, GLchar*));
+DECL_GLPROC(PFNGLGETSHADERSOURCEPROC,                                glGetShaderSource,                              void,           (GLuint, GLsizei, GLsizei*, GLchar*));
 DECL_GLPROC(PFNGLDELETESHADERPROC,                                  glDeleteShader,                                 void,           (GLuint));
 DECL_GLPROC(PFNGLCREATEPROGRAMPROC,                                 glCreateProgram,                                GLuint,         (void));
 DECL_GLPROC(PFNGLDELETEPROGRAMPROC,                                 glDeleteProgram,                                void,           (GLuint));
@@ -483,6 +485,10 @@ DECL_GLPROC(PFNGLGETOBJECTLABELPROC,                                glGetObjectL
 DECL_GLPROC(PFNGLOBJECTPTRLABELPROC,                                glObjectPtrLabel,                               void,           (const void*, GLsizei, const GLchar*));
 DECL_GLPROC(PFNGLGETOBJECTPTRLABELPROC,                             glGetObjectPtrLabel,                            void,           (const void*, GLsizei, GLsizei*, GLchar*));
 
+/* GL_KHR_parallel_shader_compile */
+
+DECL_GLPROC(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC,                   glMaxShaderCompilerThreadsKHR,                  void,           (GLuint));
+
 /* GL_ARB_clip_control */
 
 DECL_GLPROC(PFNGLCLIPCONTROLPROC,                                   glClipControl,                                  void,           (GLenum, GLenum));
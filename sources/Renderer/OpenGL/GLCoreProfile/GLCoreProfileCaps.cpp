@@ -206,6 +206,7 @@ static void GLGetSupportedFeatures(RenderingFeatures& features)
     features.hasLogicOp                     = true;
     features.hasPipelineStatistics          = HasExtension(GLExt::ARB_pipeline_statistics_query);
     features.hasRenderCondition             = true;
+    features.hasDynamicBufferOffsets        = features.hasConstantBuffers;
 }
 
 static void GLGetFeatureLimits(const RenderingFeatures& features, RenderingLimits& limits)
@@ -161,6 +161,7 @@ static void GLGetSupportedFeatures(RenderingFeatures& features, GLint version)
     features.hasLogicOp                     = false;
     features.hasPipelineStatistics          = false;
     features.hasRenderCondition             = false;
+    features.hasDynamicBufferOffsets        = features.hasConstantBuffers;
 }
 
 static void GLGetFeatureLimits(RenderingLimits& limits, GLint version)
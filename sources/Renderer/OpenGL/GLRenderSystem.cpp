@@ -7,6 +7,7 @@
 
 #include "GLRenderSystem.h"
 #include "GLProfile.h"
+#include "GLRenderThread.h"
 #include "Texture/GLMipGenerator.h"
 #include "Texture/GLTextureViewPool.h"
 #include "Ext/GLExtensions.h"
@@ -15,9 +16,11 @@
 #include "../RenderSystemUtils.h"
 #include "GLTypes.h"
 #include "GLCore.h"
+#include "GLSerialization.h"
 #include "Shader/GLLegacyShader.h"
 #include "Buffer/GLBufferWithVAO.h"
 #include "Buffer/GLBufferArrayWithVAO.h"
+#include "Buffer/GLStagingRing.h"
 #include "../CheckedCast.h"
 #include "../BufferUtils.h"
 #include "../TextureUtils.h"
@@ -54,27 +57,38 @@ static RendererConfigurationOpenGL GetGLProfileFromDesc(const RenderSystemDescri
 }
 
 GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    contextMngr_ { GetGLProfileFromDesc(renderSystemDesc) }
+    contextMngr_  { GetGLProfileFromDesc(renderSystemDesc)       },
+    readbackRing_ { contextMngr_.GetProfile().numReadbackBuffers }
 {
+    /* Start dedicated render thread that owns all GL contexts */
+    if (contextMngr_.GetProfile().renderThread)
+        GLRenderThread::Get().Start();
+
+    /* Headless contexts have no swap-chain, so create the primary GL context and its dependent devices immediately */
+    if (contextMngr_.GetProfile().headless)
+        CreateHeadlessContext();
 }
 
 GLRenderSystem::~GLRenderSystem()
 {
-    /* Clear all render state containers first, the rest will be deleted automatically */
-    GLTextureViewPool::Get().Clear();
-    GLMipGenerator::Get().Clear();
-    GLStatePool::Get().Clear();
+    /* Release all GL objects on the thread that owns the GL contexts before the render thread is stopped */
+    ReleaseGLObjects();
+    GLRenderThread::Get().Stop();
 }
 
 /* ----- Swap-chain ----- */
 
 SwapChain* GLRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainDesc, const std::shared_ptr<Surface>& surface)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateSwapChain(swapChainDesc, surface));
+    if (contextMngr_.GetProfile().headless)
+        throw std::runtime_error("cannot create swap-chain with headless OpenGL context");
     return AddSwapChain(MakeUnique<GLSwapChain>(swapChainDesc, surface, contextMngr_));
 }
 
 void GLRenderSystem::Release(SwapChain& swapChain)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(swapChain));
     RemoveFromUniqueSet(swapChains_, &swapChain);
 }
 
@@ -89,6 +103,12 @@ CommandQueue* GLRenderSystem::GetCommandQueue()
 
 CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
+    /* Immediate command buffers would issue GL calls on the encoding thread */
+    if ((commandBufferDesc.flags & CommandBufferFlags::ImmediateSubmit) != 0 && contextMngr_.GetProfile().renderThread)
+        throw std::invalid_argument("cannot create immediate OpenGL command buffer when the render thread is enabled");
+
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateCommandBuffer(commandBufferDesc));
+
     /* Get state manager from swap-chain with shared GL context */
     if (auto currentGLContext = contextMngr_.AllocContext())
     {
@@ -115,6 +135,7 @@ CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
 
 void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(commandBuffer));
     RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
 }
 
@@ -160,6 +181,7 @@ static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& bufferDe
 
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateBuffer(bufferDesc, initialData));
     AssertCreateBuffer(bufferDesc, static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
 
     auto bufferGL = CreateGLBuffer(bufferDesc, initialData);
@@ -209,6 +231,7 @@ static bool IsBufferArrayWithVertexBufferBinding(std::uint32_t numBuffers, Buffe
 
 BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateBufferArray(numBuffers, bufferArray));
     AssertCreateBufferArray(numBuffers, bufferArray);
 
     if (IsBufferArrayWithVertexBufferBinding(numBuffers, bufferArray))
@@ -223,28 +246,33 @@ BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void GLRenderSystem::Release(Buffer& buffer)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(buffer));
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
 void GLRenderSystem::Release(BufferArray& bufferArray)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(bufferArray));
     RemoveFromUniqueSet(bufferArrays_, &bufferArray);
 }
 
 void GLRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(WriteBuffer(buffer, offset, data, dataSize));
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.BufferSubData(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void GLRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(ReadBuffer(buffer, offset, data, dataSize));
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.GetBufferSubData(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(MapBuffer(buffer, access));
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     return bufferGL.MapBuffer(GLTypes::Map(access));
 }
@@ -263,12 +291,14 @@ static GLbitfield ToGLMapBufferAccess(CPUAccess access)
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(MapBuffer(buffer, access, offset, length));
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     return bufferGL.MapBufferRange(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(length), ToGLMapBufferAccess(access));
 }
 
 void GLRenderSystem::UnmapBuffer(Buffer& buffer)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(UnmapBuffer(buffer));
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.UnmapBuffer();
 }
@@ -315,6 +345,7 @@ void GLRenderSystem::ValidateGLTextureType(const TextureType type)
 
 Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateTexture(textureDesc, imageDesc));
     ValidateGLTextureType(textureDesc.type);
 
     /* Create <GLTexture> object; will result in a GL renderbuffer or texture instance */
@@ -328,11 +359,14 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
 void GLRenderSystem::Release(Texture& texture)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(texture));
     RemoveFromUniqueSet(textures_, &texture);
 }
 
 void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(WriteTexture(texture, textureRegion, imageDesc));
+
     /* Bind texture and write texture sub data */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     textureGL.TextureSubImage(textureRegion, imageDesc, false);
@@ -340,16 +374,40 @@ void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
 
 void GLRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(ReadTexture(texture, textureRegion, imageDesc));
+
     /* Bind texture and write texture sub data */
     LLGL_ASSERT_PTR(imageDesc.data);
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     textureGL.GetTextureSubImage(textureRegion, imageDesc, false);
 }
 
+std::uint64_t GLRenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(ReadTextureAsync(texture, textureRegion, format, dataType));
+
+    /* Enqueue read operation into next pixel pack buffer of the readback ring */
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    return readbackRing_.ReadTexture(textureGL, textureRegion, format, dataType);
+}
+
+const void* GLRenderSystem::MapTextureReadback(std::uint64_t ticket, bool wait, std::size_t* dataSize)
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(MapTextureReadback(ticket, wait, dataSize));
+    return readbackRing_.Map(ticket, wait, dataSize);
+}
+
+void GLRenderSystem::UnmapTextureReadback(std::uint64_t ticket)
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(UnmapTextureReadback(ticket));
+    readbackRing_.Unmap(ticket);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateSampler(samplerDesc));
     #ifdef LLGL_GL_ENABLE_OPENGL2X
     /* If GL_ARB_sampler_objects is not supported, use emulated sampler states */
     if (!HasNativeSamplers())
@@ -369,6 +427,7 @@ Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 
 void GLRenderSystem::Release(Sampler& sampler)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(sampler));
     #ifdef LLGL_GL_ENABLE_OPENGL2X
     /* If GL_ARB_sampler_objects is not supported, release emulated sampler states */
     if (!HasNativeSamplers())
@@ -384,23 +443,34 @@ void GLRenderSystem::Release(Sampler& sampler)
 
 ResourceHeap* GLRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateResourceHeap(resourceHeapDesc));
     return TakeOwnership(resourceHeaps_, MakeUnique<GLResourceHeap>(resourceHeapDesc));
 }
 
 void GLRenderSystem::Release(ResourceHeap& resourceHeap)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(resourceHeap));
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t GLRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(WriteResourceHeap(resourceHeap, firstDescriptor, resourceViews));
+    auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
+    return resourceHeapGL.WriteResourceViews(firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* GLRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateRenderPass(renderPassDesc));
     return TakeOwnership(renderPasses_, MakeUnique<GLRenderPass>(renderPassDesc));
 }
 
 void GLRenderSystem::Release(RenderPass& renderPass)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(renderPass));
     RemoveFromUniqueSet(renderPasses_, &renderPass);
 }
 
@@ -408,6 +478,7 @@ void GLRenderSystem::Release(RenderPass& renderPass)
 
 RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& renderTargetDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateRenderTarget(renderTargetDesc));
     LLGL_ASSERT_FEATURE_SUPPORT(hasRenderTargets);
     AssertCreateRenderTarget(renderTargetDesc);
     return TakeOwnership(renderTargets_, MakeUnique<GLRenderTarget>(renderTargetDesc));
@@ -415,6 +486,7 @@ RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& r
 
 void GLRenderSystem::Release(RenderTarget& renderTarget)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(renderTarget));
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
@@ -422,6 +494,7 @@ void GLRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateShader(shaderDesc));
     AssertCreateShader(shaderDesc);
 
     /* Validate rendering capabilities for required shader type */
@@ -458,6 +531,7 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 
 void GLRenderSystem::Release(Shader& shader)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(shader));
     RemoveFromUniqueSet(shaders_, &shader);
 }
 
@@ -465,33 +539,81 @@ void GLRenderSystem::Release(Shader& shader)
 
 PipelineLayout* GLRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& pipelineLayoutDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreatePipelineLayout(pipelineLayoutDesc));
     return TakeOwnership(pipelineLayouts_, MakeUnique<GLPipelineLayout>(pipelineLayoutDesc));
 }
 
 void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(pipelineLayout));
     RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
 
-PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreatePipelineState(serializedCache));
+    Serialization::Deserializer reader{ serializedCache };
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident == Serialization::GLIdent_GraphicsPSOIdent)
+    {
+        /* Create graphics PSO from cache */
+        return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(reader));
+    }
+    else if (seg.ident == Serialization::GLIdent_ComputePSOIdent)
+    {
+        /* Create compute PSO from cache */
+        return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(reader));
+    }
+
+    throw std::runtime_error("serialized cache does not denote a GL graphics or compute PSO");
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(pipelineStateDesc, GetRenderingCaps().limits));
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreatePipelineState(pipelineStateDesc, serializedCache));
+    Serialization::Serializer writer;
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<GLGraphicsPSO>(
+            pipelineStateDesc,
+            GetRenderingCaps().limits,
+            (serializedCache != nullptr ? &writer : nullptr)
+        )
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = writer.Finalize();
+
+    return pipelineState;
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(pipelineStateDesc));
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreatePipelineState(pipelineStateDesc, serializedCache));
+    Serialization::Serializer writer;
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<GLComputePSO>(
+            pipelineStateDesc,
+            (serializedCache != nullptr ? &writer : nullptr)
+        )
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = writer.Finalize();
+
+    return pipelineState;
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(pipelineState));
     RemoveFromUniqueSet(pipelineStates_, &pipelineState);
 }
 
@@ -499,11 +621,13 @@ void GLRenderSystem::Release(PipelineState& pipelineState)
 
 QueryHeap* GLRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& quertHeapDesc)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateQueryHeap(quertHeapDesc));
     return TakeOwnership(queryHeaps_, MakeUnique<GLQueryHeap>(quertHeapDesc));
 }
 
 void GLRenderSystem::Release(QueryHeap& queryHeap)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(queryHeap));
     RemoveFromUniqueSet(queryHeaps_, &queryHeap);
 }
 
@@ -511,11 +635,13 @@ void GLRenderSystem::Release(QueryHeap& queryHeap)
 
 Fence* GLRenderSystem::CreateFence()
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateFence());
     return TakeOwnership(fences_, MakeUnique<GLFence>());
 }
 
 void GLRenderSystem::Release(Fence& fence)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Release(fence));
     RemoveFromUniqueSet(fences_, &fence);
 }
 
@@ -539,6 +665,46 @@ SwapChain* GLRenderSystem::AddSwapChain(std::unique_ptr<GLSwapChain>&& swapChain
  * ======= Private: =======
  */
 
+void GLRenderSystem::CreateHeadlessContext()
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(CreateHeadlessContext());
+    if (auto context = contextMngr_.AllocContext())
+        CreateGLContextDependentDevices(context->GetStateManager());
+}
+
+void GLRenderSystem::ReleaseGLObjects()
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(ReleaseGLObjects());
+
+    /* Clear all render state containers first */
+    readbackRing_.Clear();
+    GLTextureViewPool::Get().Clear();
+    GLMipGenerator::Get().Clear();
+    GLStatePool::Get().Clear();
+    GLStagingRing::Get().Clear();
+
+    /* Delete hardware objects in reverse order of their declaration and finally the GL contexts */
+    fences_.clear();
+    queryHeaps_.clear();
+    resourceHeaps_.clear();
+    pipelineStates_.clear();
+    pipelineLayouts_.clear();
+    shaders_.clear();
+    renderTargets_.clear();
+    renderPasses_.clear();
+    #ifdef LLGL_GL_ENABLE_OPENGL2X
+    samplersGL2X_.clear();
+    #endif
+    samplers_.clear();
+    textures_.clear();
+    bufferArrays_.clear();
+    buffers_.clear();
+    commandBuffers_.clear();
+    commandQueue_.reset();
+    swapChains_.clear();
+    contextMngr_.Clear();
+}
+
 void GLRenderSystem::CreateGLContextDependentDevices(GLStateManager& stateManager)
 {
     /* Enable debug callback function */
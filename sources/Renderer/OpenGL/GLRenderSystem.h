@@ -27,6 +27,7 @@
 #include "Texture/GLTexture.h"
 #include "Texture/GLSampler.h"
 #include "Texture/GLRenderTarget.h"
+#include "Texture/GLReadbackRing.h"
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 #   include "Texture/GL2XSampler.h"
 #endif
@@ -98,6 +99,10 @@ class GLRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        std::uint64_t ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType) override;
+        const void* MapTextureReadback(std::uint64_t ticket, bool wait = true, std::size_t* dataSize = nullptr) override;
+        void UnmapTextureReadback(std::uint64_t ticket) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& samplerDesc) override;
@@ -110,6 +115,8 @@ class GLRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
@@ -160,6 +167,12 @@ class GLRenderSystem final : public RenderSystem
 
     private:
 
+        // Creates the primary GL context for headless rendering and its dependent devices.
+        void CreateHeadlessContext();
+
+        // Releases all GL objects and contexts. This is invoked on the render thread if enabled.
+        void ReleaseGLObjects();
+
         void CreateGLContextDependentDevices(GLStateManager& stateManager);
 
         void SetDebugCallback(const DebugCallback& debugCallback);
@@ -176,6 +189,7 @@ class GLRenderSystem final : public RenderSystem
         /* ----- Hardware object containers ----- */
 
         GLContextManager                        contextMngr_;
+        GLReadbackRing                          readbackRing_;
 
         HWObjectContainer<GLSwapChain>          swapChains_;
         HWObjectInstance<GLCommandQueue>        commandQueue_;
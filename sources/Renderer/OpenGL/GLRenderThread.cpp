@@ -0,0 +1,75 @@
+/*
+ * GLRenderThread.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLRenderThread.h"
+#include "../../Core/Helper.h"
+#include <LLGL/Log.h>
+#include <exception>
+
+
+namespace LLGL
+{
+
+
+GLRenderThread& GLRenderThread::Get()
+{
+    static GLRenderThread instance;
+    return instance;
+}
+
+GLRenderThread::~GLRenderThread()
+{
+    Stop();
+}
+
+void GLRenderThread::Start()
+{
+    if (!thread_)
+    {
+        /* Create single worker thread and wait until its ID is known */
+        thread_ = MakeUnique<ThreadPool>(1);
+        std::promise<std::thread::id> threadIDPromise;
+        thread_->Enqueue([&threadIDPromise]() { threadIDPromise.set_value(std::this_thread::get_id()); });
+        threadID_ = threadIDPromise.get_future().get();
+    }
+}
+
+void GLRenderThread::Stop()
+{
+    /* Finish all pending tasks and join worker thread */
+    thread_.reset();
+    threadID_ = std::thread::id{};
+}
+
+bool GLRenderThread::IsMarshalRequired() const
+{
+    return (thread_ && std::this_thread::get_id() != threadID_);
+}
+
+void GLRenderThread::Post(ThreadPool::Task task)
+{
+    thread_->Enqueue(
+        [task]()
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                Log::PostReport(Log::ReportType::Error, e.what(), "on OpenGL render thread");
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,94 @@
+/*
+ * GLRenderThread.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_RENDER_THREAD_H
+#define LLGL_GL_RENDER_THREAD_H
+
+
+#include "../../Core/ThreadPool.h"
+#include <memory>
+#include <future>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+/*
+Dedicated thread that owns the GL context (see RendererConfigurationOpenGL::renderThread).
+All functions that issue GL calls are marshaled onto this thread when they are called from any other thread.
+Tasks are executed in the order they were scheduled, so posted submissions are always finished before a subsequent invocation returns.
+*/
+class GLRenderThread
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLRenderThread& Get();
+
+    public:
+
+        GLRenderThread(const GLRenderThread&) = delete;
+        GLRenderThread& operator = (const GLRenderThread&) = delete;
+
+        ~GLRenderThread();
+
+        // Starts the render thread. All subsequent GL work is marshaled onto this thread.
+        void Start();
+
+        // Finishes all pending tasks and stops the render thread.
+        void Stop();
+
+        // Returns true if the render thread is running and the calling thread is not the render thread.
+        bool IsMarshalRequired() const;
+
+        // Runs the specified function on the render thread and blocks until it has finished. Exceptions are rethrown on the calling thread.
+        template <typename TFunc>
+        auto Invoke(TFunc func) -> decltype(func());
+
+        // Schedules the specified task on the render thread without waiting for it. Exceptions are reported via the log.
+        void Post(ThreadPool::Task task);
+
+    private:
+
+        GLRenderThread() = default;
+
+    private:
+
+        std::unique_ptr<ThreadPool> thread_;
+        std::thread::id             threadID_;
+
+};
+
+template <typename TFunc>
+auto GLRenderThread::Invoke(TFunc func) -> decltype(func())
+{
+    /* Wrap function into a shared packaged task, since the task queue requires copyable functions */
+    using TResult = decltype(func());
+    auto task = std::make_shared<std::packaged_task<TResult()>>(std::move(func));
+    auto result = task->get_future();
+    thread_->Enqueue([task]() { (*task)(); });
+    return result.get();
+}
+
+
+} // /namespace LLGL
+
+
+/* Marshals the enclosing function onto the GL render thread by returning the result of the specified call when invoked from any other thread */
+#define LLGL_GL_INVOKE_ON_RENDER_THREAD(CALL)                                   \
+    if (::LLGL::GLRenderThread::Get().IsMarshalRequired())                      \
+        return ::LLGL::GLRenderThread::Get().Invoke([&]() { return CALL; })
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,48 @@
+/*
+ * GLSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SERIALIZATION_H
+#define LLGL_GL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for OpenGL serialization.
+enum GLIdent : IdentType
+{
+    GLIdent_ReservedGL = (RendererID::OpenGL << 8),
+    GLIdent_GraphicsPSOIdent,
+    GLIdent_ComputePSOIdent,
+    GLIdent_PipelineLayout, // BindingDescriptor[n]
+    GLIdent_ProgramDriver,  // LPCSTR (GL_VENDOR); LPCSTR (GL_RENDERER); LPCSTR (GL_VERSION)
+    GLIdent_ProgramBinary,  // GLenum; glGetProgramBinary
+    GLIdent_ProgramShader,  // GLenum; LPCSTR (source); GLShaderAttribute[n]; GLShaderAttribute[n]; LPCSTR[n]
+    GLIdent_GraphicsStates, // Depth-, stencil-, rasterizer-, and blend descriptors; static viewports and scissors
+};
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
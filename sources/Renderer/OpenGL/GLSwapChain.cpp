@@ -6,6 +6,7 @@
  */
 
 #include "GLSwapChain.h"
+#include "GLRenderThread.h"
 #include "../TextureUtils.h"
 #include "Platform/GLContextManager.h"
 
@@ -54,7 +55,11 @@ GLSwapChain::GLSwapChain(
 
 void GLSwapChain::Present()
 {
-    swapChainContext_->SwapBuffers();
+    /* Swap buffers asynchronously on the render thread after all previously submitted commands */
+    if (GLRenderThread::Get().IsMarshalRequired())
+        GLRenderThread::Get().Post([this]() { swapChainContext_->SwapBuffers(); });
+    else
+        swapChainContext_->SwapBuffers();
 }
 
 std::uint32_t GLSwapChain::GetSamples() const
@@ -79,6 +84,7 @@ const RenderPass* GLSwapChain::GetRenderPass() const
 
 bool GLSwapChain::SetVsyncInterval(std::uint32_t vsyncInterval)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetVsyncInterval(vsyncInterval));
     return SetSwapInterval(static_cast<int>(vsyncInterval));
 }
 
@@ -102,6 +108,8 @@ bool GLSwapChain::MakeCurrent(GLSwapChain* swapChain)
 
 bool GLSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(ResizeBuffersPrimary(resolution));
+
     /* Notify GL context of a resize */
     context_->Resize(resolution);
 
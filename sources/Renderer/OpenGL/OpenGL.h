@@ -24,6 +24,10 @@
 #   define LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
 #endif
 
+#if defined GL_ARB_draw_elements_base_vertex
+#   define LLGL_GLEXT_MULTI_DRAW_ELEMENTS_BASE_VERTEX
+#endif
+
 #if defined GL_ARB_base_instance
 #   define LLGL_GLEXT_BASE_INSTANCE
 #endif
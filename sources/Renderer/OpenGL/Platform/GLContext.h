@@ -82,6 +82,17 @@ class GLContext
             GLContext*                          sharedContext
         );
 
+        #ifdef LLGL_GL_ENABLE_EGL
+
+        // Creates a platform specific GLContext instance without a window system; see RendererConfigurationOpenGL::headless.
+        static std::unique_ptr<GLContext> CreateHeadless(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            GLContext*                          sharedContext
+        );
+
+        #endif // /LLGL_GL_ENABLE_EGL
+
         // Sets the current GL context. This only stores a reference to this context (GetCurrent) and its global index (GetGlobalIndex).
         static void SetCurrent(GLContext* context);
 
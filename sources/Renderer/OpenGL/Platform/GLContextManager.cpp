@@ -8,19 +8,20 @@
 #include "GLContextManager.h"
 #include "../RenderState/GLStateManager.h"
 #include "../Ext/GLExtensionLoader.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
 #include <LLGL/Window.h>
 #include <LLGL/Canvas.h>
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
-GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile)
+GLContextManager::GLContextManager(const RendererConfigurationOpenGL& profile) :
+    profile_ { profile }
 {
-    profile_.contextProfile = profile.contextProfile;
-    profile_.majorVersion   = profile.majorVersion;
-    profile_.minorVersion   = profile.minorVersion;
 }
 
 std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* pixelFormat, Surface* surface)
@@ -31,6 +32,11 @@ std::shared_ptr<GLContext> GLContextManager::AllocContext(const GLPixelFormat* p
         return FindOrMakeAnyContext();
 }
 
+void GLContextManager::Clear()
+{
+    pixelFormats_.clear();
+}
+
 
 /*
  * ======= Private: =======
@@ -57,6 +63,10 @@ std::unique_ptr<Surface> GLContextManager::CreatePlaceholderSurface()
 
 std::shared_ptr<GLContext> GLContextManager::MakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface)
 {
+    /* Headless contexts don't need any surface */
+    if (profile_.headless)
+        return MakeHeadlessContextWithPixelFormat(pixelFormat);
+
     /* Create placeholder surface is none was specified */
     std::unique_ptr<Surface> placeholderSurface;
     if (surface == nullptr)
@@ -79,16 +89,59 @@ std::shared_ptr<GLContext> GLContextManager::MakeContextWithPixelFormat(const GL
 
     auto context = pixelFormats_.back().context;
 
+    InitContext(*context);
+
+    return context;
+}
+
+std::shared_ptr<GLContext> GLContextManager::MakeHeadlessContextWithPixelFormat(const GLPixelFormat& pixelFormat)
+{
+    #ifdef LLGL_GL_ENABLE_EGL
+
+    /* Use shared GL context if there already is one */
+    GLContext* sharedContext = (pixelFormats_.empty() ? nullptr : pixelFormats_.front().context.get());
+
+    /* Create new headless GL context and append to pixel format list */
+    GLPixelFormatWithContext formatWithContext;
+    {
+        formatWithContext.pixelFormat   = pixelFormat;
+        formatWithContext.context       = GLContext::CreateHeadless(pixelFormat, profile_, sharedContext);
+    }
+    pixelFormats_.emplace_back(std::move(formatWithContext));
+
+    auto context = pixelFormats_.back().context;
+
+    /* Headless contexts are never made current by a swap-chain, so make it current here */
+    GLContext::SetCurrent(context.get());
+
+    InitContext(*context);
+
+    return context;
+
+    #else
+
+    (void)pixelFormat;
+    throw std::runtime_error("headless OpenGL context requires LLGL to be built with LLGL_GL_ENABLE_EGL");
+
+    #endif // /LLGL_GL_ENABLE_EGL
+}
+
+void GLContextManager::InitContext(GLContext& context)
+{
     /* Load GL extensions for the very first context */
     const bool hasGLCoreProfile = (profile_.contextProfile == OpenGLContextProfile::CoreProfile);
     LoadGLExtensions(hasGLCoreProfile);
 
     /* Initialize state manager for new GL context */
-    auto& stateMngr = context->GetStateManager();
+    auto& stateMngr = context.GetStateManager();
     stateMngr.DetermineExtensionsAndLimits();
     InitRenderStates(stateMngr);
 
-    return context;
+    #ifdef GL_KHR_parallel_shader_compile
+    /* Let the driver compile and link shaders in the background on as many threads as it supports */
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    #endif
 }
 
 std::shared_ptr<GLContext> GLContextManager::FindOrMakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface)
@@ -37,6 +37,9 @@ class GLContextManager
         // Returns a GL context with the specified pixel format or any context if 'pixelFormat' is null.
         std::shared_ptr<GLContext> AllocContext(const GLPixelFormat* pixelFormat = nullptr, Surface* surface = nullptr);
 
+        // Releases all GL contexts. This must be called on the thread the contexts were created on.
+        void Clear();
+
     public:
 
         // Returns the OpenGL profile configuration.
@@ -62,6 +65,12 @@ class GLContextManager
         // Makes a new GL context with the specified pixel format and creates a placeholder surface is none was specified.
         std::shared_ptr<GLContext> MakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface = nullptr);
 
+        // Makes a new headless GL context with the specified pixel format. Requires LLGL_GL_ENABLE_EGL.
+        std::shared_ptr<GLContext> MakeHeadlessContextWithPixelFormat(const GLPixelFormat& pixelFormat);
+
+        // Loads the GL extensions and initializes the state manager of the specified new GL context.
+        void InitContext(GLContext& context);
+
         // Returns a GL context with the specified pixel format or creates a new one if no suitable context could be found.
         std::shared_ptr<GLContext> FindOrMakeContextWithPixelFormat(const GLPixelFormat& pixelFormat, Surface* surface = nullptr);
 
@@ -0,0 +1,287 @@
+/*
+ * LinuxEGLContext.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+#include "LinuxEGLContext.h"
+#include "../../../CheckedCast.h"
+#include "../../../../Core/Helper.h"
+#include <LLGL/Log.h>
+#include <EGL/eglext.h>
+#include <string.h>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#ifndef EGL_CONTEXT_MAJOR_VERSION_KHR
+#define EGL_CONTEXT_MAJOR_VERSION_KHR 0x3098
+#endif
+
+#ifndef EGL_CONTEXT_MINOR_VERSION_KHR
+#define EGL_CONTEXT_MINOR_VERSION_KHR 0x30FB
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR 0x30FD
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR
+#define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR 0x00000001
+#endif
+
+#ifndef EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR
+#define EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR 0x00000002
+#endif
+
+typedef EGLDisplay (*EGLGETPLATFORMDISPLAYEXTPROC)(EGLenum, void*, const EGLint*);
+
+
+/*
+ * GLContext class
+ */
+
+std::unique_ptr<GLContext> GLContext::CreateHeadless(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    GLContext*                          sharedContext)
+{
+    LinuxEGLContext* sharedContextEGL = (sharedContext != nullptr ? LLGL_CAST(LinuxEGLContext*, sharedContext) : nullptr);
+    return MakeUnique<LinuxEGLContext>(pixelFormat, profile, sharedContextEGL);
+}
+
+
+/*
+ * LinuxEGLContext class
+ */
+
+LinuxEGLContext::LinuxEGLContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    LinuxEGLContext*                    sharedContext)
+:
+    samples_ { pixelFormat.samples }
+{
+    CreateContext(pixelFormat, profile, sharedContext);
+}
+
+LinuxEGLContext::~LinuxEGLContext()
+{
+    DeleteContext();
+}
+
+void LinuxEGLContext::Resize(const Extent2D& /*resolution*/)
+{
+    // dummy
+}
+
+int LinuxEGLContext::GetSamples() const
+{
+    return samples_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxEGLContext::SetSwapInterval(int /*interval*/)
+{
+    /* Headless contexts have no swap-chain */
+    return false;
+}
+
+// Returns true if the specified extension is contained in the space separated list of extension names.
+static bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (extensions != nullptr)
+    {
+        const auto nameLen = ::strlen(name);
+        for (auto s = ::strstr(extensions, name); s != nullptr; s = ::strstr(s + nameLen, name))
+        {
+            /* Ignore partial matches, e.g. "EGL_KHR_surfaceless_context" within "EGL_KHR_surfaceless_context_ext" */
+            if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+                return true;
+        }
+    }
+    return false;
+}
+
+void LinuxEGLContext::CreateContext(
+    const GLPixelFormat&                pixelFormat,
+    const RendererConfigurationOpenGL&  profile,
+    LinuxEGLContext*                    sharedContext)
+{
+    EGLContext sharedEGLContext = (sharedContext != nullptr ? sharedContext->context_ : EGL_NO_CONTEXT);
+
+    /* Initialize EGL display without window system */
+    InitializeDisplay();
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        throw std::runtime_error("failed to bind OpenGL API for EGL display");
+
+    /* Choose framebuffer configuration; the default framebuffer is never presented, so it only serves as the context's drawable */
+    EGLConfig config = ChooseConfig(pixelFormat);
+
+    if (profile.contextProfile == OpenGLContextProfile::CoreProfile)
+    {
+        /* Create core profile */
+        context_ = CreateContextCoreProfile(config, sharedEGLContext, profile.majorVersion, profile.minorVersion);
+    }
+
+    if (context_ == EGL_NO_CONTEXT)
+    {
+        /* Fall back to compatibility profile */
+        context_ = CreateContextCompatibilityProfile(config, sharedEGLContext);
+        if (context_ == EGL_NO_CONTEXT)
+            throw std::runtime_error("failed to create headless OpenGL context with EGL (error code = " + std::to_string(eglGetError()) + ")");
+    }
+
+    if (!surfaceless_)
+    {
+        /* Create minimal pbuffer surface if surfaceless contexts are not supported */
+        const EGLint pbufferAttribs[] =
+        {
+            EGL_WIDTH,  1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+        surface_ = eglCreatePbufferSurface(display_, config, pbufferAttribs);
+        if (surface_ == EGL_NO_SURFACE)
+            throw std::runtime_error("failed to create EGL pbuffer surface for headless OpenGL context");
+    }
+
+    /* Make new OpenGL context current */
+    if (eglMakeCurrent(display_, surface_, surface_, context_) != EGL_TRUE)
+        Log::PostReport(Log::ReportType::Error, "eglMakeCurrent failed on headless OpenGL context");
+
+    /* Deduce color and depth-stencil formats */
+    SetDefaultColorFormat();
+    DeduceDepthStencilFormat(pixelFormat.depthBits, pixelFormat.stencilBits);
+}
+
+void LinuxEGLContext::DeleteContext()
+{
+    if (display_ != EGL_NO_DISPLAY)
+    {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (surface_ != EGL_NO_SURFACE)
+            eglDestroySurface(display_, surface_);
+        if (context_ != EGL_NO_CONTEXT)
+            eglDestroyContext(display_, context_);
+        /* Display is not terminated here, since EGL returns the same display handle for all contexts */
+    }
+}
+
+void LinuxEGLContext::InitializeDisplay()
+{
+    /* Prefer the surfaceless platform (EGL_MESA_platform_surfaceless), which does not require any window system or device node */
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        auto eglGetPlatformDisplayEXT = reinterpret_cast<EGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (eglGetPlatformDisplayEXT != nullptr)
+            display_ = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+
+    /* Fall back to default display */
+    if (display_ == EGL_NO_DISPLAY)
+        display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    if (display_ == EGL_NO_DISPLAY)
+        throw std::runtime_error("failed to get EGL display for headless OpenGL context");
+
+    EGLint major = 0, minor = 0;
+    if (eglInitialize(display_, &major, &minor) != EGL_TRUE)
+    {
+        display_ = EGL_NO_DISPLAY;
+        throw std::runtime_error("failed to initialize EGL display for headless OpenGL context");
+    }
+
+    /* Check if contexts can be made current without any surface */
+    surfaceless_ = HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+}
+
+EGLConfig LinuxEGLContext::ChooseConfig(const GLPixelFormat& pixelFormat)
+{
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       (surfaceless_ ? 0 : EGL_PBUFFER_BIT),
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         (pixelFormat.colorBits == 32 ? 8 : 0),
+        EGL_DEPTH_SIZE,         pixelFormat.depthBits,
+        EGL_STENCIL_SIZE,       pixelFormat.stencilBits,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+
+    if (eglChooseConfig(display_, configAttribs, &config, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+        throw std::runtime_error("failed to choose EGL framebuffer configuration for headless OpenGL context");
+
+    return config;
+}
+
+EGLContext LinuxEGLContext::CreateContextCoreProfile(EGLConfig config, EGLContext sharedContext, int major, int minor)
+{
+    /* Try highest GL version first if no specific version was requested */
+    static const int glVersions[][2] = { { 4, 6 }, { 4, 5 }, { 4, 4 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 4, 0 }, { 3, 3 }, { 3, 2 } };
+
+    const bool hasVersion = (major != 0 || minor != 0);
+    const std::size_t numVersions = (hasVersion ? 1 : sizeof(glVersions)/sizeof(glVersions[0]));
+
+    for (std::size_t i = 0; i < numVersions; ++i)
+    {
+        const EGLint contextAttribs[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION_KHR,          (hasVersion ? major : glVersions[i][0]),
+            EGL_CONTEXT_MINOR_VERSION_KHR,          (hasVersion ? minor : glVersions[i][1]),
+            EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+            EGL_NONE
+        };
+
+        auto context = eglCreateContext(display_, config, sharedContext, contextAttribs);
+        if (context != EGL_NO_CONTEXT)
+            return context;
+    }
+
+    /* Context creation failed */
+    Log::PostReport(Log::ReportType::Error, "failed to create OpenGL core profile with EGL");
+
+    return EGL_NO_CONTEXT;
+}
+
+EGLContext LinuxEGLContext::CreateContextCompatibilityProfile(EGLConfig config, EGLContext sharedContext)
+{
+    /* Create compatibility profile */
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    return eglCreateContext(display_, config, sharedContext, contextAttribs);
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+
+// ================================================================================
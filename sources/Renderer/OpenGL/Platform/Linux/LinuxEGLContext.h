@@ -0,0 +1,93 @@
+/*
+ * LinuxEGLContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_EGL_CONTEXT_H
+#define LLGL_LINUX_EGL_CONTEXT_H
+
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+
+#include "../GLContext.h"
+#include "../../OpenGL.h"
+#include <LLGL/RendererConfiguration.h>
+#include <EGL/egl.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Implementation of the <GLContext> interface for headless GNU/Linux systems and wrapper for a native EGL context.
+The context is either surfaceless (EGL_KHR_surfaceless_context) or bound to a 1x1 pbuffer surface,
+so it can only render into offscreen render targets.
+*/
+class LinuxEGLContext : public GLContext
+{
+
+    public:
+
+        LinuxEGLContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            LinuxEGLContext*                    sharedContext
+        );
+        ~LinuxEGLContext();
+
+        void Resize(const Extent2D& resolution) override;
+        int GetSamples() const override;
+
+    public:
+
+        // Returns the native <EGLContext> object.
+        inline ::EGLContext GetEGLContext() const
+        {
+            return context_;
+        }
+
+    private:
+
+        bool SetSwapInterval(int interval) override;
+
+    private:
+
+        void CreateContext(
+            const GLPixelFormat&                pixelFormat,
+            const RendererConfigurationOpenGL&  profile,
+            LinuxEGLContext*                    sharedContext
+        );
+        void DeleteContext();
+
+        void InitializeDisplay();
+        EGLConfig ChooseConfig(const GLPixelFormat& pixelFormat);
+
+        EGLContext CreateContextCoreProfile(EGLConfig config, EGLContext sharedContext, int major, int minor);
+        EGLContext CreateContextCompatibilityProfile(EGLConfig config, EGLContext sharedContext);
+
+    private:
+
+        ::EGLDisplay    display_        = EGL_NO_DISPLAY;
+        ::EGLContext    context_        = EGL_NO_CONTEXT;
+        ::EGLSurface    surface_        = EGL_NO_SURFACE;
+        bool            surfaceless_    = false;
+        int             samples_        = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,8 +13,13 @@ namespace LLGL
 {
 
 
-GLComputePSO::GLComputePSO(const ComputePipelineDescriptor& desc) :
-    GLPipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, { desc.computeShader } }
+GLComputePSO::GLComputePSO(const ComputePipelineDescriptor& desc, Serialization::Serializer* writer) :
+    GLPipelineState { /*isGraphicsPSO:*/ false, desc.pipelineLayout, { desc.computeShader }, writer }
+{
+}
+
+GLComputePSO::GLComputePSO(Serialization::Deserializer& reader) :
+    GLPipelineState { /*isGraphicsPSO:*/ false, reader }
 {
 }
 
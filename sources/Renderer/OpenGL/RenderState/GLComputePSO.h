@@ -25,7 +25,8 @@ class GLComputePSO final : public GLPipelineState
 
     public:
 
-        GLComputePSO(const ComputePipelineDescriptor& desc);
+        GLComputePSO(const ComputePipelineDescriptor& desc, Serialization::Serializer* writer = nullptr);
+        GLComputePSO(Serialization::Deserializer& reader);
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "GLFence.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 
@@ -23,6 +24,7 @@ GLFence::~GLFence()
 
 void GLFence::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     #ifdef LLGL_DEBUG
     /* Only store name in fence object in debug mode, otherwise we want to keep fence objects as lightweight as possible */
     name_ = name;
@@ -12,6 +12,7 @@
 #include "../Shader/GLShaderProgram.h"
 #include "../GLTypes.h"
 #include "../GLCore.h"
+#include "../GLSerialization.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
 #include "../../../Core/ByteBufferIterator.h"
@@ -44,8 +45,18 @@ static std::vector<Shader*> GetShaderArrayFromDesc(const GraphicsPipelineDescrip
     return shaders;
 }
 
-GLGraphicsPSO::GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits) :
-    GLPipelineState { /*isGraphicsPSO:*/ true, desc.pipelineLayout, GetShaderArrayFromDesc(desc) }
+// Returns the size (in bytes) of the packed buffer for static viewports and scissors.
+static std::size_t GetStaticStateBufferSize(std::size_t numViewports, std::size_t numScissors)
+{
+    return
+    (
+        numViewports * (sizeof(GLViewport) + sizeof(GLDepthRange)) +
+        numScissors  * (sizeof(GLScissor))
+    );
+}
+
+GLGraphicsPSO::GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits, Serialization::Serializer* writer) :
+    GLPipelineState { /*isGraphicsPSO:*/ true, desc.pipelineLayout, GetShaderArrayFromDesc(desc), writer }
 {
     /* Convert input-assembler state */
     drawMode_       = GLTypes::ToDrawMode(desc.primitiveTopology);
@@ -75,17 +86,27 @@ GLGraphicsPSO::GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const Rende
     rasterizerState_ = GLStatePool::Get().CreateRasterizerState(desc.rasterizer);
 
     /* Create blend state */
+    std::uint32_t numColorAttachments = 1;
     if (auto renderPass = desc.renderPass)
     {
         auto renderPassGL = LLGL_CAST(const GLRenderPass*, renderPass);
-        blendState_ = GLStatePool::Get().CreateBlendState(desc.blend, renderPassGL->GetNumColorAttachments());
+        numColorAttachments = renderPassGL->GetNumColorAttachments();
     }
-    else
-        blendState_ = GLStatePool::Get().CreateBlendState(desc.blend, 1);
+    blendState_ = GLStatePool::Get().CreateBlendState(desc.blend, numColorAttachments);
 
     /* Build static state buffer for viewports and scissors */
     if (!desc.viewports.empty() || !desc.scissors.empty())
         BuildStaticStateBuffer(desc);
+
+    /* Write graphics states after shader program */
+    if (writer != nullptr)
+        WriteGraphicsStates(*writer, desc, numColorAttachments);
+}
+
+GLGraphicsPSO::GLGraphicsPSO(Serialization::Deserializer& reader) :
+    GLPipelineState { /*isGraphicsPSO:*/ true, reader }
+{
+    ReadGraphicsStates(reader);
 }
 
 GLGraphicsPSO::~GLGraphicsPSO()
@@ -125,14 +146,74 @@ void GLGraphicsPSO::Bind(GLStateManager& stateMngr)
  * ======= Private: =======
  */
 
+void GLGraphicsPSO::WriteGraphicsStates(Serialization::Serializer& writer, const GraphicsPipelineDescriptor& desc, std::uint32_t numColorAttachments)
+{
+    writer.Begin(Serialization::GLIdent_GraphicsStates);
+    {
+        /* Write input-assembler state */
+        writer.WriteTyped(drawMode_);
+        writer.WriteTyped(primitiveMode_);
+        writer.WriteTyped(patchVertices_);
+
+        /* Write descriptors of depth-stencil, rasterizer, and blend states */
+        writer.WriteTyped(desc.depth);
+        writer.WriteTyped(desc.stencil);
+        writer.WriteTyped(desc.rasterizer);
+        writer.WriteTyped(desc.blend);
+        writer.WriteTyped(numColorAttachments);
+
+        /* Write packed buffer for static viewports and scissors */
+        writer.WriteTyped(numStaticViewports_);
+        writer.WriteTyped(numStaticScissors_);
+        if (staticStateBuffer_)
+            writer.Write(staticStateBuffer_.get(), GetStaticStateBufferSize(numStaticViewports_, numStaticScissors_));
+    }
+    writer.End();
+}
+
+void GLGraphicsPSO::ReadGraphicsStates(Serialization::Deserializer& reader)
+{
+    reader.Begin(Serialization::GLIdent_GraphicsStates);
+    {
+        /* Read input-assembler state */
+        reader.ReadTyped(drawMode_);
+        reader.ReadTyped(primitiveMode_);
+        reader.ReadTyped(patchVertices_);
+
+        /* Read descriptors and create depth-stencil, rasterizer, and blend states */
+        DepthDescriptor         depthDesc;
+        StencilDescriptor       stencilDesc;
+        RasterizerDescriptor    rasterizerDesc;
+        BlendDescriptor         blendDesc;
+        std::uint32_t           numColorAttachments = 1;
+
+        reader.ReadTyped(depthDesc);
+        reader.ReadTyped(stencilDesc);
+        reader.ReadTyped(rasterizerDesc);
+        reader.ReadTyped(blendDesc);
+        reader.ReadTyped(numColorAttachments);
+
+        depthStencilState_  = GLStatePool::Get().CreateDepthStencilState(depthDesc, stencilDesc);
+        rasterizerState_    = GLStatePool::Get().CreateRasterizerState(rasterizerDesc);
+        blendState_         = GLStatePool::Get().CreateBlendState(blendDesc, numColorAttachments);
+
+        /* Read packed buffer for static viewports and scissors */
+        reader.ReadTyped(numStaticViewports_);
+        reader.ReadTyped(numStaticScissors_);
+        if (numStaticViewports_ > 0 || numStaticScissors_ > 0)
+        {
+            const std::size_t bufferSize = GetStaticStateBufferSize(numStaticViewports_, numStaticScissors_);
+            staticStateBuffer_ = MakeUniqueArray<char>(bufferSize);
+            reader.Read(staticStateBuffer_.get(), bufferSize);
+        }
+    }
+    reader.End();
+}
+
 void GLGraphicsPSO::BuildStaticStateBuffer(const GraphicsPipelineDescriptor& desc)
 {
     /* Allocate packed raw buffer */
-    const std::size_t bufferSize =
-    (
-        desc.viewports.size() * (sizeof(GLViewport) + sizeof(GLDepthRange)) +
-        desc.scissors.size()  * (sizeof(GLScissor))
-    );
+    const std::size_t bufferSize = GetStaticStateBufferSize(desc.viewports.size(), desc.scissors.size());
     staticStateBuffer_ = MakeUniqueArray<char>(bufferSize);
 
     ByteBufferIterator byteBufferIter { staticStateBuffer_.get() };
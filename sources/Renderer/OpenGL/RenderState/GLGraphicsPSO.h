@@ -30,7 +30,8 @@ class GLGraphicsPSO final : public GLPipelineState
 
     public:
 
-        GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits);
+        GLGraphicsPSO(const GraphicsPipelineDescriptor& desc, const RenderingLimits& limits, Serialization::Serializer* writer = nullptr);
+        GLGraphicsPSO(Serialization::Deserializer& reader);
         ~GLGraphicsPSO();
 
         // Binds this graphics pipeline state with the specified GL state manager.
@@ -50,6 +51,9 @@ class GLGraphicsPSO final : public GLPipelineState
 
     private:
 
+        void WriteGraphicsStates(Serialization::Serializer& writer, const GraphicsPipelineDescriptor& desc, std::uint32_t numColorAttachments);
+        void ReadGraphicsStates(Serialization::Deserializer& reader);
+
         void BuildStaticStateBuffer(const GraphicsPipelineDescriptor& desc);
         void BuildStaticViewports(std::size_t numViewports, const Viewport* viewports, ByteBufferIterator& byteBufferIter);
         void BuildStaticScissors(std::size_t numScissors, const Scissor* scissors, ByteBufferIterator& byteBufferIter);
@@ -9,7 +9,13 @@
 #include "GLStatePool.h"
 #include "GLStateManager.h"
 #include "../Shader/GLShaderProgram.h"
+#include "../Shader/GLShader.h"
+#include "../GLSerialization.h"
+#include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
+#include "../GLRenderThread.h"
+#include <LLGL/PipelineLayoutFlags.h>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -27,31 +33,82 @@ static bool AnyNamesInPipelineLayout(const GLPipelineLayout& pipelineLayout)
     return false;
 }
 
+// Writes the binding descriptors of the specified pipeline layout into the serialized cache.
+static void WritePipelineLayout(Serialization::Serializer& writer, const PipelineLayout* pipelineLayout)
+{
+    if (pipelineLayout != nullptr)
+    {
+        auto pipelineLayoutGL = LLGL_CAST(const GLPipelineLayout*, pipelineLayout);
+        const auto& bindings = pipelineLayoutGL->GetBindings();
+
+        writer.Begin(Serialization::GLIdent_PipelineLayout);
+        {
+            writer.WriteTyped(static_cast<std::uint32_t>(bindings.size()));
+            for (const auto& binding : bindings)
+            {
+                writer.WriteCString(binding.name.c_str());
+                writer.WriteTyped(binding.type);
+                writer.WriteTyped(binding.bindFlags);
+                writer.WriteTyped(binding.stageFlags);
+                writer.WriteTyped(binding.slot);
+                writer.WriteTyped(binding.arraySize);
+            }
+        }
+        writer.End();
+    }
+}
+
 GLPipelineState::GLPipelineState(
     bool                        isGraphicsPSO,
     const PipelineLayout*       pipelineLayout,
-    const ArrayView<Shader*>&   shaders)
+    const ArrayView<Shader*>&   shaders,
+    Serialization::Serializer*  writer)
 :
     isGraphicsPSO_ { isGraphicsPSO }
 {
+    /* Only monolithic shader programs can be serialized, since separable shaders are linked into individual programs */
+    if (writer != nullptr)
+    {
+        for (auto shader : shaders)
+        {
+            auto shaderGL = LLGL_CAST(const GLShader*, shader);
+            if (shaderGL->IsSeparable())
+                throw std::invalid_argument("cannot serialize GL pipeline state with separable shaders");
+        }
+    }
+
     /* Create shader pipeline */
     shaderPipeline_ = GLStatePool::Get().CreateShaderPipeline(shaders.size(), shaders.data());
-    shaderPipeline_->QueryInfoLogs(report_);
+    QueryOrDeferInfoLogs();
 
     /* Create shader binding layout by binding descriptor */
     if (pipelineLayout != nullptr)
     {
-        /* Ignore pipeline layout if there are no names specified, because no valid binding layout can be created then */
         auto pipelineLayoutGL = LLGL_CAST(const GLPipelineLayout*, pipelineLayout);
-        if (AnyNamesInPipelineLayout(*pipelineLayoutGL))
-        {
-            shaderBindingLayout_ = GLStatePool::Get().CreateShaderBindingLayout(*pipelineLayoutGL);
-            if (!shaderBindingLayout_->HasBindings())
-                GLStatePool::Get().ReleaseShaderBindingLayout(std::move(shaderBindingLayout_));
-        }
+        CreateShaderBindingLayout(*pipelineLayoutGL);
+    }
+
+    /* Write PSO identifier, pipeline layout, and shader program */
+    if (writer != nullptr)
+    {
+        writer->Begin(isGraphicsPSO ? Serialization::GLIdent_GraphicsPSOIdent : Serialization::GLIdent_ComputePSOIdent);
+        writer->End();
+        WritePipelineLayout(*writer, pipelineLayout);
+        auto shaderProgramGL = LLGL_CAST(const GLShaderProgram*, shaderPipeline_.get());
+        shaderProgramGL->Serialize(*writer, shaders.size(), shaders.data());
     }
 }
 
+GLPipelineState::GLPipelineState(bool isGraphicsPSO, Serialization::Deserializer& reader) :
+    isGraphicsPSO_ { isGraphicsPSO }
+{
+    ReadShaderBindingLayout(reader);
+
+    /* Create shader program from serialized cache; it is not shared with the state pool as it has no shader signature */
+    shaderPipeline_ = std::make_shared<GLShaderProgram>(reader);
+    QueryOrDeferInfoLogs();
+}
+
 GLPipelineState::~GLPipelineState()
 {
     GLStatePool::Get().ReleaseShaderPipeline(std::move(shaderPipeline_));
@@ -60,9 +117,21 @@ GLPipelineState::~GLPipelineState()
 
 const Report* GLPipelineState::GetReport() const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(GetReport());
+    if (isReportDeferred_)
+    {
+        shaderPipeline_->QueryInfoLogs(report_);
+        isReportDeferred_ = false;
+    }
     return (report_ ? &report_ : nullptr);
 }
 
+bool GLPipelineState::IsReady() const
+{
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(IsReady());
+    return shaderPipeline_->IsCompleted();
+}
+
 void GLPipelineState::Bind(GLStateManager& stateMngr)
 {
     /* Bind shader program and discard rasterizer if there is no fragment shader */
@@ -74,6 +143,61 @@ void GLPipelineState::Bind(GLStateManager& stateMngr)
 }
 
 
+
+/*
+ * ======= Private: =======
+ */
+
+void GLPipelineState::CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout)
+{
+    /* Ignore pipeline layout if there are no names specified, because no valid binding layout can be created then */
+    if (AnyNamesInPipelineLayout(pipelineLayout))
+    {
+        shaderBindingLayout_ = GLStatePool::Get().CreateShaderBindingLayout(pipelineLayout);
+        if (!shaderBindingLayout_->HasBindings())
+            GLStatePool::Get().ReleaseShaderBindingLayout(std::move(shaderBindingLayout_));
+    }
+}
+
+void GLPipelineState::QueryOrDeferInfoLogs()
+{
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+        isReportDeferred_ = true;
+    else
+        shaderPipeline_->QueryInfoLogs(report_);
+}
+
+void GLPipelineState::ReadShaderBindingLayout(Serialization::Deserializer& reader)
+{
+    auto seg = reader.BeginOnMatch(Serialization::GLIdent_PipelineLayout);
+    if (seg.ident != Serialization::GLIdent_PipelineLayout)
+        return;
+
+    /* Read binding descriptors */
+    std::uint32_t numBindings = 0;
+    reader.ReadTyped(numBindings);
+
+    PipelineLayoutDescriptor pipelineLayoutDesc;
+    pipelineLayoutDesc.bindings.resize(numBindings);
+
+    for (auto& binding : pipelineLayoutDesc.bindings)
+    {
+        binding.name = reader.ReadCString();
+        reader.ReadTyped(binding.type);
+        reader.ReadTyped(binding.bindFlags);
+        reader.ReadTyped(binding.stageFlags);
+        reader.ReadTyped(binding.slot);
+        reader.ReadTyped(binding.arraySize);
+    }
+
+    reader.End();
+
+    /* Create binding layout from temporary pipeline layout */
+    GLPipelineLayout pipelineLayout{ pipelineLayoutDesc };
+    CreateShaderBindingLayout(pipelineLayout);
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,7 @@
 #include "../OpenGL.h"
 #include "../Shader/GLShaderBindingLayout.h"
 #include "../Shader/GLShaderPipeline.h"
+#include "../../Serialization.h"
 #include "../../../Core/BasicReport.h"
 #include <LLGL/PipelineState.h>
 #include <LLGL/RenderSystemFlags.h>
@@ -35,11 +36,16 @@ class GLPipelineState : public PipelineState
         GLPipelineState(
             bool                        isGraphicsPSO,
             const PipelineLayout*       pipelineLayout,
-            const ArrayView<Shader*>&   shaders
+            const ArrayView<Shader*>&   shaders,
+            Serialization::Serializer*  writer          = nullptr
         );
+
+        // Creates the pipeline state from a serialized cache. The PSO identifier segment must already be consumed by the reader.
+        GLPipelineState(bool isGraphicsPSO, Serialization::Deserializer& reader);
         ~GLPipelineState();
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
 
         // Binds this pipeline state with the specified GL state manager.
         virtual void Bind(GLStateManager& stateMngr);
@@ -56,12 +62,24 @@ class GLPipelineState : public PipelineState
             return shaderPipeline_.get();
         }
 
+    private:
+
+        // Creates the shader binding layout if the pipeline layout contains any binding names.
+        void CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout);
+
+        // Reads the pipeline layout bindings from the serialized cache and creates the shader binding layout.
+        void ReadShaderBindingLayout(Serialization::Deserializer& reader);
+
+        // Queries the info logs of the shader pipeline, unless the driver links it in the background. In that case, the query is deferred until the report is requested.
+        void QueryOrDeferInfoLogs();
+
     private:
 
         const bool                  isGraphicsPSO_          = false;
         GLShaderPipelineSPtr        shaderPipeline_         = nullptr;
         GLShaderBindingLayoutSPtr   shaderBindingLayout_;
-        BasicReport                 report_;
+        mutable BasicReport         report_;
+        mutable bool                isReportDeferred_       = false;
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "GLQueryHeap.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../GLTypes.h"
@@ -91,6 +92,7 @@ GLQueryHeap::~GLQueryHeap()
 
 void GLQueryHeap::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     if (groupSize_ == 1)
     {
         /* Set label for a single native query object */
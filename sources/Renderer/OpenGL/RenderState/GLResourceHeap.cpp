@@ -18,10 +18,12 @@
 #include "../Texture/GLTextureViewPool.h"
 #include "../../CheckedCast.h"
 #include "../../ResourceBindingIterator.h"
+#include "../../../Core/Helper.h"
 #include "../GLTypes.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include <LLGL/ResourceHeapFlags.h>
+#include <algorithm>
 #include <string.h>
 
 
@@ -36,54 +38,53 @@ namespace LLGL
 /*
 
 The internal buffer of GLResourceHeap is tightly packed which stores all segments of binding points consecutively.
-Here is an illustration of the buffer layout for one Texture resouce (at binding point 4) and two Sampler resources (at binding points 5 and 6) on a 32-bit build:
+Each segment starts with a compact 8 byte header, followed by up to three sub-buffers that are aligned to the size of their elements.
+Every descriptor set is padded to a multiple of the cache line size and the buffer itself starts at a cache line boundary,
+so binding a descriptor set with only a few resources touches a single cache line.
+Here is an illustration of the buffer layout for one Texture resouce (at binding point 4) and two Sampler resources (at binding points 5 and 6) on a 64-bit build:
 
 Offset      Attribute                               Value   Description                                         Segment
 --------------------------------------------------------------------------------------------------------------------------------------------
-0x00000000  GLResourceViewHeapSegment2::segmentSize    24   Size of this segment                                \
-0x00000004  GLResourceViewHeapSegment2::offsetEnd0     20   Relative offset to texture[0] (at 0x00000014)        |
-0x00000008  GLResourceViewHeapSegment2::first           4   First binding point                                  |-- Texture segment
-0x0000000C  GLResourceViewHeapSegment2::count           1   Number of binding points                             |
-0x00000010  target[0]                                   1   Texture target (GLTextureTarget::TEXTURE_2D = 1)     |
-0x00000014  texture[0]                                  1   1st OpenGL texture ID (from 'glGenTextures')        /
-0x00000018  GLResourceViewHeapSegment1::segmentSize    20   Size of this segment                                \
-0x0000001C  GLResourceViewHeapSegment1::first           5   First binding point                                  |
-0x00000020  GLResourceViewHeapSegment1::count           2   Number of binding points                             |-- Sampler segment
-0x00000024  sampler[0]                                  1   1st OpenGL sampler ID (from 'glGenSamplers')         |
-0x00000028  sampler[1]                                  2   2nd OpenGL sampler ID (from 'glGenSamplers')        /
+0x00000000  GLResourceViewHeapSegment::segmentSize     16   Size of this segment                                \
+0x00000002  GLResourceViewHeapSegment::offset1         12   Relative offset to texture[0] (at 0x0000000C)        |
+0x00000004  GLResourceViewHeapSegment::offset2          0   Unused                                               |
+0x00000006  GLResourceViewHeapSegment::first            4   First binding point                                  |-- Texture segment
+0x00000007  GLResourceViewHeapSegment::count            1   Number of binding points                             |
+0x00000008  target[0]                                   1   Texture target (GLTextureTarget::TEXTURE_2D = 1)     |
+0x0000000C  texture[0]                                  1   1st OpenGL texture ID (from 'glGenTextures')        /
+0x00000010  GLResourceViewHeapSegment::segmentSize     16   Size of this segment                                \
+0x00000012  GLResourceViewHeapSegment::offset1          0   Unused                                               |
+0x00000014  GLResourceViewHeapSegment::offset2          0   Unused                                               |
+0x00000016  GLResourceViewHeapSegment::first            5   First binding point                                  |-- Sampler segment
+0x00000017  GLResourceViewHeapSegment::count            2   Number of binding points                             |
+0x00000018  sampler[0]                                  1   1st OpenGL sampler ID (from 'glGenSamplers')         |
+0x0000001C  sampler[1]                                  2   2nd OpenGL sampler ID (from 'glGenSamplers')        /
+0x00000020  <padding>                                       Padding up to the next cache line (0x00000040)
 
 */
 
-// Resource view heap (RVH) segment structure with one dynamic sub-buffer for <GLuint>
-struct GLResourceViewHeapSegment1
+// Resource view heap (RVH) segment header for up to three dynamic sub-buffers; the first sub-buffer directly follows the header.
+struct GLResourceViewHeapSegment
 {
-    std::size_t segmentSize;    // TODO: maybe use std::uint16_t for optimization
-    GLuint      first;          // TODO: maybe use std::uint8_t for optimization
-    GLsizei     count;          // TODO: maybe use std::uint8_t for optimization
+    std::uint16_t   segmentSize;    // Size of this segment (in bytes) including the header
+    std::uint16_t   offset1;        // Relative byte offset to the second sub-buffer
+    std::uint16_t   offset2;        // Relative byte offset to the third sub-buffer
+    std::uint8_t    first;          // First binding point
+    std::uint8_t    count;          // Number of consecutive binding points
 };
 
-// Resource view heap (RVH) segment structure with two dynamic sub-buffers, one for <GLTextureTarget> and one for <GLuint>; used for 'GLStateManager::BindTextures'.
-struct GLResourceViewHeapSegment2
-{
-    std::size_t segmentSize;
-    std::size_t offsetEnd0; // Byte offset after the first sub-buffer, following the second sub-buffer
-    GLuint      first;
-    GLsizei     count;
-};
+static_assert(sizeof(GLResourceViewHeapSegment) == 8, "GLResourceViewHeapSegment must be 8 bytes");
 
-// Resource view heap (RVH) segment structure with three dynamic sub-buffers, one for <GLuint>, one for <GLintptr>, and one for <GLsizeiptr>; used for 'GLStateManager::BindBuffersRange'.
-struct GLResourceViewHeapSegment3
-{
-    std::size_t segmentSize;
-    std::size_t offsetEnd0; // Byte offset after the first sub-buffer, following the second sub-buffer
-    std::size_t offsetEnd1; // Byte offset after the second sub-buffer, following the third sub-buffer
-    GLuint      first;
-    GLsizei     count;
-};
+// Alignment (in bytes) of each segment, which is the largest element size of all sub-buffers (GLintptr, GLsizeiptr, and pointers).
+static const std::size_t g_segmentAlignment = sizeof(GLintptr);
+
+// Alignment (in bytes) of the raw buffer and the stride of each descriptor set.
+static const std::size_t g_cacheLineSize = 64;
 
 // Helper struct to gather resource binding information for all segment types
 struct GLResourceBinding
 {
+    std::uint32_t       descriptor;
     GLuint              slot;
     GLuint              object;
     GLTextureTarget     target; // Only used for textures and image texture units
@@ -93,6 +94,7 @@ struct GLResourceBinding
     #ifdef LLGL_GL_ENABLE_OPENGL2X
     GLTexture*          textureGL;
     const GL2XSampler*  samplerGL2X;
+    std::uint32_t       samplerDescriptor;
     #endif
 };
 
@@ -110,6 +112,19 @@ static bool IsGLBufferViewEnabled(const BufferViewDescriptor& bufferViewDesc)
 
 #ifdef GL_ARB_shader_image_load_store
 
+// Returns the bitfield of <glMemoryBarrier> for the specified resource
+static GLbitfield GetMemoryBarrierBitfield(const Resource& resource)
+{
+    /* Enable <GL_SHADER_STORAGE_BARRIER_BIT> bitmask for UAV buffers */
+    if (resource.GetResourceType() == ResourceType::Buffer)
+    {
+        auto& buffer = LLGL_CAST(const Buffer&, resource);
+        if ((buffer.GetBindFlags() & BindFlags::Storage) != 0)
+            return GL_SHADER_STORAGE_BARRIER_BIT;
+    }
+    return 0;
+}
+
 // Returns the bitfield of <glMemoryBarrier> for the specified resources
 static GLbitfield GetMemoryBarrierBitfield(const std::vector<ResourceViewDescriptor>& resourceViews)
 {
@@ -118,15 +133,7 @@ static GLbitfield GetMemoryBarrierBitfield(const std::vector<ResourceViewDescrip
     for (const auto& desc : resourceViews)
     {
         if (auto resource = desc.resource)
-        {
-            /* Enable <GL_SHADER_STORAGE_BARRIER_BIT> bitmask for UAV buffers */
-            if (resource->GetResourceType() == ResourceType::Buffer)
-            {
-                auto buffer = LLGL_CAST(Buffer*, resource);
-                if ((buffer->GetBindFlags() & BindFlags::Storage) != 0)
-                    barriers |= GL_SHADER_STORAGE_BARRIER_BIT;
-            }
-        }
+            barriers |= GetMemoryBarrierBitfield(*resource);
     }
 
     return barriers;
@@ -134,18 +141,51 @@ static GLbitfield GetMemoryBarrierBitfield(const std::vector<ResourceViewDescrip
 
 #endif // /GL_ARB_shader_image_load_store
 
-// Returns the resource of the specified descriptor as <GLTexture> if it describes a texture-view.
-static GLTexture* GetAsTextureView(const ResourceViewDescriptor& rvDesc)
+// Returns the range of the specified buffer view; the entire buffer is used if the buffer view is disabled
+static void GetGLBufferRange(GLBuffer& bufferGL, const BufferViewDescriptor& bufferViewDesc, GLintptr& offset, GLsizeiptr& size)
 {
-    if (IsTextureViewEnabled(rvDesc.textureView))
+    if (IsGLBufferViewEnabled(bufferViewDesc))
     {
-        if (auto* resource = rvDesc.resource)
-        {
-            if (resource->GetResourceType() == ResourceType::Texture)
-                return LLGL_CAST(GLTexture*, resource);
-        }
+        /* Fill specified range for binding */
+        offset  = static_cast<GLintptr>(bufferViewDesc.offset);
+        size    = static_cast<GLsizeiptr>(bufferViewDesc.size);
+    }
+    else
+    {
+        /* Get buffer size and fill entire range for binding */
+        GLint bufferSize = 0;
+        bufferGL.GetBufferParams(&bufferSize, nullptr, nullptr);
+
+        offset  = 0;
+        size    = bufferSize;
     }
-    return nullptr;
+}
+
+// Returns true if the specified resource bindings require a buffer range instead of the entire buffer, i.e. a buffer view or a dynamic offset
+static bool RequiresRangeForGLResourceBindings(
+    ResourceBindingIterator&        resourceIterator,
+    ResourceType                    resourceType,
+    long                            resourceBindFlags)
+{
+    /* Collect all binding points of the specified resource type */
+    const BindingDescriptor* bindingDesc = nullptr;
+    const ResourceViewDescriptor* rvDesc = nullptr;
+    resourceIterator.Reset(resourceType, resourceBindFlags);
+
+    while (resourceIterator.Next(&bindingDesc, &rvDesc) != nullptr)
+    {
+        if (bindingDesc->dynamicOffset || IsGLBufferViewEnabled(rvDesc->bufferView))
+            return true;
+    }
+
+    return false;
+}
+
+// Throws an exception if the specified resource does not match the resource type of a descriptor
+static void ValidateResourceType(const Resource& resource, const ResourceType type)
+{
+    if (resource.GetResourceType() != type)
+        throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
 }
 
 
@@ -162,6 +202,7 @@ GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
 
     /* Validate binding descriptors */
     const auto& bindings            = pipelineLayoutGL->GetBindings();
+    const auto& bindingBuckets      = pipelineLayoutGL->GetBindingBuckets();
     const auto  numBindings         = bindings.size();
     const auto  numResourceViews    = desc.resourceViews.size();
 
@@ -177,53 +218,95 @@ GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
     barriers_ = 0;
     #endif // /GL_ARB_shader_image_load_store
 
-    /* Create all texture views */
+    /*
+    Determine whether buffers are bound with ranges for all descriptor sets at once,
+    since all sets share the same segmentation and therefore must have the same layout
+    */
+    const std::size_t numSets = numResourceViews / numBindings;
+    bool useUniformBufferRanges = false, useStorageBufferRanges = false;
+
     for (std::size_t i = 0; i < numResourceViews; i += numBindings)
     {
-        ResourceBindingIterator resourceIterator{ desc.resourceViews, bindings, i };
-        BuildTextureViews(resourceIterator, BindFlags::Sampled);
-        BuildTextureViews(resourceIterator, BindFlags::Storage);
+        ResourceBindingIterator resourceIterator{ desc.resourceViews, bindings, bindingBuckets, i };
+        if (!useUniformBufferRanges)
+            useUniformBufferRanges = RequiresRangeForGLResourceBindings(resourceIterator, ResourceType::Buffer, BindFlags::ConstantBuffer);
+        if (!useStorageBufferRanges)
+            useStorageBufferRanges = RequiresRangeForGLResourceBindings(resourceIterator, ResourceType::Buffer, (BindFlags::Sampled | BindFlags::Storage));
     }
 
-    /* Build all resource view segments */
+    /* Build all resource view segments and keep track of where each descriptor is located */
+    locations_.resize(numResourceViews);
+
     for (std::size_t i = 0; i < numResourceViews; i += numBindings)
     {
         /* Reset segment header, only one is required */
-        ResourceBindingIterator resourceIterator{ desc.resourceViews, bindings, i };
+        ResourceBindingIterator resourceIterator{ desc.resourceViews, bindings, bindingBuckets, i };
         ::memset(&segmentation_, 0, sizeof(segmentation_));
 
         /* Build resource view segments for current descriptor set */
-        BuildUniformBufferSegments(resourceIterator);
-        BuildStorageBufferSegments(resourceIterator);
+        BuildUniformBufferSegments(resourceIterator, useUniformBufferRanges);
+        BuildStorageBufferSegments(resourceIterator, useStorageBufferRanges);
         BuildTextureSegments(resourceIterator);
         BuildImageTextureSegments(resourceIterator);
         BuildSamplerSegments(resourceIterator);
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         BuildGL2XSamplerSegments(resourceIterator);
         #endif
+
+        /* Pad each descriptor set to a multiple of the cache line size, so no set straddles more cache lines than necessary */
+        buffer_.resize(GetAlignedSize(buffer_.size(), g_cacheLineSize));
     }
 
     /* Store buffer stride */
-    stride_ = GetSegmentationHeapSize() / (numResourceViews / numBindings);
+    stride_ = buffer_.size() / numSets;
+
+    /* Shift all segments to the first cache line boundary within the raw buffer, since std::vector gives no alignment guarantee beyond the default */
+    const std::size_t heapSize = buffer_.size();
+    buffer_.resize(heapSize + g_cacheLineSize - 1);
+    const auto misalignment = static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(buffer_.data()) % g_cacheLineSize);
+    heapOffset_ = (misalignment > 0 ? g_cacheLineSize - misalignment : 0);
+    if (heapOffset_ > 0)
+        ::memmove(&buffer_[heapOffset_], &buffer_[0], heapSize);
+
+    /* Store bindings with dynamic offsets and which of their buffer ranges cover the entire buffer */
+    numBindings_ = static_cast<std::uint32_t>(numBindings);
+
+    for (std::size_t i = 0; i < numBindings; ++i)
+    {
+        if (bindings[i].dynamicOffset)
+            dynamicBindings_.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    for (std::size_t i = 0; i < numResourceViews; ++i)
+    {
+        if (locations_[i].type == DescriptorType::BufferRange)
+            locations_[i].wholeRange = !IsGLBufferViewEnabled(desc.resourceViews[i].bufferView);
+    }
 }
 
 GLResourceHeap::~GLResourceHeap()
 {
     /* Release all texture views for this resource heap */
-    const GLuint* textureViewIDs = reinterpret_cast<const GLuint*>(buffer_.data());
-    for (std::size_t i = 0; i < numTextureViews_; ++i)
-        GLTextureViewPool::Get().ReleaseTextureView(textureViewIDs[i]);
+    for (auto& location : locations_)
+        ReleaseTextureView(location);
+}
+
+// Returns the sub-buffer of the specified segment at the relative byte offset.
+template <typename T>
+static const T* GetSegmentSubBuffer(const GLResourceViewHeapSegment* segment, std::size_t offset)
+{
+    return reinterpret_cast<const T*>(reinterpret_cast<const std::int8_t*>(segment) + offset);
 }
 
 static void BindBuffersBaseSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer, const GLBufferTarget bufferTarget)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment1*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
         stateMngr.BindBuffersBase(
             bufferTarget,
             segment->first,
             segment->count,
-            reinterpret_cast<const GLuint*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment1))
+            GetSegmentSubBuffer<GLuint>(segment, sizeof(GLResourceViewHeapSegment))
         );
     }
     byteAlignedBuffer += segment->segmentSize;
@@ -231,15 +314,15 @@ static void BindBuffersBaseSegment(GLStateManager& stateMngr, const std::int8_t*
 
 static void BindBuffersRangeSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer, const GLBufferTarget bufferTarget)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment3*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
         stateMngr.BindBuffersRange(
             bufferTarget,
             segment->first,
             segment->count,
-            reinterpret_cast<const GLuint*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment3)),
-            reinterpret_cast<const GLintptr*>(byteAlignedBuffer + segment->offsetEnd0),
-            reinterpret_cast<const GLsizeiptr*>(byteAlignedBuffer + segment->offsetEnd1)
+            GetSegmentSubBuffer<GLuint>(segment, sizeof(GLResourceViewHeapSegment)),
+            GetSegmentSubBuffer<GLintptr>(segment, segment->offset1),
+            GetSegmentSubBuffer<GLsizeiptr>(segment, segment->offset2)
         );
     }
     byteAlignedBuffer += segment->segmentSize;
@@ -247,13 +330,13 @@ static void BindBuffersRangeSegment(GLStateManager& stateMngr, const std::int8_t
 
 static void BindTexturesSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment2*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
         stateMngr.BindTextures(
             segment->first,
             segment->count,
-            reinterpret_cast<const GLTextureTarget*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment2)),
-            reinterpret_cast<const GLuint*>(byteAlignedBuffer + segment->offsetEnd0)
+            GetSegmentSubBuffer<GLTextureTarget>(segment, sizeof(GLResourceViewHeapSegment)),
+            GetSegmentSubBuffer<GLuint>(segment, segment->offset1)
         );
     }
     byteAlignedBuffer += segment->segmentSize;
@@ -261,13 +344,13 @@ static void BindTexturesSegment(GLStateManager& stateMngr, const std::int8_t*& b
 
 static void BindImageTexturesSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment2*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
         stateMngr.BindImageTextures(
             segment->first,
             segment->count,
-            reinterpret_cast<const GLenum*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment2)),
-            reinterpret_cast<const GLuint*>(byteAlignedBuffer + segment->offsetEnd0)
+            GetSegmentSubBuffer<GLenum>(segment, sizeof(GLResourceViewHeapSegment)),
+            GetSegmentSubBuffer<GLuint>(segment, segment->offset1)
         );
     }
     byteAlignedBuffer += segment->segmentSize;
@@ -275,12 +358,12 @@ static void BindImageTexturesSegment(GLStateManager& stateMngr, const std::int8_
 
 static void BindSamplersSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment1*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
         stateMngr.BindSamplers(
             segment->first,
             segment->count,
-            reinterpret_cast<const GLuint*>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment1))
+            GetSegmentSubBuffer<GLuint>(segment, sizeof(GLResourceViewHeapSegment))
         );
     }
     byteAlignedBuffer += segment->segmentSize;
@@ -290,11 +373,11 @@ static void BindSamplersSegment(GLStateManager& stateMngr, const std::int8_t*& b
 
 static void BindTexturesWithGL2XSamplersSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer)
 {
-    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment2*>(byteAlignedBuffer);
+    const auto segment = reinterpret_cast<const GLResourceViewHeapSegment*>(byteAlignedBuffer);
     {
-        const auto texturesGL   = reinterpret_cast<GLTexture* const *>(byteAlignedBuffer + sizeof(GLResourceViewHeapSegment2));
-        const auto samplersGL2X = reinterpret_cast<const GL2XSampler* const *>(byteAlignedBuffer + segment->offsetEnd0);
-        for (GLsizei i = 0; i < segment->count; ++i)
+        const auto texturesGL   = GetSegmentSubBuffer<GLTexture*>(segment, sizeof(GLResourceViewHeapSegment));
+        const auto samplersGL2X = GetSegmentSubBuffer<const GL2XSampler*>(segment, segment->offset1);
+        for (std::uint8_t i = 0; i < segment->count; ++i)
         {
             stateMngr.BindGLTexture(*texturesGL[i]);
             if (auto samplerGL2X = samplersGL2X[i])
@@ -308,12 +391,16 @@ static void BindTexturesWithGL2XSamplersSegment(GLStateManager& stateMngr, const
 
 std::uint32_t GLResourceHeap::GetNumDescriptorSets() const
 {
-    return static_cast<std::uint32_t>(stride_ > 0 ? GetSegmentationHeapSize() / stride_ : 0);
+    return (numBindings_ > 0 ? static_cast<std::uint32_t>(locations_.size() / numBindings_) : 0);
 }
 
-void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t firstSet)
+void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t firstSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
 {
-    auto byteAlignedBuffer = GetSegmentationHeapStart(firstSet);
+    auto byteAlignedBuffer = (
+        numDynamicOffsets > 0 && !dynamicBindings_.empty()
+            ? ApplyDynamicOffsets(firstSet, numDynamicOffsets, dynamicOffsets)
+            : GetSegmentationHeapStart(firstSet)
+    );
 
     #ifdef GL_ARB_shader_image_load_store
 
@@ -359,6 +446,28 @@ void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t firstSet)
     }
 }
 
+std::uint32_t GLResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    if (firstDescriptor >= locations_.size())
+        return 0;
+
+    /* Patch segment entries of all descriptors within the range of this heap; null resources keep their previous descriptor */
+    const std::size_t numResourceViews = std::min(resourceViews.size(), locations_.size() - firstDescriptor);
+
+    std::uint32_t numWritten = 0;
+    for (std::size_t i = 0; i < numResourceViews; ++i)
+    {
+        const auto& rvDesc = resourceViews[i];
+        if (auto resource = rvDesc.resource)
+        {
+            WriteResourceView(locations_[firstDescriptor + i], *resource, rvDesc);
+            ++numWritten;
+        }
+    }
+
+    return numWritten;
+}
+
 
 /*
  * ======= Private: =======
@@ -390,6 +499,7 @@ static std::vector<GLResourceBinding> CollectGLResourceBindings(
     while (auto resource = resourceIterator.Next(&bindingDesc, &rvDesc))
     {
         GLResourceBinding binding = {};
+        binding.descriptor = static_cast<std::uint32_t>(resourceIterator.GetLastResourceIndex());
         bindingFunc(binding, resource, *rvDesc, bindingDesc->slot);
         resourceBindings.push_back(binding);
     }
@@ -406,42 +516,6 @@ static std::vector<GLResourceBinding> CollectGLResourceBindings(
     return resourceBindings;
 }
 
-// Returns true if the specified resource bindings require a buffer range instead of the entire buffer
-static bool RequiresRangeForGLResourceBindings(
-    ResourceBindingIterator&        resourceIterator,
-    ResourceType                    resourceType,
-    long                            resourceBindFlags)
-{
-    /* Collect all binding points of the specified resource type */
-    const ResourceViewDescriptor* rvDesc = nullptr;
-    resourceIterator.Reset(resourceType, resourceBindFlags);
-
-    std::vector<GLResourceBinding> resourceBindings;
-    resourceBindings.reserve(resourceIterator.GetCount());
-
-    while (resourceIterator.Next(nullptr, &rvDesc) != nullptr)
-    {
-        if (IsGLBufferViewEnabled(rvDesc->bufferView))
-            return true;
-    }
-
-    return false;
-}
-
-void GLResourceHeap::BuildTextureViews(ResourceBindingIterator& resourceIterator, long bindFlags)
-{
-    const ResourceViewDescriptor* rvDesc = nullptr;
-    resourceIterator.Reset(ResourceType::Texture, bindFlags);
-    while (auto resource = resourceIterator.Next(nullptr, &rvDesc))
-    {
-        if (auto textureGL = GetAsTextureView(*rvDesc))
-        {
-            GLuint texID = GLTextureViewPool::Get().CreateTextureView(textureGL->GetID(), rvDesc->textureView);
-            WriteSegmentationHeapEnd(&texID, sizeof(texID));
-        }
-    }
-}
-
 void GLResourceHeap::BuildBufferSegments(ResourceBindingIterator& resourceIterator, long bindFlags, std::uint8_t& numSegments)
 {
     /* Collect all buffers */
@@ -457,10 +531,10 @@ void GLResourceHeap::BuildBufferSegments(ResourceBindingIterator& resourceIterat
         }
     );
 
-    /* Build all resource segments for type <GLResourceViewHeapSegment1> */
+    /* Build all resource segments of type <GLResourceViewHeapSegment> with one sub-buffer */
     BuildAllSegments(
         resourceBindings,
-        std::bind(&GLResourceHeap::BuildSegment1, this, std::placeholders::_1, std::placeholders::_2),
+        std::bind(&GLResourceHeap::BuildSegment1, this, std::placeholders::_1, std::placeholders::_2, DescriptorType::Buffer),
         numSegments
     );
 }
@@ -477,26 +551,11 @@ void GLResourceHeap::BuildBufferRangeSegments(ResourceBindingIterator& resourceI
             auto bufferGL = LLGL_CAST(GLBuffer*, resource);
             binding.slot    = slot;
             binding.object  = bufferGL->GetID();
-
-            if (IsGLBufferViewEnabled(rvDesc.bufferView))
-            {
-                /* Fill specified range for binding */
-                binding.offset  = static_cast<GLintptr>(rvDesc.bufferView.offset);
-                binding.size    = static_cast<GLsizeiptr>(rvDesc.bufferView.size);
-            }
-            else
-            {
-                /* Get buffer size and fill entire range for binding */
-                GLint bufferSize = 0;
-                bufferGL->GetBufferParams(&bufferSize, nullptr, nullptr);
-
-                binding.offset  = 0;
-                binding.size    = bufferSize;
-            }
+            GetGLBufferRange(*bufferGL, rvDesc.bufferView, binding.offset, binding.size);
         }
     );
 
-    /* Build all resource segments for type <GLResourceViewHeapSegment3> */
+    /* Build all resource segments of type <GLResourceViewHeapSegment> with three sub-buffers */
     BuildAllSegments(
         resourceBindings,
         std::bind(&GLResourceHeap::BuildSegment3, this, std::placeholders::_1, std::placeholders::_2),
@@ -504,19 +563,19 @@ void GLResourceHeap::BuildBufferRangeSegments(ResourceBindingIterator& resourceI
     );
 }
 
-void GLResourceHeap::BuildUniformBufferSegments(ResourceBindingIterator& resourceIterator)
+void GLResourceHeap::BuildUniformBufferSegments(ResourceBindingIterator& resourceIterator, bool useRanges)
 {
     const long bindFlags = BindFlags::ConstantBuffer;
-    if (RequiresRangeForGLResourceBindings(resourceIterator, ResourceType::Buffer, bindFlags))
+    if (useRanges)
         BuildBufferRangeSegments(resourceIterator, bindFlags, segmentation_.numUniformBufferRangeSegments);
     else
         BuildBufferSegments(resourceIterator, bindFlags, segmentation_.numUniformBufferSegments);
 }
 
-void GLResourceHeap::BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator)
+void GLResourceHeap::BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator, bool useRanges)
 {
     const long bindFlags = (BindFlags::Sampled | BindFlags::Storage);
-    if (RequiresRangeForGLResourceBindings(resourceIterator, ResourceType::Buffer, bindFlags))
+    if (useRanges)
         BuildBufferRangeSegments(resourceIterator, bindFlags, segmentation_.numStorageBufferRangeSegments);
     else
         BuildBufferSegments(resourceIterator, bindFlags, segmentation_.numStorageBufferSegments);
@@ -535,24 +594,18 @@ void GLResourceHeap::BuildTextureSegments(ResourceBindingIterator& resourceItera
             BindFlags::Sampled,
             [this](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& rvDesc, std::uint32_t slot)
             {
-                binding.slot = slot;
+                /* Generate resource binding for texture resource or custom texture-view subresource */
+                auto textureGL = LLGL_CAST(GLTexture*, resource);
+                binding.slot    = slot;
+                binding.object  = GetOrCreateTextureView(locations_[binding.descriptor], *textureGL, rvDesc.textureView);
                 if (IsTextureViewEnabled(rvDesc.textureView))
-                {
-                    /* Generate resource binding for custom texture-view subresource */
-                    binding.object = GetTextureViewID(this->numTextureViews_++);
                     binding.target = GLStateManager::GetTextureTarget(rvDesc.textureView.type);
-                }
                 else
-                {
-                    /* Generate resource binding for texture resource */
-                    auto textureGL = LLGL_CAST(GLTexture*, resource);
-                    binding.object = textureGL->GetID();
                     binding.target = GLStateManager::GetTextureTarget(textureGL->GetType());
-                }
             }
         );
 
-        /* Build all resource segments for type <GLResourceViewHeapSegment2> */
+        /* Build all resource segments of type <GLResourceViewHeapSegment> with two sub-buffers */
         BuildAllSegments(
             resourceBindings,
             std::bind(&GLResourceHeap::BuildSegment2Target, this, std::placeholders::_1, std::placeholders::_2),
@@ -570,24 +623,18 @@ void GLResourceHeap::BuildImageTextureSegments(ResourceBindingIterator& resource
         BindFlags::Storage,
         [this](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& rvDesc, std::uint32_t slot)
         {
-            binding.slot = slot;
+            /* Generate resource binding for texture resource or custom texture-view subresource */
+            auto textureGL = LLGL_CAST(GLTexture*, resource);
+            binding.slot    = slot;
+            binding.object  = GetOrCreateTextureView(locations_[binding.descriptor], *textureGL, rvDesc.textureView);
             if (IsTextureViewEnabled(rvDesc.textureView))
-            {
-                /* Generate resource binding for custom texture-view subresource */
-                binding.object = GetTextureViewID(this->numTextureViews_++);
                 binding.format = GLTypes::Map(rvDesc.textureView.format);
-            }
             else
-            {
-                /* Generate resource binding for texture resource */
-                auto textureGL = LLGL_CAST(GLTexture*, resource);
-                binding.object = textureGL->GetID();
                 binding.format = textureGL->GetGLInternalFormat();
-            }
         }
     );
 
-    /* Build all resource segments for type <GLResourceViewHeapSegment2> */
+    /* Build all resource segments of type <GLResourceViewHeapSegment> with two sub-buffers */
     BuildAllSegments(
         resourceBindings,
         std::bind(&GLResourceHeap::BuildSegment2Format, this, std::placeholders::_1, std::placeholders::_2),
@@ -614,10 +661,10 @@ void GLResourceHeap::BuildSamplerSegments(ResourceBindingIterator& resourceItera
             }
         );
 
-        /* Build all resource segments for type <GLResourceViewHeapSegment1> */
+        /* Build all resource segments of type <GLResourceViewHeapSegment> with one sub-buffer */
         BuildAllSegments(
             resourceBindings,
-            std::bind(&GLResourceHeap::BuildSegment1, this, std::placeholders::_1, std::placeholders::_2),
+            std::bind(&GLResourceHeap::BuildSegment1, this, std::placeholders::_1, std::placeholders::_2, DescriptorType::Sampler),
             segmentation_.numSamplerSegments
         );
     }
@@ -637,7 +684,7 @@ void GLResourceHeap::BuildGL2XSamplerSegments(ResourceBindingIterator& resourceI
         if (maxNumTextures <= 0)
             throw std::runtime_error("GL_MAX_TEXTURE_IMAGE_UNITS ( " + std::to_string(maxNumTextures) +  " ) must be greater than zero");
 
-        std::vector<const GL2XSampler*> samplerSlots;
+        std::vector<GLResourceBinding> samplerSlots;
         samplerSlots.resize(static_cast<std::size_t>(maxNumTextures));
 
         CollectGLResourceBindings(
@@ -650,7 +697,8 @@ void GLResourceHeap::BuildGL2XSamplerSegments(ResourceBindingIterator& resourceI
                 {
                     /* Generate resource binding for texture resource and GL2.x sampler */
                     auto samplerGL2X = LLGL_CAST(GL2XSampler*, resource);
-                    samplerSlots[slot] = samplerGL2X;
+                    samplerSlots[slot].samplerGL2X          = samplerGL2X;
+                    samplerSlots[slot].samplerDescriptor    = binding.descriptor;
                 }
             }
         );
@@ -660,17 +708,21 @@ void GLResourceHeap::BuildGL2XSamplerSegments(ResourceBindingIterator& resourceI
             resourceIterator,
             ResourceType::Texture,
             BindFlags::Sampled,
-            [this, &samplerSlots](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& rvDesc, std::uint32_t slot)
+            [&samplerSlots](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& rvDesc, std::uint32_t slot)
             {
                 /* Generate resource binding for texture resource and GL2.x sampler */
                 auto textureGL = LLGL_CAST(GLTexture*, resource);
                 binding.slot        = slot;
                 binding.textureGL   = textureGL;
-                binding.samplerGL2X = (slot < samplerSlots.size() ? samplerSlots[slot] : nullptr);
+                if (slot < samplerSlots.size())
+                {
+                    binding.samplerGL2X         = samplerSlots[slot].samplerGL2X;
+                    binding.samplerDescriptor   = samplerSlots[slot].samplerDescriptor;
+                }
             }
         );
 
-        /* Build all resource segments for type <GLResourceViewHeapSegment2> */
+        /* Build all resource segments of type <GLResourceViewHeapSegment> with two sub-buffers */
         BuildAllSegments(
             textureBindings,
             std::bind(&GLResourceHeap::BuildSegment2GL2XSampler, this, std::placeholders::_1, std::placeholders::_2),
@@ -716,187 +768,345 @@ void GLResourceHeap::BuildAllSegments(
     }
 }
 
-void GLResourceHeap::BuildSegment1(GLResourceBindingIter it, GLsizei count)
+std::size_t GLResourceHeap::AllocSegment(GLResourceBindingIter it, GLsizei count, std::size_t elementSize0, std::size_t elementSize1, std::size_t elementSize2)
 {
-    std::size_t startOffset = buffer_.size();
+    /* Validate limits of the compact segment header */
+    if (it->slot > 0xFF || count > 0xFF)
+        throw std::invalid_argument("cannot create resource heap with binding slots greater than 255");
+
+    /* Determine sub-buffer offsets; each sub-buffer is aligned to the size of its elements */
+    const std::size_t offset1       = GetAlignedSize(sizeof(GLResourceViewHeapSegment) + elementSize0 * count, std::max(elementSize1, std::size_t(1)));
+    const std::size_t offset2       = GetAlignedSize(offset1 + elementSize1 * count, std::max(elementSize2, std::size_t(1)));
+    const std::size_t segmentSize   = GetAlignedSize(offset2 + elementSize2 * count, g_segmentAlignment);
+
+    if (segmentSize > 0xFFFF)
+        throw std::invalid_argument("cannot create resource heap with segment size greater than 65535 bytes");
 
     /* Allocate space for segment */
-    const std::size_t segmentSize = sizeof(GLResourceViewHeapSegment1) + sizeof(GLuint) * count;
+    const std::size_t startOffset = buffer_.size();
     buffer_.resize(startOffset + segmentSize);
 
     /* Write segment header */
-    auto segment = reinterpret_cast<GLResourceViewHeapSegment1*>(&buffer_[startOffset]);
+    auto segment = reinterpret_cast<GLResourceViewHeapSegment*>(&buffer_[startOffset]);
     {
-        segment->segmentSize    = segmentSize;
-        segment->first          = it->slot;
-        segment->count          = count;
+        segment->segmentSize    = static_cast<std::uint16_t>(segmentSize);
+        segment->offset1        = static_cast<std::uint16_t>(elementSize1 > 0 ? offset1 : 0);
+        segment->offset2        = static_cast<std::uint16_t>(elementSize2 > 0 ? offset2 : 0);
+        segment->first          = static_cast<std::uint8_t>(it->slot);
+        segment->count          = static_cast<std::uint8_t>(count);
     }
 
-    /* Write segment body */
-    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment1)]);
-    for (GLsizei i = 0; i < count; ++i, ++it)
-        segmentIDs[i] = it->object;
+    return startOffset;
 }
 
-void GLResourceHeap::BuildSegment2Target(GLResourceBindingIter it, GLsizei count)
+void GLResourceHeap::BuildSegment1(GLResourceBindingIter it, GLsizei count, DescriptorType type)
 {
-    std::size_t startOffset = buffer_.size();
+    const std::size_t startOffset   = AllocSegment(it, count, sizeof(GLuint));
+    const std::size_t offset0       = startOffset + sizeof(GLResourceViewHeapSegment);
 
-    /* Allocate space for segment */
-    const std::size_t segmentOffsetEnd0 = sizeof(GLResourceViewHeapSegment2) + sizeof(GLTextureTarget) * count;
-    const std::size_t segmentSize       = segmentOffsetEnd0 + sizeof(GLuint) * count;
-    buffer_.resize(startOffset + segmentSize);
+    /* Write segment body */
+    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[offset0]);
+    auto begin = it;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+        segmentIDs[i] = it->object;
 
-    /* Write segment header */
-    auto segment = reinterpret_cast<GLResourceViewHeapSegment2*>(&buffer_[startOffset]);
+    /* Store locations of all descriptors in this segment */
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
     {
-        segment->segmentSize    = segmentSize;
-        segment->offsetEnd0     = segmentOffsetEnd0;
-        segment->first          = it->slot;
-        segment->count          = count;
+        auto& location = locations_[it->descriptor];
+        location.type       = type;
+        location.offset0    = static_cast<std::uint32_t>(offset0 + sizeof(GLuint) * i);
     }
+}
+
+void GLResourceHeap::BuildSegment2Target(GLResourceBindingIter it, GLsizei count)
+{
+    const std::size_t startOffset   = AllocSegment(it, count, sizeof(GLTextureTarget), sizeof(GLuint));
+    const std::size_t offset0       = startOffset + sizeof(GLResourceViewHeapSegment);
+    const std::size_t offset1       = startOffset + reinterpret_cast<const GLResourceViewHeapSegment*>(&buffer_[startOffset])->offset1;
 
     /* Write first part of segment body (of type <GLTextureTarget>) */
-    auto segmentTargets = reinterpret_cast<GLTextureTarget*>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment2)]);
+    auto segmentTargets = reinterpret_cast<GLTextureTarget*>(&buffer_[offset0]);
     auto begin = it;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentTargets[i] = it->target;
 
     /* Write second part of segment body (of type <GLuint>) */
-    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[startOffset + segmentOffsetEnd0]);
+    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[offset1]);
     it = begin;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentIDs[i] = it->object;
+
+    /* Store locations of all descriptors in this segment */
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+    {
+        auto& location = locations_[it->descriptor];
+        location.type       = DescriptorType::Texture;
+        location.offset0    = static_cast<std::uint32_t>(offset0 + sizeof(GLTextureTarget) * i);
+        location.offset1    = static_cast<std::uint32_t>(offset1 + sizeof(GLuint) * i);
+    }
 }
 
 void GLResourceHeap::BuildSegment2Format(GLResourceBindingIter it, GLsizei count)
 {
-    std::size_t startOffset = buffer_.size();
-
-    /* Allocate space for segment */
-    const std::size_t segmentOffsetEnd0 = sizeof(GLResourceViewHeapSegment2) + sizeof(GLenum) * count;
-    const std::size_t segmentSize       = segmentOffsetEnd0 + sizeof(GLuint) * count;
-    buffer_.resize(startOffset + segmentSize);
-
-    /* Write segment header */
-    auto segment = reinterpret_cast<GLResourceViewHeapSegment2*>(&buffer_[startOffset]);
-    {
-        segment->segmentSize    = segmentSize;
-        segment->offsetEnd0     = segmentOffsetEnd0;
-        segment->first          = it->slot;
-        segment->count          = count;
-    }
+    const std::size_t startOffset   = AllocSegment(it, count, sizeof(GLenum), sizeof(GLuint));
+    const std::size_t offset0       = startOffset + sizeof(GLResourceViewHeapSegment);
+    const std::size_t offset1       = startOffset + reinterpret_cast<const GLResourceViewHeapSegment*>(&buffer_[startOffset])->offset1;
 
     /* Write first part of segment body (of type <GLenum>) */
-    auto segmentFormats = reinterpret_cast<GLenum*>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment2)]);
+    auto segmentFormats = reinterpret_cast<GLenum*>(&buffer_[offset0]);
     auto begin = it;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentFormats[i] = it->format;
 
     /* Write second part of segment body (of type <GLuint>) */
-    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[startOffset + segmentOffsetEnd0]);
+    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[offset1]);
     it = begin;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentIDs[i] = it->object;
+
+    /* Store locations of all descriptors in this segment */
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+    {
+        auto& location = locations_[it->descriptor];
+        location.type       = DescriptorType::ImageTexture;
+        location.offset0    = static_cast<std::uint32_t>(offset0 + sizeof(GLenum) * i);
+        location.offset1    = static_cast<std::uint32_t>(offset1 + sizeof(GLuint) * i);
+    }
 }
 
 void GLResourceHeap::BuildSegment3(GLResourceBindingIter it, GLsizei count)
 {
-    std::size_t startOffset = buffer_.size();
-
-    /* Allocate space for segment */
-    const std::size_t segmentOffsetEnd0 = sizeof(GLResourceViewHeapSegment3) + sizeof(GLuint) * count;
-    const std::size_t segmentOffsetEnd1 = segmentOffsetEnd0 + sizeof(GLintptr) * count;
-    const std::size_t segmentSize       = segmentOffsetEnd1 + sizeof(GLsizeiptr) * count;
-    buffer_.resize(startOffset + segmentSize);
-
-    /* Write segment header */
-    auto segment = reinterpret_cast<GLResourceViewHeapSegment3*>(&buffer_[startOffset]);
-    {
-        segment->segmentSize    = segmentSize;
-        segment->offsetEnd0     = segmentOffsetEnd0;
-        segment->offsetEnd1     = segmentOffsetEnd1;
-        segment->first          = it->slot;
-        segment->count          = count;
-    }
+    const std::size_t startOffset   = AllocSegment(it, count, sizeof(GLuint), sizeof(GLintptr), sizeof(GLsizeiptr));
+    const auto        segment       = reinterpret_cast<const GLResourceViewHeapSegment*>(&buffer_[startOffset]);
+    const std::size_t offset0       = startOffset + sizeof(GLResourceViewHeapSegment);
+    const std::size_t offset1       = startOffset + segment->offset1;
+    const std::size_t offset2       = startOffset + segment->offset2;
 
     /* Write first part of segment body (of type <GLuint>) */
-    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment3)]);
+    auto segmentIDs = reinterpret_cast<GLuint*>(&buffer_[offset0]);
     auto begin = it;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentIDs[i] = it->object;
 
     /* Write second part of segment body (of type <GLintptr>) */
-    auto segmentOffsets = reinterpret_cast<GLintptr*>(&buffer_[startOffset + segmentOffsetEnd0]);
+    auto segmentOffsets = reinterpret_cast<GLintptr*>(&buffer_[offset1]);
     it = begin;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentOffsets[i] = it->offset;
 
-    /* Write second part of segment body (of type <GLsizeiptr>) */
-    auto segmentSizes = reinterpret_cast<GLsizeiptr*>(&buffer_[startOffset + segmentOffsetEnd1]);
+    /* Write third part of segment body (of type <GLsizeiptr>) */
+    auto segmentSizes = reinterpret_cast<GLsizeiptr*>(&buffer_[offset2]);
     it = begin;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentSizes[i] = it->size;
+
+    /* Store locations of all descriptors in this segment */
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+    {
+        auto& location = locations_[it->descriptor];
+        location.type       = DescriptorType::BufferRange;
+        location.offset0    = static_cast<std::uint32_t>(offset0 + sizeof(GLuint) * i);
+        location.offset1    = static_cast<std::uint32_t>(offset1 + sizeof(GLintptr) * i);
+        location.offset2    = static_cast<std::uint32_t>(offset2 + sizeof(GLsizeiptr) * i);
+    }
 }
 
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 
 void GLResourceHeap::BuildSegment2GL2XSampler(GLResourceBindingIter it, GLsizei count)
 {
-    std::size_t startOffset = buffer_.size();
-
-    /* Allocate space for segment */
-    const std::size_t segmentOffsetEnd0 = sizeof(GLResourceViewHeapSegment2) + sizeof(GLTexture*) * count;
-    const std::size_t segmentSize       = segmentOffsetEnd0 + sizeof(const GL2XSampler*) * count;
-    buffer_.resize(startOffset + segmentSize);
-
-    /* Write segment header */
-    auto segment = reinterpret_cast<GLResourceViewHeapSegment2*>(&buffer_[startOffset]);
-    {
-        segment->segmentSize    = segmentSize;
-        segment->offsetEnd0     = segmentOffsetEnd0;
-        segment->first          = it->slot;
-        segment->count          = count;
-    }
+    const std::size_t startOffset   = AllocSegment(it, count, sizeof(GLTexture*), sizeof(const GL2XSampler*));
+    const std::size_t offset0       = startOffset + sizeof(GLResourceViewHeapSegment);
+    const std::size_t offset1       = startOffset + reinterpret_cast<const GLResourceViewHeapSegment*>(&buffer_[startOffset])->offset1;
 
     /* Write first part of segment body (of type <GLTexture*>) */
-    auto segmentTextures = reinterpret_cast<GLTexture**>(&buffer_[startOffset + sizeof(GLResourceViewHeapSegment2)]);
+    auto segmentTextures = reinterpret_cast<GLTexture**>(&buffer_[offset0]);
     auto begin = it;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentTextures[i] = it->textureGL;
 
     /* Write second part of segment body (of type <const GL2XSampler*>) */
-    auto segmentSamplers = reinterpret_cast<const GL2XSampler**>(&buffer_[startOffset + segmentOffsetEnd0]);
+    auto segmentSamplers = reinterpret_cast<const GL2XSampler**>(&buffer_[offset1]);
     it = begin;
     for (GLsizei i = 0; i < count; ++i, ++it)
         segmentSamplers[i] = it->samplerGL2X;
+
+    /* Store locations of all descriptors in this segment; samplers are only referenced if a texture shares their slot */
+    it = begin;
+    for (GLsizei i = 0; i < count; ++i, ++it)
+    {
+        auto& location = locations_[it->descriptor];
+        location.type       = DescriptorType::GL2XTexture;
+        location.offset0    = static_cast<std::uint32_t>(offset0 + sizeof(GLTexture*) * i);
+
+        if (it->samplerGL2X != nullptr)
+        {
+            auto& samplerLocation = locations_[it->samplerDescriptor];
+            samplerLocation.type    = DescriptorType::GL2XSampler;
+            samplerLocation.offset0 = static_cast<std::uint32_t>(offset1 + sizeof(const GL2XSampler*) * i);
+        }
+    }
 }
 
 #endif // /LLGL_GL_ENABLE_OPENGL2X
 
-void GLResourceHeap::WriteSegmentationHeapEnd(const void* data, std::size_t size)
+template <typename T>
+void GLResourceHeap::WriteSegmentEntry(std::uint32_t offset, const T& value)
 {
-    std::size_t startOffset = buffer_.size();
-    buffer_.resize(startOffset + size);
-    ::memcpy(&buffer_[startOffset], data, size);
+    *reinterpret_cast<T*>(&buffer_[heapOffset_ + offset]) = value;
 }
 
-GLuint GLResourceHeap::GetTextureViewID(std::size_t idx) const
+void GLResourceHeap::WriteResourceView(DescriptorLocation& location, Resource& resource, const ResourceViewDescriptor& rvDesc)
 {
-    /* All texture-view IDs are stored in the front of the internal buffer */
-    return *(reinterpret_cast<const GLuint*>(buffer_.data()) + idx);
+    switch (location.type)
+    {
+        case DescriptorType::Undefined:
+        break;
+
+        case DescriptorType::Buffer:
+        {
+            ValidateResourceType(resource, ResourceType::Buffer);
+            if (IsGLBufferViewEnabled(rvDesc.bufferView))
+                throw std::invalid_argument("cannot write buffer range into resource heap descriptor that was created without buffer ranges");
+
+            auto& bufferGL = LLGL_CAST(GLBuffer&, resource);
+            WriteSegmentEntry<GLuint>(location.offset0, bufferGL.GetID());
+        }
+        break;
+
+        case DescriptorType::BufferRange:
+        {
+            ValidateResourceType(resource, ResourceType::Buffer);
+
+            auto& bufferGL = LLGL_CAST(GLBuffer&, resource);
+            GLintptr offset = 0;
+            GLsizeiptr size = 0;
+            GetGLBufferRange(bufferGL, rvDesc.bufferView, offset, size);
+
+            WriteSegmentEntry<GLuint>(location.offset0, bufferGL.GetID());
+            WriteSegmentEntry<GLintptr>(location.offset1, offset);
+            WriteSegmentEntry<GLsizeiptr>(location.offset2, size);
+            location.wholeRange = !IsGLBufferViewEnabled(rvDesc.bufferView);
+        }
+        break;
+
+        case DescriptorType::Texture:
+        {
+            ValidateResourceType(resource, ResourceType::Texture);
+
+            auto& textureGL = LLGL_CAST(GLTexture&, resource);
+            ReleaseTextureView(location);
+            if (IsTextureViewEnabled(rvDesc.textureView))
+                WriteSegmentEntry<GLTextureTarget>(location.offset0, GLStateManager::GetTextureTarget(rvDesc.textureView.type));
+            else
+                WriteSegmentEntry<GLTextureTarget>(location.offset0, GLStateManager::GetTextureTarget(textureGL.GetType()));
+            WriteSegmentEntry<GLuint>(location.offset1, GetOrCreateTextureView(location, textureGL, rvDesc.textureView));
+        }
+        break;
+
+        case DescriptorType::ImageTexture:
+        {
+            ValidateResourceType(resource, ResourceType::Texture);
+
+            auto& textureGL = LLGL_CAST(GLTexture&, resource);
+            ReleaseTextureView(location);
+            if (IsTextureViewEnabled(rvDesc.textureView))
+                WriteSegmentEntry<GLenum>(location.offset0, GLTypes::Map(rvDesc.textureView.format));
+            else
+                WriteSegmentEntry<GLenum>(location.offset0, textureGL.GetGLInternalFormat());
+            WriteSegmentEntry<GLuint>(location.offset1, GetOrCreateTextureView(location, textureGL, rvDesc.textureView));
+        }
+        break;
+
+        case DescriptorType::Sampler:
+        {
+            ValidateResourceType(resource, ResourceType::Sampler);
+            auto& samplerGL = LLGL_CAST(GLSampler&, resource);
+            WriteSegmentEntry<GLuint>(location.offset0, samplerGL.GetID());
+        }
+        break;
+
+        #ifdef LLGL_GL_ENABLE_OPENGL2X
+
+        case DescriptorType::GL2XTexture:
+        {
+            ValidateResourceType(resource, ResourceType::Texture);
+            WriteSegmentEntry<GLTexture*>(location.offset0, LLGL_CAST(GLTexture*, &resource));
+        }
+        break;
+
+        case DescriptorType::GL2XSampler:
+        {
+            ValidateResourceType(resource, ResourceType::Sampler);
+            WriteSegmentEntry<const GL2XSampler*>(location.offset0, LLGL_CAST(const GL2XSampler*, &resource));
+        }
+        break;
+
+        #endif // /LLGL_GL_ENABLE_OPENGL2X
+
+        default:
+        break;
+    }
+
+    #ifdef GL_ARB_shader_image_load_store
+    barriers_ |= GetMemoryBarrierBitfield(resource);
+    #endif // /GL_ARB_shader_image_load_store
 }
 
-std::size_t GLResourceHeap::GetSegmentationHeapSize() const
+GLuint GLResourceHeap::GetOrCreateTextureView(DescriptorLocation& location, GLTexture& textureGL, const TextureViewDescriptor& textureViewDesc)
 {
-    /* Resource heap starts after texture-view IDs (GLuint) */
-    return (buffer_.size() - (numTextureViews_ * sizeof(GLuint)));
+    if (IsTextureViewEnabled(textureViewDesc))
+    {
+        /* Create texture-view only once, since the same descriptor can be referenced by more than one segment */
+        if (location.textureView == 0)
+            location.textureView = GLTextureViewPool::Get().CreateTextureView(textureGL.GetID(), textureViewDesc);
+        return location.textureView;
+    }
+    return textureGL.GetID();
+}
+
+void GLResourceHeap::ReleaseTextureView(DescriptorLocation& location)
+{
+    if (location.textureView != 0)
+    {
+        GLTextureViewPool::Get().ReleaseTextureView(location.textureView);
+        location.textureView = 0;
+    }
 }
 
 const std::int8_t* GLResourceHeap::GetSegmentationHeapStart(std::uint32_t firstSet) const
 {
-    /* Resource heap starts after texture-view IDs (GLuint) */
-    return (buffer_.data() + (numTextureViews_ * sizeof(GLuint)) + stride_ * firstSet);
+    return (buffer_.data() + heapOffset_ + stride_ * firstSet);
+}
+
+const std::int8_t* GLResourceHeap::ApplyDynamicOffsets(std::uint32_t firstSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets)
+{
+    /* Copy segments of the specified descriptor set, so the heap itself remains unchanged */
+    const std::size_t setOffset = stride_ * firstSet;
+    const auto setBegin = buffer_.begin() + heapOffset_ + setOffset;
+    dynamicBuffer_.assign(setBegin, setBegin + stride_);
+
+    /* Add dynamic offsets to the buffer ranges; ranges that cover the entire buffer are shrunk to still end at the end of the buffer */
+    const std::size_t numOffsets = std::min(static_cast<std::size_t>(numDynamicOffsets), dynamicBindings_.size());
+
+    for (std::size_t i = 0; i < numOffsets; ++i)
+    {
+        const auto& location = locations_[firstSet * numBindings_ + dynamicBindings_[i]];
+        if (location.type == DescriptorType::BufferRange)
+        {
+            const auto offset = static_cast<GLintptr>(dynamicOffsets[i]);
+            *reinterpret_cast<GLintptr*>(&dynamicBuffer_[location.offset1 - setOffset]) += offset;
+            if (location.wholeRange)
+                *reinterpret_cast<GLsizeiptr*>(&dynamicBuffer_[location.offset2 - setOffset]) -= offset;
+        }
+    }
+
+    return dynamicBuffer_.data();
 }
 
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/ResourceHeap.h>
 #include <LLGL/ResourceFlags.h>
+#include <LLGL/Container/ArrayView.h>
 #include "../OpenGL.h"
 #include <vector>
 #include <functional>
@@ -21,8 +22,12 @@ namespace LLGL
 
 
 class GLStateManager;
+class GLTexture;
+class Resource;
 class ResourceBindingIterator;
 struct ResourceHeapDescriptor;
+struct ResourceViewDescriptor;
+struct TextureViewDescriptor;
 struct GLResourceBinding;
 
 /*
@@ -41,20 +46,47 @@ class GLResourceHeap final : public ResourceHeap
         GLResourceHeap(const ResourceHeapDescriptor& desc);
         ~GLResourceHeap();
 
-        // Binds this resource heap with the specified GL state manager.
-        void Bind(GLStateManager& stateMngr, std::uint32_t firstSet);
+        // Binds this resource heap with the specified GL state manager. Dynamic offsets are added to the buffer ranges of all bindings with dynamic offsets.
+        void Bind(GLStateManager& stateMngr, std::uint32_t firstSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
+
+        // Patches the segment entries of the specified descriptors and returns the number of written descriptors.
+        std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
+
+    private:
+
+        // Type of a descriptor location within the raw buffer.
+        enum class DescriptorType : std::uint8_t
+        {
+            Undefined,      // Descriptor is not referenced by any segment
+            Buffer,         // <GLuint> in a segment with one sub-buffer
+            BufferRange,    // <GLuint>, <GLintptr>, and <GLsizeiptr> in a segment with three sub-buffers
+            Texture,        // <GLTextureTarget> and <GLuint> in a segment with two sub-buffers
+            ImageTexture,   // <GLenum> and <GLuint> in a segment with two sub-buffers
+            Sampler,        // <GLuint> in a segment with one sub-buffer
+            GL2XTexture,    // <GLTexture*> in a segment with two sub-buffers
+            GL2XSampler,    // <const GL2XSampler*> in a segment with two sub-buffers
+        };
+
+        // Location of a single descriptor within the raw buffer. The offsets follow the order of sub-buffers within the respective segment.
+        struct DescriptorLocation
+        {
+            DescriptorType  type        = DescriptorType::Undefined;
+            std::uint32_t   offset0     = 0;    // Byte offset to the entry in the first sub-buffer
+            std::uint32_t   offset1     = 0;    // Byte offset to the entry in the second sub-buffer
+            std::uint32_t   offset2     = 0;    // Byte offset to the entry in the third sub-buffer
+            GLuint          textureView = 0;    // GL texture object generated with glTextureView that is owned by this descriptor
+            bool            wholeRange  = false;// Buffer range covers the entire buffer, so dynamic offsets must shrink its size
+        };
 
     private:
 
         using GLResourceBindingIter = std::vector<GLResourceBinding>::const_iterator;
         using BuildSegmentFunc = std::function<void(GLResourceBindingIter begin, GLsizei count)>;
 
-        void BuildTextureViews(ResourceBindingIterator& resourceIterator, long bindFlags);
-
         void BuildBufferSegments(ResourceBindingIterator& resourceIterator, long bindFlags, std::uint8_t& numSegments);
         void BuildBufferRangeSegments(ResourceBindingIterator& resourceIterator, long bindFlags, std::uint8_t& numSegments);
-        void BuildUniformBufferSegments(ResourceBindingIterator& resourceIterator);
-        void BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator);
+        void BuildUniformBufferSegments(ResourceBindingIterator& resourceIterator, bool useRanges);
+        void BuildStorageBufferSegments(ResourceBindingIterator& resourceIterator, bool useRanges);
         void BuildTextureSegments(ResourceBindingIterator& resourceIterator);
         void BuildImageTextureSegments(ResourceBindingIterator& resourceIterator);
         void BuildSamplerSegments(ResourceBindingIterator& resourceIterator);
@@ -68,7 +100,16 @@ class GLResourceHeap final : public ResourceHeap
             std::uint8_t&                           numSegments
         );
 
-        void BuildSegment1(GLResourceBindingIter it, GLsizei count);
+        // Allocates a segment with up to three sub-buffers for the specified element sizes, writes its header, and returns its byte offset.
+        std::size_t AllocSegment(
+            GLResourceBindingIter   it,
+            GLsizei                 count,
+            std::size_t             elementSize0,
+            std::size_t             elementSize1    = 0,
+            std::size_t             elementSize2    = 0
+        );
+
+        void BuildSegment1(GLResourceBindingIter it, GLsizei count, DescriptorType type);
         void BuildSegment2Target(GLResourceBindingIter it, GLsizei count);
         void BuildSegment2Format(GLResourceBindingIter it, GLsizei count);
         void BuildSegment3(GLResourceBindingIter it, GLsizei count);
@@ -76,14 +117,21 @@ class GLResourceHeap final : public ResourceHeap
         void BuildSegment2GL2XSampler(GLResourceBindingIter it, GLsizei count);
         #endif
 
-        void WriteSegmentationHeapEnd(const void* data, std::size_t size);
+        void WriteResourceView(DescriptorLocation& location, Resource& resource, const ResourceViewDescriptor& rvDesc);
 
-        GLuint GetTextureViewID(std::size_t idx) const;
+        // Returns the texture-view of the specified descriptor location (and creates it if necessary) or the ID of the texture itself.
+        GLuint GetOrCreateTextureView(DescriptorLocation& location, GLTexture& textureGL, const TextureViewDescriptor& textureViewDesc);
 
-        std::size_t GetSegmentationHeapSize() const;
+        void ReleaseTextureView(DescriptorLocation& location);
+
+        template <typename T>
+        void WriteSegmentEntry(std::uint32_t offset, const T& value);
 
         const std::int8_t* GetSegmentationHeapStart(std::uint32_t firstSet) const;
 
+        // Copies the segments of the specified descriptor set into a temporary buffer and adds the dynamic offsets to its buffer ranges.
+        const std::int8_t* ApplyDynamicOffsets(std::uint32_t firstSet, std::uint32_t numDynamicOffsets, const std::uint32_t* dynamicOffsets);
+
     private:
 
         // Describes the segments within the raw buffer (per descriptor set).
@@ -100,13 +148,18 @@ class GLResourceHeap final : public ResourceHeap
 
     private:
 
-        BufferSegmentation          segmentation_;
+        BufferSegmentation              segmentation_;
+
+        std::size_t                     stride_             = 0;    // Buffer stride (in bytes) per descriptor set
+        std::size_t                     heapOffset_         = 0;    // Byte offset to the first cache line aligned descriptor set within the raw buffer
+        std::vector<std::int8_t>        buffer_;                    // Raw buffer with resource binding information
+        std::vector<DescriptorLocation> locations_;                 // Locations of all descriptors within the raw buffer
 
-        std::size_t                 numTextureViews_    = 0;    // Number of GL texture objects generated with glTextureView
-        std::size_t                 stride_             = 0;    // Buffer stride (in bytes) per descriptor set
-        std::vector<std::int8_t>    buffer_;                    // Raw buffer with resource binding information
+        std::uint32_t                   numBindings_        = 0;
+        std::vector<std::uint32_t>      dynamicBindings_;           // Indices of all bindings with dynamic offsets within the pipeline layout
+        std::vector<std::int8_t>        dynamicBuffer_;             // Temporary copy of a descriptor set with dynamic offsets applied
 
-        GLbitfield                  barriers_           = 0;    // Bitmask for glMemoryBarrier
+        GLbitfield                      barriers_           = 0;    // Bitmask for glMemoryBarrier
 
 };
 
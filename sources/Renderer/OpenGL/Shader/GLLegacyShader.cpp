@@ -11,6 +11,7 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../../../Core/Exception.h"
 
 
@@ -25,11 +26,16 @@ GLLegacyShader::GLLegacyShader(const ShaderDescriptor& desc) :
     SetID(id);
     BuildShader(desc);
 
-    /* Query compile status and log */
-    ReportStatusAndLog(
-        GLLegacyShader::GetCompileStatus(GetID()),
-        GLLegacyShader::GetGLShaderLog(GetID())
-    );
+    /* Query compile status and log, unless the driver compiles in the background */
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+        DeferStatusAndLog();
+    else
+    {
+        ReportStatusAndLog(
+            GLLegacyShader::GetCompileStatus(GetID()),
+            GLLegacyShader::GetGLShaderLog(GetID())
+        );
+    }
 }
 
 GLLegacyShader::~GLLegacyShader()
@@ -39,17 +45,25 @@ GLLegacyShader::~GLLegacyShader()
 
 void GLLegacyShader::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     GLSetObjectLabel(GL_SHADER, GetID(), name);
 }
 
 bool GLLegacyShader::Reflect(ShaderReflection& reflection) const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Reflect(reflection));
     const Shader* shaders[] = { this };
     GLShaderProgram intermediateProgram{ 1, shaders };
     GLShaderProgram::QueryReflection(intermediateProgram.GetID(), reflection);
     return true;
 }
 
+void GLLegacyShader::QueryStatusAndLog(BasicReport& report) const
+{
+    const bool hasErrors = !GLLegacyShader::GetCompileStatus(GetID());
+    report.Reset(GLLegacyShader::GetGLShaderLog(GetID()), hasErrors);
+}
+
 void GLLegacyShader::CompileShaderSource(GLuint shader, const char* source)
 {
     const GLchar* strings[1] = { source };
@@ -43,6 +43,8 @@ class GLLegacyShader final : public GLShader
 
     private:
 
+        void QueryStatusAndLog(BasicReport& report) const override;
+
         void BuildShader(const ShaderDescriptor& shaderDesc);
         void CompileSource(const ShaderDescriptor& shaderDesc);
         void LoadBinary(const ShaderDescriptor& shaderDesc);
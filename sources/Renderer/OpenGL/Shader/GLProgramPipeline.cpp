@@ -92,6 +92,12 @@ void GLProgramPipeline::QueryInfoLogs(BasicReport& report)
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLProgramPipeline::IsCompleted()
+{
+    /* Separable shader programs have already been linked when their shaders were created */
+    return true;
+}
+
 
 /*
  * ======= Private: =======
@@ -29,6 +29,7 @@ class GLProgramPipeline final : public GLShaderPipeline
         void Bind(GLStateManager& stateMngr) override;
         void BindResourceSlots(const GLShaderBindingLayout& bindingLayout) override;
         void QueryInfoLogs(BasicReport& report) override;
+        bool IsCompleted() override;
 
     private:
 
@@ -12,6 +12,7 @@
 #include "../Ext/GLExtensions.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 
 
 namespace LLGL
@@ -78,11 +79,13 @@ GLSeparableShader::~GLSeparableShader()
 
 void GLSeparableShader::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     GLSetObjectLabel(GL_PROGRAM, GetID(), name);
 }
 
 bool GLSeparableShader::Reflect(ShaderReflection& reflection) const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(Reflect(reflection));
     GLShaderProgram::QueryReflection(GetID(), reflection);
     return true;
 }
@@ -8,6 +8,7 @@
 #include "GLShader.h"
 #include "GLShaderSourcePatcher.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../../Core/Helper.h"
@@ -35,6 +36,12 @@ GLShader::GLShader(const bool isSeparable, const ShaderDescriptor& desc) :
 
 const Report* GLShader::GetReport() const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(GetReport());
+    if (isReportDeferred_)
+    {
+        QueryStatusAndLog(report_);
+        isReportDeferred_ = false;
+    }
     return (report_ ? &report_ : nullptr);
 }
 
@@ -121,6 +128,17 @@ void GLShader::PatchShaderSourceWithOptions(
 void GLShader::ReportStatusAndLog(bool status, const std::string& log)
 {
     report_.Reset(log, !status);
+    isReportDeferred_ = false;
+}
+
+void GLShader::DeferStatusAndLog()
+{
+    isReportDeferred_ = true;
+}
+
+void GLShader::QueryStatusAndLog(BasicReport& /*report*/) const
+{
+    // dummy
 }
 
 
@@ -88,6 +88,12 @@ class GLShader : public Shader
         // Resets the report with the specified compile/link status and log.
         void ReportStatusAndLog(bool status, const std::string& log);
 
+        // Defers the query of the compile status and log until the report is requested. This lets the driver compile the shader in the background.
+        void DeferStatusAndLog();
+
+        // Queries the compile status and log for a deferred report.
+        virtual void QueryStatusAndLog(BasicReport& report) const;
+
         // Stores the native shader ID.
         inline void SetID(GLuint id)
         {
@@ -109,7 +115,8 @@ class GLShader : public Shader
         std::vector<GLShaderAttribute>  shaderAttribs_;
         std::size_t                     numVertexAttribs_           = 0;
         std::vector<const char*>        transformFeedbackVaryings_;
-        BasicReport                     report_;
+        mutable BasicReport             report_;
+        mutable bool                    isReportDeferred_           = false;
 
 };
 
@@ -41,6 +41,9 @@ class GLShaderPipeline
         // Adds the shader info logs to the output report.
         virtual void QueryInfoLogs(BasicReport& report) = 0;
 
+        // Returns true if the driver has finished compiling and linking this pipeline. Only false while shaders are linked in the background (see GL_KHR_parallel_shader_compile).
+        virtual bool IsCompleted() = 0;
+
         // Returns the native pipeline ID. Can be either from glCreateProgramPipelines or glCreateProgram.
         inline GLuint GetID() const
         {
@@ -13,6 +13,7 @@
 #include "../RenderState/GLStateManager.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionLoader.h"
+#include "../GLSerialization.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Exception.h"
 #include "../../../Core/BasicReport.h"
@@ -21,6 +22,7 @@
 #include <LLGL/Misc/ForRange.h>
 #include <vector>
 #include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
@@ -123,20 +125,14 @@ GLShaderProgram::GLShaderProgram(std::size_t numShaders, const Shader* const* sh
         AttachGLLegacyShader(GetID(), shaders[i], orderedShaders);
 
     #ifdef __APPLE__
-    /*
-    Mac implementation of OpenGL violates GL spec and always requires a fragment shader,
-    so we create a dummy if not specified by client.
-    */
     if (orderedShaders.fs == nullptr)
-    {
-        const GLchar* nullFragmentShaderSource =
-            "#version 330 core\n"
-            "void main() {}\n"
-        ;
-        const GLuint nullFragmentShader = g_nullFragmentShader.GetOrCreate(GL_FRAGMENT_SHADER, nullFragmentShaderSource);
-        glAttachShader(GetID(), nullFragmentShader);
-        hasNullFragmentShader_ = true;
-    }
+        AttachNullFragmentShader();
+    #endif
+
+    #ifdef GL_ARB_get_program_binary
+    /* Keep program binary retrievable for serialized PSO caches */
+    if (HasExtension(GLExt::ARB_get_program_binary))
+        glProgramParameteri(GetID(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     #endif
 
     /* Build input layout for vertex shader */
@@ -174,6 +170,66 @@ GLShaderProgram::GLShaderProgram(std::size_t numShaders, const Shader* const* sh
     BuildSignature(numShaders, shaders);
 }
 
+// Returns true if GL program binaries can be retrieved and loaded.
+static bool HasProgramBinarySupport()
+{
+    #ifdef GL_ARB_get_program_binary
+    return HasExtension(GLExt::ARB_get_program_binary);
+    #else
+    return false;
+    #endif
+}
+
+// Returns the specified GL string or an empty string if the query failed.
+static const char* GLGetStringOrEmpty(GLenum name)
+{
+    auto bytes = glGetString(name);
+    return (bytes != nullptr ? reinterpret_cast<const char*>(bytes) : "");
+}
+
+GLShaderProgram::GLShaderProgram(Serialization::Deserializer& reader) :
+    GLShaderPipeline { glCreateProgram() }
+{
+    /* Program binaries are only valid for the exact same GL driver */
+    reader.Begin(Serialization::GLIdent_ProgramDriver);
+    bool isSameDriver = true;
+    for (auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+    {
+        if (std::strcmp(reader.ReadCString(), GLGetStringOrEmpty(name)) != 0)
+            isSameDriver = false;
+    }
+    reader.End();
+
+    /* Try to load program binary */
+    bool isLinked = false;
+
+    auto seg = reader.BeginOnMatch(Serialization::GLIdent_ProgramBinary);
+    if (seg.ident == Serialization::GLIdent_ProgramBinary)
+    {
+        #ifdef GL_ARB_get_program_binary
+        if (isSameDriver && HasProgramBinarySupport() && seg.size > sizeof(GLenum))
+        {
+            GLenum binaryFormat = 0;
+            reader.ReadTyped(binaryFormat);
+            glProgramBinary(GetID(), binaryFormat, seg.data + sizeof(GLenum), static_cast<GLsizei>(seg.size - sizeof(GLenum)));
+            isLinked = GLShaderProgram::GetLinkStatus(GetID());
+        }
+        #endif
+        reader.End();
+    }
+
+    /* Fall back to the cached shader sources if the driver rejected the program binary */
+    if (isLinked)
+    {
+        while (reader.ReadSegmentOnMatch(Serialization::GLIdent_ProgramShader).ident == Serialization::GLIdent_ProgramShader)
+        {
+            /* Skip shader sources */
+        }
+    }
+    else
+        LinkFromCachedShaders(reader);
+}
+
 GLShaderProgram::~GLShaderProgram()
 {
     glDeleteProgram(GetID());
@@ -184,6 +240,84 @@ GLShaderProgram::~GLShaderProgram()
     #endif
 }
 
+static void WriteShaderAttribs(Serialization::Serializer& writer, std::size_t numAttribs, const GLShaderAttribute* attribs)
+{
+    writer.WriteTyped(static_cast<std::uint32_t>(numAttribs));
+    for_range(i, numAttribs)
+    {
+        writer.WriteTyped(attribs[i].index);
+        writer.WriteCString(attribs[i].name);
+    }
+}
+
+static void WriteShaderSource(Serialization::Serializer& writer, GLuint shader)
+{
+    GLint sourceLength = 0;
+    glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &sourceLength);
+
+    if (sourceLength > 0)
+    {
+        std::vector<GLchar> source(static_cast<std::size_t>(sourceLength), '\0');
+        glGetShaderSource(shader, sourceLength, nullptr, source.data());
+        writer.WriteCString(source.data());
+    }
+    else
+        writer.WriteCString("");
+}
+
+void GLShaderProgram::Serialize(Serialization::Serializer& writer, std::size_t numShaders, const Shader* const* shaders) const
+{
+    /* Write GL driver identification to validate the program binary */
+    writer.Begin(Serialization::GLIdent_ProgramDriver);
+    {
+        writer.WriteCString(GLGetStringOrEmpty(GL_VENDOR));
+        writer.WriteCString(GLGetStringOrEmpty(GL_RENDERER));
+        writer.WriteCString(GLGetStringOrEmpty(GL_VERSION));
+    }
+    writer.End();
+
+    #ifdef GL_ARB_get_program_binary
+    /* Write program binary */
+    if (HasProgramBinarySupport())
+    {
+        GLint binaryLength = 0;
+        glGetProgramiv(GetID(), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength > 0)
+        {
+            std::vector<char> binary(static_cast<std::size_t>(binaryLength));
+            GLenum binaryFormat = 0;
+            glGetProgramBinary(GetID(), binaryLength, &binaryLength, &binaryFormat, binary.data());
+
+            writer.Begin(Serialization::GLIdent_ProgramBinary);
+            {
+                writer.WriteTyped(binaryFormat);
+                writer.Write(binary.data(), static_cast<std::size_t>(binaryLength));
+            }
+            writer.End();
+        }
+    }
+    #endif
+
+    /* Write shader sources and attributes as fallback for a different GL driver */
+    for_range(i, numShaders)
+    {
+        auto shaderGL = LLGL_CAST(const GLShader*, shaders[i]);
+        writer.Begin(Serialization::GLIdent_ProgramShader);
+        {
+            writer.WriteTyped(GLTypes::Map(shaderGL->GetType()));
+            WriteShaderSource(writer, shaderGL->GetID());
+            WriteShaderAttribs(writer, shaderGL->GetNumVertexAttribs(), shaderGL->GetVertexAttribs());
+            WriteShaderAttribs(writer, shaderGL->GetNumFragmentAttribs(), shaderGL->GetFragmentAttribs());
+
+            const auto& varyings = shaderGL->GetTransformFeedbackVaryings();
+            writer.WriteTyped(static_cast<std::uint32_t>(varyings.size()));
+            for (auto name : varyings)
+                writer.WriteCString(name);
+        }
+        writer.End();
+    }
+}
+
 void GLShaderProgram::Bind(GLStateManager& stateMngr)
 {
     stateMngr.BindShaderProgram(GetID());
@@ -198,6 +332,109 @@ void GLShaderProgram::BindResourceSlots(const GLShaderBindingLayout& bindingLayo
     }
 }
 
+static void ReadShaderAttribs(Serialization::Deserializer& reader, std::vector<GLShaderAttribute>& attribs)
+{
+    std::uint32_t numAttribs = 0;
+    reader.ReadTyped(numAttribs);
+    attribs.resize(numAttribs);
+    for (auto& attr : attribs)
+    {
+        reader.ReadTyped(attr.index);
+        attr.name = reader.ReadCString();
+    }
+}
+
+void GLShaderProgram::LinkFromCachedShaders(Serialization::Deserializer& reader)
+{
+    std::vector<GLuint>             shaders;
+    std::vector<GLShaderAttribute>  vertexAttribs, fragmentAttribs, attribs;
+    std::vector<const char*>        varyings, geometryVaryings;
+    bool                            hasFragmentShader = false;
+
+    while (reader.BeginOnMatch(Serialization::GLIdent_ProgramShader).ident == Serialization::GLIdent_ProgramShader)
+    {
+        /* Compile shader from cached source and attach it to this program */
+        GLenum type = 0;
+        reader.ReadTyped(type);
+
+        const GLuint shader = glCreateShader(type);
+        GLLegacyShader::CompileShaderSource(shader, reader.ReadCString());
+        glAttachShader(GetID(), shader);
+        shaders.push_back(shader);
+
+        /* Read input and output attributes of vertex and fragment shaders */
+        ReadShaderAttribs(reader, attribs);
+        if (type == GL_VERTEX_SHADER)
+            vertexAttribs = attribs;
+
+        ReadShaderAttribs(reader, attribs);
+        if (type == GL_FRAGMENT_SHADER)
+        {
+            fragmentAttribs = attribs;
+            hasFragmentShader = true;
+        }
+
+        /* Read transform feedback varyings of vertex or geometry shader */
+        std::uint32_t numVaryings = 0;
+        reader.ReadTyped(numVaryings);
+        for_range(i, numVaryings)
+        {
+            auto name = reader.ReadCString();
+            if (type == GL_GEOMETRY_SHADER)
+                geometryVaryings.push_back(name);
+            else if (type == GL_VERTEX_SHADER)
+                varyings.push_back(name);
+        }
+
+        reader.End();
+    }
+
+    #ifdef __APPLE__
+    if (!hasFragmentShader)
+        AttachNullFragmentShader();
+    #else
+    (void)hasFragmentShader;
+    #endif
+
+    /* Link program the same way as for shaders from the descriptor */
+    GLShaderProgram::BindAttribLocations(GetID(), vertexAttribs.size(), vertexAttribs.data());
+    GLShaderProgram::BindFragDataLocations(GetID(), fragmentAttribs.size(), fragmentAttribs.data());
+
+    if (!geometryVaryings.empty())
+        varyings = std::move(geometryVaryings);
+
+    if (!varyings.empty())
+        GLShaderProgram::LinkProgramWithTransformFeedbackVaryings(GetID(), varyings.size(), varyings.data());
+    else
+        GLShaderProgram::LinkProgram(GetID());
+
+    /* Shader objects are no longer needed after linking */
+    for (auto shader : shaders)
+    {
+        glDetachShader(GetID(), shader);
+        glDeleteShader(shader);
+    }
+}
+
+#ifdef __APPLE__
+
+void GLShaderProgram::AttachNullFragmentShader()
+{
+    /*
+    Mac implementation of OpenGL violates GL spec and always requires a fragment shader,
+    so we create a dummy if not specified by client.
+    */
+    const GLchar* nullFragmentShaderSource =
+        "#version 330 core\n"
+        "void main() {}\n"
+    ;
+    const GLuint nullFragmentShader = g_nullFragmentShader.GetOrCreate(GL_FRAGMENT_SHADER, nullFragmentShaderSource);
+    glAttachShader(GetID(), nullFragmentShader);
+    hasNullFragmentShader_ = true;
+}
+
+#endif // /__APPLE__
+
 void GLShaderProgram::QueryInfoLogs(BasicReport& report)
 {
     const bool hasErrors = !GLShaderProgram::GetLinkStatus(GetID());
@@ -205,6 +442,19 @@ void GLShaderProgram::QueryInfoLogs(BasicReport& report)
     report.Reset(std::move(log), hasErrors);
 }
 
+bool GLShaderProgram::IsCompleted()
+{
+    #ifdef GL_KHR_parallel_shader_compile
+    if (HasExtension(GLExt::KHR_parallel_shader_compile))
+    {
+        GLint status = GL_FALSE;
+        glGetProgramiv(GetID(), GL_COMPLETION_STATUS_KHR, &status);
+        return (status != GL_FALSE);
+    }
+    #endif
+    return true;
+}
+
 bool GLShaderProgram::GetLinkStatus(GLuint program)
 {
     GLint status = 0;
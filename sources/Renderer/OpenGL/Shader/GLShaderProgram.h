@@ -12,6 +12,7 @@
 #include <LLGL/ShaderReflection.h>
 #include "GLShaderPipeline.h"
 #include "GLShaderUniform.h"
+#include "../../Serialization.h"
 
 
 namespace LLGL
@@ -29,12 +30,23 @@ class GLShaderProgram final : public GLShaderPipeline
         void Bind(GLStateManager& stateMngr) override;
         void BindResourceSlots(const GLShaderBindingLayout& bindingLayout) override;
         void QueryInfoLogs(BasicReport& report) override;
+        bool IsCompleted() override;
 
     public:
 
         GLShaderProgram(std::size_t numShaders, const Shader* const* shaders);
+
+        /*
+        Constructs the shader program from a serialized PSO cache. The program binary is only loaded if the cache was created with the same GL driver.
+        Otherwise, or if the driver rejects the binary, the program is compiled and linked from the shader sources of the cache.
+        */
+        GLShaderProgram(Serialization::Deserializer& reader);
+
         ~GLShaderProgram();
 
+        // Writes the program binary and the shader sources of this program as serialized segments. The shaders must be the ones this program was created with.
+        void Serialize(Serialization::Serializer& writer, std::size_t numShaders, const Shader* const* shaders) const;
+
     public:
 
         // Returns true if the native GL shader program was linked successfully.
@@ -61,6 +73,14 @@ class GLShaderProgram final : public GLShaderPipeline
         // Queries the shader reflection for the specified program.
         static void QueryReflection(GLuint program, ShaderReflection& reflection);
 
+    private:
+
+        #ifdef __APPLE__
+        void AttachNullFragmentShader();
+        #endif
+
+        void LinkFromCachedShaders(Serialization::Deserializer& reader);
+
     private:
 
         const GLShaderBindingLayout*    bindingLayout_          = nullptr;
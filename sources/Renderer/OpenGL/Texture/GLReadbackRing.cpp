@@ -0,0 +1,221 @@
+/*
+ * GLReadbackRing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLReadbackRing.h"
+#include "GLTexture.h"
+#include "GLReadTextureFBO.h"
+#include "../GLTypes.h"
+#include "../GLProfile.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../RenderState/GLStateManager.h"
+#include "../../TextureUtils.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+GLReadbackRing::GLReadbackRing(std::uint32_t numSlots)
+{
+    slots_.resize(std::max(1u, numSlots));
+}
+
+GLReadbackRing::~GLReadbackRing()
+{
+    Clear();
+}
+
+// Returns the required size (in bytes) to read the specified texture region.
+static GLsizeiptr GetReadbackDataSize(const GLTexture& textureGL, const TextureRegion& region, const ImageFormat format, const DataType dataType)
+{
+    const auto& subresource     = region.subresource;
+    const auto  baseSubresource = TextureSubresource{ 0, subresource.numArrayLayers, 0, 1 };
+    const auto  numTexels       = NumMipTexels(textureGL.GetType(), region.extent, baseSubresource);
+    return static_cast<GLsizeiptr>(GetMemoryFootprint(format, dataType, numTexels));
+}
+
+std::uint64_t GLReadbackRing::ReadTexture(GLTexture& textureGL, const TextureRegion& region, const ImageFormat format, const DataType dataType)
+{
+    const auto dataSize = GetReadbackDataSize(textureGL, region, format, dataType);
+    if (dataSize == 0)
+        throw std::invalid_argument("cannot read texture asynchronously with compressed image format");
+
+    /* Take next slot in the ring; this invalidates the oldest ticket if it has not been unmapped yet */
+    const auto ticket = nextTicket_++;
+    auto& slot = slots_[static_cast<std::size_t>((ticket - 1) % slots_.size())];
+
+    ReleaseSlot(slot);
+    ReserveSlotCapacity(slot, dataSize);
+
+    /* Read texture data into pack buffer; this only enqueues the copy operation on the GPU */
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, slot.buffer);
+    GLStateManager::Get().SetPixelStorePack(0, 0, 1);
+    {
+        #ifdef LLGL_OPENGL
+        if (!textureGL.IsRenderbuffer())
+        {
+            const DstImageDescriptor imageDesc{ format, dataType, nullptr, static_cast<std::size_t>(dataSize) };
+            textureGL.GetTextureSubImage(region, imageDesc);
+        }
+        else
+        #endif // /LLGL_OPENGL
+        {
+            ReadPixelsFromFramebuffer(textureGL, region, format, dataType);
+        }
+    }
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+
+    /* Insert fence after the copy operation, so the slot can be resolved without stalling the pipeline */
+    slot.fence->Submit();
+    slot.size   = dataSize;
+    slot.ticket = ticket;
+    slot.state  = SlotState::Pending;
+
+    return ticket;
+}
+
+const void* GLReadbackRing::Map(std::uint64_t ticket, bool wait, std::size_t* dataSize)
+{
+    auto slot = FindSlot(ticket);
+    if (slot == nullptr)
+        return nullptr;
+
+    if (dataSize != nullptr)
+        *dataSize = static_cast<std::size_t>(slot->size);
+
+    /* Return previously mapped memory if the same ticket is mapped twice */
+    if (slot->state == SlotState::Mapped)
+        return slot->mappedData;
+
+    /* Check if copy operation has been completed, or wait for it */
+    if (!slot->fence->Wait(wait ? ~0ull : 0ull))
+        return nullptr;
+
+    /* Map entire range of the pack buffer that was written by the read operation */
+    void* data = nullptr;
+
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, slot->buffer);
+    {
+        #ifdef GL_ARB_map_buffer_range
+        if (HasExtension(GLExt::ARB_map_buffer_range))
+            data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot->size, GL_MAP_READ_BIT);
+        else
+        #endif // /GL_ARB_map_buffer_range
+            data = GLProfile::MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot->size, GL_MAP_READ_BIT);
+    }
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+
+    if (data != nullptr)
+    {
+        slot->mappedData    = data;
+        slot->state         = SlotState::Mapped;
+    }
+
+    return data;
+}
+
+void GLReadbackRing::Unmap(std::uint64_t ticket)
+{
+    if (auto slot = FindSlot(ticket))
+        ReleaseSlot(*slot);
+}
+
+void GLReadbackRing::Clear()
+{
+    for (auto& slot : slots_)
+    {
+        ReleaseSlot(slot);
+        if (slot.buffer != 0)
+        {
+            glDeleteBuffers(1, &(slot.buffer));
+            GLStateManager::Get().NotifyBufferRelease(slot.buffer, GLBufferTarget::PIXEL_PACK_BUFFER);
+            slot.buffer     = 0;
+            slot.capacity   = 0;
+        }
+        slot.fence.reset();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+GLReadbackRing::Slot* GLReadbackRing::FindSlot(std::uint64_t ticket)
+{
+    if (ticket == 0 || ticket >= nextTicket_)
+        return nullptr;
+
+    auto& slot = slots_[static_cast<std::size_t>((ticket - 1) % slots_.size())];
+    if (slot.ticket != ticket || slot.state == SlotState::Free)
+        return nullptr;
+
+    return &slot;
+}
+
+void GLReadbackRing::ReleaseSlot(Slot& slot)
+{
+    if (slot.state == SlotState::Mapped)
+    {
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, slot.buffer);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+    }
+    slot.mappedData = nullptr;
+    slot.ticket     = 0;
+    slot.state      = SlotState::Free;
+}
+
+void GLReadbackRing::ReserveSlotCapacity(Slot& slot, GLsizeiptr size)
+{
+    if (slot.buffer == 0)
+    {
+        glGenBuffers(1, &(slot.buffer));
+        slot.fence = MakeUnique<GLFence>();
+    }
+
+    if (slot.capacity < size)
+    {
+        /* Re-allocate mutable buffer storage, GL_STREAM_READ hints the driver to place it in CPU visible memory */
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, slot.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+        slot.capacity = size;
+    }
+}
+
+// Reads the texture region with glReadPixels from a temporary FBO; used for renderbuffers and GLES.
+void GLReadbackRing::ReadPixelsFromFramebuffer(GLTexture& textureGL, const TextureRegion& region, const ImageFormat format, const DataType dataType)
+{
+    const auto offset = CalcTextureOffset(textureGL.GetType(), region.offset, region.subresource.baseArrayLayer);
+
+    GLStateManager::Get().PushBoundFramebuffer(GLFramebufferTarget::READ_FRAMEBUFFER);
+    {
+        GLReadTextureFBO readFBO;
+        readFBO.Attach(textureGL, static_cast<GLint>(region.subresource.baseMipLevel), offset);
+        glReadPixels(
+            offset.x,
+            offset.y,
+            static_cast<GLsizei>(region.extent.width),
+            static_cast<GLsizei>(region.extent.height),
+            GLTypes::Map(format),
+            GLTypes::Map(dataType),
+            nullptr
+        );
+    }
+    GLStateManager::Get().PopBoundFramebuffer();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
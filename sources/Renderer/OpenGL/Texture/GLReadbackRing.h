@@ -0,0 +1,99 @@
+/*
+ * GLReadbackRing.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_READBACK_RING_H
+#define LLGL_GL_READBACK_RING_H
+
+
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Format.h>
+#include "../OpenGL.h"
+#include "../RenderState/GLFence.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class GLTexture;
+
+/*
+Ring of GL_PIXEL_PACK_BUFFER objects for asynchronous texture readback.
+Each read operation is identified by a ticket and occupies one slot of the ring until it is unmapped.
+Enqueuing more read operations than there are slots in the ring invalidates the oldest ticket.
+*/
+class GLReadbackRing
+{
+
+    public:
+
+        GLReadbackRing(std::uint32_t numSlots);
+        ~GLReadbackRing();
+
+        GLReadbackRing(const GLReadbackRing&) = delete;
+        GLReadbackRing& operator = (const GLReadbackRing&) = delete;
+
+        // Enqueues a read operation from the specified texture region into the next pack buffer and returns its ticket.
+        std::uint64_t ReadTexture(GLTexture& textureGL, const TextureRegion& region, const ImageFormat format, const DataType dataType);
+
+        // Maps the pack buffer of the specified ticket. Returns null if the ticket is invalid or, if 'wait' is false, not yet resolved.
+        const void* Map(std::uint64_t ticket, bool wait, std::size_t* dataSize);
+
+        // Unmaps the pack buffer of the specified ticket and makes its slot available again.
+        void Unmap(std::uint64_t ticket);
+
+        // Deletes all pack buffers. This must be called while the GL context is still active.
+        void Clear();
+
+    private:
+
+        enum class SlotState
+        {
+            Free,
+            Pending,
+            Mapped,
+        };
+
+        struct Slot
+        {
+            GLuint                      buffer      = 0;
+            GLsizeiptr                  capacity    = 0;
+            GLsizeiptr                  size        = 0;
+            std::uint64_t               ticket      = 0;
+            SlotState                   state       = SlotState::Free;
+            void*                       mappedData  = nullptr;
+            std::unique_ptr<GLFence>    fence;
+        };
+
+    private:
+
+        Slot* FindSlot(std::uint64_t ticket);
+
+        void ReleaseSlot(Slot& slot);
+        void ReserveSlotCapacity(Slot& slot, GLsizeiptr size);
+
+        void ReadPixelsFromFramebuffer(GLTexture& textureGL, const TextureRegion& region, const ImageFormat format, const DataType dataType);
+
+    private:
+
+        std::vector<Slot>   slots_;
+        std::uint64_t       nextTicket_ = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,7 @@
 #include "../GLCore.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../RenderState/GLStateManager.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
@@ -87,6 +88,7 @@ GLRenderTarget::~GLRenderTarget()
 
 void GLRenderTarget::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     GLSetObjectLabel(GL_FRAMEBUFFER, framebuffer_.GetID(), name);
 }
 
@@ -8,6 +8,7 @@
 #include "GLSampler.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLStateManager.h"
 
@@ -29,6 +30,7 @@ GLSampler::~GLSampler()
 
 void GLSampler::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     GLSetObjectLabel(GL_SAMPLER, GetID(), name);
 }
 
@@ -15,6 +15,7 @@
 #endif
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
+#include "../GLRenderThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../RenderState/GLStateManager.h"
@@ -141,6 +142,7 @@ GLTexture::~GLTexture()
 
 void GLTexture::SetName(const char* name)
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(SetName(name));
     if (IsRenderbuffer())
         GLSetObjectLabel(GL_RENDERBUFFER, GetID(), name);
     else
@@ -166,6 +168,7 @@ static GLenum GLGetTextureParamTarget(const TextureType type)
 
 Extent3D GLTexture::GetMipExtent(std::uint32_t mipLevel) const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(GetMipExtent(mipLevel));
     GLint texSize[3] = { 0 };
     GLint level = static_cast<GLint>(mipLevel);
 
@@ -191,6 +194,7 @@ Extent3D GLTexture::GetMipExtent(std::uint32_t mipLevel) const
 
 TextureDescriptor GLTexture::GetDesc() const
 {
+    LLGL_GL_INVOKE_ON_RENDER_THREAD(GetDesc());
     TextureDescriptor texDesc;
 
     texDesc.type        = GetType();
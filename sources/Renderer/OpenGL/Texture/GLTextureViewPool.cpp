@@ -96,23 +96,23 @@ GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureVie
 
 void GLTextureViewPool::ReleaseTextureView(GLuint texID)
 {
-    /* Try to find texture by GL texture ID only */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = Utils::FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [texID](const GLTextureView& rhs)
+    if (texID == 0)
+        return;
+
+    /* Find texture by GL texture ID only; the array is sorted by the view parameters, so it must be searched linearly */
+    auto it = std::find_if(
+        textureViews_.begin(),
+        textureViews_.end(),
+        [texID](const GLTextureView& entry)
         {
-            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
-            return 0;
-        },
-        &insertionIndex
+            return (entry.texID == texID);
+        }
     );
 
-    if (sharedTexView != nullptr)
+    if (it != textureViews_.end())
     {
         /* Delete GL texture view if the reference counter reaches 0 */
-        ReleaseSharedGLTextureView(*sharedTexView);
+        ReleaseSharedGLTextureView(*it);
 
         /* Remove unused entries in the array after a given amount has been freed */
         if (numReusableEntries_ > g_maxNumReusableTextureViews)
@@ -260,7 +260,9 @@ void GLTextureViewPool::ReleaseSharedGLTextureView(GLTextureView& texView)
         texView.refCount--;
         if (texView.refCount == 0)
         {
+            /* Keep the entry for reuse, but invalidate its GL texture ID */
             DeleteGLTextureView(texView);
+            texView.texID = 0;
             ++numReusableEntries_;
         }
     }
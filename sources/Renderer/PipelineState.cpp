@@ -0,0 +1,25 @@
+/*
+ * PipelineState.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/PipelineState.h>
+
+
+namespace LLGL
+{
+
+
+bool PipelineState::IsReady() const
+{
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
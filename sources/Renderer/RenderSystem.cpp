@@ -17,6 +17,7 @@
 #include <LLGL/RenderSystem.h>
 #include <string>
 #include <map>
+#include <vector>
 
 #ifdef LLGL_ENABLE_DEBUG_LAYER
 #   include "DebugLayer/DbgRenderSystem.h"
@@ -38,14 +39,19 @@ namespace LLGL
 
 struct RenderSystem::Pimpl
 {
-    int                     rendererID = 0;
-    std::string             name;
-    RendererInfo            info;
-    RenderingCapabilities   caps;
+    int                                             rendererID          = 0;
+    std::string                                     name;
+    RendererInfo                                    info;
+    RenderingCapabilities                           caps;
+    std::map<std::uint64_t, std::vector<char>>      readbacks;
+    std::uint64_t                                   nextReadbackTicket  = 1;
 };
 
 static std::map<RenderSystem*, std::unique_ptr<Module>> g_renderSystemModules;
 
+// Maximum number of pending readbacks of the default ReadTextureAsync implementation; matches the default of RendererConfigurationOpenGL::numReadbackBuffers.
+static const std::size_t g_maxNumPendingReadbacks = 3;
+
 RenderSystem::RenderSystem() :
     pimpl_ { new Pimpl{} }
 {
@@ -275,6 +281,62 @@ const RenderingCapabilities& RenderSystem::GetRenderingCaps() const
     return pimpl_->caps;
 }
 
+std::uint64_t RenderSystem::ReadTextureAsync(Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    /* Determine required data size for the texture region */
+    const auto& subresource     = textureRegion.subresource;
+    const auto  baseSubresource = TextureSubresource{ 0, subresource.numArrayLayers, 0, 1 };
+    const auto  numTexels       = NumMipTexels(texture.GetType(), textureRegion.extent, baseSubresource);
+    const auto  dataSize        = GetMemoryFootprint(format, dataType, numTexels);
+
+    if (dataSize == 0)
+        throw std::invalid_argument("cannot read texture asynchronously with compressed image format");
+
+    /* Fallback: read texture synchronously into CPU memory that is kept until the ticket is unmapped */
+    std::vector<char> data(dataSize);
+    const DstImageDescriptor imageDesc{ format, dataType, data.data(), data.size() };
+    ReadTexture(texture, textureRegion, imageDesc);
+
+    /* Invalidate the oldest tickets, so readbacks that are never unmapped do not accumulate */
+    auto& readbacks = pimpl_->readbacks;
+    while (readbacks.size() >= g_maxNumPendingReadbacks)
+        readbacks.erase(readbacks.begin());
+
+    const auto ticket = pimpl_->nextReadbackTicket++;
+    readbacks[ticket] = std::move(data);
+
+    return ticket;
+}
+
+const void* RenderSystem::MapTextureReadback(std::uint64_t ticket, bool /*wait*/, std::size_t* dataSize)
+{
+    auto it = pimpl_->readbacks.find(ticket);
+    if (it != pimpl_->readbacks.end())
+    {
+        if (dataSize != nullptr)
+            *dataSize = it->second.size();
+        return it->second.data();
+    }
+    return nullptr;
+}
+
+void RenderSystem::UnmapTextureReadback(std::uint64_t ticket)
+{
+    pimpl_->readbacks.erase(ticket);
+}
+
+PipelineState* RenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc)
+{
+    /* Fallback: create PSO synchronously; it is ready once this function returns */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
+PipelineState* RenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc)
+{
+    /* Fallback: create PSO synchronously; it is ready once this function returns */
+    return CreatePipelineState(pipelineStateDesc);
+}
+
 
 /*
  * ======= Protected: =======
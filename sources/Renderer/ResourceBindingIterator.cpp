@@ -13,6 +13,67 @@ namespace LLGL
 {
 
 
+/*
+ * ResourceBindingBuckets class
+ */
+
+// Returns the bucket index for the specified resource type, or -1 if the type is undefined
+static int GetResourceTypeBucket(const ResourceType type)
+{
+    switch (type)
+    {
+        case ResourceType::Buffer:  return 0;
+        case ResourceType::Texture: return 1;
+        case ResourceType::Sampler: return 2;
+        default:                    return -1;
+    }
+}
+
+ResourceBindingBuckets::ResourceBindingBuckets(const std::vector<BindingDescriptor>& bindings)
+{
+    for (std::size_t i = 0; i < bindings.size(); ++i)
+    {
+        const auto& binding = bindings[i];
+        const auto typeBucket = GetResourceTypeBucket(binding.type);
+        if (typeBucket < 0)
+            continue;
+
+        auto& typeBuckets = buckets_[typeBucket];
+        typeBuckets[0].push_back(static_cast<std::uint32_t>(i));
+
+        for (std::size_t stage = 0; stage < numStages; ++stage)
+        {
+            if ((binding.stageFlags & (1l << stage)) != 0)
+                typeBuckets[1 + stage].push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+// Returns the index of the specified stage bit (starting at 1), or 0 if the stages do not denote exactly one stage
+static std::size_t GetSingleStageBucket(long stages, std::size_t numStages)
+{
+    for (std::size_t stage = 0; stage < numStages; ++stage)
+    {
+        if (stages == (1l << stage))
+            return (1 + stage);
+    }
+    return 0;
+}
+
+const std::vector<std::uint32_t>& ResourceBindingBuckets::GetIndices(const ResourceType type, long stages) const
+{
+    static const std::vector<std::uint32_t> g_emptyBucket;
+    const auto typeBucket = GetResourceTypeBucket(type);
+    if (typeBucket < 0)
+        return g_emptyBucket;
+    return buckets_[typeBucket][GetSingleStageBucket(stages, numStages)];
+}
+
+
+/*
+ * ResourceBindingIterator class
+ */
+
 ResourceBindingIterator::ResourceBindingIterator(
     const std::vector<ResourceViewDescriptor>&  resourceViews,
     const std::vector<BindingDescriptor>&       bindings,
@@ -28,12 +89,26 @@ ResourceBindingIterator::ResourceBindingIterator(
         count_ = std::min(count_, bindings.size());
 }
 
+ResourceBindingIterator::ResourceBindingIterator(
+    const std::vector<ResourceViewDescriptor>&  resourceViews,
+    const std::vector<BindingDescriptor>&       bindings,
+    const ResourceBindingBuckets&               buckets,
+    std::size_t                                 firstResourceIndex,
+    bool                                        iterateAllSegments)
+:
+    ResourceBindingIterator { resourceViews, bindings, firstResourceIndex, iterateAllSegments }
+{
+    buckets_ = &buckets;
+}
+
 void ResourceBindingIterator::Reset(const ResourceType typeOfInterest, long bindFlagsOfInterest, long stagesOfInterest)
 {
     iterator_               = 0;
     typeOfInterest_         = typeOfInterest;
     bindFlagsOfInterest_    = bindFlagsOfInterest;
     stagesOfInterest_       = stagesOfInterest;
+    if (buckets_ != nullptr)
+        bucket_ = &(buckets_->GetIndices(typeOfInterest, stagesOfInterest));
 }
 
 // Returns the specified resource type as string
@@ -57,31 +132,65 @@ static void ErrNullPointerResource(const ResourceType t)
     );
 }
 
+Resource* ResourceBindingIterator::Accept(
+    const BindingDescriptor&        current,
+    std::size_t                     resourceIndex,
+    const BindingDescriptor**       bindingDesc,
+    const ResourceViewDescriptor**  rvDesc)
+{
+    /* Check for null pointer exception */
+    const auto& resourceViewDesc = resourceViews_[resourceIndex];
+    if (auto resource = resourceViewDesc.resource)
+    {
+        if (bindingDesc != nullptr)
+            *bindingDesc = &current;
+        if (rvDesc != nullptr)
+            *rvDesc = &resourceViewDesc;
+        lastResourceIndex_ = resourceIndex;
+        return resource;
+    }
+    else
+        ErrNullPointerResource(current.type);
+}
+
 Resource* ResourceBindingIterator::Next(const BindingDescriptor** bindingDesc, const ResourceViewDescriptor** rvDesc)
 {
-    while (iterator_ < count_)
+    if (bucket_ != nullptr)
+    {
+        /* Only visit the binding points of the type of interest; the iterator runs over all segments of that bucket */
+        const std::size_t numBindings   = bindings_.size();
+        const std::size_t bucketSize    = bucket_->size();
+        const std::size_t numSegments   = (count_ + numBindings - 1) / numBindings;
+
+        while (iterator_ < numSegments * bucketSize)
+        {
+            const std::size_t index = (iterator_ / bucketSize) * numBindings + (*bucket_)[iterator_ % bucketSize];
+            ++iterator_;
+            if (index >= count_)
+                continue;
+
+            const auto& current = bindings_[index % numBindings];
+            if ( ( bindFlagsOfInterest_ == 0 || (current.bindFlags  & bindFlagsOfInterest_) != 0 ) &&
+                 ( stagesOfInterest_    == 0 || (current.stageFlags & stagesOfInterest_   ) != 0 ) )
+            {
+                return Accept(current, offset_ + index, bindingDesc, rvDesc);
+            }
+        }
+    }
+    else
     {
-        /* Search for resource type of interest */
-        const auto& current = bindings_[iterator_ % bindings_.size()];
-        if ( current.type == typeOfInterest_ &&
-             ( bindFlagsOfInterest_ == 0 || (current.bindFlags  & bindFlagsOfInterest_) != 0 ) &&
-             ( stagesOfInterest_    == 0 || (current.stageFlags & stagesOfInterest_   ) != 0 ) )
+        while (iterator_ < count_)
         {
-            /* Check for null pointer exception */
-            const auto& resourceViewDesc = resourceViews_[offset_ + iterator_];
-            if (auto resource = resourceViewDesc.resource)
+            /* Search for resource type of interest */
+            const auto& current = bindings_[iterator_ % bindings_.size()];
+            const std::size_t index = iterator_++;
+            if ( current.type == typeOfInterest_ &&
+                 ( bindFlagsOfInterest_ == 0 || (current.bindFlags  & bindFlagsOfInterest_) != 0 ) &&
+                 ( stagesOfInterest_    == 0 || (current.stageFlags & stagesOfInterest_   ) != 0 ) )
             {
-                if (bindingDesc != nullptr)
-                    *bindingDesc = &current;
-                if (rvDesc != nullptr)
-                    *rvDesc = &resourceViewDesc;
-                ++iterator_;
-                return resource;
+                return Accept(current, offset_ + index, bindingDesc, rvDesc);
             }
-            else
-                ErrNullPointerResource(current.type);
         }
-        ++iterator_;
     }
     return nullptr;
 }
@@ -13,12 +13,40 @@
 #include <LLGL/ResourceHeapFlags.h>
 #include <LLGL/PipelineLayoutFlags.h>
 #include <vector>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+// Indices of all binding points of a pipeline layout, bucketed by resource type and shader stage.
+class LLGL_EXPORT ResourceBindingBuckets
+{
+
+    public:
+
+        ResourceBindingBuckets() = default;
+        ResourceBindingBuckets(const std::vector<BindingDescriptor>& bindings);
+
+        /*
+        Returns the indices of all bindings of the specified resource type in ascending order.
+        If 'stages' denotes a single shader stage, only the bindings visible to that stage are returned.
+        */
+        const std::vector<std::uint32_t>& GetIndices(const ResourceType type, long stages = 0) const;
+
+    private:
+
+        static const std::size_t numResourceTypes   = 3; // Buffer, Texture, Sampler
+        static const std::size_t numStages          = 6; // Vertex, TessControl, TessEvaluation, Geometry, Fragment, Compute
+
+    private:
+
+        // Indices per resource type; the first bucket contains all stages, the remaining ones a single stage each.
+        std::vector<std::uint32_t> buckets_[numResourceTypes][1 + numStages];
+
+};
+
 // Helper class to iterate over all resource views and their binding points of a certain type
 class LLGL_EXPORT ResourceBindingIterator
 {
@@ -32,6 +60,15 @@ class LLGL_EXPORT ResourceBindingIterator
             bool                                        iterateAllSegments  = false
         );
 
+        // Iterates only over the pre-bucketed binding points, instead of scanning all bindings on every call to 'Reset'.
+        ResourceBindingIterator(
+            const std::vector<ResourceViewDescriptor>&  resourceViews,
+            const std::vector<BindingDescriptor>&       bindings,
+            const ResourceBindingBuckets&               buckets,
+            std::size_t                                 firstResourceIndex  = 0,
+            bool                                        iterateAllSegments  = false
+        );
+
         // Resets the iteration for the specified binding parameters.
         void Reset(const ResourceType typeOfInterest, long bindFlagsOfInterest = 0, long stagesOfInterest = 0);
 
@@ -44,13 +81,32 @@ class LLGL_EXPORT ResourceBindingIterator
             return count_;
         }
 
+        // Returns the index of the resource view that was returned by the last call to 'Next'.
+        inline std::size_t GetLastResourceIndex() const
+        {
+            return lastResourceIndex_;
+        }
+
+    private:
+
+        // Returns the specified resource if it is not null, or throws an exception otherwise.
+        Resource* Accept(
+            const BindingDescriptor&        current,
+            std::size_t                     resourceIndex,
+            const BindingDescriptor**       bindingDesc,
+            const ResourceViewDescriptor**  rvDesc
+        );
+
     private:
 
         const std::vector<ResourceViewDescriptor>&  resourceViews_;
         const std::vector<BindingDescriptor>&       bindings_;
+        const ResourceBindingBuckets*               buckets_                = nullptr;
+        const std::vector<std::uint32_t>*           bucket_                 = nullptr;
         std::size_t                                 iterator_               = 0;
         std::size_t                                 offset_                 = 0;
         std::size_t                                 count_                  = 0;
+        std::size_t                                 lastResourceIndex_      = 0;
         ResourceType                                typeOfInterest_         = ResourceType::Undefined;
         long                                        bindFlagsOfInterest_    = ~0;
         long                                        stagesOfInterest_       = StageFlags::AllStages;
@@ -8,6 +8,7 @@
 #include "SPIRVReflect.h"
 #include "../../Core/Helper.h"
 #include <string>
+#include <algorithm>
 
 
 namespace LLGL
@@ -56,9 +57,15 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpName:
             OpName(instr);
             break;
+        case spv::Op::OpMemberName:
+            OpMemberName(instr);
+            break;
         case spv::Op::OpDecorate:
             OpDecorate(instr);
             break;
+        case spv::Op::OpMemberDecorate:
+            OpMemberDecorate(instr);
+            break;
         case spv::Op::OpTypeVoid:
         case spv::Op::OpTypeBool:
         case spv::Op::OpTypeInt:
@@ -92,6 +99,15 @@ void SPIRVReflect::OpName(const Instr& instr)
     SetName(instr.GetUInt32(0), instr.GetASCII(1));
 }
 
+void SPIRVReflect::OpMemberName(const Instr& instr)
+{
+    auto& names = memberNames_[instr.GetUInt32(0)];
+    auto member = instr.GetUInt32(1);
+    if (member >= names.size())
+        names.resize(member + 1, nullptr);
+    names[member] = instr.GetASCII(2);
+}
+
 void SPIRVReflect::OpDecorate(const Instr& instr)
 {
     auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(1));
@@ -111,6 +127,19 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
     }
 }
 
+void SPIRVReflect::OpMemberDecorate(const Instr& instr)
+{
+    auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(2));
+    if (decoration == spv::Decoration::Offset)
+    {
+        auto& offsets = memberOffsets_[instr.GetUInt32(0)];
+        auto member = instr.GetUInt32(1);
+        if (member >= offsets.size())
+            offsets.resize(member + 1, 0);
+        offsets[member] = instr.GetUInt32(3);
+    }
+}
+
 void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
@@ -256,6 +285,23 @@ void SPIRVReflect::OpTypeStruct(const Instr& instr, SpvType& type)
         AccumulateSizeInVectorBoundary(type.size, 16, fieldType->size);
     }
     type.size = GetAlignedSize(type.size, 16u);
+
+    /* Take field names and offsets that have been declared before this instruction */
+    auto names = memberNames_.find(instr.result);
+    if (names != memberNames_.end())
+    {
+        type.fieldNames = std::move(names->second);
+        memberNames_.erase(names);
+    }
+    type.fieldNames.resize(type.fieldTypes.size(), nullptr);
+
+    auto offsets = memberOffsets_.find(instr.result);
+    if (offsets != memberOffsets_.end())
+    {
+        type.fieldOffsets = std::move(offsets->second);
+        memberOffsets_.erase(offsets);
+    }
+    type.fieldOffsets.resize(type.fieldTypes.size(), 0);
 }
 
 void SPIRVReflect::OpTypeOpaque(const Instr& instr, SpvType& type)
@@ -289,7 +335,6 @@ void SPIRVReflect::OpVariable(const Instr& instr)
     {
         case spv::StorageClass::Uniform:
         case spv::StorageClass::UniformConstant:
-        //case spv::StorageClass::PushConstant:
         {
             auto& var = uniforms_[instr.result];
             {
@@ -306,6 +351,12 @@ void SPIRVReflect::OpVariable(const Instr& instr)
         }
         break;
 
+        case spv::StorageClass::PushConstant:
+        {
+            OpVariablePushConstant(instr);
+        }
+        break;
+
         case spv::StorageClass::Input:
         {
             auto& var = varyings_[instr.result];
@@ -331,6 +382,41 @@ void SPIRVReflect::OpVariable(const Instr& instr)
     }
 }
 
+/*
+Example:
+        OpMemberDecorate %14 0 Offset 0
+        OpMemberDecorate %14 1 Offset 64
+  %14 = OpTypeStruct    %13 %12             struct S { mat4; vec4 }
+  %15 = OpTypePointer   PushConstant %14    S*
+  %16 = OpVariable      %15 PushConstant    layout(push_constant) uniform S
+*/
+void SPIRVReflect::OpVariablePushConstant(const Instr& instr)
+{
+    auto& var = pushConstants_[instr.result];
+    {
+        var.name = GetName(instr.result);
+        var.type = FindType(instr.type);
+
+        if (auto structType = var.type->DereferencePtr(spv::Op::OpTypeStruct))
+        {
+            if (var.name == nullptr || *var.name == '\0')
+                var.name = structType->name;
+
+            /* Push constants use explicit offsets, so the block ends after the field with the highest offset */
+            for (std::size_t i = 0; i < structType->fieldTypes.size(); ++i)
+            {
+                auto fieldType = structType->fieldTypes[i];
+                auto fieldSize = fieldType->size;
+                if (fieldType->opcode == spv::Op::OpTypeArray && fieldType->baseType != nullptr)
+                    fieldSize = fieldType->baseType->size * fieldType->elements;
+                var.size = std::max(var.size, structType->fieldOffsets[i] + fieldSize);
+            }
+        }
+        else
+            var.size = var.type->size;
+    }
+}
+
 void SPIRVReflect::OpConstant(const Instr& instr)
 {
     auto& val = constants_[instr.result];
@@ -40,6 +40,8 @@ class SPIRVReflect final : public SPIRVParser
             std::uint32_t               size        = 0;                        // Size (in bytes) of this type, or 0 if this is an OpTypeVoid type.
             bool                        sign        = false;                    // Specifies whether or not this is a signed type (only for OpTypeInt).
             std::vector<const SpvType*> fieldTypes;                             // List of types of each record field.
+            std::vector<const char*>    fieldNames;                             // List of names of each record field (from OpMemberName).
+            std::vector<std::uint32_t>  fieldOffsets;                           // List of byte offsets of each record field (from OpMemberDecorate Offset).
         };
 
         // SPIRV-V scalar constants.
@@ -102,6 +104,12 @@ class SPIRVReflect final : public SPIRVParser
             return varyings_;
         }
 
+        // Returns the push constant blocks. The size of each block is determined by the explicit offsets of its fields.
+        inline const std::map<spv::Id, SpvUniform>& GetPushConstants() const
+        {
+            return pushConstants_;
+        }
+
     private:
 
         using Instr = SPIRVInstruction;
@@ -110,7 +118,9 @@ class SPIRVReflect final : public SPIRVParser
         void OnParseInstruction(const SPIRVInstruction& instr) override;
 
         void OpName(const Instr& instr);
+        void OpMemberName(const Instr& instr);
         void OpDecorate(const Instr& instr);
+        void OpMemberDecorate(const Instr& instr);
         void OpDecorateBinding(const Instr& instr);
         void OpDecorateLocation(const Instr& instr);
         void OpDecorateBuiltin(const Instr& instr);
@@ -131,6 +141,7 @@ class SPIRVReflect final : public SPIRVParser
         void OpTypePointer(const Instr& instr, SpvType& type);
         void OpTypeFunction(const Instr& instr, SpvType& type);
         void OpVariable(const Instr& instr);
+        void OpVariablePushConstant(const Instr& instr);
         void OpConstant(const Instr& instr);
 
     private:
@@ -153,6 +164,11 @@ class SPIRVReflect final : public SPIRVParser
         std::map<spv::Id, SpvRecord>    records_;
         std::map<spv::Id, SpvUniform>   uniforms_;
         std::map<spv::Id, SpvVarying>   varyings_;
+        std::map<spv::Id, SpvUniform>   pushConstants_;
+
+        // Record field names and offsets, which are declared before their OpTypeStruct instruction.
+        std::map<spv::Id, std::vector<const char*>>     memberNames_;
+        std::map<spv::Id, std::vector<std::uint32_t>>   memberOffsets_;
 
 };
 
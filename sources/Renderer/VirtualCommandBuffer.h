@@ -133,17 +133,13 @@ class VirtualCommandBuffer
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer(VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
         }
 
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer& operator = (VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
             return *this;
         }
 
@@ -235,6 +231,25 @@ class VirtualCommandBuffer
             return reinterpret_cast<TCommand*>(data + sizeof(opcode));
         }
 
+        // Allocates a new command with the specified opcode and untyped command data, e.g. to copy a command from another virtual command buffer.
+        char* AllocRawCommand(const TOpcode opcode, std::size_t commandSize)
+        {
+            char* data = AllocData(sizeof(opcode) + commandSize);
+            *reinterpret_cast<TOpcode*>(data) = opcode;
+            return (data + sizeof(opcode));
+        }
+
+        // Swaps the memory of this virtual command buffer with the specified one.
+        void Swap(VirtualCommandBuffer& rhs)
+        {
+            std::swap(initialCapacity_, rhs.initialCapacity_);
+            std::swap(first_, rhs.first_);
+            std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
+            std::swap(size_, rhs.size_);
+        }
+
     public:
 
         // STL compatible function to return the constant iterator to the first memory chunk.
@@ -110,6 +110,7 @@ void* VKBuffer::Map(VKDevice& device, const CPUAccess access, VkDeviceSize offse
 
         if (HasWriteAccess(access))
         {
+            WaitStagingBuffer(device);
             mappedWriteRange_[0] = offset;
             mappedWriteRange_[1] = offset + length;
         }
@@ -132,13 +133,30 @@ void VKBuffer::Unmap(VKDevice& device)
         {
             const VkDeviceSize offset = mappedWriteRange_[0];
             const VkDeviceSize length = (mappedWriteRange_[1] - mappedWriteRange_[0]);
-            device.CopyBuffer(stagingBuffer, GetVkBuffer(), length, offset, offset);
+            UploadStagingBuffer(device, offset, length);
             mappedWriteRange_[0] = 0;
             mappedWriteRange_[1] = 0;
         }
     }
 }
 
+void VKBuffer::UploadStagingBuffer(VKDevice& device, VkDeviceSize offset, VkDeviceSize length)
+{
+    /* Record copy command without waiting for it; the CPU only has to wait before it writes to the staging buffer again */
+    device.CopyBuffer(device.GetUploadCommandBuffer(), GetStagingVkBuffer(), GetVkBuffer(), length, offset, offset);
+    stagingSubmissionID_ = device.GetUploadSubmissionID();
+    uploadSubmissionID_ = stagingSubmissionID_;
+}
+
+void VKBuffer::WaitStagingBuffer(VKDevice& device)
+{
+    if (stagingSubmissionID_ != 0)
+    {
+        device.WaitSubmission(stagingSubmissionID_);
+        stagingSubmissionID_ = 0;
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -37,6 +37,24 @@ class VKBuffer : public Buffer
         void* Map(VKDevice& device, const CPUAccess access, VkDeviceSize offset, VkDeviceSize length);
         void Unmap(VKDevice& device);
 
+        // Copies the specified range of the staging buffer into the hardware buffer with the upload command buffer of the device.
+        void UploadStagingBuffer(VKDevice& device, VkDeviceSize offset, VkDeviceSize length);
+
+        // Blocks until the GPU no longer reads from the staging buffer, so the CPU can write to it again.
+        void WaitStagingBuffer(VKDevice& device);
+
+        // Stores the queue submission of the upload command buffer that writes into this buffer.
+        inline void SetUploadSubmissionID(std::uint64_t submissionID)
+        {
+            uploadSubmissionID_ = submissionID;
+        }
+
+        // Returns the latest queue submission that writes into this buffer with the upload command buffer, or 0 if there is none.
+        inline std::uint64_t GetUploadSubmissionID() const
+        {
+            return uploadSubmissionID_;
+        }
+
         // Returns the device buffer object.
         inline VKDeviceBuffer& GetDeviceBuffer()
         {
@@ -92,6 +110,8 @@ class VKBuffer : public Buffer
 
         VkDeviceSize    size_                   = 0;
         VkDeviceSize    mappedWriteRange_[2]    = { 0, 0 };
+        std::uint64_t   stagingSubmissionID_    = 0; // Latest queue submission that reads from the staging buffer.
+        std::uint64_t   uploadSubmissionID_     = 0; // Latest queue submission that writes into the hardware buffer.
 
         VkIndexType     indexType_              = VK_INDEX_TYPE_MAX_ENUM;
 
@@ -0,0 +1,111 @@
+/*
+ * VKStagingBufferPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingBufferPool.h"
+#include "../VKDevice.h"
+#include "../VKInitializers.h"
+#include "../Memory/VKDeviceMemoryManager.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+VKStagingBufferPool::VKStagingBufferPool(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize chunkSize) :
+    device_           { device           },
+    deviceMemoryMngr_ { deviceMemoryMngr },
+    chunkSize_        { chunkSize        }
+{
+}
+
+VKStagingBufferPool::~VKStagingBufferPool()
+{
+    /* Device memory of each chunk is implicitly unmapped when it is released */
+}
+
+VKStagingBufferPool::VKStagingBufferPool(VKStagingBufferPool&& rhs) :
+    device_           { rhs.device_                },
+    deviceMemoryMngr_ { rhs.deviceMemoryMngr_      },
+    chunks_           { std::move(rhs.chunks_)     },
+    chunkIdx_         { rhs.chunkIdx_              },
+    chunkSize_        { rhs.chunkSize_             }
+{
+    rhs.chunks_.clear();
+    rhs.chunkIdx_ = 0;
+}
+
+void VKStagingBufferPool::Reset()
+{
+    for (auto& chunk : chunks_)
+        chunk.offset = 0;
+    chunkIdx_ = 0;
+}
+
+void VKStagingBufferPool::Write(
+    const void*     data,
+    VkDeviceSize    dataSize,
+    VkBuffer&       srcBuffer,
+    VkDeviceSize&   srcOffset)
+{
+    /* Find a chunk that fits the requested data size or allocate a new chunk */
+    while (chunkIdx_ < chunks_.size() && chunks_[chunkIdx_].offset + dataSize > chunks_[chunkIdx_].size)
+        ++chunkIdx_;
+
+    if (chunkIdx_ == chunks_.size())
+        AllocChunk(dataSize);
+
+    /* Copy data into persistently mapped memory of current chunk and increment writing offset */
+    auto& chunk = chunks_[chunkIdx_];
+    ::memcpy(chunk.mappedData + chunk.offset, data, static_cast<std::size_t>(dataSize));
+
+    srcBuffer   = chunk.buffer.GetVkBuffer();
+    srcOffset   = chunk.offset;
+
+    chunk.offset += dataSize;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKStagingBufferPool::AllocChunk(VkDeviceSize minChunkSize)
+{
+    const VkDeviceSize size = std::max(chunkSize_, minChunkSize);
+
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    /* Create staging buffer and a dedicated device memory allocation for it */
+    VKDeviceBuffer buffer{ device_, createInfo };
+
+    const auto& requirements = buffer.GetRequirements();
+    const auto memoryTypeIndex = deviceMemoryMngr_.FindMemoryType(
+        requirements.memoryTypeBits,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+
+    auto memory = MakeUnique<VKDeviceMemory>(device_, requirements.size, memoryTypeIndex);
+    auto region = memory->Allocate(requirements.size, requirements.alignment);
+    buffer.BindMemoryRegion(device_, region);
+
+    /* Map entire chunk once; host-coherent memory does not need to be flushed */
+    auto mappedData = reinterpret_cast<char*>(memory->Map(device_, 0, VK_WHOLE_SIZE)) + region->GetOffset();
+
+    chunks_.push_back(Chunk{ std::move(memory), std::move(buffer), mappedData, size, 0 });
+    chunkIdx_ = chunks_.size() - 1;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,91 @@
+/*
+ * VKStagingBufferPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_BUFFER_POOL_H
+#define LLGL_VK_STAGING_BUFFER_POOL_H
+
+
+#include "VKDeviceBuffer.h"
+#include "../Memory/VKDeviceMemory.h"
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKDeviceMemoryManager;
+
+/*
+Linear allocator for dynamic buffer updates during command buffer recording.
+Data is written into a growing list of host-visible chunks, which are recycled as a whole with "Reset"
+once the GPU has finished all copy commands that read from them.
+Each chunk has its own device memory allocation that stays mapped for its entire lifetime,
+so recording neither accesses the shared device memory manager nor maps memory that other resources share.
+*/
+class VKStagingBufferPool
+{
+
+    public:
+
+        VKStagingBufferPool(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize chunkSize);
+        ~VKStagingBufferPool();
+
+        VKStagingBufferPool(VKStagingBufferPool&& rhs);
+
+        VKStagingBufferPool(const VKStagingBufferPool&) = delete;
+        VKStagingBufferPool& operator = (const VKStagingBufferPool&) = delete;
+
+        // Resets the writing offset of all chunks in the pool.
+        void Reset();
+
+        // Writes the specified data into the pool and returns the staging buffer and offset it has been written to.
+        void Write(
+            const void*     data,
+            VkDeviceSize    dataSize,
+            VkBuffer&       srcBuffer,
+            VkDeviceSize&   srcOffset
+        );
+
+    private:
+
+        struct Chunk
+        {
+            std::unique_ptr<VKDeviceMemory> memory;     // Dedicated device memory; must be released after the buffer
+            VKDeviceBuffer                  buffer;
+            char*                           mappedData;
+            VkDeviceSize                    size;
+            VkDeviceSize                    offset;
+        };
+
+    private:
+
+        // Allocates a new chunk with the specified minimal size.
+        void AllocChunk(VkDeviceSize minChunkSize);
+
+    private:
+
+        VKDevice&               device_;
+        VKDeviceMemoryManager&  deviceMemoryMngr_;  // Only used to find the memory type of new chunks
+
+        std::vector<Chunk>      chunks_;
+        std::size_t             chunkIdx_           = 0;
+        VkDeviceSize            chunkSize_          = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -69,6 +69,9 @@ class VKDeviceMemoryManager
 
         #endif
 
+        // Finds a memory type index for the specified attributes. This only reads the immutable memory properties and can be called from any thread.
+        std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
+
         // Returns the VkDevice object used for this device memory manager.
         inline VkDevice GetVkDevice() const
         {
@@ -77,9 +80,6 @@ class VKDeviceMemoryManager
 
     private:
 
-        // Finds a memory type index for the specified attributes.
-        std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
-
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
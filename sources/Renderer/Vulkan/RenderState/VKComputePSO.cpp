@@ -7,6 +7,7 @@
 
 #include "VKComputePSO.h"
 #include "../Shader/VKShader.h"
+#include "../VKSerialization.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
 #include "../../CheckedCast.h"
@@ -21,27 +22,67 @@ namespace LLGL
 VKComputePSO::VKComputePSO(
     const VKPtr<VkDevice>&              device,
     const ComputePipelineDescriptor&    desc,
-    VkPipelineLayout                    defaultPipelineLayout)
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache,
+    Serialization::Serializer*          writer,
+    ThreadPool*                         threadPool)
 :
     VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE }
 {
-    /* Create Vulkan compute pipeline object */
-    CreateVkPipeline(
+    auto pipelineLayout = GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout);
+
+    if (threadPool != nullptr)
+    {
+        /* Create Vulkan compute pipeline object on worker thread with a copy of the descriptor */
+        CreateVkPipelineAsync(
+            *threadPool,
+            [this, &device, pipelineLayout, pipelineCache, desc]()
+            {
+                CreateVkPipeline(device, pipelineLayout, pipelineCache, desc, nullptr);
+            }
+        );
+    }
+    else
+    {
+        /* Create Vulkan compute pipeline object */
+        CreateVkPipeline(device, pipelineLayout, pipelineCache, desc, writer);
+    }
+}
+
+VKComputePSO::VKComputePSO(
+    const VKPtr<VkDevice>&              device,
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache,
+    Serialization::Deserializer&        reader)
+:
+    VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE }
+{
+    /* Create Vulkan compute pipeline object from serialized cache */
+    CreateVkPipelineFromCache(
         device,
-        GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
-        desc
+        ReadPipelineLayout(device, reader, defaultPipelineLayout),
+        pipelineCache,
+        reader
     );
 }
 
+VKComputePSO::~VKComputePSO()
+{
+    /* Creation on worker thread still refers to this object */
+    WaitForCreation();
+}
+
 
 /*
  * ======= Private: =======
  */
 
 void VKComputePSO::CreateVkPipeline(
-    VkDevice                            device,
+    const VKPtr<VkDevice>&              device,
     VkPipelineLayout                    pipelineLayout,
-    const ComputePipelineDescriptor&    desc)
+    VkPipelineCache                     pipelineCache,
+    const ComputePipelineDescriptor&    desc,
+    Serialization::Serializer*          writer)
 {
     /* Get compute shader */
     auto computeShaderVK = LLGL_CAST(const VKShader*, desc.computeShader);
@@ -63,7 +104,65 @@ void VKComputePSO::CreateVkPipeline(
         createInfo.basePipelineHandle   = VK_NULL_HANDLE;
         createInfo.basePipelineIndex    = 0;
     }
-    auto result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+
+    if (writer != nullptr)
+    {
+        /* Write compute PSO identifier, pipeline layout, and shader */
+        writer->Begin(Serialization::VKIdent_ComputePSOIdent);
+        writer->End();
+        WritePipelineLayout(*writer, desc.pipelineLayout);
+        WriteShaderStage(*writer, desc.computeShader);
+
+        /* Create PSO with a dedicated pipeline cache, so the serialized cache only contains data of this PSO */
+        auto localPipelineCache = CreateVkPipelineCache(device);
+        CreateVkPipelineWithCache(device, createInfo, localPipelineCache);
+        Serialization::VKWriteSegmentPipelineCache(*writer, device, localPipelineCache);
+        MergeVkPipelineCache(device, pipelineCache, localPipelineCache);
+    }
+    else
+        CreateVkPipelineWithCache(device, createInfo, pipelineCache);
+}
+
+void VKComputePSO::CreateVkPipelineFromCache(
+    const VKPtr<VkDevice>&          device,
+    VkPipelineLayout                pipelineLayout,
+    VkPipelineCache                 pipelineCache,
+    Serialization::Deserializer&    reader)
+{
+    /* Re-create shader module */
+    std::vector<VKPtr<VkShaderModule>>              shaderModules;
+    std::vector<std::string>                        entryPoints;
+    std::vector<VkPipelineShaderStageCreateInfo>    shaderStageCreateInfos;
+    ReadShaderStages(device, reader, shaderModules, entryPoints, shaderStageCreateInfos);
+
+    if (shaderStageCreateInfos.size() != 1)
+        throw std::runtime_error("serialized cache of Vulkan compute pipeline must contain exactly one shader stage");
+
+    /* Create compute pipeline state object */
+    VkComputePipelineCreateInfo createInfo;
+    {
+        createInfo.sType                = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.pNext                = nullptr;
+        createInfo.flags                = 0;
+        createInfo.stage                = shaderStageCreateInfos.front();
+        createInfo.layout               = pipelineLayout;
+        createInfo.basePipelineHandle   = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex    = 0;
+    }
+
+    /* Seed a dedicated pipeline cache with the serialized cache data and merge it into the render system's pipeline cache */
+    auto seg = reader.ReadSegmentOnMatch(Serialization::VKIdent_PipelineCache);
+    auto localPipelineCache = CreateVkPipelineCache(device, seg.data, seg.size);
+    CreateVkPipelineWithCache(device, createInfo, localPipelineCache);
+    MergeVkPipelineCache(device, pipelineCache, localPipelineCache);
+}
+
+void VKComputePSO::CreateVkPipelineWithCache(
+    VkDevice                            device,
+    const VkComputePipelineCreateInfo&  createInfo,
+    VkPipelineCache                     pipelineCache)
+{
+    auto result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan compute pipeline");
 }
 
@@ -23,18 +23,50 @@ class VKComputePSO final : public VKPipelineState
 
     public:
 
+        /*
+        Constructs the compute PSO with the specified descriptor.
+        If a thread pool is specified, the native PSO is created on a worker thread and the serializer must be null.
+        */
         VKComputePSO(
             const VKPtr<VkDevice>&              device,
             const ComputePipelineDescriptor&    desc,
-            VkPipelineLayout                    defaultPipelineLayout
+            VkPipelineLayout                    defaultPipelineLayout,
+            VkPipelineCache                     pipelineCache,
+            Serialization::Serializer*          writer                  = nullptr,
+            ThreadPool*                         threadPool              = nullptr
         );
 
+        // Constructs the compute PSO with a deserializer of a cached PSO.
+        VKComputePSO(
+            const VKPtr<VkDevice>&              device,
+            VkPipelineLayout                    defaultPipelineLayout,
+            VkPipelineCache                     pipelineCache,
+            Serialization::Deserializer&        reader
+        );
+
+        ~VKComputePSO();
+
     private:
 
         void CreateVkPipeline(
-            VkDevice                            device,
+            const VKPtr<VkDevice>&              device,
             VkPipelineLayout                    pipelineLayout,
-            const ComputePipelineDescriptor&    desc
+            VkPipelineCache                     pipelineCache,
+            const ComputePipelineDescriptor&    desc,
+            Serialization::Serializer*          writer
+        );
+
+        void CreateVkPipelineFromCache(
+            const VKPtr<VkDevice>&              device,
+            VkPipelineLayout                    pipelineLayout,
+            VkPipelineCache                     pipelineCache,
+            Serialization::Deserializer&        reader
+        );
+
+        void CreateVkPipelineWithCache(
+            VkDevice                            device,
+            const VkComputePipelineCreateInfo&  createInfo,
+            VkPipelineCache                     pipelineCache
         );
 
 };
@@ -0,0 +1,226 @@
+/*
+ * VKDescriptorPoolAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDescriptorPoolAllocator.h"
+#include "../VKCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of descriptor sets a default page can hold.
+static const std::uint32_t g_pageMaxSets = 256;
+
+// Number of descriptors per type and per set a default page reserves.
+static const std::uint32_t g_pageDescriptorsPerSet = 4;
+
+// Descriptor types a default page reserves memory for; these are all types that resource heaps can be created with.
+static const VkDescriptorType g_pageDescriptorTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+VKDescriptorPoolAllocator::Page::Page(const VKPtr<VkDevice>& device) :
+    pool { device, vkDestroyDescriptorPool }
+{
+}
+
+VKDescriptorPoolAllocator::VKDescriptorPoolAllocator(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+void VKDescriptorPoolAllocator::Allocate(
+    VkDescriptorSetLayout       setLayout,
+    std::uint32_t               numPoolSizes,
+    const VkDescriptorPoolSize* poolSizes,
+    std::uint32_t               numSets,
+    VkDescriptorSet*            outSets)
+{
+    /* Hand out recycled descriptor sets of the same layout first */
+    auto it = freeSets_.find(setLayout);
+    if (it != freeSets_.end())
+    {
+        auto& freeSets = it->second;
+        while (numSets > 0 && !freeSets.empty())
+        {
+            *outSets++ = freeSets.back();
+            freeSets.pop_back();
+            --numSets;
+            --numRecycledSets_;
+            ++numReusedSets_;
+        }
+    }
+
+    if (numSets == 0)
+        return;
+
+    const std::vector<VkDescriptorSetLayout> setLayouts(numSets, setLayout);
+
+    /* Try current page first, then all pages that got descriptor sets back since they ran out of memory */
+    if (!pages_.empty() && AllocateFromPage(pages_[currentPage_], setLayouts, outSets) == VK_SUCCESS)
+        return;
+
+    for (std::size_t i = 0; i < pages_.size(); ++i)
+    {
+        auto& page = pages_[i];
+        if (page.hasFreedSets && i != currentPage_)
+        {
+            page.hasFreedSets = false;
+            if (AllocateFromPage(page, setLayouts, outSets) == VK_SUCCESS)
+            {
+                currentPage_ = i;
+                return;
+            }
+        }
+    }
+
+    /* Allocate from a new page that is large enough for this request */
+    auto& page = CreatePage(numPoolSizes, poolSizes, numSets);
+    auto result = AllocateFromPage(page, setLayouts, outSets);
+    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+}
+
+void VKDescriptorPoolAllocator::Free(VkDescriptorSetLayout setLayout, std::uint32_t numSets, const VkDescriptorSet* sets)
+{
+    auto& freeSets = freeSets_[setLayout];
+    freeSets.insert(freeSets.end(), sets, sets + numSets);
+    numRecycledSets_ += numSets;
+}
+
+void VKDescriptorPoolAllocator::ReleaseSetLayout(VkDescriptorSetLayout setLayout)
+{
+    auto it = freeSets_.find(setLayout);
+    if (it == freeSets_.end())
+        return;
+
+    /* Free descriptor sets individually, since they might have been allocated from different pages */
+    for (auto set : it->second)
+    {
+        auto itSet = allocatedSets_.find(set);
+        if (itSet != allocatedSets_.end())
+        {
+            vkFreeDescriptorSets(device_, itSet->second, 1, &set);
+            for (auto& page : pages_)
+            {
+                if (page.pool.Get() == itSet->second)
+                {
+                    page.hasFreedSets = true;
+                    break;
+                }
+            }
+            allocatedSets_.erase(itSet);
+        }
+    }
+
+    numRecycledSets_ -= it->second.size();
+    freeSets_.erase(it);
+}
+
+VKDescriptorPoolDetails VKDescriptorPoolAllocator::QueryDetails() const
+{
+    VKDescriptorPoolDetails details;
+    {
+        details.numPages            = pages_.size();
+        details.numAllocatedSets    = allocatedSets_.size() - numRecycledSets_;
+        details.numRecycledSets     = numRecycledSets_;
+        details.numReusedSets       = numReusedSets_;
+    }
+    return details;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VkResult VKDescriptorPoolAllocator::AllocateFromPage(Page& page, const std::vector<VkDescriptorSetLayout>& setLayouts, VkDescriptorSet* outSets)
+{
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = page.pool;
+        allocInfo.descriptorSetCount    = static_cast<std::uint32_t>(setLayouts.size());
+        allocInfo.pSetLayouts           = setLayouts.data();
+    }
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, outSets);
+
+    /* Keep track of the page each descriptor set has been allocated from */
+    if (result == VK_SUCCESS)
+    {
+        for (std::size_t i = 0; i < setLayouts.size(); ++i)
+            allocatedSets_[outSets[i]] = page.pool.Get();
+    }
+
+    return result;
+}
+
+VKDescriptorPoolAllocator::Page& VKDescriptorPoolAllocator::CreatePage(
+    std::uint32_t               numPoolSizes,
+    const VkDescriptorPoolSize* poolSizes,
+    std::uint32_t               numSets)
+{
+    const std::uint32_t maxSets = std::max(g_pageMaxSets, numSets);
+
+    /* Reserve default amount of descriptors for all types, and enlarge them for requests that exceed a default page */
+    std::vector<VkDescriptorPoolSize> pagePoolSizes;
+    pagePoolSizes.reserve(sizeof(g_pageDescriptorTypes)/sizeof(g_pageDescriptorTypes[0]) + numPoolSizes);
+
+    for (auto type : g_pageDescriptorTypes)
+        pagePoolSizes.push_back({ type, maxSets * g_pageDescriptorsPerSet });
+
+    for (std::uint32_t i = 0; i < numPoolSizes; ++i)
+    {
+        const auto requiredCount = poolSizes[i].descriptorCount * numSets;
+        auto it = std::find_if(
+            pagePoolSizes.begin(),
+            pagePoolSizes.end(),
+            [&poolSizes, i](const VkDescriptorPoolSize& pagePoolSize)
+            {
+                return (pagePoolSize.type == poolSizes[i].type);
+            }
+        );
+        if (it != pagePoolSizes.end())
+            it->descriptorCount = std::max(it->descriptorCount, requiredCount);
+        else
+            pagePoolSizes.push_back({ poolSizes[i].type, requiredCount });
+    }
+
+    /* Create descriptor pool; sets must be freeable individually to release them when their layout is destroyed */
+    Page page{ device_ };
+
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolCreateInfo.maxSets          = maxSets;
+        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(pagePoolSizes.size());
+        poolCreateInfo.pPoolSizes       = pagePoolSizes.data();
+    }
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, page.pool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+
+    pages_.emplace_back(std::move(page));
+    currentPage_ = pages_.size() - 1;
+
+    return pages_.back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,108 @@
+/*
+ * VKDescriptorPoolAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DESCRIPTOR_POOL_ALLOCATOR_H
+#define LLGL_VK_DESCRIPTOR_POOL_ALLOCATOR_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+// Allocation statistics of the descriptor pool allocator.
+struct VKDescriptorPoolDetails
+{
+    std::size_t numPages            = 0; // Number of VkDescriptorPool objects.
+    std::size_t numAllocatedSets    = 0; // Number of descriptor sets in use by resource heaps.
+    std::size_t numRecycledSets     = 0; // Number of freed descriptor sets waiting to be reused.
+    std::size_t numReusedSets       = 0; // Total number of allocations that were served by recycled descriptor sets.
+};
+
+/*
+Device-level descriptor set allocator. Descriptor sets are allocated from a growing list of shared VkDescriptorPool pages.
+Freed descriptor sets are kept in a free list per descriptor set layout and handed out again to the next allocation with the same layout,
+so creating and releasing resource heaps does not create or destroy any descriptor pools.
+*/
+class VKDescriptorPoolAllocator
+{
+
+    public:
+
+        VKDescriptorPoolAllocator(const VKPtr<VkDevice>& device);
+
+        VKDescriptorPoolAllocator(const VKDescriptorPoolAllocator&) = delete;
+        VKDescriptorPoolAllocator& operator = (const VKDescriptorPoolAllocator&) = delete;
+
+        /*
+        Allocates 'numSets' descriptor sets with the specified layout.
+        'poolSizes' specifies the number of descriptors for each type that a single descriptor set of this layout requires.
+        */
+        void Allocate(
+            VkDescriptorSetLayout       setLayout,
+            std::uint32_t               numPoolSizes,
+            const VkDescriptorPoolSize* poolSizes,
+            std::uint32_t               numSets,
+            VkDescriptorSet*            outSets
+        );
+
+        // Returns the specified descriptor sets to the free list of their layout.
+        void Free(VkDescriptorSetLayout setLayout, std::uint32_t numSets, const VkDescriptorSet* sets);
+
+        // Releases all freed descriptor sets of the specified layout back to their pools. Must be called before the layout is destroyed.
+        void ReleaseSetLayout(VkDescriptorSetLayout setLayout);
+
+        // Queries the allocation statistics of all pages.
+        VKDescriptorPoolDetails QueryDetails() const;
+
+    private:
+
+        struct Page
+        {
+            Page(const VKPtr<VkDevice>& device);
+
+            VKPtr<VkDescriptorPool> pool;
+            bool                    hasFreedSets = false; // Descriptor sets have been freed since this page ran out of memory.
+        };
+
+    private:
+
+        // Tries to allocate the descriptor sets from the specified page. Out of pool memory is not treated as an error, so other pages can be tried.
+        VkResult AllocateFromPage(Page& page, const std::vector<VkDescriptorSetLayout>& setLayouts, VkDescriptorSet* outSets);
+
+        // Creates a new page that can hold at least the specified descriptor sets.
+        Page& CreatePage(std::uint32_t numPoolSizes, const VkDescriptorPoolSize* poolSizes, std::uint32_t numSets);
+
+    private:
+
+        const VKPtr<VkDevice>&                                          device_;
+
+        std::vector<Page>                                               pages_;
+        std::size_t                                                     currentPage_        = 0;
+
+        std::unordered_map<VkDescriptorSet, VkDescriptorPool>           allocatedSets_;
+        std::map<VkDescriptorSetLayout, std::vector<VkDescriptorSet>>   freeSets_;
+        std::size_t                                                     numRecycledSets_    = 0;
+        std::size_t                                                     numReusedSets_      = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -11,8 +11,10 @@
 #include "../Ext/VKExtensionRegistry.h"
 #include "../Shader/VKShader.h"
 #include "../VKTypes.h"
+#include "../VKSerialization.h"
 #include "../VKCore.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
 #include <cstddef>
 #include <LLGL/PipelineStateFlags.h>
 #include <LLGL/StaticLimits.h>
@@ -27,27 +29,62 @@ VKGraphicsPSO::VKGraphicsPSO(
     const VKPtr<VkDevice>&              device,
     VkPipelineLayout                    defaultPipelineLayout,
     const RenderPass*                   defaultRenderPass,
+    VkPipelineCache                     pipelineCache,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits)
+    const VKGraphicsPipelineLimits&     limits,
+    Serialization::Serializer*          writer,
+    ThreadPool*                         threadPool)
 :
     VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS },
     scissorEnabled_    { desc.rasterizer.scissorTestEnabled      },
     hasDynamicScissor_ { desc.scissors.empty()                   }
 {
-    if (auto renderPass = (desc.renderPass != nullptr ? desc.renderPass : defaultRenderPass))
+    auto renderPass = (desc.renderPass != nullptr ? desc.renderPass : defaultRenderPass);
+    if (renderPass == nullptr)
+        throw std::invalid_argument("cannot create Vulkan graphics pipeline without render pass");
+
+    auto renderPassVK   = LLGL_CAST(const VKRenderPass*, renderPass);
+    auto pipelineLayout = GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout);
+
+    if (threadPool != nullptr)
     {
-        /* Create Vulkan graphics pipeline object */
-        auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
-        CreateVkPipeline(
-            device,
-            GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
-            *renderPassVK,
-            limits,
-            desc
+        /* Create Vulkan graphics pipeline object on worker thread with a copy of the descriptor */
+        CreateVkPipelineAsync(
+            *threadPool,
+            [this, &device, pipelineLayout, renderPassVK, pipelineCache, limits, desc]()
+            {
+                CreateVkPipeline(device, pipelineLayout, *renderPassVK, pipelineCache, limits, desc, nullptr);
+            }
         );
     }
     else
-        throw std::invalid_argument("cannot create Vulkan graphics pipeline without render pass");
+    {
+        /* Create Vulkan graphics pipeline object */
+        CreateVkPipeline(device, pipelineLayout, *renderPassVK, pipelineCache, limits, desc, writer);
+    }
+}
+
+VKGraphicsPSO::~VKGraphicsPSO()
+{
+    /* Creation on worker thread still refers to this object */
+    WaitForCreation();
+}
+
+VKGraphicsPSO::VKGraphicsPSO(
+    const VKPtr<VkDevice>&              device,
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache,
+    Serialization::Deserializer&        reader)
+:
+    VKPipelineState { device, VK_PIPELINE_BIND_POINT_GRAPHICS }
+{
+    /* Create Vulkan graphics pipeline object from serialized cache */
+    CreateVkPipelineFromCache(
+        device,
+        ReadPipelineLayout(device, reader, defaultPipelineLayout),
+        pipelineCache,
+        reader
+    );
 }
 
 
@@ -333,11 +370,13 @@ static void CreateDynamicState(
 }
 
 void VKGraphicsPSO::CreateVkPipeline(
-    VkDevice                            device,
+    const VKPtr<VkDevice>&              device,
     VkPipelineLayout                    pipelineLayout,
     const VKRenderPass&                 renderPass,
+    VkPipelineCache                     pipelineCache,
     const VKGraphicsPipelineLimits&     limits,
-    const GraphicsPipelineDescriptor&   desc)
+    const GraphicsPipelineDescriptor&   desc,
+    Serialization::Serializer*          writer)
 {
     /* Get shader program object */
     auto vertexShaderVK = LLGL_CAST(const VKShader*, desc.vertexShader);
@@ -414,10 +453,315 @@ void VKGraphicsPSO::CreateVkPipeline(
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+
+    if (writer != nullptr)
+    {
+        /* Serialize PSO and create it with a dedicated pipeline cache, so the serialized cache only contains data of this PSO */
+        SerializePSO(*writer, desc, renderPass, createInfo);
+        auto localPipelineCache = CreateVkPipelineCache(device);
+        CreateVkPipelineWithCache(device, createInfo, localPipelineCache);
+        Serialization::VKWriteSegmentPipelineCache(*writer, device, localPipelineCache);
+        MergeVkPipelineCache(device, pipelineCache, localPipelineCache);
+    }
+    else
+        CreateVkPipelineWithCache(device, createInfo, pipelineCache);
+}
+
+// Create-info structures of a graphics PSO that is restored from a serialized cache.
+struct VKGraphicsPipelineCacheStates
+{
+    VkPipelineVertexInputStateCreateInfo                    vertexInputState;
+    std::vector<VkVertexInputBindingDescription>            vertexBindingDescs;
+    std::vector<VkVertexInputAttributeDescription>          vertexAttribDescs;
+    VkPipelineInputAssemblyStateCreateInfo                  inputAssemblyState;
+    bool                                                    hasTessellationState;
+    VkPipelineTessellationStateCreateInfo                   tessellationState;
+    VkPipelineViewportStateCreateInfo                       viewportState;
+    std::vector<VkViewport>                                 viewports;
+    std::vector<VkRect2D>                                   scissors;
+    VkPipelineRasterizationStateCreateInfo                  rasterizerState;
+    bool                                                    hasConservativeRasterState;
+    VkPipelineRasterizationConservativeStateCreateInfoEXT   conservativeRasterState;
+    VkPipelineMultisampleStateCreateInfo                    multisampleState;
+    VkSampleMask                                            sampleMask;
+    VkPipelineDepthStencilStateCreateInfo                   depthStencilState;
+    VkPipelineColorBlendStateCreateInfo                     colorBlendState;
+    std::vector<VkPipelineColorBlendAttachmentState>        colorBlendAttachments;
+    bool                                                    hasDynamicState;
+    VkPipelineDynamicStateCreateInfo                        dynamicState;
+    std::vector<VkDynamicState>                             dynamicStates;
+};
+
+template <typename T>
+static void ReadArray(Serialization::Deserializer& reader, std::vector<T>& container, std::uint32_t count)
+{
+    container.resize(count);
+    reader.Read(container.data(), count * sizeof(T));
+}
+
+void VKGraphicsPSO::CreateVkPipelineFromCache(
+    const VKPtr<VkDevice>&          device,
+    VkPipelineLayout                pipelineLayout,
+    VkPipelineCache                 pipelineCache,
+    Serialization::Deserializer&    reader)
+{
+    /* Re-create compatible render pass */
+    reader.Begin(Serialization::VKIdent_RenderPass);
+    {
+        std::uint32_t numAttachments = 0, numColorAttachments = 0, numAttachmentDescs = 0;
+        VkSampleCountFlagBits sampleCountBits = VK_SAMPLE_COUNT_1_BIT;
+        std::vector<VkAttachmentDescription> attachmentDescs;
+
+        reader.ReadTyped(numAttachments);
+        reader.ReadTyped(numColorAttachments);
+        reader.ReadTyped(sampleCountBits);
+        reader.ReadTyped(numAttachmentDescs);
+        ReadArray(reader, attachmentDescs, numAttachmentDescs);
+
+        cachedRenderPass_ = MakeUnique<VKRenderPass>(device);
+        cachedRenderPass_->CreateVkRenderPassWithDescriptors(
+            device,
+            numAttachments,
+            numColorAttachments,
+            attachmentDescs.data(),
+            sampleCountBits
+        );
+    }
+    reader.End();
+
+    /* Re-create shader modules */
+    std::vector<VKPtr<VkShaderModule>>              shaderModules;
+    std::vector<std::string>                        entryPoints;
+    std::vector<VkPipelineShaderStageCreateInfo>    shaderStageCreateInfos;
+    ReadShaderStages(device, reader, shaderModules, entryPoints, shaderStageCreateInfos);
+
+    /* Read vertex input state */
+    VKGraphicsPipelineCacheStates states;
+
+    reader.Begin(Serialization::VKIdent_VertexInput);
+    {
+        std::uint32_t numBindings = 0, numAttribs = 0;
+        reader.ReadTyped(numBindings);
+        ReadArray(reader, states.vertexBindingDescs, numBindings);
+        reader.ReadTyped(numAttribs);
+        ReadArray(reader, states.vertexAttribDescs, numAttribs);
+
+        states.vertexInputState.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        states.vertexInputState.pNext                           = nullptr;
+        states.vertexInputState.flags                           = 0;
+        states.vertexInputState.vertexBindingDescriptionCount   = numBindings;
+        states.vertexInputState.pVertexBindingDescriptions      = (numBindings > 0 ? states.vertexBindingDescs.data() : nullptr);
+        states.vertexInputState.vertexAttributeDescriptionCount = numAttribs;
+        states.vertexInputState.pVertexAttributeDescriptions    = (numAttribs > 0 ? states.vertexAttribDescs.data() : nullptr);
+    }
+    reader.End();
+
+    /*
+    Read fixed function states and re-point all of their pointers to the deserialized storage.
+    The serialized pointers are only used as flags whether the respective array is present;
+    'pNext' chains are never serialized, so they must not be dereferenced.
+    */
+    reader.Begin(Serialization::VKIdent_GraphicsStates);
+    {
+        reader.ReadTyped(scissorEnabled_);
+        reader.ReadTyped(hasDynamicScissor_);
+
+        reader.ReadTyped(states.inputAssemblyState);
+        states.inputAssemblyState.pNext = nullptr;
+
+        reader.ReadTyped(states.hasTessellationState);
+        if (states.hasTessellationState)
+        {
+            reader.ReadTyped(states.tessellationState);
+            states.tessellationState.pNext = nullptr;
+        }
+
+        reader.ReadTyped(states.viewportState);
+        states.viewportState.pNext = nullptr;
+        if (states.viewportState.pViewports != nullptr)
+        {
+            ReadArray(reader, states.viewports, states.viewportState.viewportCount);
+            states.viewportState.pViewports = states.viewports.data();
+        }
+        if (states.viewportState.pScissors != nullptr)
+        {
+            ReadArray(reader, states.scissors, states.viewportState.scissorCount);
+            states.viewportState.pScissors = states.scissors.data();
+        }
+
+        reader.ReadTyped(states.rasterizerState);
+        states.rasterizerState.pNext = nullptr;
+        reader.ReadTyped(states.hasConservativeRasterState);
+        if (states.hasConservativeRasterState)
+        {
+            reader.ReadTyped(states.conservativeRasterState);
+            states.conservativeRasterState.pNext = nullptr;
+            states.rasterizerState.pNext = &(states.conservativeRasterState);
+        }
+
+        reader.ReadTyped(states.multisampleState);
+        states.multisampleState.pNext = nullptr;
+        if (states.multisampleState.pSampleMask != nullptr)
+        {
+            reader.ReadTyped(states.sampleMask);
+            states.multisampleState.pSampleMask = &(states.sampleMask);
+        }
+
+        reader.ReadTyped(states.depthStencilState);
+        states.depthStencilState.pNext = nullptr;
+
+        reader.ReadTyped(states.colorBlendState);
+        states.colorBlendState.pNext = nullptr;
+        ReadArray(reader, states.colorBlendAttachments, states.colorBlendState.attachmentCount);
+        states.colorBlendState.pAttachments = (states.colorBlendState.attachmentCount > 0 ? states.colorBlendAttachments.data() : nullptr);
+
+        reader.ReadTyped(states.hasDynamicState);
+        if (states.hasDynamicState)
+        {
+            reader.ReadTyped(states.dynamicState);
+            states.dynamicState.pNext = nullptr;
+            ReadArray(reader, states.dynamicStates, states.dynamicState.dynamicStateCount);
+            states.dynamicState.pDynamicStates = (states.dynamicState.dynamicStateCount > 0 ? states.dynamicStates.data() : nullptr);
+        }
+    }
+    reader.End();
+
+    /* Create graphics pipeline state object */
+    VkGraphicsPipelineCreateInfo createInfo;
+    {
+        createInfo.sType                        = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        createInfo.pNext                        = nullptr;
+        createInfo.flags                        = 0;
+        createInfo.stageCount                   = static_cast<std::uint32_t>(shaderStageCreateInfos.size());
+        createInfo.pStages                      = shaderStageCreateInfos.data();
+        createInfo.pVertexInputState            = (&states.vertexInputState);
+        createInfo.pInputAssemblyState          = (&states.inputAssemblyState);
+        createInfo.pTessellationState           = (states.hasTessellationState ? &states.tessellationState : nullptr);
+        createInfo.pViewportState               = (&states.viewportState);
+        createInfo.pRasterizationState          = (&states.rasterizerState);
+        createInfo.pMultisampleState            = (&states.multisampleState);
+        createInfo.pDepthStencilState           = (&states.depthStencilState);
+        createInfo.pColorBlendState             = (&states.colorBlendState);
+        createInfo.pDynamicState                = (states.hasDynamicState ? &states.dynamicState : nullptr);
+        createInfo.layout                       = pipelineLayout;
+        createInfo.renderPass                   = cachedRenderPass_->GetVkRenderPass();
+        createInfo.subpass                      = 0;
+        createInfo.basePipelineHandle           = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex            = 0;
+    }
+
+    /* Seed a dedicated pipeline cache with the serialized cache data and merge it into the render system's pipeline cache */
+    auto seg = reader.ReadSegmentOnMatch(Serialization::VKIdent_PipelineCache);
+    auto localPipelineCache = CreateVkPipelineCache(device, seg.data, seg.size);
+    CreateVkPipelineWithCache(device, createInfo, localPipelineCache);
+    MergeVkPipelineCache(device, pipelineCache, localPipelineCache);
+}
+
+void VKGraphicsPSO::CreateVkPipelineWithCache(
+    VkDevice                            device,
+    const VkGraphicsPipelineCreateInfo& createInfo,
+    VkPipelineCache                     pipelineCache)
+{
+    auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
 }
 
+template <typename T>
+static void WriteArray(Serialization::Serializer& writer, const T* data, std::uint32_t count)
+{
+    if (count > 0)
+        writer.Write(data, count * sizeof(T));
+}
+
+void VKGraphicsPSO::SerializePSO(
+    Serialization::Serializer&          writer,
+    const GraphicsPipelineDescriptor&   desc,
+    const VKRenderPass&                 renderPass,
+    const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    /* Write graphics PSO identifier */
+    writer.Begin(Serialization::VKIdent_GraphicsPSOIdent);
+    writer.End();
+
+    /* Write pipeline layout bindings */
+    WritePipelineLayout(writer, desc.pipelineLayout);
+
+    /* Write attachment descriptors of render pass */
+    const auto& attachmentDescs = renderPass.GetAttachmentDescs();
+    writer.Begin(Serialization::VKIdent_RenderPass);
+    {
+        writer.WriteTyped(renderPass.GetNumAttachments());
+        writer.WriteTyped(static_cast<std::uint32_t>(renderPass.GetNumColorAttachments()));
+        writer.WriteTyped(renderPass.GetSampleCountBits());
+        writer.WriteTyped(static_cast<std::uint32_t>(attachmentDescs.size()));
+        WriteArray(writer, attachmentDescs.data(), static_cast<std::uint32_t>(attachmentDescs.size()));
+    }
+    writer.End();
+
+    /* Write shader stages */
+    WriteShaderStage(writer, desc.vertexShader);
+    WriteShaderStage(writer, desc.tessControlShader);
+    WriteShaderStage(writer, desc.tessEvaluationShader);
+    WriteShaderStage(writer, desc.geometryShader);
+    WriteShaderStage(writer, desc.fragmentShader);
+
+    /* Write vertex input state */
+    const auto& vertexInputState = *createInfo.pVertexInputState;
+    writer.Begin(Serialization::VKIdent_VertexInput);
+    {
+        writer.WriteTyped(vertexInputState.vertexBindingDescriptionCount);
+        WriteArray(writer, vertexInputState.pVertexBindingDescriptions, vertexInputState.vertexBindingDescriptionCount);
+        writer.WriteTyped(vertexInputState.vertexAttributeDescriptionCount);
+        WriteArray(writer, vertexInputState.pVertexAttributeDescriptions, vertexInputState.vertexAttributeDescriptionCount);
+    }
+    writer.End();
+
+    /* Write fixed function states; pointers are written as is and only used as flags when the cache is read */
+    writer.Begin(Serialization::VKIdent_GraphicsStates);
+    {
+        writer.WriteTyped(scissorEnabled_);
+        writer.WriteTyped(hasDynamicScissor_);
+
+        writer.WriteTyped(*createInfo.pInputAssemblyState);
+
+        writer.WriteTyped(createInfo.pTessellationState != nullptr);
+        if (createInfo.pTessellationState != nullptr)
+            writer.WriteTyped(*createInfo.pTessellationState);
+
+        const auto& viewportState = *createInfo.pViewportState;
+        writer.WriteTyped(viewportState);
+        if (viewportState.pViewports != nullptr)
+            WriteArray(writer, viewportState.pViewports, viewportState.viewportCount);
+        if (viewportState.pScissors != nullptr)
+            WriteArray(writer, viewportState.pScissors, viewportState.scissorCount);
+
+        const auto& rasterizerState = *createInfo.pRasterizationState;
+        writer.WriteTyped(rasterizerState);
+        writer.WriteTyped(rasterizerState.pNext != nullptr);
+        if (rasterizerState.pNext != nullptr)
+            writer.WriteTyped(*reinterpret_cast<const VkPipelineRasterizationConservativeStateCreateInfoEXT*>(rasterizerState.pNext));
+
+        const auto& multisampleState = *createInfo.pMultisampleState;
+        writer.WriteTyped(multisampleState);
+        if (multisampleState.pSampleMask != nullptr)
+            writer.WriteTyped(*multisampleState.pSampleMask);
+
+        writer.WriteTyped(*createInfo.pDepthStencilState);
+
+        const auto& colorBlendState = *createInfo.pColorBlendState;
+        writer.WriteTyped(colorBlendState);
+        WriteArray(writer, colorBlendState.pAttachments, colorBlendState.attachmentCount);
+
+        writer.WriteTyped(createInfo.pDynamicState != nullptr);
+        if (createInfo.pDynamicState != nullptr)
+        {
+            writer.WriteTyped(*createInfo.pDynamicState);
+            WriteArray(writer, createInfo.pDynamicState->pDynamicStates, createInfo.pDynamicState->dynamicStateCount);
+        }
+    }
+    writer.End();
+}
+
 
 } // /namespace LLGL
 
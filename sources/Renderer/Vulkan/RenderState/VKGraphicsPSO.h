@@ -10,6 +10,7 @@
 
 
 #include "VKPipelineState.h"
+#include "VKRenderPass.h"
 
 
 namespace LLGL
@@ -24,22 +25,37 @@ struct VKGraphicsPipelineLimits
 };
 
 struct GraphicsPipelineDescriptor;
-class VKRenderPass;
-class RenderPass;
 
 class VKGraphicsPSO final : public VKPipelineState
 {
 
     public:
 
+        /*
+        Constructs the graphics PSO with the specified descriptor.
+        If a thread pool is specified, the native PSO is created on a worker thread and the serializer must be null.
+        */
         VKGraphicsPSO(
             const VKPtr<VkDevice>&              device,
             VkPipelineLayout                    defaultPipelineLayout,
             const RenderPass*                   defaultRenderPass,
+            VkPipelineCache                     pipelineCache,
             const GraphicsPipelineDescriptor&   desc,
-            const VKGraphicsPipelineLimits&     limits
+            const VKGraphicsPipelineLimits&     limits,
+            Serialization::Serializer*          writer                  = nullptr,
+            ThreadPool*                         threadPool              = nullptr
+        );
+
+        // Constructs the graphics PSO with a deserializer of a cached PSO.
+        VKGraphicsPSO(
+            const VKPtr<VkDevice>&              device,
+            VkPipelineLayout                    defaultPipelineLayout,
+            VkPipelineCache                     pipelineCache,
+            Serialization::Deserializer&        reader
         );
 
+        ~VKGraphicsPSO();
+
         // Returns true if scissors are enabled.
         inline bool IsScissorEnabled() const
         {
@@ -55,17 +71,40 @@ class VKGraphicsPSO final : public VKPipelineState
     private:
 
         void CreateVkPipeline(
-            VkDevice                            device,
+            const VKPtr<VkDevice>&              device,
             VkPipelineLayout                    pipelineLayout,
             const VKRenderPass&                 renderPass,
+            VkPipelineCache                     pipelineCache,
             const VKGraphicsPipelineLimits&     limits,
-            const GraphicsPipelineDescriptor&   desc
+            const GraphicsPipelineDescriptor&   desc,
+            Serialization::Serializer*          writer
+        );
+
+        void CreateVkPipelineFromCache(
+            const VKPtr<VkDevice>&              device,
+            VkPipelineLayout                    pipelineLayout,
+            VkPipelineCache                     pipelineCache,
+            Serialization::Deserializer&        reader
+        );
+
+        void CreateVkPipelineWithCache(
+            VkDevice                            device,
+            const VkGraphicsPipelineCreateInfo& createInfo,
+            VkPipelineCache                     pipelineCache
+        );
+
+        void SerializePSO(
+            Serialization::Serializer&          writer,
+            const GraphicsPipelineDescriptor&   desc,
+            const VKRenderPass&                 renderPass,
+            const VkGraphicsPipelineCreateInfo& createInfo
         );
 
     private:
 
-        bool scissorEnabled_    = false;
-        bool hasDynamicScissor_ = false;
+        bool                            scissorEnabled_     = false;
+        bool                            hasDynamicScissor_  = false;
+        std::unique_ptr<VKRenderPass>   cachedRenderPass_;  // Compatible render pass that was re-created from a serialized cache.
 
 };
 
@@ -7,6 +7,7 @@
 
 #include "VKPipelineBarrier.h"
 #include <LLGL/ShaderFlags.h>
+#include <algorithm>
 
 
 namespace LLGL
@@ -34,6 +35,15 @@ void VKPipelineBarrier::Submit(VkCommandBuffer commandBuffer)
     );
 }
 
+void VKPipelineBarrier::Reset()
+{
+    srcStageMask_ = 0;
+    dstStageMask_ = 0;
+    memoryBarrier_.clear();
+    bufferBarriers_.clear();
+    imageBarriers_.clear();
+}
+
 static VkPipelineStageFlags ToVkStageFlags(long stageFlags)
 {
     VkPipelineStageFlags bitmask = 0;
@@ -61,6 +71,176 @@ void VKPipelineBarrier::InsertMemoryBarrier(long stageFlags, VkAccessFlags srcAc
     srcStageMask_ |= stagesBitmask;
     dstStageMask_ |= stagesBitmask;
 
+    AppendMemoryBarrier(srcAccess, dstAccess);
+}
+
+// Returns the end of the specified range; VK_WHOLE_SIZE is kept as the largest possible end.
+static VkDeviceSize GetBufferRangeEnd(VkDeviceSize offset, VkDeviceSize size)
+{
+    return (size == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : offset + size);
+}
+
+void VKPipelineBarrier::InsertBufferBarrier(
+    VkBuffer                buffer,
+    VkDeviceSize            offset,
+    VkDeviceSize            size,
+    VkAccessFlags           srcAccess,
+    VkAccessFlags           dstAccess,
+    VkPipelineStageFlags    srcStageMask,
+    VkPipelineStageFlags    dstStageMask)
+{
+    srcStageMask_ |= srcStageMask;
+    dstStageMask_ |= dstStageMask;
+
+    /* Merge with a barrier of the same buffer and access masks */
+    for (auto& barrier : bufferBarriers_)
+    {
+        if (barrier.buffer == buffer && barrier.srcAccessMask == srcAccess && barrier.dstAccessMask == dstAccess)
+        {
+            const auto end = std::max(GetBufferRangeEnd(barrier.offset, barrier.size), GetBufferRangeEnd(offset, size));
+            barrier.offset  = std::min(barrier.offset, offset);
+            barrier.size    = (end == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : end - barrier.offset);
+            return;
+        }
+    }
+
+    /* Insert a new buffer memory barrier */
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = buffer;
+        barrier.offset              = offset;
+        barrier.size                = size;
+    }
+    bufferBarriers_.push_back(barrier);
+}
+
+// Returns the union of both subresource ranges. Counts of VK_REMAINING_* are kept as the largest possible end.
+static VkImageSubresourceRange MergeSubresourceRanges(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+{
+    auto MergeRange = [](std::uint32_t lhsBase, std::uint32_t lhsCount, std::uint32_t rhsBase, std::uint32_t rhsCount, std::uint32_t remaining, std::uint32_t& base, std::uint32_t& count)
+    {
+        base = std::min(lhsBase, rhsBase);
+        if (lhsCount == remaining || rhsCount == remaining)
+            count = remaining;
+        else
+            count = std::max(lhsBase + lhsCount, rhsBase + rhsCount) - base;
+    };
+
+    VkImageSubresourceRange range;
+    {
+        range.aspectMask = (lhs.aspectMask | rhs.aspectMask);
+        MergeRange(lhs.baseMipLevel, lhs.levelCount, rhs.baseMipLevel, rhs.levelCount, VK_REMAINING_MIP_LEVELS, range.baseMipLevel, range.levelCount);
+        MergeRange(lhs.baseArrayLayer, lhs.layerCount, rhs.baseArrayLayer, rhs.layerCount, VK_REMAINING_ARRAY_LAYERS, range.baseArrayLayer, range.layerCount);
+    }
+    return range;
+}
+
+void VKPipelineBarrier::InsertImageBarrier(
+    VkImage                         image,
+    const VkImageSubresourceRange&  subresourceRange,
+    VkImageLayout                   oldLayout,
+    VkImageLayout                   newLayout,
+    VkAccessFlags                   srcAccess,
+    VkAccessFlags                   dstAccess,
+    VkPipelineStageFlags            srcStageMask,
+    VkPipelineStageFlags            dstStageMask)
+{
+    srcStageMask_ |= srcStageMask;
+    dstStageMask_ |= dstStageMask;
+
+    /* Merge with a barrier of the same image, layouts, and access masks; layout transitions of different subresources must not be merged */
+    if (oldLayout == newLayout)
+    {
+        for (auto& barrier : imageBarriers_)
+        {
+            if (barrier.image           == image        &&
+                barrier.oldLayout       == oldLayout    &&
+                barrier.newLayout       == newLayout    &&
+                barrier.srcAccessMask   == srcAccess    &&
+                barrier.dstAccessMask   == dstAccess)
+            {
+                barrier.subresourceRange = MergeSubresourceRanges(barrier.subresourceRange, subresourceRange);
+                return;
+            }
+        }
+    }
+
+    /* Insert a new image memory barrier */
+    VkImageMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image               = image;
+        barrier.subresourceRange    = subresourceRange;
+    }
+    imageBarriers_.push_back(barrier);
+}
+
+void VKPipelineBarrier::Merge(const VKPipelineBarrier& other)
+{
+    srcStageMask_ |= other.srcStageMask_;
+    dstStageMask_ |= other.dstStageMask_;
+
+    for (const auto& barrier : other.memoryBarrier_)
+        AppendMemoryBarrier(barrier.srcAccessMask, barrier.dstAccessMask);
+
+    for (const auto& barrier : other.bufferBarriers_)
+        InsertBufferBarrier(barrier.buffer, barrier.offset, barrier.size, barrier.srcAccessMask, barrier.dstAccessMask, 0, 0);
+
+    for (const auto& barrier : other.imageBarriers_)
+    {
+        InsertImageBarrier(
+            barrier.image,
+            barrier.subresourceRange,
+            barrier.oldLayout,
+            barrier.newLayout,
+            barrier.srcAccessMask,
+            barrier.dstAccessMask,
+            0,
+            0
+        );
+    }
+}
+
+bool VKPipelineBarrier::ContainsBuffer(VkBuffer buffer) const
+{
+    for (const auto& barrier : bufferBarriers_)
+    {
+        if (barrier.buffer == buffer)
+            return true;
+    }
+    return false;
+}
+
+bool VKPipelineBarrier::ContainsImage(VkImage image) const
+{
+    for (const auto& barrier : imageBarriers_)
+    {
+        if (barrier.image == image)
+            return true;
+    }
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKPipelineBarrier::AppendMemoryBarrier(VkAccessFlags srcAccess, VkAccessFlags dstAccess)
+{
     /* Check if a memory barrier alread exists */
     for (const auto& barrier : memoryBarrier_)
     {
@@ -18,7 +18,10 @@ namespace LLGL
 {
 
 
-// Helper class to manage information for a Vulkan pipeline barrier command.
+/*
+Helper class to manage information for a Vulkan pipeline barrier command.
+Barriers can be accumulated from multiple commands and submitted as a single batch.
+*/
 class VKPipelineBarrier
 {
 
@@ -30,9 +33,51 @@ class VKPipelineBarrier
         // Submits this pipeline barrier into the specified command buffer.
         void Submit(VkCommandBuffer commandBuffer);
 
+        // Removes all barriers and resets the stage masks.
+        void Reset();
+
         // Inserts a memory barrier
         void InsertMemoryBarrier(long stageFlags, VkAccessFlags srcAccess, VkAccessFlags dstAccess);
 
+        // Inserts a buffer memory barrier. Barriers for the same buffer with the same access masks are merged into a single range.
+        void InsertBufferBarrier(
+            VkBuffer                buffer,
+            VkDeviceSize            offset,
+            VkDeviceSize            size,
+            VkAccessFlags           srcAccess,
+            VkAccessFlags           dstAccess,
+            VkPipelineStageFlags    srcStageMask,
+            VkPipelineStageFlags    dstStageMask
+        );
+
+        /*
+        Inserts an image memory barrier. Barriers for the same image with the same layouts and access masks are merged into a single subresource range.
+        Redundant transitions are not detected, since no layout or access state is tracked per image.
+        */
+        void InsertImageBarrier(
+            VkImage                         image,
+            const VkImageSubresourceRange&  subresourceRange,
+            VkImageLayout                   oldLayout,
+            VkImageLayout                   newLayout,
+            VkAccessFlags                   srcAccess,
+            VkAccessFlags                   dstAccess,
+            VkPipelineStageFlags            srcStageMask,
+            VkPipelineStageFlags            dstStageMask
+        );
+
+        // Inserts all barriers of the specified pipeline barrier into this one.
+        void Merge(const VKPipelineBarrier& other);
+
+        // Returns true if this barrier contains a buffer memory barrier for the specified buffer.
+        bool ContainsBuffer(VkBuffer buffer) const;
+
+        // Returns true if this barrier contains an image memory barrier for the specified image.
+        bool ContainsImage(VkImage image) const;
+
+    private:
+
+        void AppendMemoryBarrier(VkAccessFlags srcAccess, VkAccessFlags dstAccess);
+
     private:
 
         VkPipelineStageFlags                srcStageMask_   = 0;
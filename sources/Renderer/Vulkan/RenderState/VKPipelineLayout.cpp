@@ -8,6 +8,7 @@
 #include "VKPipelineLayout.h"
 #include "../VKTypes.h"
 #include "../VKCore.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -46,7 +47,7 @@ static VkDescriptorType GetVkDescriptorType(const BindingDescriptor& desc)
             return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
         case ResourceType::Buffer:
             if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
-                return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                return (desc.dynamicOffset ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
             if ((desc.bindFlags & (BindFlags::Sampled | BindFlags::Storage)) != 0)
                 return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             break;
@@ -85,25 +86,81 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
 {
     /* Initialize all descriptor-set layout bindings */
     const auto numBindings = desc.bindings.size();
-    std::vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings);
+    layoutBindings_.resize(numBindings);
 
     for (std::size_t i = 0; i < numBindings; ++i)
-        Convert(layoutBindings[i], desc.bindings[i]);
+        Convert(layoutBindings_[i], desc.bindings[i]);
 
+    /* Create descriptor set layout and pipeline layout */
+    CreateVkPipelineLayout(device);
+    BuildDynamicOffsetOrder();
+
+    /* Create list of binding points (for later pass to 'VkWriteDescriptorSet::dstBinding') */
+    bindings_.reserve(numBindings);
+    for (std::size_t i = 0; i < numBindings; ++i)
+    {
+        bindings_.push_back(
+            {
+                desc.bindings[i].slot,
+                desc.bindings[i].stageFlags,
+                layoutBindings_[i].descriptorType
+            }
+        );
+    }
+}
+
+VKPipelineLayout::VKPipelineLayout(
+    const VKPtr<VkDevice>&                              device,
+    const std::vector<VkDescriptorSetLayoutBinding>&    layoutBindings,
+    const std::vector<VKLayoutBinding>&                 bindings)
+:
+    pipelineLayout_      { device, vkDestroyPipelineLayout      },
+    descriptorSetLayout_ { device, vkDestroyDescriptorSetLayout },
+    layoutBindings_      { layoutBindings                       },
+    bindings_            { bindings                             }
+{
+    CreateVkPipelineLayout(device);
+    BuildDynamicOffsetOrder();
+}
+
+std::uint32_t VKPipelineLayout::GetNumBindings() const
+{
+    return static_cast<std::uint32_t>(bindings_.size());
+}
+
+VkPushConstantRange VKPipelineLayout::GetPushConstantRange()
+{
+    VkPushConstantRange range;
+    {
+        range.stageFlags    = VK_SHADER_STAGE_ALL;
+        range.offset        = 0;
+        range.size          = VKPipelineLayout::pushConstantRangeSize;
+    }
+    return range;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKPipelineLayout::CreateVkPipelineLayout(VkDevice device)
+{
     /* Create descriptor set layout */
     VkDescriptorSetLayoutCreateInfo descSetCreateInfo;
     {
         descSetCreateInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         descSetCreateInfo.pNext         = nullptr;
         descSetCreateInfo.flags         = 0;
-        descSetCreateInfo.bindingCount  = static_cast<std::uint32_t>(layoutBindings.size());
-        descSetCreateInfo.pBindings     = layoutBindings.data();
+        descSetCreateInfo.bindingCount  = static_cast<std::uint32_t>(layoutBindings_.size());
+        descSetCreateInfo.pBindings     = layoutBindings_.data();
     }
     auto result = vkCreateDescriptorSetLayout(device, &descSetCreateInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout");
 
     /* Create pipeline layout */
     VkDescriptorSetLayout setLayouts[] = { descriptorSetLayout_.Get() };
+    VkPushConstantRange pushConstantRanges[] = { VKPipelineLayout::GetPushConstantRange() };
 
     VkPipelineLayoutCreateInfo layoutCreateInfo;
     {
@@ -112,29 +169,41 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
         layoutCreateInfo.flags                  = 0;
         layoutCreateInfo.setLayoutCount         = 1;
         layoutCreateInfo.pSetLayouts            = setLayouts;
-        layoutCreateInfo.pushConstantRangeCount = 0;
-        layoutCreateInfo.pPushConstantRanges    = nullptr;
+        layoutCreateInfo.pushConstantRangeCount = 1;
+        layoutCreateInfo.pPushConstantRanges    = pushConstantRanges;
     }
     result = vkCreatePipelineLayout(device, &layoutCreateInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan pipeline layout");
+}
 
-    /* Create list of binding points (for later pass to 'VkWriteDescriptorSet::dstBinding') */
-    bindings_.reserve(numBindings);
-    for (std::size_t i = 0; i < numBindings; ++i)
+void VKPipelineLayout::BuildDynamicOffsetOrder()
+{
+    /* Gather all dynamic bindings in the order they appear in the pipeline layout */
+    std::vector<std::uint32_t> dynamicBindings;
+    for (std::size_t i = 0; i < layoutBindings_.size(); ++i)
     {
-        bindings_.push_back(
-            {
-                desc.bindings[i].slot,
-                desc.bindings[i].stageFlags,
-                layoutBindings[i].descriptorType
-            }
-        );
+        if (layoutBindings_[i].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+            dynamicBindings.push_back(static_cast<std::uint32_t>(i));
     }
-}
 
-std::uint32_t VKPipelineLayout::GetNumBindings() const
-{
-    return static_cast<std::uint32_t>(bindings_.size());
+    numDynamicOffsets_ = static_cast<std::uint32_t>(dynamicBindings.size());
+
+    /* Vulkan consumes dynamic offsets in the order of binding numbers, so store a permutation if the layout order differs */
+    dynamicOffsetOrder_.resize(dynamicBindings.size());
+    for (std::uint32_t i = 0; i < numDynamicOffsets_; ++i)
+        dynamicOffsetOrder_[i] = i;
+
+    std::stable_sort(
+        dynamicOffsetOrder_.begin(),
+        dynamicOffsetOrder_.end(),
+        [this, &dynamicBindings](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (layoutBindings_[dynamicBindings[lhs]].binding < layoutBindings_[dynamicBindings[rhs]].binding);
+        }
+    );
+
+    if (std::is_sorted(dynamicOffsetOrder_.begin(), dynamicOffsetOrder_.end()))
+        dynamicOffsetOrder_.clear();
 }
 
 
@@ -34,10 +34,31 @@ class VKPipelineLayout final : public PipelineLayout
 
         std::uint32_t GetNumBindings() const override;
 
+    public:
+
+        /*
+        Size (in bytes) of the push constant range that is shared by all pipeline layouts.
+        This is the minimum of 'VkPhysicalDeviceLimits::maxPushConstantsSize' that all Vulkan devices support.
+        */
+        static const std::uint32_t pushConstantRangeSize = 128;
+
+        /*
+        Returns the push constant range for all shader stages that is shared by all pipeline layouts.
+        Identical push constant ranges keep all pipeline layouts compatible, so push constants and descriptor sets are not disturbed when pipelines are switched.
+        */
+        static VkPushConstantRange GetPushConstantRange();
+
     public:
 
         VKPipelineLayout(const VKPtr<VkDevice>& device, const PipelineLayoutDescriptor& desc);
 
+        // Constructs the pipeline layout with the native layout bindings of a serialized PSO cache.
+        VKPipelineLayout(
+            const VKPtr<VkDevice>&                              device,
+            const std::vector<VkDescriptorSetLayoutBinding>&    layoutBindings,
+            const std::vector<VKLayoutBinding>&                 bindings
+        );
+
         // Returns the native VkPipelineLayout object.
         inline VkPipelineLayout GetVkPipelineLayout() const
         {
@@ -56,11 +77,38 @@ class VKPipelineLayout final : public PipelineLayout
             return bindings_;
         }
 
+        // Returns the list of native descriptor set layout bindings this pipeline layout was created with.
+        inline const std::vector<VkDescriptorSetLayoutBinding>& GetVkLayoutBindings() const
+        {
+            return layoutBindings_;
+        }
+
+        // Returns the number of bindings with dynamic offsets.
+        inline std::uint32_t GetNumDynamicOffsets() const
+        {
+            return numDynamicOffsets_;
+        }
+
+        // Returns the indices of dynamic offsets in the order Vulkan expects them. This is empty if the pipeline layout already has this order.
+        inline const std::vector<std::uint32_t>& GetDynamicOffsetOrder() const
+        {
+            return dynamicOffsetOrder_;
+        }
+
     private:
 
-        VKPtr<VkPipelineLayout>         pipelineLayout_;
-        VKPtr<VkDescriptorSetLayout>    descriptorSetLayout_;
-        std::vector<VKLayoutBinding>    bindings_;
+        void CreateVkPipelineLayout(VkDevice device);
+        void BuildDynamicOffsetOrder();
+
+    private:
+
+        VKPtr<VkPipelineLayout>                     pipelineLayout_;
+        VKPtr<VkDescriptorSetLayout>                descriptorSetLayout_;
+        std::vector<VkDescriptorSetLayoutBinding>   layoutBindings_;
+        std::vector<VKLayoutBinding>                bindings_;
+
+        std::uint32_t                               numDynamicOffsets_  = 0;
+        std::vector<std::uint32_t>                  dynamicOffsetOrder_;
 
 };
 
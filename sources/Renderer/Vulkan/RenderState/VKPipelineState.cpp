@@ -7,7 +7,13 @@
 
 #include "VKPipelineState.h"
 #include "VKPipelineLayout.h"
+#include "../Shader/VKShader.h"
+#include "../VKSerialization.h"
+#include "../VKTypes.h"
+#include "../VKCore.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include "../../../Core/ThreadPool.h"
 
 
 namespace LLGL
@@ -20,9 +26,26 @@ VKPipelineState::VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPo
 {
 }
 
+VKPipelineState::~VKPipelineState()
+{
+    WaitForCreation();
+}
+
 const Report* VKPipelineState::GetReport() const
 {
-    return nullptr; //TODO
+    WaitForCreation();
+    return (report_ ? &report_ : nullptr);
+}
+
+bool VKPipelineState::IsReady() const
+{
+    return (!creation_.valid() || creation_.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
+void VKPipelineState::WaitForCreation() const
+{
+    if (creation_.valid())
+        creation_.wait();
 }
 
 
@@ -37,9 +60,11 @@ VkPipelineLayout VKPipelineState::GetVkPipelineLayoutOrDefault(
     if (pipelineLayout)
     {
         auto pipelineLayoutVK = LLGL_CAST(const VKPipelineLayout*, pipelineLayout);
-        return pipelineLayoutVK->GetVkPipelineLayout();
+        pipelineLayout_ = pipelineLayoutVK->GetVkPipelineLayout();
     }
-    return defaultPipelineLayout;
+    else
+        pipelineLayout_ = defaultPipelineLayout;
+    return pipelineLayout_;
 }
 
 VkPipeline* VKPipelineState::GetVkPipelineAddress()
@@ -47,6 +72,172 @@ VkPipeline* VKPipelineState::GetVkPipelineAddress()
     return pipeline_.ReleaseAndGetAddressOf();
 }
 
+void VKPipelineState::CreateVkPipelineAsync(ThreadPool& threadPool, const std::function<void()>& createTask)
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    creation_ = promise->get_future().share();
+
+    threadPool.Enqueue(
+        [this, promise, createTask]()
+        {
+            try
+            {
+                createTask();
+            }
+            catch (const std::exception& e)
+            {
+                report_.Reset(std::string(e.what()) + '\n', /*hasErrors:*/ true);
+            }
+            promise->set_value();
+        }
+    );
+}
+
+void VKPipelineState::WritePipelineLayout(Serialization::Serializer& writer, const PipelineLayout* pipelineLayout)
+{
+    if (pipelineLayout != nullptr)
+    {
+        auto pipelineLayoutVK = LLGL_CAST(const VKPipelineLayout*, pipelineLayout);
+        const auto& layoutBindings  = pipelineLayoutVK->GetVkLayoutBindings();
+        const auto& bindings        = pipelineLayoutVK->GetBindings();
+
+        writer.Begin(Serialization::VKIdent_PipelineLayout);
+        {
+            writer.WriteTyped(static_cast<std::uint32_t>(layoutBindings.size()));
+            writer.Write(layoutBindings.data(), layoutBindings.size() * sizeof(VkDescriptorSetLayoutBinding));
+            writer.Write(bindings.data(), bindings.size() * sizeof(VKLayoutBinding));
+        }
+        writer.End();
+    }
+}
+
+void VKPipelineState::WriteShaderStage(Serialization::Serializer& writer, const Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderVK = LLGL_CAST(const VKShader*, shader);
+        const auto& code = shaderVK->GetShaderModuleData();
+        Serialization::VKWriteSegmentShaderStage(
+            writer,
+            VKTypes::Map(shaderVK->GetType()),
+            shaderVK->GetEntryPoint().c_str(),
+            code.data(),
+            code.size()
+        );
+    }
+}
+
+VkPipelineLayout VKPipelineState::ReadPipelineLayout(
+    const VKPtr<VkDevice>&          device,
+    Serialization::Deserializer&    reader,
+    VkPipelineLayout                defaultPipelineLayout)
+{
+    auto seg = reader.BeginOnMatch(Serialization::VKIdent_PipelineLayout);
+    if (seg.ident != Serialization::VKIdent_PipelineLayout)
+    {
+        pipelineLayout_ = defaultPipelineLayout;
+        return pipelineLayout_;
+    }
+
+    /* Read native layout bindings and binding points */
+    std::uint32_t numBindings = 0;
+    reader.ReadTyped(numBindings);
+
+    std::vector<VkDescriptorSetLayoutBinding> layoutBindings(numBindings);
+    reader.Read(layoutBindings.data(), numBindings * sizeof(VkDescriptorSetLayoutBinding));
+
+    for (auto& binding : layoutBindings)
+        binding.pImmutableSamplers = nullptr;
+
+    std::vector<VKLayoutBinding> bindings(numBindings);
+    reader.Read(bindings.data(), numBindings * sizeof(VKLayoutBinding));
+
+    reader.End();
+
+    /* Create pipeline layout that is owned by this PSO */
+    cachedPipelineLayout_ = MakeUnique<VKPipelineLayout>(device, layoutBindings, bindings);
+    pipelineLayout_ = cachedPipelineLayout_->GetVkPipelineLayout();
+
+    return pipelineLayout_;
+}
+
+void VKPipelineState::ReadShaderStages(
+    const VKPtr<VkDevice>&                          device,
+    Serialization::Deserializer&                    reader,
+    std::vector<VKPtr<VkShaderModule>>&             shaderModules,
+    std::vector<std::string>&                       entryPoints,
+    std::vector<VkPipelineShaderStageCreateInfo>&   createInfos)
+{
+    VkShaderStageFlagBits       stage;
+    std::string                 entryPoint;
+    std::vector<std::uint32_t>  code;
+
+    while (Serialization::VKReadSegmentShaderStage(reader, stage, entryPoint, code))
+    {
+        /* Create shader module from SPIR-V code */
+        VKPtr<VkShaderModule> shaderModule{ device, vkDestroyShaderModule };
+
+        VkShaderModuleCreateInfo moduleCreateInfo;
+        {
+            moduleCreateInfo.sType      = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            moduleCreateInfo.pNext      = nullptr;
+            moduleCreateInfo.flags      = 0;
+            moduleCreateInfo.codeSize   = code.size() * sizeof(std::uint32_t);
+            moduleCreateInfo.pCode      = code.data();
+        }
+        auto result = vkCreateShaderModule(device, &moduleCreateInfo, nullptr, shaderModule.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan shader module from serialized cache");
+
+        VkPipelineShaderStageCreateInfo createInfo;
+        {
+            createInfo.sType                = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            createInfo.pNext                = nullptr;
+            createInfo.flags                = 0;
+            createInfo.stage                = stage;
+            createInfo.module               = shaderModule;
+            createInfo.pName                = nullptr;
+            createInfo.pSpecializationInfo  = nullptr;
+        }
+        createInfos.push_back(createInfo);
+        shaderModules.push_back(std::move(shaderModule));
+        entryPoints.push_back(entryPoint);
+    }
+
+    /* Set entry point names after all strings have been stored */
+    for (std::size_t i = 0; i < createInfos.size(); ++i)
+        createInfos[i].pName = entryPoints[i].c_str();
+}
+
+VKPtr<VkPipelineCache> VKPipelineState::CreateVkPipelineCache(
+    const VKPtr<VkDevice>&  device,
+    const void*             initialData,
+    std::size_t             initialDataSize)
+{
+    VKPtr<VkPipelineCache> pipelineCache{ device, vkDestroyPipelineCache };
+
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = initialDataSize;
+        createInfo.pInitialData     = initialData;
+    }
+    auto result = vkCreatePipelineCache(device, &createInfo, nullptr, pipelineCache.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+
+    return pipelineCache;
+}
+
+void VKPipelineState::MergeVkPipelineCache(VkDevice device, VkPipelineCache dstPipelineCache, VkPipelineCache srcPipelineCache)
+{
+    if (dstPipelineCache != VK_NULL_HANDLE)
+    {
+        auto result = vkMergePipelineCaches(device, dstPipelineCache, 1, &srcPipelineCache);
+        VKThrowIfFailed(result, "failed to merge Vulkan pipeline caches");
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -11,14 +11,23 @@
 
 #include <LLGL/PipelineState.h>
 #include <vulkan/vulkan.h>
+#include "VKPipelineLayout.h"
 #include "../VKPtr.h"
+#include "../../Serialization.h"
+#include "../../../Core/BasicReport.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
-class PipelineLayout;
+class Shader;
+class ThreadPool;
 
 class VKPipelineState : public PipelineState
 {
@@ -26,24 +35,38 @@ class VKPipelineState : public PipelineState
     public:
 
         VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint);
+        ~VKPipelineState();
 
         const Report* GetReport() const override;
+        bool IsReady() const override;
 
-        // Returns the native PSO.
+        // Returns the native PSO. Blocks until the PSO has been created if this is done on a worker thread.
         inline VkPipeline GetVkPipeline() const
         {
+            if (creation_.valid())
+                creation_.wait();
             return pipeline_.Get();
         }
 
+        // Blocks until the PSO has been created if this is done on a worker thread.
+        void WaitForCreation() const;
+
         // Returns the pipeline binding point.
         inline VkPipelineBindPoint GetBindPoint() const
         {
             return bindPoint_;
         }
 
+        // Returns the native pipeline layout this PSO was created with. This is used to update push constants.
+        inline VkPipelineLayout GetVkPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
     protected:
 
-        static VkPipelineLayout GetVkPipelineLayoutOrDefault(
+        // Returns the native pipeline layout of the specified interface or the default pipeline layout and stores it for this PSO.
+        VkPipelineLayout GetVkPipelineLayoutOrDefault(
             const PipelineLayout*   pipelineLayout,
             VkPipelineLayout        defaultPipelineLayout
         );
@@ -51,10 +74,52 @@ class VKPipelineState : public PipelineState
         // Releases the native PSO and returns its address.
         VkPipeline* GetVkPipelineAddress();
 
+        /*
+        Runs the specified task to create the native PSO on a worker thread of the thread pool.
+        Exceptions thrown by the task are stored as errors in the report of this PSO.
+        */
+        void CreateVkPipelineAsync(ThreadPool& threadPool, const std::function<void()>& createTask);
+
+        // Writes the bindings of the specified pipeline layout as serialized segment. Nothing is written for the default pipeline layout.
+        static void WritePipelineLayout(Serialization::Serializer& writer, const PipelineLayout* pipelineLayout);
+
+        // Writes the SPIR-V code of the specified shader as serialized segment. Nothing is written if the shader is null.
+        static void WriteShaderStage(Serialization::Serializer& writer, const Shader* shader);
+
+        // Re-creates the pipeline layout of a serialized cache, or returns the default pipeline layout if the cache does not contain one.
+        VkPipelineLayout ReadPipelineLayout(
+            const VKPtr<VkDevice>&          device,
+            Serialization::Deserializer&    reader,
+            VkPipelineLayout                defaultPipelineLayout
+        );
+
+        // Re-creates the shader modules of all shader stages of a serialized cache.
+        static void ReadShaderStages(
+            const VKPtr<VkDevice>&                          device,
+            Serialization::Deserializer&                    reader,
+            std::vector<VKPtr<VkShaderModule>>&             shaderModules,
+            std::vector<std::string>&                       entryPoints,
+            std::vector<VkPipelineShaderStageCreateInfo>&   createInfos
+        );
+
+        // Creates a pipeline cache for a single PSO, optionally initialized with the data of a serialized cache.
+        static VKPtr<VkPipelineCache> CreateVkPipelineCache(
+            const VKPtr<VkDevice>&  device,
+            const void*             initialData     = nullptr,
+            std::size_t             initialDataSize = 0
+        );
+
+        // Merges the specified source pipeline cache into the destination pipeline cache. No other thread must use the destination cache during this call.
+        static void MergeVkPipelineCache(VkDevice device, VkPipelineCache dstPipelineCache, VkPipelineCache srcPipelineCache);
+
     private:
 
-        VKPtr<VkPipeline>   pipeline_;
-        VkPipelineBindPoint bindPoint_  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        VKPtr<VkPipeline>                   pipeline_;
+        VkPipelineBindPoint                 bindPoint_              = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        VkPipelineLayout                    pipelineLayout_         = VK_NULL_HANDLE;
+        std::unique_ptr<VKPipelineLayout>   cachedPipelineLayout_;  // Pipeline layout that was re-created from a serialized cache.
+        std::shared_future<void>            creation_;              // Pending creation on a worker thread; only valid for asynchronously created PSOs.
+        BasicReport                         report_;
 
 };
 
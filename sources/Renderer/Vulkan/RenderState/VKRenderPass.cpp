@@ -146,14 +146,17 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
     sampleCountBits_ = sampleCountBits;
     const bool multiSampleEnabled = (sampleCountBits > VK_SAMPLE_COUNT_1_BIT);
 
+    /* Store attachment descriptors to re-create compatible render passes from serialized PSO caches */
+    const auto numAttachmentDescs = (multiSampleEnabled ? numAttachments + numColorAttachments : numAttachments);
+    attachmentDescs_.assign(attachmentDescs, attachmentDescs + numAttachmentDescs);
+
     std::vector<VkAttachmentReference> rtvAttachmentsRefs(numAttachments);
     std::vector<VkAttachmentReference> rtvMsaaAttachmentsRefs;
     VkAttachmentReference dsvAttachmentRef = {};
 
     /* Store index for depth-stencil attachment */
     bool hasDepthStencil = (numColorAttachments < numAttachments);
-    if (hasDepthStencil)
-        depthStencilIndex_ = static_cast<std::uint8_t>(numColorAttachments);
+    depthStencilIndex_ = (hasDepthStencil ? static_cast<std::uint8_t>(numColorAttachments) : 0xFFu);
 
     /* Store number of color attachments (required for default blend states in VKGraphicsPipeline) */
     numColorAttachments_ = static_cast<std::uint8_t>(numColorAttachments);
@@ -235,7 +238,7 @@ void VKRenderPass::CreateVkRenderPassWithDescriptors(
         createInfo.sType                    = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
         createInfo.pNext                    = nullptr;
         createInfo.flags                    = 0;
-        createInfo.attachmentCount          = (multiSampleEnabled ? numAttachments + numColorAttachments : numAttachments);
+        createInfo.attachmentCount          = numAttachmentDescs;
         createInfo.pAttachments             = attachmentDescs;
         createInfo.subpassCount             = 1;
         createInfo.pSubpasses               = (&subpassDesc);
@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -82,15 +83,28 @@ class VKRenderPass final : public RenderPass
             return sampleCountBits_;
         }
 
+        // Returns the number of attachments (excluding the multi-sampled color attachments).
+        inline std::uint32_t GetNumAttachments() const
+        {
+            return (depthStencilIndex_ != 0xFFu ? numColorAttachments_ + 1u : numColorAttachments_);
+        }
+
+        // Returns the attachment descriptors this render pass was created with. This is used to serialize compatible render passes for PSO caches.
+        inline const std::vector<VkAttachmentDescription>& GetAttachmentDescs() const
+        {
+            return attachmentDescs_;
+        }
+
     private:
 
-        VKPtr<VkRenderPass>     renderPass_;
+        VKPtr<VkRenderPass>                     renderPass_;
+        std::vector<VkAttachmentDescription>    attachmentDescs_;
 
-        std::uint64_t           clearValuesMask_        = 0;
-        std::uint8_t            depthStencilIndex_      = 0xFFu;
-        std::uint8_t            numClearValues_         = 0;
-        std::uint8_t            numColorAttachments_    = 0;
-        VkSampleCountFlagBits   sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
+        std::uint64_t                           clearValuesMask_        = 0;
+        std::uint8_t                            depthStencilIndex_      = 0xFFu;
+        std::uint8_t                            numClearValues_         = 0;
+        std::uint8_t                            numColorAttachments_    = 0;
+        VkSampleCountFlagBits                   sampleCountBits_        = VK_SAMPLE_COUNT_1_BIT;
 
 };
 
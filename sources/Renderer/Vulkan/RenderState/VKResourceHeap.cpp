@@ -7,6 +7,7 @@
 
 #include "VKResourceHeap.h"
 #include "VKPipelineLayout.h"
+#include "VKDescriptorPoolAllocator.h"
 #include "../Buffer/VKBuffer.h"
 #include "../Texture/VKSampler.h"
 #include "../Texture/VKTexture.h"
@@ -18,6 +19,7 @@
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
 #include <LLGL/ResourceHeapFlags.h>
+#include <algorithm>
 #include <map>
 
 
@@ -41,16 +43,35 @@ static VkPipelineBindPoint FindPipelineBindPoint(const VKPipelineLayout& pipelin
     return VK_PIPELINE_BIND_POINT_MAX_ENUM;
 }
 
-VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc) :
-    descriptorPool_ { device, vkDestroyDescriptorPool }
+// Throws an exception if the specified resource does not match the resource type of a descriptor
+static void ValidateResourceType(const Resource& resource, const ResourceType type)
+{
+    if (resource.GetResourceType() != type)
+        throw std::invalid_argument("cannot write resource into resource heap descriptor of a different resource type");
+}
+
+VKResourceHeap::DescriptorImageView::DescriptorImageView(const VKPtr<VkDevice>& device, std::size_t descriptor) :
+    descriptor { descriptor                 },
+    imageView  { device, vkDestroyImageView }
+{
+}
+
+VKResourceHeap::VKResourceHeap(
+    const VKPtr<VkDevice>&          device,
+    VKDescriptorPoolAllocator&      descriptorPoolAllocator,
+    const ResourceHeapDescriptor&   desc)
+:
+    descriptorPoolAllocator_ { descriptorPoolAllocator }
 {
     /* Get pipeline layout object */
     auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
     if (!pipelineLayoutVK)
         throw std::invalid_argument("failed to create resource view heap due to missing pipeline layout");
 
-    pipelineLayout_ = pipelineLayoutVK->GetVkPipelineLayout();
-    bindPoint_      = FindPipelineBindPoint(*pipelineLayoutVK);
+    pipelineLayoutVK_   = pipelineLayoutVK;
+    pipelineLayout_     = pipelineLayoutVK->GetVkPipelineLayout();
+    setLayout_          = pipelineLayoutVK->GetVkDescriptorSetLayout();
+    bindPoint_          = FindPipelineBindPoint(*pipelineLayoutVK);
 
     /* Validate binding descriptors */
     const auto& bindings            = pipelineLayoutVK->GetBindings();
@@ -66,19 +87,20 @@ VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeap
     const auto numDescriptorSets = (numResourceViews / numBindings);
     descriptorSets_.resize(numDescriptorSets, VK_NULL_HANDLE);
 
-    /* Create resource descriptor pool */
-    CreateDescriptorPool(device, desc, bindings);
-
-    /* Create resource descriptor set for pipeline layout */
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    setLayouts.resize(numDescriptorSets, pipelineLayoutVK->GetVkDescriptorSetLayout());
-    CreateDescriptorSets(device, static_cast<std::uint32_t>(numDescriptorSets), setLayouts.data());
+    /* Allocate resource descriptor sets for pipeline layout from the shared descriptor pools */
+    AllocateDescriptorSets(bindings);
 
     /* Update write descriptors in descriptor set */
-    UpdateDescriptorSets(device, desc, bindings);
+    UpdateDescriptorSets(device, 0, desc.resourceViews);
 
     /* Create pipeline barrier for resource views that require it, e.g. those with storage binding flags */
-    CreatePipelineBarrier(desc.resourceViews, pipelineLayoutVK->GetBindings());
+    CreatePipelineBarrier(0, desc.resourceViews);
+}
+
+VKResourceHeap::~VKResourceHeap()
+{
+    /* Return descriptor sets to the allocator, so they can be recycled by the next resource heap with the same layout */
+    descriptorPoolAllocator_.Free(setLayout_, GetNumDescriptorSets(), descriptorSets_.data());
 }
 
 std::uint32_t VKResourceHeap::GetNumDescriptorSets() const
@@ -86,10 +108,34 @@ std::uint32_t VKResourceHeap::GetNumDescriptorSets() const
     return static_cast<std::uint32_t>(descriptorSets_.size());
 }
 
-void VKResourceHeap::InsertPipelineBarrier(VkCommandBuffer commandBuffer)
+void VKResourceHeap::InsertPipelineBarrier(VKPipelineBarrier& pendingBarrier) const
 {
     if (barrier_.IsEnabled())
-        barrier_.Submit(commandBuffer);
+        pendingBarrier.Merge(barrier_);
+}
+
+std::uint32_t VKResourceHeap::WriteResourceViews(
+    const VKPtr<VkDevice>&                      device,
+    std::uint32_t                               firstDescriptor,
+    const ArrayView<ResourceViewDescriptor>&    resourceViews)
+{
+    const std::size_t numDescriptors = descriptorSets_.size() * pipelineLayoutVK_->GetBindings().size();
+    if (firstDescriptor >= numDescriptors)
+        return 0;
+
+    /* Only update the descriptors within the range of this heap */
+    const ArrayView<ResourceViewDescriptor> resourceViewsInRange
+    {
+        resourceViews.data(),
+        std::min(resourceViews.size(), numDescriptors - firstDescriptor)
+    };
+
+    const auto numWritten = UpdateDescriptorSets(device, firstDescriptor, resourceViewsInRange);
+
+    /* Extend pipeline barrier for new resource views that require it */
+    CreatePipelineBarrier(firstDescriptor, resourceViewsInRange);
+
+    return numWritten;
 }
 
 
@@ -132,90 +178,69 @@ static void CompressDescriptorPoolSizes(std::vector<VkDescriptorPoolSize>& poolS
     );
 }
 
-//TODO: enhance pool size accumulation
-void VKResourceHeap::CreateDescriptorPool(
-    const VKPtr<VkDevice>&              device,
-    const ResourceHeapDescriptor&       desc,
-    const std::vector<VKLayoutBinding>& bindings)
+void VKResourceHeap::AllocateDescriptorSets(const std::vector<VKLayoutBinding>& bindings)
 {
-    /* Initialize descriptor pool sizes */
-    const auto numResourceViews = desc.resourceViews.size();
-    const auto numBindings      = bindings.size();
-
-    std::vector<VkDescriptorPoolSize> poolSizes(numResourceViews);
-    for (std::size_t i = 0; i < numResourceViews; ++i)
+    /* Initialize descriptor pool sizes for a single descriptor set */
+    std::vector<VkDescriptorPoolSize> poolSizes(bindings.size());
+    for (std::size_t i = 0; i < bindings.size(); ++i)
     {
-        poolSizes[i].type               = bindings[i % numBindings].descriptorType;
+        poolSizes[i].type               = bindings[i].descriptorType;
         poolSizes[i].descriptorCount    = 1;
     }
 
     /* Compress pool sizes by merging equal types with accumulated number of descriptors */
     CompressDescriptorPoolSizes(poolSizes);
 
-    /* Create descriptor pool */
-    VkDescriptorPoolCreateInfo poolCreateInfo;
-    {
-        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
-        poolCreateInfo.maxSets          = GetNumDescriptorSets();
-        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
-        poolCreateInfo.pPoolSizes       = poolSizes.data();
-    }
-    auto result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, descriptorPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
-}
-
-void VKResourceHeap::CreateDescriptorSets(
-    const VKPtr<VkDevice>&          device,
-    std::uint32_t                   numSetLayouts,
-    const VkDescriptorSetLayout*    setLayouts)
-{
-    /* Allocate descriptor set */
-    VkDescriptorSetAllocateInfo allocInfo;
-    {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.descriptorPool        = descriptorPool_;
-        allocInfo.descriptorSetCount    = numSetLayouts;
-        allocInfo.pSetLayouts           = setLayouts;
-    }
-    auto result = vkAllocateDescriptorSets(device, &allocInfo, descriptorSets_.data());
-    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+    /* Allocate descriptor sets */
+    descriptorPoolAllocator_.Allocate(
+        setLayout_,
+        static_cast<std::uint32_t>(poolSizes.size()),
+        poolSizes.data(),
+        GetNumDescriptorSets(),
+        descriptorSets_.data()
+    );
 }
 
-void VKResourceHeap::UpdateDescriptorSets(
-    const VKPtr<VkDevice>&              device,
-    const ResourceHeapDescriptor&       desc,
-    const std::vector<VKLayoutBinding>& bindings)
+std::uint32_t VKResourceHeap::UpdateDescriptorSets(
+    const VKPtr<VkDevice>&                      device,
+    std::size_t                                 firstDescriptor,
+    const ArrayView<ResourceViewDescriptor>&    resourceViews)
 {
     /* Allocate local storage for buffer and image descriptors */
-    const auto numResourceViews = desc.resourceViews.size();
-    const auto numBindings      = bindings.size();
+    const auto& bindings        = pipelineLayoutVK_->GetBindings();
+    const auto  numBindings     = bindings.size();
 
-    VKWriteDescriptorContainer container{ numResourceViews };
+    VKWriteDescriptorContainer container{ resourceViews.size() };
 
-    for (std::size_t i = 0; i < numResourceViews; ++i)
+    for (std::size_t i = 0; i < resourceViews.size(); ++i)
     {
-        /* Get resource view information */
-        const auto& binding = bindings[i % numBindings];
+        /* Get resource view information; null resources keep their previous descriptor */
+        const auto& rvDesc = resourceViews[i];
+        if (rvDesc.resource == nullptr)
+            continue;
+
+        const auto descriptor = firstDescriptor + i;
+        const auto& binding = bindings[descriptor % numBindings];
         const auto descriptorType = binding.descriptorType;
 
-        const auto& rvDesc = desc.resourceViews[i];
-        VkDescriptorSet descSet = descriptorSets_[i / numBindings];
+        VkDescriptorSet descSet = descriptorSets_[descriptor / numBindings];
 
         switch (descriptorType)
         {
             case VK_DESCRIPTOR_TYPE_SAMPLER:
+                ValidateResourceType(*rvDesc.resource, ResourceType::Sampler);
                 FillWriteDescriptorForSampler(rvDesc, descSet, binding, container);
                 break;
 
             case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-                FillWriteDescriptorForTexture(device, rvDesc, descSet, binding, container);
+                ValidateResourceType(*rvDesc.resource, ResourceType::Texture);
+                FillWriteDescriptorForTexture(device, rvDesc, descriptor, descSet, binding, container);
                 break;
 
             case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
             case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                ValidateResourceType(*rvDesc.resource, ResourceType::Buffer);
                 FillWriteDescriptorForBuffer(device, rvDesc, descSet, binding, container);
                 break;
 
@@ -238,6 +263,8 @@ void VKResourceHeap::UpdateDescriptorSets(
             nullptr                             // No descriptors to be copied
         );
     }
+
+    return container.numWriteDescriptors;
 }
 
 void VKResourceHeap::FillWriteDescriptorForSampler(
@@ -273,6 +300,7 @@ void VKResourceHeap::FillWriteDescriptorForSampler(
 void VKResourceHeap::FillWriteDescriptorForTexture(
     const VKPtr<VkDevice>&          device,
     const ResourceViewDescriptor&   rvDesc,
+    std::size_t                     descriptor,
     VkDescriptorSet                 descSet,
     const VKLayoutBinding&          binding,
     VKWriteDescriptorContainer&     container)
@@ -283,7 +311,7 @@ void VKResourceHeap::FillWriteDescriptorForTexture(
     auto imageInfo = container.NextImageInfo();
     {
         imageInfo->sampler       = VK_NULL_HANDLE;
-        imageInfo->imageView     = GetOrCreateImageView(device, *textureVK, rvDesc);
+        imageInfo->imageView     = GetOrCreateImageView(device, *textureVK, rvDesc, descriptor);
         imageInfo->imageLayout   = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
 
@@ -340,15 +368,14 @@ void VKResourceHeap::FillWriteDescriptorForBuffer(
     }
 }
 
-void VKResourceHeap::CreatePipelineBarrier(
-    const std::vector<ResourceViewDescriptor>&  resourceViews,
-    const std::vector<VKLayoutBinding>&         bindings)
+void VKResourceHeap::CreatePipelineBarrier(std::size_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
 {
-    const auto numBindings = bindings.size();
+    const auto& bindings    = pipelineLayoutVK_->GetBindings();
+    const auto  numBindings = bindings.size();
     for (std::size_t i = 0; i < resourceViews.size(); ++i)
     {
         const auto& desc    = resourceViews[i];
-        const auto& binding = bindings[i % numBindings];
+        const auto& binding = bindings[(firstDescriptor + i) % numBindings];
 
         if (auto resource = desc.resource)
         {
@@ -373,18 +400,34 @@ void VKResourceHeap::CreatePipelineBarrier(
 VkImageView VKResourceHeap::GetOrCreateImageView(
     const VKPtr<VkDevice>&          device,
     VKTexture&                      textureVK,
-    const ResourceViewDescriptor&   rvDesc)
+    const ResourceViewDescriptor&   rvDesc,
+    std::size_t                     descriptor)
 {
+    /* Find image view that is owned by the specified descriptor */
+    auto it = std::lower_bound(
+        imageViews_.begin(),
+        imageViews_.end(),
+        descriptor,
+        [](const DescriptorImageView& lhs, std::size_t rhs)
+        {
+            return (lhs.descriptor < rhs);
+        }
+    );
+    const bool hasImageView = (it != imageViews_.end() && it->descriptor == descriptor);
+
     if (IsTextureViewEnabled(rvDesc.textureView))
     {
-        /* Creates a new image view for the specified subresource descriptor */
-        imageViews_.emplace_back(device, vkDestroyImageView);
-        textureVK.CreateImageView(device, rvDesc.textureView, imageViews_.back().ReleaseAndGetAddressOf());
-        return imageViews_.back();
+        /* Creates a new image view for the specified subresource descriptor, which replaces the previous one of this descriptor */
+        if (!hasImageView)
+            it = imageViews_.insert(it, DescriptorImageView{ device, descriptor });
+        textureVK.CreateImageView(device, rvDesc.textureView, it->imageView.ReleaseAndGetAddressOf());
+        return it->imageView;
     }
     else
     {
-        /* Returns the standard image view */
+        /* Release previous image view of this descriptor and return the standard image view */
+        if (hasImageView)
+            imageViews_.erase(it);
         return textureVK.GetVkImageView();
     }
 }
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/ResourceHeap.h>
+#include <LLGL/Container/ArrayView.h>
 #include "VKPipelineBarrier.h"
 #include "../Vulkan.h"
 #include "../VKPtr.h"
@@ -22,6 +23,8 @@ namespace LLGL
 
 class VKBuffer;
 class VKTexture;
+class VKDescriptorPoolAllocator;
+class VKPipelineLayout;
 struct VKWriteDescriptorContainer;
 struct VKLayoutBinding;
 struct ResourceHeapDescriptor;
@@ -37,21 +40,33 @@ class VKResourceHeap final : public ResourceHeap
 
     public:
 
-        VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc);
+        VKResourceHeap(
+            const VKPtr<VkDevice>&          device,
+            VKDescriptorPoolAllocator&      descriptorPoolAllocator,
+            const ResourceHeapDescriptor&   desc
+        );
+        ~VKResourceHeap();
 
-        // Inserts a pipeline barrier command into the command buffer if this resource heap requires it.
-        void InsertPipelineBarrier(VkCommandBuffer commandBuffer);
+        // Inserts the barriers this resource heap requires into the specified pending pipeline barrier of a command buffer.
+        void InsertPipelineBarrier(VKPipelineBarrier& pendingBarrier) const;
 
-        // Returns the native Vulkan pipeline layout.
-        inline VkPipelineLayout GetVkPipelineLayout() const
+        // Updates the specified descriptors with a single call to vkUpdateDescriptorSets and returns the number of written descriptors.
+        std::uint32_t WriteResourceViews(
+            const VKPtr<VkDevice>&                      device,
+            std::uint32_t                               firstDescriptor,
+            const ArrayView<ResourceViewDescriptor>&    resourceViews
+        );
+
+        // Returns the pipeline layout this resource heap was created with.
+        inline const VKPipelineLayout* GetPipelineLayout() const
         {
-            return pipelineLayout_;
+            return pipelineLayoutVK_;
         }
 
-        // Returns the native Vulkan descritpor pool.
-        inline VkDescriptorPool GetVkDescriptorPool() const
+        // Returns the native Vulkan pipeline layout.
+        inline VkPipelineLayout GetVkPipelineLayout() const
         {
-            return descriptorPool_.Get();
+            return pipelineLayout_;
         }
 
         // Returns the list of native Vulkan descriptor sets.
@@ -71,22 +86,23 @@ class VKResourceHeap final : public ResourceHeap
 
     private:
 
-        void CreateDescriptorPool(
-            const VKPtr<VkDevice>&              device,
-            const ResourceHeapDescriptor&       desc,
-            const std::vector<VKLayoutBinding>& bindings
-        );
+        // Image view that has been created for the texture-view of a single descriptor.
+        struct DescriptorImageView
+        {
+            DescriptorImageView(const VKPtr<VkDevice>& device, std::size_t descriptor);
 
-        void CreateDescriptorSets(
-            const VKPtr<VkDevice>&          device,
-            std::uint32_t                   numSetLayouts,
-            const VkDescriptorSetLayout*    setLayouts
-        );
+            std::size_t         descriptor;
+            VKPtr<VkImageView>  imageView;
+        };
 
-        void UpdateDescriptorSets(
-            const VKPtr<VkDevice>&              device,
-            const ResourceHeapDescriptor&       desc,
-            const std::vector<VKLayoutBinding>& bindings
+    private:
+
+        void AllocateDescriptorSets(const std::vector<VKLayoutBinding>& bindings);
+
+        std::uint32_t UpdateDescriptorSets(
+            const VKPtr<VkDevice>&                      device,
+            std::size_t                                 firstDescriptor,
+            const ArrayView<ResourceViewDescriptor>&    resourceViews
         );
 
         void FillWriteDescriptorForSampler(
@@ -99,6 +115,7 @@ class VKResourceHeap final : public ResourceHeap
         void FillWriteDescriptorForTexture(
             const VKPtr<VkDevice>&          device,
             const ResourceViewDescriptor&   rvDesc,
+            std::size_t                     descriptor,
             VkDescriptorSet                 descSet,
             const VKLayoutBinding&          binding,
             VKWriteDescriptorContainer&     container
@@ -112,30 +129,30 @@ class VKResourceHeap final : public ResourceHeap
             VKWriteDescriptorContainer&     container
         );
 
-        void CreatePipelineBarrier(
-            const std::vector<ResourceViewDescriptor>&  resourceViews,
-            const std::vector<VKLayoutBinding>&         bindings
-        );
+        void CreatePipelineBarrier(std::size_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
 
-        // Returns the image view for the specified texture or creates one if the texture-view is enabled.
+        // Returns the image view for the specified texture or creates one for the specified descriptor if the texture-view is enabled.
         VkImageView GetOrCreateImageView(
             const VKPtr<VkDevice>&          device,
             VKTexture&                      textureVK,
-            const ResourceViewDescriptor&   rvDesc
+            const ResourceViewDescriptor&   rvDesc,
+            std::size_t                     descriptor
         );
 
     private:
 
-        VkPipelineLayout                pipelineLayout_ = VK_NULL_HANDLE;
+        const VKPipelineLayout*             pipelineLayoutVK_   = nullptr;
+        VkPipelineLayout                    pipelineLayout_     = VK_NULL_HANDLE;
 
-        VKPtr<VkDescriptorPool>         descriptorPool_;
-        std::vector<VkDescriptorSet>    descriptorSets_;
+        VKDescriptorPoolAllocator&          descriptorPoolAllocator_;
+        VkDescriptorSetLayout               setLayout_          = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet>        descriptorSets_;
 
-        std::vector<VKPtr<VkImageView>> imageViews_;
-        //std::vector<VkBufferView>       bufferViews_;
+        std::vector<DescriptorImageView>    imageViews_;                            // Image views sorted by descriptor index
+        //std::vector<VkBufferView>           bufferViews_;
 
-        VKPipelineBarrier               barrier_; //TODO: make it an array, one element for each descriptor set
-        VkPipelineBindPoint             bindPoint_      = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        VKPipelineBarrier                   barrier_; //TODO: make it an array, one element for each descriptor set
+        VkPipelineBindPoint                 bindPoint_          = VK_PIPELINE_BIND_POINT_MAX_ENUM;
 
 
 };
@@ -10,6 +10,7 @@
 #include "../VKTypes.h"
 #include "../../../Core/Helper.h"
 #include <LLGL/Misc/TypeNames.h>
+#include <LLGL/Constants.h>
 
 #ifdef LLGL_ENABLE_SPIRV_REFLECT
 #   include "../../SPIRV/SPIRVReflect.h"
@@ -194,6 +195,108 @@ static Format SpvTypeToFormat(const SPIRVReflect::SpvType* type, std::uint32_t*
     return Format::Undefined;
 }
 
+static UniformType SpvVectorTypeToUniformType(const SPIRVReflect::SpvType* type, std::uint32_t count)
+{
+    if (type == nullptr || count < 1 || count > 4)
+        return UniformType::Undefined;
+
+    const auto n = static_cast<int>(count) - 1;
+    switch (type->opcode)
+    {
+        case spv::Op::OpTypeFloat:
+            if (type->size == 4)
+                return static_cast<UniformType>(static_cast<int>(UniformType::Float1) + n);
+            if (type->size == 8)
+                return static_cast<UniformType>(static_cast<int>(UniformType::Double1) + n);
+            break;
+        case spv::Op::OpTypeInt:
+            if (type->size == 4)
+                return static_cast<UniformType>(static_cast<int>(type->sign ? UniformType::Int1 : UniformType::UInt1) + n);
+            break;
+        case spv::Op::OpTypeBool:
+            return static_cast<UniformType>(static_cast<int>(UniformType::Bool1) + n);
+        default:
+            break;
+    }
+
+    return UniformType::Undefined;
+}
+
+static UniformType SpvMatrixTypeToUniformType(const SPIRVReflect::SpvType* columnType, std::uint32_t columns)
+{
+    if (columnType == nullptr || columnType->baseType == nullptr)
+        return UniformType::Undefined;
+
+    const auto rows = columnType->elements;
+    if (columns < 2 || columns > 4 || rows < 2 || rows > 4)
+        return UniformType::Undefined;
+
+    /* Matrix uniform types are ordered by columns first, e.g. Float2x2, Float2x3, Float2x4, Float3x2, ... */
+    const auto n = static_cast<int>((columns - 2) * 3 + (rows - 2));
+    if (columnType->baseType->opcode == spv::Op::OpTypeFloat)
+    {
+        if (columnType->baseType->size == 4)
+            return static_cast<UniformType>(static_cast<int>(UniformType::Float2x2) + n);
+        if (columnType->baseType->size == 8)
+            return static_cast<UniformType>(static_cast<int>(UniformType::Double2x2) + n);
+    }
+
+    return UniformType::Undefined;
+}
+
+// Returns the uniform type of the specified SPIR-V type and its array size, or 1 if the type is not an array.
+static UniformType SpvTypeToUniformType(const SPIRVReflect::SpvType* type, std::uint32_t& arraySize)
+{
+    arraySize = 1;
+
+    if (type != nullptr && type->opcode == spv::Op::OpTypeArray)
+    {
+        arraySize   = type->elements;
+        type        = type->baseType;
+    }
+
+    if (type != nullptr)
+    {
+        switch (type->opcode)
+        {
+            case spv::Op::OpTypeFloat:
+            case spv::Op::OpTypeInt:
+            case spv::Op::OpTypeBool:
+                return SpvVectorTypeToUniformType(type, 1);
+            case spv::Op::OpTypeVector:
+                return SpvVectorTypeToUniformType(type->baseType, type->elements);
+            case spv::Op::OpTypeMatrix:
+                return SpvMatrixTypeToUniformType(type->baseType, type->elements);
+            default:
+                break;
+        }
+    }
+
+    return UniformType::Undefined;
+}
+
+// Appends all fields of the push constant blocks as uniforms. The uniform location is the byte offset within the push constant range.
+static void ReflectSpvPushConstants(ShaderReflection& reflection, const SPIRVReflect& spvReflect)
+{
+    for (const auto& it : spvReflect.GetPushConstants())
+    {
+        const auto& var = it.second;
+        if (auto structType = var.type->DereferencePtr(spv::Op::OpTypeStruct))
+        {
+            for (std::size_t i = 0; i < structType->fieldTypes.size(); ++i)
+            {
+                ShaderUniform uniform;
+                {
+                    uniform.name        = GetOptString(structType->fieldNames[i]);
+                    uniform.type        = SpvTypeToUniformType(structType->fieldTypes[i], uniform.size);
+                    uniform.location    = static_cast<UniformLocation>(structType->fieldOffsets[i]);
+                }
+                reflection.uniforms.push_back(uniform);
+            }
+        }
+    }
+}
+
 static SystemValue SpvBuiltinToSystemValue(spv::BuiltIn type)
 {
     switch (type)
@@ -353,9 +456,31 @@ bool VKShader::Reflect(ShaderReflection& reflection) const
             resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
     }
 
+    /* Gather push constants */
+    ReflectSpvPushConstants(reflection, spvReflect);
+
     return true;
 }
 
+UniformLocation VKShader::FindUniformLocation(const char* name) const
+{
+    /* Parse shader module */
+    SPIRVReflect spvReflect;
+    spvReflect.Parse(shaderModuleData_.data(), shaderModuleData_.size());
+
+    /* Find push constant field by name */
+    ShaderReflection reflection;
+    ReflectSpvPushConstants(reflection, spvReflect);
+
+    for (const auto& uniform : reflection.uniforms)
+    {
+        if (uniform.name == name)
+            return uniform.location;
+    }
+
+    return Constants::invalidLocation;
+}
+
 bool VKShader::ReflectLocalSize(Extent3D& localSize) const
 {
     if (GetType() == ShaderType::Compute)
@@ -382,6 +507,11 @@ bool VKShader::Reflect(ShaderReflection& /*reflection*/) const
     return false; // dummy
 }
 
+UniformLocation VKShader::FindUniformLocation(const char* /*name*/) const
+{
+    return Constants::invalidLocation; // dummy
+}
+
 bool VKShader::ReflectLocalSize(Extent3D& /*workGroupSize*/) const
 {
     return false; // dummy
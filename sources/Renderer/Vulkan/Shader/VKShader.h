@@ -30,6 +30,7 @@ class VKShader final : public Shader
 
         const Report* GetReport() const override;
         bool Reflect(ShaderReflection& reflection) const override;
+        UniformLocation FindUniformLocation(const char* name) const override;
 
     public:
 
@@ -46,6 +47,18 @@ class VKShader final : public Shader
             return shaderModule_;
         }
 
+        // Returns the SPIR-V code the shader module was created with.
+        inline const std::vector<char>& GetShaderModuleData() const
+        {
+            return shaderModuleData_;
+        }
+
+        // Returns the name of the shader entry point.
+        inline const std::string& GetEntryPoint() const
+        {
+            return entryPoint_;
+        }
+
     private:
 
         // Note: "Success" is a reserved macro by X11 lib.
@@ -107,6 +107,18 @@ class VKTexture final : public Texture
             return imageWrapper_.GetMemoryRegion();
         }
 
+        // Stores the queue submission of the upload command buffer that writes into this texture.
+        inline void SetUploadSubmissionID(std::uint64_t submissionID)
+        {
+            uploadSubmissionID_ = submissionID;
+        }
+
+        // Returns the latest queue submission that writes into this texture with the upload command buffer, or 0 if there is none.
+        inline std::uint64_t GetUploadSubmissionID() const
+        {
+            return uploadSubmissionID_;
+        }
+
     private:
 
         void CreateImage(VkDevice device, const TextureDescriptor& desc);
@@ -121,6 +133,8 @@ class VKTexture final : public Texture
         std::uint32_t       numMipLevels_   = 0;
         std::uint32_t       numArrayLayers_ = 0;
 
+        std::uint64_t       uploadSubmissionID_ = 0;
+
 };
 
 
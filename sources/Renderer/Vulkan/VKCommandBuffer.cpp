@@ -16,6 +16,7 @@
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKComputePSO.h"
 #include "RenderState/VKResourceHeap.h"
+#include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "Texture/VKSampler.h"
 #include "Texture/VKTexture.h"
@@ -26,7 +27,9 @@
 #include "../../Core/Exception.h"
 #include <LLGL/StaticLimits.h>
 #include <LLGL/TypeInfo.h>
+#include <LLGL/Container/SmallVector.h>
 #include <cstddef>
+#include <algorithm>
 
 
 namespace LLGL
@@ -42,6 +45,9 @@ static std::uint32_t GetMaxDrawIndirectCount(const VKPhysicalDevice& physicalDev
         return 1u;
 }
 
+// Default size (in bytes) of each chunk in the staging buffer pools for "UpdateBuffer".
+static const VkDeviceSize g_stagingBufferChunkSize = 0x10000;
+
 // Returns the number of native command buffers for the specified descriptor
 static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
 {
@@ -51,10 +57,17 @@ static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
         return std::max(1u, desc.numNativeBuffers);
 }
 
+// Returns true if the two buffer copy regions overlap in their destination range.
+static bool IsBufferCopyDstOverlapping(const VkBufferCopy& lhs, const VkBufferCopy& rhs)
+{
+    return (lhs.dstOffset < rhs.dstOffset + rhs.size && rhs.dstOffset < lhs.dstOffset + lhs.size);
+}
+
 VKCommandBuffer::VKCommandBuffer(
     const VKPhysicalDevice&         physicalDevice,
     VKDevice&                       device,
-    VkQueue                         commandQueue,
+    VKCommandQueue&                 commandQueue,
+    VKDeviceMemoryManager&          deviceMemoryMngr,
     const QueueFamilyIndices&       queueFamilyIndices,
     const CommandBufferDescriptor&  desc)
 :
@@ -87,7 +100,12 @@ VKCommandBuffer::VKCommandBuffer(
     /* Create native command buffer objects */
     CreateCommandPool(queueFamilyIndices.graphicsFamily);
     CreateCommandBuffers(bufferCount);
-    CreateRecordingFences(commandQueue, bufferCount);
+    submissionIDList_.resize(bufferCount, 0);
+
+    /* Create one staging buffer pool per native command buffer, so a pool is only reset once its submission has been completed */
+    stagingBufferPools_.reserve(bufferCount);
+    for (std::uint32_t i = 0; i < bufferCount; ++i)
+        stagingBufferPools_.emplace_back(device, deviceMemoryMngr, g_stagingBufferChunkSize);
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
@@ -95,6 +113,10 @@ VKCommandBuffer::VKCommandBuffer(
 
 VKCommandBuffer::~VKCommandBuffer()
 {
+    /* Wait until the GPU has finished reading from the staging buffer pools */
+    for (auto submissionID : submissionIDList_)
+        commandQueue_.WaitSubmission(submissionID);
+
     vkFreeCommandBuffers(
         device_,
         commandPool_,
@@ -110,9 +132,12 @@ void VKCommandBuffer::Begin()
     /* Use next internal VkCommandBuffer object to reduce latency */
     AcquireNextBuffer();
 
-    /* Wait for fence before recording */
-    vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
-    vkResetFences(device_, 1, &recordingFence_);
+    /* Wait until the queue submission of this native command buffer has been completed before recording */
+    commandQueue_.WaitSubmission(submissionIDList_[commandBufferIndex_]);
+
+    /* Recycle staging memory of previous encoding of this native command buffer */
+    stagingBufferPools_[commandBufferIndex_].Reset();
+    pendingCopyRegions_.clear();
 
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
@@ -130,12 +155,21 @@ void VKCommandBuffer::Begin()
     ResetQueryPoolsInFlight();
     #endif
 
+    /* Discard barriers of previous encoding */
+    pendingBarrier_.Reset();
+
+    /* Push constants require a bound PSO in each encoding */
+    boundPipelineLayout_ = VK_NULL_HANDLE;
+
     /* Store new record state */
     recordState_ = RecordState::OutsideRenderPass;
 }
 
 void VKCommandBuffer::End()
 {
+    /* Record remaining barriers, so subsequent submissions see the results of this command buffer */
+    FlushPipelineBarrier();
+
     /* End encoding of current command buffer */
     auto result = vkEndCommandBuffer(commandBuffer_);
     VKThrowIfFailed(result, "failed to end Vulkan command buffer");
@@ -146,8 +180,8 @@ void VKCommandBuffer::End()
     /* Execute command buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
     {
-        auto result = VKSubmitCommandBuffer(commandQueue_, commandBuffer_, GetQueueSubmitFence());
-        VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
+        commandQueue_.EnqueueCommandBuffer(*this);
+        commandQueue_.FlushSubmissions();
     }
 }
 
@@ -155,6 +189,7 @@ void VKCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferVK = LLGL_CAST(VKCommandBuffer&, deferredCommandBuffer);
     VkCommandBuffer cmdBuffers[] = { cmdBufferVK.GetVkCommandBuffer() };
+    FlushPipelineBarrier();
     vkCmdExecuteCommands(commandBuffer_, 1, cmdBuffers);
 }
 
@@ -164,24 +199,31 @@ void VKCommandBuffer::UpdateBuffer(
     Buffer&         dstBuffer,
     std::uint64_t   dstOffset,
     const void*     data,
-    std::uint16_t   dataSize)
+    std::uint64_t   dataSize)
 {
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
-    auto size   = static_cast<VkDeviceSize>(dataSize);
-    auto offset = static_cast<VkDeviceSize>(dstOffset);
+    /* Write data into the staging buffer pool of the current native command buffer */
+    VkBuffer srcBuffer = VK_NULL_HANDLE;
+    VkBufferCopy region;
+    {
+        region.dstOffset    = static_cast<VkDeviceSize>(dstOffset);
+        region.size         = static_cast<VkDeviceSize>(dataSize);
+    }
+    stagingBufferPools_[commandBufferIndex_].Write(data, region.size, srcBuffer, region.srcOffset);
 
+    /* Append copy region; consecutive updates are recorded as a single copy command once the pending barriers are flushed */
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
-        vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
-        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
+        AppendBufferCopy(srcBuffer, dstBufferVK.GetVkBuffer(), region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.dstOffset, region.size);
         ResumeRenderPass();
     }
     else
     {
-        vkCmdUpdateBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, data);
-        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
+        AppendBufferCopy(srcBuffer, dstBufferVK.GetVkBuffer(), region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.dstOffset, region.size);
     }
 }
 
@@ -205,11 +247,19 @@ void VKCommandBuffer::CopyBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        FlushPipelineBarrierForBuffer(srcBufferVK.GetVkBuffer());
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.dstOffset, region.size);
         ResumeRenderPass();
     }
     else
+    {
+        FlushPipelineBarrierForBuffer(srcBufferVK.GetVkBuffer());
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.dstOffset, region.size);
+    }
 }
 
 void VKCommandBuffer::CopyBufferFromTexture(
@@ -239,11 +289,19 @@ void VKCommandBuffer::CopyBufferFromTexture(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        FlushPipelineBarrierForImage(srcTextureVK.GetVkImage());
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.bufferOffset, VK_WHOLE_SIZE);
         ResumeRenderPass();
     }
     else
+    {
+        FlushPipelineBarrierForImage(srcTextureVK.GetVkImage());
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), region.bufferOffset, VK_WHOLE_SIZE);
+    }
 }
 
 void VKCommandBuffer::FillBuffer(
@@ -271,11 +329,17 @@ void VKCommandBuffer::FillBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
         ResumeRenderPass();
     }
     else
+    {
+        FlushPipelineBarrierForBuffer(dstBufferVK.GetVkBuffer());
         vkCmdFillBuffer(commandBuffer_, dstBufferVK.GetVkBuffer(), offset, size, value);
+        BufferPipelineBarrier(dstBufferVK.GetVkBuffer(), offset, size);
+    }
 }
 
 void VKCommandBuffer::CopyTexture(
@@ -306,11 +370,19 @@ void VKCommandBuffer::CopyTexture(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        FlushPipelineBarrierForImage(srcTextureVK.GetVkImage());
+        FlushPipelineBarrierForImage(dstTextureVK.GetVkImage());
         device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
+        ImagePipelineBarrier(dstTextureVK.GetVkImage(), region.dstSubresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
         ResumeRenderPass();
     }
     else
+    {
+        FlushPipelineBarrierForImage(srcTextureVK.GetVkImage());
+        FlushPipelineBarrierForImage(dstTextureVK.GetVkImage());
         device_.CopyTexture(commandBuffer_, srcTextureVK, dstTextureVK, region);
+        ImagePipelineBarrier(dstTextureVK.GetVkImage(), region.dstSubresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
 }
 
 void VKCommandBuffer::CopyTextureFromBuffer(
@@ -340,16 +412,25 @@ void VKCommandBuffer::CopyTextureFromBuffer(
     if (IsInsideRenderPass())
     {
         PauseRenderPass();
+        FlushPipelineBarrierForBuffer(srcBufferVK.GetVkBuffer());
+        FlushPipelineBarrierForImage(dstTextureVK.GetVkImage());
         device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
+        ImagePipelineBarrier(dstTextureVK.GetVkImage(), region.imageSubresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
         ResumeRenderPass();
     }
     else
+    {
+        FlushPipelineBarrierForBuffer(srcBufferVK.GetVkBuffer());
+        FlushPipelineBarrierForImage(dstTextureVK.GetVkImage());
         device_.CopyBufferToImage(commandBuffer_, srcBufferVK, dstTextureVK, region);
+        ImagePipelineBarrier(dstTextureVK.GetVkImage(), region.imageSubresource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
 }
 
 void VKCommandBuffer::GenerateMips(Texture& texture)
 {
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
+    FlushPipelineBarrierForImage(textureVK.GetVkImage());
     device_.GenerateMips(
         commandBuffer_,
         textureVK.GetVkImage(),
@@ -369,6 +450,7 @@ void VKCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& s
     if (subresource.baseMipLevel   < maxNumMipLevels   && subresource.numMipLevels   > 0 &&
         subresource.baseArrayLayer < maxNumArrayLayers && subresource.numArrayLayers > 0)
     {
+        FlushPipelineBarrierForImage(textureVK.GetVkImage());
         device_.GenerateMips(
             commandBuffer_,
             textureVK.GetVkImage(),
@@ -466,7 +548,12 @@ void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::u
 /* ----- Resources ----- */
 
 //private
-void VKCommandBuffer::BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet)
+void VKCommandBuffer::BindResourceHeap(
+    VKResourceHeap&         resourceHeapVK,
+    VkPipelineBindPoint     bindingPoint,
+    std::uint32_t           firstSet,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
     const VkDescriptorSet descriptorSets[1] = { resourceHeapVK.GetVkDescriptorSets()[firstSet] };
     vkCmdBindDescriptorSets(
@@ -476,34 +563,74 @@ void VKCommandBuffer::BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelin
         0,                                      // First set in SPIR-V (always 0 atm.)
         1,                                      // Number of descriptor sets (always 1 atm.)
         descriptorSets,                         // Descriptor sets
-        0,                                      // No dynamic offsets
-        nullptr
+        numDynamicOffsets,                      // Dynamic offsets in order of binding numbers
+        dynamicOffsets
     );
 }
 
-void VKCommandBuffer::SetResourceHeap(
-    ResourceHeap&           resourceHeap,
+//private
+void VKCommandBuffer::BindResourceHeapToBindPoints(
+    VKResourceHeap&         resourceHeapVK,
     std::uint32_t           firstSet,
-    const PipelineBindPoint bindPoint)
+    const PipelineBindPoint bindPoint,
+    std::uint32_t           numDynamicOffsets,
+    const std::uint32_t*    dynamicOffsets)
 {
-    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
-
     /* Bind resource heap to pipelines */
     if (bindPoint == PipelineBindPoint::Undefined)
     {
         if (resourceHeapVK.GetBindPoint() == VK_PIPELINE_BIND_POINT_MAX_ENUM)
         {
-            BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_GRAPHICS, firstSet);
-            BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_COMPUTE, firstSet);
+            BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_GRAPHICS, firstSet, numDynamicOffsets, dynamicOffsets);
+            BindResourceHeap(resourceHeapVK, VK_PIPELINE_BIND_POINT_COMPUTE, firstSet, numDynamicOffsets, dynamicOffsets);
         }
         else
-            BindResourceHeap(resourceHeapVK, resourceHeapVK.GetBindPoint(), firstSet);
+            BindResourceHeap(resourceHeapVK, resourceHeapVK.GetBindPoint(), firstSet, numDynamicOffsets, dynamicOffsets);
     }
     else
-        BindResourceHeap(resourceHeapVK, VKTypes::Map(bindPoint), firstSet);
+        BindResourceHeap(resourceHeapVK, VKTypes::Map(bindPoint), firstSet, numDynamicOffsets, dynamicOffsets);
+
+    /* Defer resource barrier until the next draw or dispatch command */
+    resourceHeapVK.InsertPipelineBarrier(pendingBarrier_);
+}
+
+void VKCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    const PipelineBindPoint bindPoint)
+{
+    SetResourceHeap(resourceHeap, firstSet, bindPoint, {});
+}
+
+void VKCommandBuffer::SetResourceHeap(
+    ResourceHeap&                   resourceHeap,
+    std::uint32_t                   firstSet,
+    const PipelineBindPoint         bindPoint,
+    const ArrayView<std::uint32_t>& dynamicOffsets)
+{
+    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
+
+    /* Vulkan requires an offset for each dynamic binding, so missing offsets default to 0 */
+    const auto* pipelineLayoutVK = resourceHeapVK.GetPipelineLayout();
+    const auto numDynamicOffsets = pipelineLayoutVK->GetNumDynamicOffsets();
+    if (numDynamicOffsets == 0)
+    {
+        BindResourceHeapToBindPoints(resourceHeapVK, firstSet, bindPoint, 0, nullptr);
+        return;
+    }
+
+    /* Reorder offsets from pipeline layout order to binding number order */
+    SmallVector<std::uint32_t> offsetsVK;
+    offsetsVK.resize(numDynamicOffsets, 0u);
+    const auto& offsetOrder = pipelineLayoutVK->GetDynamicOffsetOrder();
+    for (std::uint32_t i = 0; i < numDynamicOffsets; ++i)
+    {
+        const auto srcIndex = (offsetOrder.empty() ? i : offsetOrder[i]);
+        if (srcIndex < dynamicOffsets.size())
+            offsetsVK[i] = dynamicOffsets[srcIndex];
+    }
 
-    /* Insert resource barrier into command buffer */
-    resourceHeapVK.InsertPipelineBarrier(commandBuffer_);
+    BindResourceHeapToBindPoints(resourceHeapVK, firstSet, bindPoint, numDynamicOffsets, offsetsVK.data());
 }
 
 void VKCommandBuffer::SetResource(
@@ -586,6 +713,7 @@ void VKCommandBuffer::BeginRenderPass(
         beginInfo.clearValueCount   = numClearValuesVK;
         beginInfo.pClearValues      = clearValuesVK;
     }
+    FlushPipelineBarrier();
     vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     /* Store new record state */
@@ -717,6 +845,9 @@ void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
     auto& pipelineStateVK = LLGL_CAST(VKPipelineState&, pipelineState);
     vkCmdBindPipeline(commandBuffer_, pipelineStateVK.GetBindPoint(), pipelineStateVK.GetVkPipeline());
 
+    /* Store pipeline layout for push constants; all pipeline layouts share the same push constant range */
+    boundPipelineLayout_ = pipelineStateVK.GetVkPipelineLayout();
+
     /* Handle special case for graphics PSOs */
     if (pipelineStateVK.GetBindPoint() == VK_PIPELINE_BIND_POINT_GRAPHICS)
     {
@@ -755,11 +886,23 @@ void VKCommandBuffer::SetUniform(
 
 void VKCommandBuffer::SetUniforms(
     UniformLocation location,
-    std::uint32_t   count,
+    std::uint32_t   /*count*/,
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //TODO
+    /* Uniforms are push constants and their location is the byte offset within the push constant range */
+    if (boundPipelineLayout_ == VK_NULL_HANDLE || location < 0)
+        return;
+
+    const auto offset = static_cast<std::uint32_t>(location);
+
+    /* Offset and data size must be a multiple of 4 bytes and fit into the push constant range */
+    if (dataSize == 0 || dataSize % 4 != 0 || offset % 4 != 0)
+        return;
+    if (offset >= VKPipelineLayout::pushConstantRangeSize || dataSize > VKPipelineLayout::pushConstantRangeSize - offset)
+        return;
+
+    vkCmdPushConstants(commandBuffer_, boundPipelineLayout_, VK_SHADER_STAGE_ALL, offset, dataSize, data);
 }
 
 /* ----- Queries ----- */
@@ -885,52 +1028,62 @@ void VKCommandBuffer::EndStreamOutput()
 
 void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    FlushPipelineBarrier();
     vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    FlushPipelineBarrier();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    FlushPipelineBarrier();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    FlushPipelineBarrier();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    FlushPipelineBarrier();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    FlushPipelineBarrier();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    FlushPipelineBarrier();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    FlushPipelineBarrier();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushPipelineBarrier();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    FlushPipelineBarrier();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -949,12 +1102,14 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushPipelineBarrier();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    FlushPipelineBarrier();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -975,11 +1130,13 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    FlushPipelineBarrier();
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushPipelineBarrier();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
@@ -1053,32 +1210,6 @@ void VKCommandBuffer::CreateCommandBuffers(std::uint32_t bufferCount)
     VKThrowIfFailed(result, "failed to allocate Vulkan command buffers");
 }
 
-void VKCommandBuffer::CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences)
-{
-    recordingFenceList_.reserve(numFences);
-
-    VkFenceCreateInfo createInfo;
-    {
-        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-    }
-
-    for (std::uint32_t i = 0; i < numFences; ++i)
-    {
-        VKPtr<VkFence> fence{ device_, vkDestroyFence };
-        {
-            /* Create fence for command buffer recording */
-            auto result = vkCreateFence(device_, &createInfo, nullptr, fence.ReleaseAndGetAddressOf());
-            VKThrowIfFailed(result, "failed to create Vulkan fence");
-
-            /* Initial fence signal */
-            vkQueueSubmit(commandQueue, 0, nullptr, fence);
-        }
-        recordingFenceList_.emplace_back(std::move(fence));
-    }
-}
-
 void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
 {
     if (numAttachments > 0)
@@ -1173,6 +1304,7 @@ void VKCommandBuffer::ResumeRenderPass()
         beginInfo.clearValueCount   = 0;
         beginInfo.pClearValues      = nullptr;
     }
+    FlushPipelineBarrier();
     vkCmdBeginRenderPass(commandBuffer_, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
 }
 
@@ -1190,26 +1322,107 @@ void VKCommandBuffer::BufferPipelineBarrier(
     VkPipelineStageFlags    srcStageMask,
     VkPipelineStageFlags    dstStageMask)
 {
-    VkBufferMemoryBarrier barrier;
+    pendingBarrier_.InsertBufferBarrier(buffer, offset, size, srcAccessMask, dstAccessMask, srcStageMask, dstStageMask);
+}
+
+void VKCommandBuffer::ImagePipelineBarrier(
+    VkImage                         image,
+    const VkImageSubresourceLayers& subresource,
+    VkImageLayout                   layout,
+    VkAccessFlags                   srcAccessMask,
+    VkAccessFlags                   dstAccessMask,
+    VkPipelineStageFlags            srcStageMask,
+    VkPipelineStageFlags            dstStageMask)
+{
+    VkImageSubresourceRange subresourceRange;
     {
-        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-        barrier.pNext               = nullptr;
-        barrier.srcAccessMask       = srcAccessMask;
-        barrier.dstAccessMask       = dstAccessMask;
-        barrier.srcQueueFamilyIndex = 0;
-        barrier.dstQueueFamilyIndex = 0;
-        barrier.buffer              = buffer;
-        barrier.offset              = offset;
-        barrier.size                = size;
+        subresourceRange.aspectMask     = subresource.aspectMask;
+        subresourceRange.baseMipLevel   = subresource.mipLevel;
+        subresourceRange.levelCount     = 1;
+        subresourceRange.baseArrayLayer = subresource.baseArrayLayer;
+        subresourceRange.layerCount     = subresource.layerCount;
     }
-    vkCmdPipelineBarrier(commandBuffer_, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    pendingBarrier_.InsertImageBarrier(image, subresourceRange, layout, layout, srcAccessMask, dstAccessMask, srcStageMask, dstStageMask);
+}
+
+void VKCommandBuffer::FlushPipelineBarrier()
+{
+    FlushBufferCopies();
+    if (pendingBarrier_.IsEnabled())
+    {
+        pendingBarrier_.Submit(commandBuffer_);
+        pendingBarrier_.Reset();
+    }
+}
+
+void VKCommandBuffer::AppendBufferCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& region)
+{
+    /* Batch region with pending copy command if it uses the same buffers and its destination range does not overlap */
+    if (!pendingCopyRegions_.empty() && srcBuffer == pendingCopySrcBuffer_ && dstBuffer == pendingCopyDstBuffer_)
+    {
+        auto it = std::find_if(
+            pendingCopyRegions_.begin(),
+            pendingCopyRegions_.end(),
+            [&region](const VkBufferCopy& pendingRegion)
+            {
+                return IsBufferCopyDstOverlapping(pendingRegion, region);
+            }
+        );
+        if (it == pendingCopyRegions_.end())
+        {
+            /* Merge with previous region if both source and destination ranges are contiguous */
+            auto& lastRegion = pendingCopyRegions_.back();
+            if (lastRegion.srcOffset + lastRegion.size == region.srcOffset &&
+                lastRegion.dstOffset + lastRegion.size == region.dstOffset)
+            {
+                lastRegion.size += region.size;
+            }
+            else
+                pendingCopyRegions_.push_back(region);
+            return;
+        }
+    }
+
+    /* Record previous copy command and flush barriers the new copy command depends on */
+    FlushPipelineBarrierForBuffer(dstBuffer);
+    FlushBufferCopies();
+
+    pendingCopySrcBuffer_ = srcBuffer;
+    pendingCopyDstBuffer_ = dstBuffer;
+    pendingCopyRegions_.push_back(region);
+}
+
+void VKCommandBuffer::FlushBufferCopies()
+{
+    if (!pendingCopyRegions_.empty())
+    {
+        vkCmdCopyBuffer(
+            commandBuffer_,
+            pendingCopySrcBuffer_,
+            pendingCopyDstBuffer_,
+            static_cast<std::uint32_t>(pendingCopyRegions_.size()),
+            pendingCopyRegions_.data()
+        );
+        pendingCopyRegions_.clear();
+    }
+}
+
+void VKCommandBuffer::FlushPipelineBarrierForBuffer(VkBuffer buffer)
+{
+    if (pendingBarrier_.ContainsBuffer(buffer))
+        FlushPipelineBarrier();
+}
+
+void VKCommandBuffer::FlushPipelineBarrierForImage(VkImage image)
+{
+    if (pendingBarrier_.ContainsImage(image))
+        FlushPipelineBarrier();
 }
 
 void VKCommandBuffer::AcquireNextBuffer()
 {
     commandBufferIndex_ = (commandBufferIndex_ + 1) % commandBufferList_.size();
     commandBuffer_      = commandBufferList_[commandBufferIndex_];
-    recordingFence_     = recordingFenceList_[commandBufferIndex_].Get();
 }
 
 void VKCommandBuffer::ResetQueryPoolsInFlight()
@@ -13,6 +13,8 @@
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "RenderState/VKPipelineBarrier.h"
+#include "Buffer/VKStagingBufferPool.h"
 
 #include <vector>
 
@@ -23,6 +25,8 @@ namespace LLGL
 
 class VKDevice;
 class VKPhysicalDevice;
+class VKCommandQueue;
+class VKDeviceMemoryManager;
 class VKResourceHeap;
 class VKRenderPass;
 class VKQueryHeap;
@@ -37,7 +41,8 @@ class VKCommandBuffer final : public CommandBuffer
         VKCommandBuffer(
             const VKPhysicalDevice&         physicalDevice,
             VKDevice&                       device,
-            VkQueue                         commandQueue,
+            VKCommandQueue&                 commandQueue,
+            VKDeviceMemoryManager&          deviceMemoryMngr,
             const QueueFamilyIndices&       queueFamilyIndices,
             const CommandBufferDescriptor&  desc
         );
@@ -56,7 +61,7 @@ class VKCommandBuffer final : public CommandBuffer
             Buffer&         dstBuffer,
             std::uint64_t   dstOffset,
             const void*     data,
-            std::uint16_t   dataSize
+            std::uint64_t   dataSize
         ) override;
 
         void CopyBuffer(
@@ -127,6 +132,13 @@ class VKCommandBuffer final : public CommandBuffer
             const PipelineBindPoint bindPoint       = PipelineBindPoint::Undefined
         ) override;
 
+        void SetResourceHeap(
+            ResourceHeap&                   resourceHeap,
+            std::uint32_t                   firstSet,
+            const PipelineBindPoint         bindPoint,
+            const ArrayView<std::uint32_t>& dynamicOffsets
+        ) override;
+
         void SetResource(
             Resource&       resource,
             std::uint32_t   slot,
@@ -232,10 +244,10 @@ class VKCommandBuffer final : public CommandBuffer
             return commandBuffer_;
         }
 
-        // Returns the fence used to submit the command buffer to the queue.
-        inline VkFence GetQueueSubmitFence() const
+        // Stores the ID of the queue submission the current native command buffer has been enqueued to. See VKCommandQueue::EnqueueCommandBuffer.
+        inline void SetSubmissionID(std::uint64_t submissionID)
         {
-            return recordingFence_;
+            submissionIDList_[commandBufferIndex_] = submissionID;
         }
 
         // Returns true if this is an immediate command buffer, otherwise it is a deferred command buffer.
@@ -258,7 +270,6 @@ class VKCommandBuffer final : public CommandBuffer
 
         void CreateCommandPool(std::uint32_t queueFamilyIndex);
         void CreateCommandBuffers(std::uint32_t bufferCount);
-        void CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
@@ -275,8 +286,23 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool IsInsideRenderPass() const;
 
-        void BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet);
+        void BindResourceHeap(
+            VKResourceHeap&         resourceHeapVK,
+            VkPipelineBindPoint     bindingPoint,
+            std::uint32_t           firstSet,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets
+        );
+
+        void BindResourceHeapToBindPoints(
+            VKResourceHeap&         resourceHeapVK,
+            std::uint32_t           firstSet,
+            const PipelineBindPoint bindPoint,
+            std::uint32_t           numDynamicOffsets,
+            const std::uint32_t*    dynamicOffsets
+        );
 
+        // Inserts a buffer memory barrier into the pending pipeline barrier.
         void BufferPipelineBarrier(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -287,6 +313,32 @@ class VKCommandBuffer final : public CommandBuffer
             VkPipelineStageFlags    dstStageMask    = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
         );
 
+        // Inserts an image memory barrier without layout transition into the pending pipeline barrier.
+        void ImagePipelineBarrier(
+            VkImage                         image,
+            const VkImageSubresourceLayers& subresource,
+            VkImageLayout                   layout,
+            VkAccessFlags                   srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT,
+            VkAccessFlags                   dstAccessMask   = VK_ACCESS_SHADER_READ_BIT,
+            VkPipelineStageFlags            srcStageMask    = VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VkPipelineStageFlags            dstStageMask    = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+        );
+
+        // Records all pending barriers as a single pipeline barrier command. Called before draw and dispatch commands and before a render pass begins.
+        void FlushPipelineBarrier();
+
+        // Appends a copy region from the staging buffer pool to the pending buffer copy command.
+        void AppendBufferCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& region);
+
+        // Records all pending buffer copy regions as a single copy command. Called before the pending barriers are recorded.
+        void FlushBufferCopies();
+
+        // Flushes the pending barriers if the specified buffer has a pending barrier the next transfer command depends on.
+        void FlushPipelineBarrierForBuffer(VkBuffer buffer);
+
+        // Flushes the pending barriers if the specified image has a pending barrier the next transfer command depends on.
+        void FlushPipelineBarrierForImage(VkImage image);
+
         // Acquires the next native VkCommandBuffer object.
         void AcquireNextBuffer();
 
@@ -299,7 +351,7 @@ class VKCommandBuffer final : public CommandBuffer
 
         VKDevice&                       device_;
 
-        VkQueue                         commandQueue_               = VK_NULL_HANDLE;
+        VKCommandQueue&                 commandQueue_;
 
         VKPtr<VkCommandPool>            commandPool_;
 
@@ -307,8 +359,7 @@ class VKCommandBuffer final : public CommandBuffer
         VkCommandBuffer                 commandBuffer_;
         std::size_t                     commandBufferIndex_         = 0;
 
-        std::vector<VKPtr<VkFence>>     recordingFenceList_;
-        VkFence                         recordingFence_;
+        std::vector<std::uint64_t>      submissionIDList_;
 
         RecordState                     recordState_                = RecordState::Undefined;
 
@@ -328,8 +379,17 @@ class VKCommandBuffer final : public CommandBuffer
         bool                            scissorEnabled_             = false;
         bool                            scissorRectInvalidated_     = true;
 
+        VkPipelineLayout                boundPipelineLayout_        = VK_NULL_HANDLE; // pipeline layout of the last bound PSO for push constants
+
         std::uint32_t                   maxDrawIndirectCount_       = 0;
 
+        VKPipelineBarrier               pendingBarrier_;            // Barriers accumulated since the last flush.
+
+        std::vector<VKStagingBufferPool>    stagingBufferPools_;        // Upload memory for "UpdateBuffer", one pool per native command buffer.
+        VkBuffer                            pendingCopySrcBuffer_   = VK_NULL_HANDLE;
+        VkBuffer                            pendingCopyDstBuffer_   = VK_NULL_HANDLE;
+        std::vector<VkBufferCopy>           pendingCopyRegions_;        // Copy regions accumulated by consecutive "UpdateBuffer" commands.
+
         #if 1//TODO: optimize usage of query pools
         std::vector<VKQueryHeap*>       queryHeapsInFlight_;
         std::size_t                     numQueryHeapsInFlight_      = 0;
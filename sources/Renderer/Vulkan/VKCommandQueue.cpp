@@ -7,37 +7,27 @@
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
+#include "VKDevice.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
 #include "../CheckedCast.h"
 #include "VKCore.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence)
-{
-    VkSubmitInfo submitInfo;
-    {
-        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.pNext                = nullptr;
-        submitInfo.waitSemaphoreCount   = 0;
-        submitInfo.pWaitSemaphores      = nullptr;
-        submitInfo.pWaitDstStageMask    = 0;
-        submitInfo.commandBufferCount   = 1;
-        submitInfo.pCommandBuffers      = &commandBuffer;
-        submitInfo.signalSemaphoreCount = 0;
-        submitInfo.pSignalSemaphores    = nullptr;
-    }
-    return vkQueueSubmit(commandQueue, 1, &submitInfo, fence);
-}
+// Number of fences that guard flushed submissions. Flushing a submission waits for the one that was flushed this many submissions ago.
+static const std::size_t g_numSubmissionFences = 16;
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(VKDevice& device, VkQueue queue) :
+    device_             { device                     },
+    native_             { queue                      },
+    uploadCommandPool_  { device.CreateCommandPool() }
 {
+    CreateSubmissionFences(device);
 }
 
 /* ----- Command Buffers ----- */
@@ -46,14 +36,15 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferVK = LLGL_CAST(VKCommandBuffer&, commandBuffer);
     if (!commandBufferVK.IsImmediateCmdBuffer())
-    {
-        auto result = VKSubmitCommandBuffer(
-            native_,
-            commandBufferVK.GetVkCommandBuffer(),
-            commandBufferVK.GetQueueSubmitFence()
-        );
-        VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
-    }
+        EnqueueCommandBuffer(commandBufferVK);
+}
+
+void VKCommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Append all command buffers to the pending submission and flush them at once */
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        Submit(*commandBuffers[i]);
+    FlushSubmissions();
 }
 
 /* ----- Queries ----- */
@@ -67,6 +58,9 @@ bool VKCommandQueue::QueryResult(
 {
     auto& queryHeapVK = LLGL_CAST(VKQueryHeap&, queryHeap);
 
+    /* Queries cannot become available while the command buffers they were recorded in are still pending */
+    FlushSubmissions();
+
     /* Store result directly into output parameter */
     auto stateResult = GetQueryResults(queryHeapVK, firstQuery, numQueries, data, dataSize);
     if (stateResult == VK_NOT_READY)
@@ -102,6 +96,9 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryP
 
 void VKCommandQueue::Submit(Fence& fence)
 {
+    /* Flush pending command buffers, so the fence is signaled after they have been completed */
+    FlushSubmissions();
+
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
     fenceVK.Reset(device_);
     vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
@@ -115,7 +112,133 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void VKCommandQueue::WaitIdle()
 {
+    FlushSubmissions();
     vkQueueWaitIdle(native_);
+    completedSubmissionID_ = nextSubmissionID_ - 1;
+}
+
+/* ----- Internals ----- */
+
+void VKCommandQueue::EnqueueCommandBuffer(VKCommandBuffer& commandBufferVK)
+{
+    /* Upload commands that have been recorded so far must be executed before this command buffer */
+    EnqueueUploadCommandBuffer();
+
+    /* Command buffer will be part of the next flushed submission */
+    commandBufferVK.SetSubmissionID(nextSubmissionID_);
+    pendingCmdBuffers_.push_back(commandBufferVK.GetVkCommandBuffer());
+}
+
+void VKCommandQueue::FlushSubmissions()
+{
+    EnqueueUploadCommandBuffer();
+
+    if (pendingCmdBuffers_.empty())
+        return;
+
+    /* Wait until the fence slot for this submission has been released by its previous submission */
+    auto& submissionFence = submissionFences_[nextSubmissionID_ % g_numSubmissionFences];
+    WaitSubmissionFence(submissionFence);
+    vkResetFences(device_, 1, &submissionFence.fence);
+
+    /* Submit all pending command buffers with a single submit info and a single fence */
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = nullptr;
+        submitInfo.waitSemaphoreCount   = 0;
+        submitInfo.pWaitSemaphores      = nullptr;
+        submitInfo.pWaitDstStageMask    = 0;
+        submitInfo.commandBufferCount   = static_cast<std::uint32_t>(pendingCmdBuffers_.size());
+        submitInfo.pCommandBuffers      = pendingCmdBuffers_.data();
+        submitInfo.signalSemaphoreCount = 0;
+        submitInfo.pSignalSemaphores    = nullptr;
+    }
+    auto result = vkQueueSubmit(native_, 1, &submitInfo, submissionFence.fence);
+    VKThrowIfFailed(result, "failed to submit command buffers to Vulkan graphics queue");
+
+    submissionFence.submissionID = nextSubmissionID_++;
+    pendingCmdBuffers_.clear();
+}
+
+void VKCommandQueue::WaitSubmission(std::uint64_t submissionID)
+{
+    if (submissionID <= completedSubmissionID_)
+        return;
+
+    /* Submission might still be pending */
+    if (submissionID >= nextSubmissionID_)
+        FlushSubmissions();
+
+    WaitSubmissionFence(submissionFences_[submissionID % g_numSubmissionFences]);
+}
+
+bool VKCommandQueue::IsSubmissionCompleted(std::uint64_t submissionID)
+{
+    if (submissionID <= completedSubmissionID_)
+        return true;
+    if (submissionID >= nextSubmissionID_)
+        return false;
+
+    /* Fences are signaled in submission order, so all previous submissions have been completed as well */
+    auto& submissionFence = submissionFences_[submissionID % g_numSubmissionFences];
+    if (vkGetFenceStatus(device_, submissionFence.fence) == VK_SUCCESS)
+    {
+        completedSubmissionID_ = std::max(completedSubmissionID_, submissionFence.submissionID);
+        return (submissionID <= completedSubmissionID_);
+    }
+
+    return false;
+}
+
+VkCommandBuffer VKCommandQueue::GetUploadCommandBuffer()
+{
+    if (uploadCmdBuffer_ != VK_NULL_HANDLE)
+        return uploadCmdBuffer_;
+
+    /* Reuse an upload command buffer whose submission has been completed, or allocate a new one */
+    for (auto it = uploadCmdBuffersInFlight_.begin(); it != uploadCmdBuffersInFlight_.end(); ++it)
+    {
+        if (IsSubmissionCompleted(it->first))
+        {
+            uploadCmdBuffer_ = it->second;
+            uploadCmdBuffersInFlight_.erase(it);
+            vkResetCommandBuffer(uploadCmdBuffer_, 0);
+            break;
+        }
+    }
+
+    if (uploadCmdBuffer_ == VK_NULL_HANDLE)
+    {
+        VkCommandBufferAllocateInfo allocInfo;
+        {
+            allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.pNext                 = nullptr;
+            allocInfo.commandPool           = uploadCommandPool_;
+            allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount    = 1;
+        }
+        auto result = vkAllocateCommandBuffers(device_, &allocInfo, &uploadCmdBuffer_);
+        VKThrowIfFailed(result, "failed to allocate Vulkan upload command buffer");
+    }
+
+    /* Begin recording of upload command buffer */
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo  = nullptr;
+    }
+    auto result = vkBeginCommandBuffer(uploadCmdBuffer_, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin recording Vulkan upload command buffer");
+
+    return uploadCmdBuffer_;
+}
+
+std::uint64_t VKCommandQueue::GetUploadSubmissionID() const
+{
+    return (uploadCmdBuffer_ != VK_NULL_HANDLE ? nextSubmissionID_ : uploadSubmissionID_);
 }
 
 
@@ -123,6 +246,73 @@ void VKCommandQueue::WaitIdle()
  * ======= Private: =======
  */
 
+VKCommandQueue::SubmissionFence::SubmissionFence(const VKPtr<VkDevice>& device) :
+    fence { device, vkDestroyFence }
+{
+}
+
+void VKCommandQueue::CreateSubmissionFences(const VKPtr<VkDevice>& device)
+{
+    VkFenceCreateInfo createInfo;
+    {
+        createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+    }
+
+    submissionFences_.reserve(g_numSubmissionFences);
+    for (std::size_t i = 0; i < g_numSubmissionFences; ++i)
+    {
+        SubmissionFence submissionFence{ device };
+        auto result = vkCreateFence(device, &createInfo, nullptr, submissionFence.fence.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
+        submissionFences_.emplace_back(std::move(submissionFence));
+    }
+}
+
+void VKCommandQueue::EnqueueUploadCommandBuffer()
+{
+    if (uploadCmdBuffer_ == VK_NULL_HANDLE)
+        return;
+
+    /* Make all transfer writes visible to subsequent command buffers, which have not been synchronized with a fence wait since */
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    }
+    vkCmdPipelineBarrier(
+        uploadCmdBuffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+
+    auto result = vkEndCommandBuffer(uploadCmdBuffer_);
+    VKThrowIfFailed(result, "failed to end recording Vulkan upload command buffer");
+
+    /* Upload command buffer will be part of the next flushed submission */
+    uploadSubmissionID_ = nextSubmissionID_;
+    pendingCmdBuffers_.push_back(uploadCmdBuffer_);
+    uploadCmdBuffersInFlight_.push_back({ uploadSubmissionID_, uploadCmdBuffer_ });
+    uploadCmdBuffer_ = VK_NULL_HANDLE;
+}
+
+void VKCommandQueue::WaitSubmissionFence(SubmissionFence& submissionFence)
+{
+    if (submissionFence.submissionID > completedSubmissionID_)
+    {
+        /* Fences are signaled in submission order, so all previous submissions have been completed as well */
+        vkWaitForFences(device_, 1, &submissionFence.fence, VK_TRUE, UINT64_MAX);
+        completedSubmissionID_ = submissionFence.submissionID;
+    }
+}
+
 VkResult VKCommandQueue::GetQueryResults(
     VKQueryHeap&    queryHeapVK,
     std::uint32_t   firstQuery,
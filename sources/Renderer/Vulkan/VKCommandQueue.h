@@ -14,17 +14,18 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "RenderState/VKFence.h"
+#include <vector>
+#include <utility>
 
 
 namespace LLGL
 {
 
 
+class VKDevice;
+class VKCommandBuffer;
 class VKQueryHeap;
 
-// Helper function to submit the specified Vulkan command buffer to a command queue.
-VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence);
-
 class VKCommandQueue final : public CommandQueue
 {
 
@@ -32,11 +33,12 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue);
+        VKCommandQueue(VKDevice& device, VkQueue queue);
 
         /* ----- Command Buffers ----- */
 
         void Submit(CommandBuffer& commandBuffer) override;
+        void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers) override;
 
         /* ----- Queries ----- */
 
@@ -49,8 +51,57 @@ class VKCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+    public:
+
+        /* ----- Internals ----- */
+
+        // Appends the specified command buffer to the pending submission. It is not submitted to the GPU queue before the next flush.
+        void EnqueueCommandBuffer(VKCommandBuffer& commandBufferVK);
+
+        // Submits all pending command buffers to the GPU queue with a single call to vkQueueSubmit.
+        void FlushSubmissions();
+
+        // Blocks until the GPU queue has completed the specified submission. Pending command buffers are flushed if necessary.
+        void WaitSubmission(std::uint64_t submissionID);
+
+        // Returns true if the GPU queue has completed the specified submission. This does not block.
+        bool IsSubmissionCompleted(std::uint64_t submissionID);
+
+        /*
+        Returns the shared command buffer for one-shot operations such as resource uploads, and begins recording if necessary.
+        It is recorded until the next command buffer is enqueued or the pending command buffers are flushed, so that it is submitted in bulk with them.
+        */
+        VkCommandBuffer GetUploadCommandBuffer();
+
+        // Returns the ID of the latest submission that contains upload commands, including the upload command buffer that is currently recorded.
+        std::uint64_t GetUploadSubmissionID() const;
+
+        // Returns the native VkQueue handle.
+        inline VkQueue GetVkQueue() const
+        {
+            return native_;
+        }
+
+    private:
+
+        // Fence that guards a single flushed submission.
+        struct SubmissionFence
+        {
+            SubmissionFence(const VKPtr<VkDevice>& device);
+
+            VKPtr<VkFence>  fence;
+            std::uint64_t   submissionID = 0;
+        };
+
     private:
 
+        void CreateSubmissionFences(const VKPtr<VkDevice>& device);
+
+        // Ends the upload command buffer if it is being recorded and appends it to the pending submission.
+        void EnqueueUploadCommandBuffer();
+
+        void WaitSubmissionFence(SubmissionFence& submissionFence);
+
         VkResult GetQueryResults(
             VKQueryHeap&    queryHeapVK,
             std::uint32_t   firstQuery,
@@ -79,8 +130,19 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        VkDevice                        device_;
+        VkQueue                         native_                 = VK_NULL_HANDLE;
+
+        std::vector<VkCommandBuffer>    pendingCmdBuffers_;
+        std::vector<SubmissionFence>    submissionFences_;
+        std::uint64_t                   nextSubmissionID_       = 1;
+        std::uint64_t                   completedSubmissionID_  = 0;
+
+        VKPtr<VkCommandPool>            uploadCommandPool_;
+        VkCommandBuffer                 uploadCmdBuffer_        = VK_NULL_HANDLE;   // Upload command buffer that is currently recorded.
+        std::vector<std::pair<std::uint64_t, VkCommandBuffer>>
+                                        uploadCmdBuffersInFlight_;                  // Enqueued upload command buffers and their submission IDs.
+        std::uint64_t                   uploadSubmissionID_     = 0;
 
 };
 
@@ -6,12 +6,14 @@
  */
 
 #include "VKDevice.h"
+#include "VKCommandQueue.h"
 #include "VKTypes.h"
 #include "RenderState/VKFence.h"
 #include "Buffer/VKBuffer.h"
 #include "Texture/VKTexture.h"
 #include "Memory/VKDeviceMemoryRegion.h"
 #include "Memory/VKDeviceMemory.h"
+#include "../../Core/Assertion.h"
 #include <set>
 #include <algorithm>
 #include <string.h>
@@ -34,7 +36,8 @@ VKDevice::VKDevice(VKDevice&& device) :
     device_             { std::move(device.device_)      },
     queueFamilyIndices_ { device.queueFamilyIndices_     },
     graphicsQueue_      { device.graphicsQueue_          },
-    commandPool_        { std::move(device.commandPool_) }
+    commandPool_        { std::move(device.commandPool_) },
+    commandQueue_       { device.commandQueue_           }
 {
 }
 
@@ -44,6 +47,7 @@ VKDevice& VKDevice::operator = (VKDevice&& device)
     queueFamilyIndices_ = device.queueFamilyIndices_;
     graphicsQueue_      = device.graphicsQueue_;
     commandPool_        = std::move(device.commandPool_);
+    commandQueue_       = device.commandQueue_;
     return *this;
 }
 
@@ -162,6 +166,10 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
     auto result = vkEndCommandBuffer(cmdBuffer);
     VKThrowIfFailed(result, "failed to end recording Vulkan command buffer");
 
+    /* Submit pending command buffers first to preserve the order of submissions */
+    if (commandQueue_ != nullptr)
+        commandQueue_->FlushSubmissions();
+
     /* Create fence to ensure the command buffer has finished execution */
     {
         VKFence fence{ device_ };
@@ -184,6 +192,37 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
         vkFreeCommandBuffers(device_, commandPool_, 1, &cmdBuffer);
 }
 
+void VKDevice::SetCommandQueue(VKCommandQueue* commandQueue)
+{
+    commandQueue_ = commandQueue;
+}
+
+/* ----- Uploads ----- */
+
+VkCommandBuffer VKDevice::GetUploadCommandBuffer()
+{
+    LLGL_ASSERT_PTR(commandQueue_);
+    return commandQueue_->GetUploadCommandBuffer();
+}
+
+std::uint64_t VKDevice::GetUploadSubmissionID() const
+{
+    LLGL_ASSERT_PTR(commandQueue_);
+    return commandQueue_->GetUploadSubmissionID();
+}
+
+void VKDevice::WaitSubmission(std::uint64_t submissionID)
+{
+    LLGL_ASSERT_PTR(commandQueue_);
+    commandQueue_->WaitSubmission(submissionID);
+}
+
+bool VKDevice::IsSubmissionCompleted(std::uint64_t submissionID)
+{
+    LLGL_ASSERT_PTR(commandQueue_);
+    return commandQueue_->IsSubmissionCompleted(submissionID);
+}
+
 // Returns the image aspect for the specified Vulkan format
 static VkImageAspectFlags GetImageAspectForVkFormat(VkFormat format)
 {
@@ -22,6 +22,7 @@ namespace LLGL
 
 class VKBuffer;
 class VKTexture;
+class VKCommandQueue;
 
 class VKDevice
 {
@@ -54,6 +55,27 @@ class VKDevice
         VkCommandBuffer AllocCommandBuffer(bool begin = true);
         void FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release = true);
 
+        // Sets the command queue whose pending submissions are flushed before a one-shot command buffer is submitted (see FlushCommandBuffer).
+        void SetCommandQueue(VKCommandQueue* commandQueue);
+
+        /* ----- Uploads ----- */
+
+        /*
+        Returns the shared command buffer of the command queue for one-shot operations the CPU does not wait for, e.g. initial resource uploads.
+        Its commands are submitted in bulk together with the next command buffers that are submitted to the queue (see VKCommandQueue::GetUploadCommandBuffer).
+        The command queue must have been set with SetCommandQueue before any of the upload functions is called.
+        */
+        VkCommandBuffer GetUploadCommandBuffer();
+
+        // Returns the ID of the latest queue submission that contains upload commands.
+        std::uint64_t GetUploadSubmissionID() const;
+
+        // Blocks until the specified queue submission has been completed.
+        void WaitSubmission(std::uint64_t submissionID);
+
+        // Returns true if the specified queue submission has been completed. This does not block.
+        bool IsSubmissionCompleted(std::uint64_t submissionID);
+
         /* ----- Buffer/Image operatons ----- */
 
         void TransitionImageLayout(
@@ -74,6 +96,7 @@ class VKDevice
             VkDeviceSize    dstOffset = 0
         );
 
+        // Copies the source buffer into the destination buffer with a one-shot command buffer and blocks until the copy has been completed.
         void CopyBuffer(
             VkBuffer        srcBuffer,
             VkBuffer        dstBuffer,
@@ -181,6 +204,7 @@ class VKDevice
         QueueFamilyIndices      queueFamilyIndices_;
         VkQueue                 graphicsQueue_      = VK_NULL_HANDLE;
         VKPtr<VkCommandPool>    commandPool_;
+        VKCommandQueue*         commandQueue_       = nullptr;
 
 };
 
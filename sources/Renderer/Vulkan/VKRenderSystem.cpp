@@ -18,6 +18,7 @@
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "VKInitializers.h"
+#include "VKSerialization.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "RenderState/VKComputePSO.h"
 #include <LLGL/Log.h>
@@ -59,9 +60,11 @@ static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 /* ----- Common ----- */
 
 VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    instance_              { vkDestroyInstance                        },
-    debugReportCallback_   { instance_, DestroyDebugReportCallbackEXT },
-    defaultPipelineLayout_ { device_, vkDestroyPipelineLayout         }
+    instance_                { vkDestroyInstance                        },
+    debugReportCallback_     { instance_, DestroyDebugReportCallbackEXT },
+    defaultPipelineLayout_   { device_, vkDestroyPipelineLayout         },
+    pipelineCache_           { device_, vkDestroyPipelineCache          },
+    descriptorPoolAllocator_ { device_                                  }
 {
     /* Extract optional renderer configuartion */
     auto rendererConfigVK = GetRendererConfiguration<RendererConfigurationVulkan>(renderSystemDesc);
@@ -77,6 +80,7 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
 
     /* Create default resources */
     CreateDefaultPipelineLayout();
+    CreatePipelineCache();
 
     /* Create device memory manager */
     deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
@@ -89,7 +93,13 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
 
 VKRenderSystem::~VKRenderSystem()
 {
+    WaitForPipelineThreadPool();
+    device_.SetCommandQueue(nullptr);
     device_.WaitIdle();
+
+    /* Release staging buffers of upload submissions after the device has become idle */
+    for (auto& stagingBuffer : stagingBuffersInFlight_)
+        stagingBuffer.second.ReleaseMemoryRegion(*deviceMemoryMngr_);
 }
 
 /* ----- Swap-chain ----- */
@@ -98,7 +108,7 @@ SwapChain* VKRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChainD
 {
     return TakeOwnership(
         swapChains_,
-        MakeUnique<VKSwapChain>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, swapChainDesc, surface)
+        MakeUnique<VKSwapChain>(instance_, physicalDevice_, device_, *commandQueue_, *deviceMemoryMngr_, swapChainDesc, surface)
     );
 }
 
@@ -120,7 +130,7 @@ CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
 {
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), commandBufferDesc)
+        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, *commandQueue_, *deviceMemoryMngr_, device_.GetQueueFamilyIndices(), commandBufferDesc)
     );
 }
 
@@ -155,18 +165,23 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const v
     );
     buffer->BindMemoryRegion(device_, memoryRegion);
 
-    /* Copy staging buffer into hardware buffer */
-    device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(bufferDesc.size));
-
     if (bufferDesc.cpuAccessFlags != 0 || (bufferDesc.miscFlags & MiscFlags::DynamicUsage) != 0)
     {
-        /* Store ownership of staging buffer */
+        /* Store ownership of staging buffer, then copy it into hardware buffer */
         buffer->TakeStagingBuffer(std::move(stagingBuffer));
+        buffer->UploadStagingBuffer(device_, 0, static_cast<VkDeviceSize>(bufferDesc.size));
     }
     else
     {
-        /* Release staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Copy staging buffer into hardware buffer, then release staging buffer once the copy has been completed */
+        device_.CopyBuffer(
+            device_.GetUploadCommandBuffer(),
+            stagingBuffer.GetVkBuffer(),
+            buffer->GetVkBuffer(),
+            static_cast<VkDeviceSize>(bufferDesc.size)
+        );
+        buffer->SetUploadSubmissionID(device_.GetUploadSubmissionID());
+        ReleaseStagingBufferDeferred(std::move(stagingBuffer));
     }
 
     return buffer;
@@ -180,8 +195,12 @@ BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void VKRenderSystem::Release(Buffer& buffer)
 {
-    /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+
+    /* Wait only if an upload into this buffer is still pending */
+    WaitPendingUpload(bufferVK.GetUploadSubmissionID());
+
+    /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     RemoveFromUniqueSet(buffers_, &buffer);
@@ -198,11 +217,12 @@ void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const voi
 
     if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
-        /* Copy input data to staging buffer memory */
+        /* Copy input data to staging buffer memory once the GPU no longer reads from it */
+        bufferVK.WaitStagingBuffer(device_);
         device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, offset);
 
         /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), dataSize, offset, offset);
+        bufferVK.UploadStagingBuffer(device_, offset, dataSize);
     }
     else
     {
@@ -217,10 +237,11 @@ void VKRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const voi
         auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, data, dataSize);
 
         /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, offset);
+        device_.CopyBuffer(device_.GetUploadCommandBuffer(), stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, offset);
+        bufferVK.SetUploadSubmissionID(device_.GetUploadSubmissionID());
 
-        /* Release device memory region of staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Release device memory region of staging buffer once the copy has been completed */
+        ReleaseStagingBufferDeferred(std::move(stagingBuffer));
     }
 }
 
@@ -347,8 +368,8 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     /* Create device texture */
     auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state; the CPU does not wait for these commands */
+    auto cmdBuffer = device_.GetUploadCommandBuffer();
     {
         const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
 
@@ -392,10 +413,10 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             );
         }
     }
-    device_.FlushCommandBuffer(cmdBuffer);
+    textureVK->SetUploadSubmissionID(device_.GetUploadSubmissionID());
 
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    /* Release staging buffer once the upload has been completed */
+    ReleaseStagingBufferDeferred(std::move(stagingBuffer));
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -405,8 +426,12 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
 void VKRenderSystem::Release(Texture& texture)
 {
-    /* Release device memory region, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    /* Wait only if an upload into this texture is still pending */
+    WaitPendingUpload(textureVK.GetUploadSubmissionID());
+
+    /* Release device memory region, then release texture object */
     deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
     RemoveFromUniqueSet(textures_, &texture);
 }
@@ -466,8 +491,8 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
 
     auto stagingBuffer = CreateStagingBufferAndInitialize(stagingCreateInfo, imageData, imageDataSize);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state; the CPU does not wait for these commands */
+    auto cmdBuffer = device_.GetUploadCommandBuffer();
     {
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -497,10 +522,10 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
             subresource
         );
     }
-    device_.FlushCommandBuffer(cmdBuffer);
+    textureVK.SetUploadSubmissionID(device_.GetUploadSubmissionID());
 
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    /* Release staging buffer once the upload has been completed */
+    ReleaseStagingBufferDeferred(std::move(stagingBuffer));
 }
 
 void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -587,7 +612,7 @@ void VKRenderSystem::Release(Sampler& sampler)
 
 ResourceHeap* VKRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& resourceHeapDesc)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, resourceHeapDesc));
+    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, descriptorPoolAllocator_, resourceHeapDesc));
 }
 
 void VKRenderSystem::Release(ResourceHeap& resourceHeap)
@@ -595,6 +620,12 @@ void VKRenderSystem::Release(ResourceHeap& resourceHeap)
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
+std::uint32_t VKRenderSystem::WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews)
+{
+    auto& resourceHeapVK = LLGL_CAST(VKResourceHeap&, resourceHeap);
+    return resourceHeapVK.WriteResourceViews(device_, firstDescriptor, resourceViews);
+}
+
 /* ----- Render Passes ----- */
 
 RenderPass* VKRenderSystem::CreateRenderPass(const RenderPassDescriptor& renderPassDesc)
@@ -644,17 +675,100 @@ PipelineLayout* VKRenderSystem::CreatePipelineLayout(const PipelineLayoutDescrip
 
 void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    /* Release recycled descriptor sets before their layout is destroyed */
+    auto& pipelineLayoutVK = LLGL_CAST(VKPipelineLayout&, pipelineLayout);
+    descriptorPoolAllocator_.ReleaseSetLayout(pipelineLayoutVK.GetVkDescriptorSetLayout());
     RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
 
-PipelineState* VKRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    Serialization::Deserializer reader{ serializedCache };
+
+    /*
+    PSOs from a serialized cache merge their pipeline cache into the shared one,
+    but vkMergePipelineCaches requires external synchronization of the destination cache,
+    which is still used by the worker threads of asynchronous PSO creation
+    */
+    WaitForPipelineThreadPool();
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident == Serialization::VKIdent_GraphicsPSOIdent)
+    {
+        /* Create graphics PSO from cache */
+        return TakeOwnership(
+            pipelineStates_,
+            MakeUnique<VKGraphicsPSO>(device_, defaultPipelineLayout_, pipelineCache_, reader)
+        );
+    }
+    else if (seg.ident == Serialization::VKIdent_ComputePSOIdent)
+    {
+        /* Create compute PSO from cache */
+        return TakeOwnership(
+            pipelineStates_,
+            MakeUnique<VKComputePSO>(device_, defaultPipelineLayout_, pipelineCache_, reader)
+        );
+    }
+
+    throw std::runtime_error("serialized cache does not denote a Vulkan graphics or compute PSO");
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    Serialization::Serializer writer;
+
+    /* Serialized PSOs merge their pipeline cache into the shared one, so wait for asynchronous PSO creations to finish */
+    if (serializedCache != nullptr)
+        WaitForPipelineThreadPool();
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKGraphicsPSO>(
+            device_,
+            defaultPipelineLayout_,
+            (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
+            pipelineCache_,
+            pipelineStateDesc,
+            gfxPipelineLimits_,
+            (serializedCache != nullptr ? &writer : nullptr)
+        )
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = writer.Finalize();
+
+    return pipelineState;
+}
+
+PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache)
+{
+    Serialization::Serializer writer;
+
+    /* Serialized PSOs merge their pipeline cache into the shared one, so wait for asynchronous PSO creations to finish */
+    if (serializedCache != nullptr)
+        WaitForPipelineThreadPool();
+
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKComputePSO>(
+            device_,
+            pipelineStateDesc,
+            defaultPipelineLayout_,
+            pipelineCache_,
+            (serializedCache != nullptr ? &writer : nullptr)
+        )
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = writer.Finalize();
+
+    return pipelineState;
+}
+
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc)
 {
     return TakeOwnership(
         pipelineStates_,
@@ -662,17 +776,27 @@ PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescrip
             device_,
             defaultPipelineLayout_,
             (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
+            pipelineCache_,
             pipelineStateDesc,
-            gfxPipelineLimits_
+            gfxPipelineLimits_,
+            nullptr,
+            &GetPipelineThreadPool()
         )
     );
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc)
 {
     return TakeOwnership(
         pipelineStates_,
-        MakeUnique<VKComputePSO>(device_, pipelineStateDesc, defaultPipelineLayout_)
+        MakeUnique<VKComputePSO>(
+            device_,
+            pipelineStateDesc,
+            defaultPipelineLayout_,
+            pipelineCache_,
+            nullptr,
+            &GetPipelineThreadPool()
+        )
     );
 }
 
@@ -877,6 +1001,7 @@ void VKRenderSystem::CreateLogicalDevice()
 
     /* Create command queue interface */
     commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
+    device_.SetCommandQueue(commandQueue_.get());
 
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
@@ -884,14 +1009,47 @@ void VKRenderSystem::CreateLogicalDevice()
 
 void VKRenderSystem::CreateDefaultPipelineLayout()
 {
+    /* Default pipeline layout has no descriptor sets but must share the push constant range with all other pipeline layouts */
+    VkPushConstantRange pushConstantRanges[] = { VKPipelineLayout::GetPushConstantRange() };
+
     VkPipelineLayoutCreateInfo layoutCreateInfo = {};
     {
-        layoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.pushConstantRangeCount = 1;
+        layoutCreateInfo.pPushConstantRanges    = pushConstantRanges;
     }
     auto result = vkCreatePipelineLayout(device_, &layoutCreateInfo, nullptr, defaultPipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan default pipeline layout");
 }
 
+void VKRenderSystem::CreatePipelineCache()
+{
+    /* Create render system wide pipeline cache; all PSOs are created with it or merge their dedicated caches into it */
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = 0;
+        createInfo.pInitialData     = nullptr;
+    }
+    auto result = vkCreatePipelineCache(device_, &createInfo, nullptr, pipelineCache_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+}
+
+ThreadPool& VKRenderSystem::GetPipelineThreadPool()
+{
+    if (!pipelineThreadPool_)
+        pipelineThreadPool_ = MakeUnique<ThreadPool>();
+    return *pipelineThreadPool_;
+}
+
+void VKRenderSystem::WaitForPipelineThreadPool()
+{
+    if (pipelineThreadPool_)
+        pipelineThreadPool_->WaitIdle();
+}
+
 bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const
 {
     if (config != nullptr)
@@ -929,6 +1087,9 @@ bool VKRenderSystem::IsExtensionRequired(const std::string& name) const
 
 VKDeviceBuffer VKRenderSystem::CreateStagingBuffer(const VkBufferCreateInfo& createInfo)
 {
+    /* Recycle memory of staging buffers whose uploads have been completed */
+    ReleaseCompletedStagingBuffers();
+
     return VKDeviceBuffer
     {
         device_,
@@ -954,6 +1115,28 @@ VKDeviceBuffer VKRenderSystem::CreateStagingBufferAndInitialize(
 }
 
 
+void VKRenderSystem::ReleaseStagingBufferDeferred(VKDeviceBuffer&& stagingBuffer)
+{
+    stagingBuffersInFlight_.emplace_back(device_.GetUploadSubmissionID(), std::move(stagingBuffer));
+}
+
+void VKRenderSystem::WaitPendingUpload(std::uint64_t submissionID)
+{
+    if (submissionID != 0 && !device_.IsSubmissionCompleted(submissionID))
+        device_.WaitSubmission(submissionID);
+}
+
+void VKRenderSystem::ReleaseCompletedStagingBuffers()
+{
+    auto it = stagingBuffersInFlight_.begin();
+    while (it != stagingBuffersInFlight_.end() && device_.IsSubmissionCompleted(it->first))
+    {
+        it->second.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        ++it;
+    }
+    stagingBuffersInFlight_.erase(stagingBuffersInFlight_.begin(), it);
+}
+
 } // /namespace LLGL
 
 
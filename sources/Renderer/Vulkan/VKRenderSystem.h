@@ -14,6 +14,7 @@
 #include "VKDevice.h"
 #include "../ContainerTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "RenderState/VKDescriptorPoolAllocator.h"
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
@@ -34,12 +35,14 @@
 #include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKResourceHeap.h"
+#include "../../Core/ThreadPool.h"
 
 #include <string>
 #include <memory>
 #include <vector>
 #include <set>
 #include <tuple>
+#include <utility>
 
 
 namespace LLGL
@@ -108,6 +111,8 @@ class VKRenderSystem final : public RenderSystem
 
         void Release(ResourceHeap& resourceHeap) override;
 
+        std::uint32_t WriteResourceHeap(ResourceHeap& resourceHeap, std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews) override;
+
         /* ----- Render Passes ----- */
 
         RenderPass* CreateRenderPass(const RenderPassDescriptor& renderPassDesc) override;
@@ -138,6 +143,9 @@ class VKRenderSystem final : public RenderSystem
         PipelineState* CreatePipelineState(const GraphicsPipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
         PipelineState* CreatePipelineState(const ComputePipelineDescriptor& pipelineStateDesc, std::unique_ptr<Blob>* serializedCache = nullptr) override;
 
+        PipelineState* CreatePipelineStateAsync(const GraphicsPipelineDescriptor& pipelineStateDesc) override;
+        PipelineState* CreatePipelineStateAsync(const ComputePipelineDescriptor& pipelineStateDesc) override;
+
         void Release(PipelineState& pipelineState) override;
 
         /* ----- Queries ----- */
@@ -159,6 +167,13 @@ class VKRenderSystem final : public RenderSystem
         void PickPhysicalDevice();
         void CreateLogicalDevice();
         void CreateDefaultPipelineLayout();
+        void CreatePipelineCache();
+
+        // Returns the thread pool for asynchronous PSO creation; the worker threads are started on first use.
+        ThreadPool& GetPipelineThreadPool();
+
+        // Waits until all pending asynchronous PSO creations have finished.
+        void WaitForPipelineThreadPool();
 
         bool IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const;
         bool IsExtensionRequired(const std::string& name) const;
@@ -171,6 +186,15 @@ class VKRenderSystem final : public RenderSystem
             VkDeviceSize                dataSize
         );
 
+        // Keeps the staging buffer alive until the upload submission that reads from it has been completed.
+        void ReleaseStagingBufferDeferred(VKDeviceBuffer&& stagingBuffer);
+
+        // Blocks until the specified upload submission has been completed. Does nothing if the submission ID is 0 or it has already been completed.
+        void WaitPendingUpload(std::uint64_t submissionID);
+
+        // Releases the memory of all staging buffers whose upload submissions have been completed.
+        void ReleaseCompletedStagingBuffers();
+
     private:
 
         /* ----- Common objects ----- */
@@ -182,13 +206,18 @@ class VKRenderSystem final : public RenderSystem
 
         VKPtr<VkDebugReportCallbackEXT>         debugReportCallback_;
         VKPtr<VkPipelineLayout>                 defaultPipelineLayout_;
+        VKPtr<VkPipelineCache>                  pipelineCache_;
 
         bool                                    debugLayerEnabled_      = false;
 
         std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        VKDescriptorPoolAllocator               descriptorPoolAllocator_;
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
+        std::vector<std::pair<std::uint64_t, VKDeviceBuffer>>
+                                                stagingBuffersInFlight_;    // Staging buffers of upload submissions, ordered by submission ID.
+
         /* ----- Hardware object containers ----- */
 
         HWObjectContainer<VKSwapChain>          swapChains_;
@@ -207,6 +236,10 @@ class VKRenderSystem final : public RenderSystem
         HWObjectContainer<VKQueryHeap>          queryHeaps_;
         HWObjectContainer<VKFence>              fences_;
 
+        /* ----- Worker threads ----- */
+
+        std::unique_ptr<ThreadPool>             pipelineThreadPool_;    // Declared last, so pending PSO creations are finished before any object is destroyed.
+
 };
 
 
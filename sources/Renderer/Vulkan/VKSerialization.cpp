@@ -0,0 +1,83 @@
+/*
+ * VKSerialization.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKSerialization.h"
+#include "VKCore.h"
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+void VKWriteSegmentShaderStage(
+    Serializer&             writer,
+    VkShaderStageFlagBits   stage,
+    const char*             entryPoint,
+    const void*             code,
+    std::size_t             codeSize)
+{
+    writer.Begin(VKIdent_ShaderStage);
+    {
+        writer.WriteTyped(stage);
+        writer.WriteCString(entryPoint);
+        writer.WriteTyped(static_cast<std::uint64_t>(codeSize));
+        writer.Write(code, codeSize);
+    }
+    writer.End();
+}
+
+void VKWriteSegmentPipelineCache(Serializer& writer, VkDevice device, VkPipelineCache pipelineCache)
+{
+    /* Query size of pipeline cache data */
+    std::size_t dataSize = 0;
+    auto result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr);
+    VKThrowIfFailed(result, "failed to query size of Vulkan pipeline cache data");
+
+    if (dataSize > 0)
+    {
+        /* Retrieve pipeline cache data */
+        std::vector<char> data(dataSize);
+        result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data());
+        VKThrowIfFailed(result, "failed to retrieve Vulkan pipeline cache data");
+        writer.WriteSegment(VKIdent_PipelineCache, data.data(), dataSize);
+    }
+}
+
+bool VKReadSegmentShaderStage(
+    Deserializer&               reader,
+    VkShaderStageFlagBits&      stage,
+    std::string&                entryPoint,
+    std::vector<std::uint32_t>& code)
+{
+    auto seg = reader.BeginOnMatch(VKIdent_ShaderStage);
+    if (seg.ident != VKIdent_ShaderStage)
+        return false;
+
+    reader.ReadTyped(stage);
+    entryPoint = reader.ReadCString();
+
+    /* Copy SPIR-V code into a word-aligned container */
+    std::uint64_t codeSize = 0;
+    reader.ReadTyped(codeSize);
+    code.resize(static_cast<std::size_t>((codeSize + 3) / 4));
+    reader.Read(code.data(), static_cast<std::size_t>(codeSize));
+
+    reader.End();
+    return true;
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
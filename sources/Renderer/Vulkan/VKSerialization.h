@@ -0,0 +1,75 @@
+/*
+ * VKSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_SERIALIZATION_H
+#define LLGL_VK_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+#include "Vulkan.h"
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for Vulkan serialization.
+enum VKIdent : IdentType
+{
+    VKIdent_ReservedVulkan = (RendererID::Vulkan << 8),
+    VKIdent_GraphicsPSOIdent,
+    VKIdent_ComputePSOIdent,
+    VKIdent_PipelineLayout,     // VkDescriptorSetLayoutBinding[n]; VKLayoutBinding[n]
+    VKIdent_RenderPass,         // VkAttachmentDescription[n]
+    VKIdent_ShaderStage,        // VkShaderStageFlagBits; LPCSTR; SPIR-V
+    VKIdent_VertexInput,        // VkVertexInputBindingDescription[n]; VkVertexInputAttributeDescription[n]
+    VKIdent_GraphicsStates,     // Vk*StateCreateInfo
+    VKIdent_PipelineCache,      // vkGetPipelineCacheData
+};
+
+
+/* ----- Functions ----- */
+
+// Writes the specified shader stage with its entry point and SPIR-V code as a serialized segment.
+void VKWriteSegmentShaderStage(
+    Serializer&             writer,
+    VkShaderStageFlagBits   stage,
+    const char*             entryPoint,
+    const void*             code,
+    std::size_t             codeSize
+);
+
+// Writes the data of the specified pipeline cache as a serialized segment. Nothing is written if the cache is empty.
+void VKWriteSegmentPipelineCache(Serializer& writer, VkDevice device, VkPipelineCache pipelineCache);
+
+// Reads a shader stage from the next deserialized segment. Returns false if the next segment is not a shader stage.
+bool VKReadSegmentShaderStage(
+    Deserializer&               reader,
+    VkShaderStageFlagBits&      stage,
+    std::string&                entryPoint,
+    std::vector<std::uint32_t>& code
+);
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
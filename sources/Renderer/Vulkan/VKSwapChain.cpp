@@ -6,6 +6,7 @@
  */
 
 #include "VKSwapChain.h"
+#include "VKCommandQueue.h"
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
@@ -43,6 +44,7 @@ VKSwapChain::VKSwapChain(
     const VKPtr<VkInstance>&        instance,
     VkPhysicalDevice                physicalDevice,
     const VKPtr<VkDevice>&          device,
+    VKCommandQueue&                 commandQueue,
     VKDeviceMemoryManager&          deviceMemoryMngr,
     const SwapChainDescriptor&      desc,
     const std::shared_ptr<Surface>& surface)
@@ -51,6 +53,7 @@ VKSwapChain::VKSwapChain(
     instance_                { instance                        },
     physicalDevice_          { physicalDevice                  },
     device_                  { device                          },
+    commandQueue_            { commandQueue                    },
     deviceMemoryMngr_        { deviceMemoryMngr                },
     surface_                 { instance, vkDestroySurfaceKHR   },
     swapChain_               { device, vkDestroySwapchainKHR   },
@@ -87,6 +90,9 @@ VKSwapChain::VKSwapChain(
 
 void VKSwapChain::Present()
 {
+    /* Flush pending command buffers, so they are submitted before the semaphores below */
+    commandQueue_.FlushSubmissions();
+
     /* Initialize semaphores */
     VkSemaphore waitSemaphorse[] = { imageAvailableSemaphore_ };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
@@ -185,7 +191,7 @@ bool VKSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
         swapChainExtent_.height != resolution.height)
     {
         /* Wait until graphics queue is idle before resources are destroyed and recreated */
-        vkQueueWaitIdle(graphicsQueue_);
+        commandQueue_.WaitIdle();
 
         /* Recreate presenting semaphores and Vulkan surface */
         CreatePresentSemaphores();
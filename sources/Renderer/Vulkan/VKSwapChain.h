@@ -24,6 +24,7 @@ namespace LLGL
 {
 
 
+class VKCommandQueue;
 class VKDeviceMemoryManager;
 class VKDeviceMemoryRegion;
 
@@ -36,6 +37,7 @@ class VKSwapChain final : public SwapChain
             const VKPtr<VkInstance>&        instance,
             VkPhysicalDevice                physicalDevice,
             const VKPtr<VkDevice>&          device,
+            VKCommandQueue&                 commandQueue,
             VKDeviceMemoryManager&          deviceMemoryMngr,
             const SwapChainDescriptor&      desc,
             const std::shared_ptr<Surface>& surface
@@ -122,6 +124,7 @@ class VKSwapChain final : public SwapChain
         VkPhysicalDevice        physicalDevice_                             = VK_NULL_HANDLE;
         const VKPtr<VkDevice>&  device_;
 
+        VKCommandQueue&         commandQueue_;
         VKDeviceMemoryManager&  deviceMemoryMngr_;
 
         VKPtr<VkSurfaceKHR>     surface_;
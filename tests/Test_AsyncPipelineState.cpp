@@ -0,0 +1,260 @@
+/*
+ * Test_AsyncPipelineState.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <vector>
+#include <cstring>
+
+
+// Vertex with 2D position and 8-bit color
+struct Vertex
+{
+    float           position[2];
+    std::uint8_t    color[4];
+};
+
+static const char* g_vertexShaderSource =
+    "#version 330\n"
+    "in vec2 position;\n"
+    "in vec4 color;\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "    vColor = color;\n"
+    "}\n";
+
+static const char* g_fragmentShaderSource =
+    "#version 330\n"
+    "in vec4 vColor;\n"
+    "out vec4 outColor;\n"
+    "void main() {\n"
+    "    outColor = vColor;\n"
+    "}\n";
+
+// Fragment shader with an undeclared identifier, so linking the shader program must fail
+static const char* g_faultyFragmentShaderSource =
+    "#version 330\n"
+    "in vec4 vColor;\n"
+    "out vec4 outColor;\n"
+    "void main() {\n"
+    "    outColor = vColour;\n"
+    "}\n";
+
+// Colors of the four quads, one for each quadrant of the render target
+static const std::uint8_t g_quadColors[4][4] =
+{
+    { 255,   0,   0, 255 },
+    {   0, 255,   0, 255 },
+    {   0,   0, 255, 255 },
+    { 255, 255,   0, 255 },
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load OpenGL renderer with a headless context, so no window is required
+        LLGL::RendererConfigurationOpenGL config;
+        {
+            config.headless = true;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = "OpenGL";
+            rendererDesc.rendererConfig     = &config;
+            rendererDesc.rendererConfigSize = sizeof(config);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        // Create render target with a single color attachment
+        const LLGL::Extent2D resolution{ 64, 64 };
+
+        LLGL::TextureDescriptor colorTextureDesc;
+        {
+            colorTextureDesc.type       = LLGL::TextureType::Texture2D;
+            colorTextureDesc.bindFlags  = LLGL::BindFlags::ColorAttachment;
+            colorTextureDesc.format     = LLGL::Format::RGBA8UNorm;
+            colorTextureDesc.extent     = { resolution.width, resolution.height, 1 };
+            colorTextureDesc.mipLevels  = 1;
+        }
+        auto colorTexture = renderer->CreateTexture(colorTextureDesc);
+
+        LLGL::RenderTargetDescriptor renderTargetDesc;
+        {
+            renderTargetDesc.resolution     = resolution;
+            renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, colorTexture } };
+        }
+        auto renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+        // Create vertex buffer with four quads that cover one quadrant each (from top-left to bottom-right in the render target)
+        const std::vector<LLGL::VertexAttribute> vertexAttribs =
+        {
+            LLGL::VertexAttribute{ "position", LLGL::Format::RG32Float,  0, 0, sizeof(Vertex) },
+            LLGL::VertexAttribute{ "color",    LLGL::Format::RGBA8UNorm, 1, 8, sizeof(Vertex) },
+        };
+
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < 4; ++i)
+        {
+            const float x = static_cast<float>(i % 2) - 1.0f;
+            const float y = -static_cast<float>(i / 2);
+            const float corners[4][2] = { { x, y }, { x + 1, y }, { x + 1, y + 1 }, { x, y + 1 } };
+            for (const auto& corner : corners)
+            {
+                Vertex vertex;
+                ::memcpy(vertex.position, corner, sizeof(corner));
+                ::memcpy(vertex.color, g_quadColors[i], sizeof(vertex.color));
+                vertices.push_back(vertex);
+            }
+        }
+
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(Vertex) * vertices.size();
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = vertexAttribs;
+        }
+        auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices.data());
+
+        // Create index buffer with the indices of all quads
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            for (std::uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u })
+                indices.push_back(i * 4 + index);
+        }
+
+        LLGL::BufferDescriptor indexBufferDesc;
+        {
+            indexBufferDesc.size        = sizeof(std::uint32_t) * indices.size();
+            indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+            indexBufferDesc.format      = LLGL::Format::R32UInt;
+        }
+        auto indexBuffer = renderer->CreateBuffer(indexBufferDesc, indices.data());
+
+        // Create shaders for graphics pipelines
+        LLGL::ShaderDescriptor vertexShaderDesc{ LLGL::ShaderType::Vertex, g_vertexShaderSource };
+        {
+            vertexShaderDesc.sourceType             = LLGL::ShaderSourceType::CodeString;
+            vertexShaderDesc.vertex.inputAttribs    = vertexAttribs;
+        }
+        LLGL::ShaderDescriptor fragmentShaderDesc{ LLGL::ShaderType::Fragment, g_fragmentShaderSource };
+        {
+            fragmentShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+        }
+        LLGL::ShaderDescriptor faultyFragmentShaderDesc{ LLGL::ShaderType::Fragment, g_faultyFragmentShaderSource };
+        {
+            faultyFragmentShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+        }
+
+        auto vertexShader           = renderer->CreateShader(vertexShaderDesc);
+        auto fragmentShader         = renderer->CreateShader(fragmentShaderDesc);
+        auto faultyFragmentShader   = renderer->CreateShader(faultyFragmentShaderDesc);
+
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader   = vertexShader;
+            pipelineDesc.fragmentShader = fragmentShader;
+            pipelineDesc.renderPass     = renderTarget->GetRenderPass();
+        }
+
+        auto commandQueue = renderer->GetCommandQueue();
+
+        // Renders all quads with the specified pipeline and compares the center of each quadrant with the expected color
+        auto RenderAndCompare = [&](LLGL::PipelineState& pipelineState, const char* pipelineName) -> int
+        {
+            auto commands = renderer->CreateCommandBuffer();
+
+            commands->Begin();
+            {
+                commands->SetVertexBuffer(*vertexBuffer);
+                commands->SetIndexBuffer(*indexBuffer);
+                commands->BeginRenderPass(*renderTarget);
+                {
+                    commands->Clear(LLGL::ClearFlags::Color);
+                    commands->SetViewport(resolution);
+                    commands->SetPipelineState(pipelineState);
+                    commands->DrawIndexed(static_cast<std::uint32_t>(indices.size()), 0);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+
+            commandQueue->Submit(*commands);
+            commandQueue->WaitIdle();
+
+            renderer->Release(*commands);
+
+            int numErrors = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const std::int32_t x = static_cast<std::int32_t>((i % 2) * resolution.width / 2 + resolution.width / 4);
+                const std::int32_t y = static_cast<std::int32_t>((i / 2) * resolution.height / 2 + resolution.height / 4);
+
+                std::uint8_t color[4] = {};
+                const LLGL::TextureRegion region{ LLGL::Offset3D{ x, y, 0 }, LLGL::Extent3D{ 1, 1, 1 } };
+                renderer->ReadTexture(*colorTexture, region, LLGL::DstImageDescriptor{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, color, sizeof(color) });
+
+                if (::memcmp(color, g_quadColors[i], sizeof(color)) != 0)
+                {
+                    std::cerr << "quad " << i << " mismatch (" << pipelineName << "): expected color ("
+                        << int(g_quadColors[i][0]) << ", " << int(g_quadColors[i][1]) << ", " << int(g_quadColors[i][2]) << ", " << int(g_quadColors[i][3])
+                        << "), but got (" << int(color[0]) << ", " << int(color[1]) << ", " << int(color[2]) << ", " << int(color[3]) << ")" << std::endl;
+                    ++numErrors;
+                }
+            }
+            return numErrors;
+        };
+
+        int numErrors = 0;
+
+        // Create pipeline in the background and poll its completion before it is used
+        auto polledPipeline = renderer->CreatePipelineStateAsync(pipelineDesc);
+        while (!polledPipeline->IsReady())
+        {
+            // Wait until pipeline is ready
+        }
+        if (auto report = polledPipeline->GetReport())
+        {
+            if (report->HasErrors())
+                throw std::runtime_error(report->GetText());
+        }
+        numErrors += RenderAndCompare(*polledPipeline, "polled pipeline");
+
+        // Create pipeline in the background and use it immediately, which must block until it is ready
+        auto immediatePipeline = renderer->CreatePipelineStateAsync(pipelineDesc);
+        numErrors += RenderAndCompare(*immediatePipeline, "immediately used pipeline");
+
+        // Create pipeline with a faulty shader in the background, which must report the link error once it is ready
+        pipelineDesc.fragmentShader = faultyFragmentShader;
+        auto faultyPipeline = renderer->CreatePipelineStateAsync(pipelineDesc);
+        while (!faultyPipeline->IsReady())
+        {
+            // Wait until pipeline is ready
+        }
+        auto faultyReport = faultyPipeline->GetReport();
+        if (faultyReport == nullptr || !faultyReport->HasErrors())
+        {
+            std::cerr << "faulty pipeline mismatch: expected report with errors" << std::endl;
+            ++numErrors;
+        }
+
+        if (numErrors == 0)
+            std::cout << "asynchronous pipelines match" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
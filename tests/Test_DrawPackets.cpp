@@ -0,0 +1,200 @@
+/*
+ * Test_DrawPackets.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Timer.h>
+#include <iostream>
+#include <vector>
+#include <functional>
+
+
+static unsigned int g_seed;
+
+int FastRand()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return (g_seed >> 16) & RAND_MAX;
+}
+
+int RandInt(int max)
+{
+    return (FastRand() % (max + 1));
+}
+
+double MeasureCPUTime(const std::function<void()>& callback)
+{
+    const auto startTime = LLGL::Timer::Tick();
+    callback();
+    const auto endTime = LLGL::Timer::Tick();
+    return (static_cast<double>(endTime - startTime) * 1000.0 / static_cast<double>(LLGL::Timer::Frequency()));
+}
+
+void PrintStatistics(const std::string& title, const LLGL::DrawPacketStatistics& stats, double time)
+{
+    std::cout << title << std::endl;
+    std::cout << "\tdraw commands:            " << stats.numDrawCommands << std::endl;
+    std::cout << "\tpipeline state bindings:  " << stats.numPipelineStateBindings << std::endl;
+    std::cout << "\tresource heap bindings:   " << stats.numResourceHeapBindings << std::endl;
+    std::cout << "\tvertex buffer bindings:   " << stats.numVertexBufferBindings << std::endl;
+    std::cout << "\tindex buffer bindings:    " << stats.numIndexBufferBindings << std::endl;
+    std::cout << "\tduration:                 " << time << "ms" << "\n\n";
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Use the Null renderer, so only the CPU cost of the state changes is measured
+        auto renderer = LLGL::RenderSystem::Load("Null");
+
+        const int numPipelines      = 16;
+        const int numDescriptorSets = 64;
+        const int numMeshes         = 256;
+        const int numDraws          = 200000;
+
+        // Create pipeline states that share one pipeline layout with one texture binding
+        LLGL::PipelineLayoutDescriptor layoutDesc;
+        {
+            layoutDesc.bindings = { LLGL::BindingDescriptor{ LLGL::ResourceType::Texture, LLGL::BindFlags::Sampled, LLGL::StageFlags::FragmentStage, 0 } };
+        }
+        auto pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.pipelineLayout = pipelineLayout;
+        }
+        std::vector<LLGL::PipelineState*> pipelines;
+        for (int i = 0; i < numPipelines; ++i)
+            pipelines.push_back(renderer->CreatePipelineState(pipelineDesc));
+
+        // Create resource heap with one texture per descriptor set
+
+        LLGL::TextureDescriptor textureDesc;
+        {
+            textureDesc.format      = LLGL::Format::RGBA8UNorm;
+            textureDesc.extent      = { 4, 4, 1 };
+            textureDesc.bindFlags   = LLGL::BindFlags::Sampled;
+            textureDesc.mipLevels   = 1;
+        }
+        LLGL::ResourceHeapDescriptor heapDesc;
+        {
+            heapDesc.pipelineLayout = pipelineLayout;
+            for (int i = 0; i < numDescriptorSets; ++i)
+                heapDesc.resourceViews.push_back(renderer->CreateTexture(textureDesc));
+        }
+        auto resourceHeap = renderer->CreateResourceHeap(heapDesc);
+
+        // Create vertex and index buffers for each mesh
+        std::vector<LLGL::Buffer*> vertexBuffers, indexBuffers;
+        for (int i = 0; i < numMeshes; ++i)
+        {
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.size       = 1024;
+                vertexBufferDesc.bindFlags  = LLGL::BindFlags::VertexBuffer;
+            }
+            vertexBuffers.push_back(renderer->CreateBuffer(vertexBufferDesc));
+
+            LLGL::BufferDescriptor indexBufferDesc;
+            {
+                indexBufferDesc.size        = 1024;
+                indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+                indexBufferDesc.format      = LLGL::Format::R32UInt;
+            }
+            indexBuffers.push_back(renderer->CreateBuffer(indexBufferDesc));
+        }
+
+        // Generate draw packets in random scene order
+        std::vector<LLGL::DrawPacket> packets(numDraws);
+        for (auto& packet : packets)
+        {
+            const int mesh = RandInt(numMeshes - 1);
+            packet.pipelineState    = pipelines[RandInt(numPipelines - 1)];
+            packet.pipelineLayout   = pipelineLayout;
+            packet.resourceHeap     = resourceHeap;
+            packet.descriptorSet    = static_cast<std::uint32_t>(RandInt(numDescriptorSets - 1));
+            packet.vertexBuffer     = vertexBuffers[mesh];
+            packet.indexBuffer      = indexBuffers[mesh];
+            packet.numVertices      = 36;
+        }
+
+        auto commandQueue = renderer->GetCommandQueue();
+        auto commands = renderer->CreateCommandBuffer();
+
+        const auto EncodeAndSubmit = [&](LLGL::DrawPacketQueue& queue, bool sortPackets) -> LLGL::DrawPacketStatistics
+        {
+            LLGL::DrawPacketStatistics stats;
+            for (const auto& packet : packets)
+                queue.Append(packet);
+            commands->Begin();
+            {
+                stats = queue.Flush(*commands, sortPackets);
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+            commandQueue->WaitIdle();
+            return stats;
+        };
+
+        std::cout << "encode " << numDraws << " draw commands with " << numPipelines << " pipeline states, "
+                  << numDescriptorSets << " descriptor sets, and " << numMeshes << " meshes\n\n";
+
+        // Naive submission binds all states for each draw command
+        LLGL::DrawPacketStatistics naiveStats;
+        {
+            naiveStats.numDrawCommands          = numDraws;
+            naiveStats.numPipelineStateBindings = numDraws;
+            naiveStats.numResourceHeapBindings  = numDraws;
+            naiveStats.numVertexBufferBindings  = numDraws;
+            naiveStats.numIndexBufferBindings   = numDraws;
+        }
+        auto naiveTime = MeasureCPUTime(
+            [&]()
+            {
+                commands->Begin();
+                for (const auto& packet : packets)
+                {
+                    commands->SetPipelineState(*packet.pipelineState);
+                    commands->SetResourceHeap(*packet.resourceHeap, packet.descriptorSet);
+                    commands->SetVertexBuffer(*packet.vertexBuffer);
+                    commands->SetIndexBuffer(*packet.indexBuffer);
+                    commands->DrawIndexed(packet.numVertices, packet.firstVertex);
+                }
+                commands->End();
+                commandQueue->Submit(*commands);
+                commandQueue->WaitIdle();
+            }
+        );
+        PrintStatistics("scene order with all states per draw", naiveStats, naiveTime);
+
+        // Scene order, but only redundant consecutive state changes are omitted
+        LLGL::DrawPacketQueue singleThreadedQueue{ 1 };
+        LLGL::DrawPacketStatistics stats;
+        auto unsortedTime = MeasureCPUTime([&]() { stats = EncodeAndSubmit(singleThreadedQueue, false); });
+        PrintStatistics("scene order with redundant states omitted", stats, unsortedTime);
+
+        // Sorted by state key on a single thread
+        auto sortedTime = MeasureCPUTime([&]() { stats = EncodeAndSubmit(singleThreadedQueue, true); });
+        PrintStatistics("sorted by state key (1 thread)", stats, sortedTime);
+
+        // Sorted by state key on all hardware threads
+        LLGL::DrawPacketQueue multiThreadedQueue;
+        EncodeAndSubmit(multiThreadedQueue, true); // Warm up worker threads
+        auto parallelTime = MeasureCPUTime([&]() { stats = EncodeAndSubmit(multiThreadedQueue, true); });
+        PrintStatistics("sorted by state key (all threads)", stats, parallelTime);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
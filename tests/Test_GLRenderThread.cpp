@@ -0,0 +1,285 @@
+/*
+ * Test_GLRenderThread.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+
+// Vertex with 2D position and 8-bit color
+struct Vertex
+{
+    float           position[2];
+    std::uint8_t    color[4];
+};
+
+static const char* g_vertexShaderSource =
+    "#version 330\n"
+    "in vec2 position;\n"
+    "in vec4 color;\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "    vColor = color;\n"
+    "}\n";
+
+static const char* g_fragmentShaderSource =
+    "#version 330\n"
+    "in vec4 vColor;\n"
+    "out vec4 outColor;\n"
+    "void main() {\n"
+    "    outColor = vColor;\n"
+    "}\n";
+
+// Colors of the four quads, one for each quadrant of the render target
+static const std::uint8_t g_quadColors[4][4] =
+{
+    { 255,   0,   0, 255 },
+    {   0, 255,   0, 255 },
+    {   0,   0, 255, 255 },
+    { 255, 255,   0, 255 },
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load OpenGL renderer with a headless context and a dedicated render thread that owns the GL context
+        LLGL::RendererConfigurationOpenGL config;
+        {
+            config.headless     = true;
+            config.renderThread = true;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = "OpenGL";
+            rendererDesc.rendererConfig     = &config;
+            rendererDesc.rendererConfigSize = sizeof(config);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        const LLGL::Extent2D resolution{ 64, 64 };
+
+        // Immediate command buffers cannot be created when GL commands are marshaled to the render thread
+        int numErrors = 0;
+        try
+        {
+            renderer->CreateCommandBuffer(LLGL::CommandBufferDescriptor{ LLGL::CommandBufferFlags::ImmediateSubmit });
+            std::cerr << "immediate command buffer mismatch: expected exception" << std::endl;
+            ++numErrors;
+        }
+        catch (const std::exception&)
+        {
+            // Expected exception
+        }
+
+        // Create render pass that is shared between the render targets of all worker threads
+        LLGL::RenderPassDescriptor renderPassDesc;
+        {
+            renderPassDesc.colorAttachments[0].format = LLGL::Format::RGBA8UNorm;
+        }
+        auto renderPass = renderer->CreateRenderPass(renderPassDesc);
+
+        // Create vertex buffer with four quads that cover one quadrant each (from top-left to bottom-right in the render target)
+        const std::vector<LLGL::VertexAttribute> vertexAttribs =
+        {
+            LLGL::VertexAttribute{ "position", LLGL::Format::RG32Float,  0, 0, sizeof(Vertex) },
+            LLGL::VertexAttribute{ "color",    LLGL::Format::RGBA8UNorm, 1, 8, sizeof(Vertex) },
+        };
+
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < 4; ++i)
+        {
+            const float x = static_cast<float>(i % 2) - 1.0f;
+            const float y = -static_cast<float>(i / 2);
+            const float corners[4][2] = { { x, y }, { x + 1, y }, { x + 1, y + 1 }, { x, y + 1 } };
+            for (const auto& corner : corners)
+            {
+                Vertex vertex;
+                ::memcpy(vertex.position, corner, sizeof(corner));
+                ::memcpy(vertex.color, g_quadColors[i], sizeof(vertex.color));
+                vertices.push_back(vertex);
+            }
+        }
+
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(Vertex) * vertices.size();
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = vertexAttribs;
+        }
+        auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices.data());
+
+        // Create index buffer with the indices of all quads; the first six indices can also be used with a vertex offset
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            for (std::uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u })
+                indices.push_back(i * 4 + index);
+        }
+
+        LLGL::BufferDescriptor indexBufferDesc;
+        {
+            indexBufferDesc.size        = sizeof(std::uint32_t) * indices.size();
+            indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+            indexBufferDesc.format      = LLGL::Format::R32UInt;
+        }
+        auto indexBuffer = renderer->CreateBuffer(indexBufferDesc, indices.data());
+
+        // Create graphics pipeline
+        LLGL::ShaderDescriptor vertexShaderDesc{ LLGL::ShaderType::Vertex, g_vertexShaderSource };
+        {
+            vertexShaderDesc.sourceType         = LLGL::ShaderSourceType::CodeString;
+            vertexShaderDesc.vertex.inputAttribs = vertexAttribs;
+        }
+        LLGL::ShaderDescriptor fragmentShaderDesc{ LLGL::ShaderType::Fragment, g_fragmentShaderSource };
+        {
+            fragmentShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+        }
+
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader   = renderer->CreateShader(vertexShaderDesc);
+            pipelineDesc.fragmentShader = renderer->CreateShader(fragmentShaderDesc);
+            pipelineDesc.renderPass     = renderPass;
+        }
+        auto pipeline = renderer->CreatePipelineState(pipelineDesc);
+        if (auto report = pipeline->GetReport())
+        {
+            if (report->HasErrors())
+                throw std::runtime_error(report->GetText());
+        }
+
+        auto commandQueue = renderer->GetCommandQueue();
+        std::mutex outputMutex;
+
+        // Renders all quads from the calling thread into its own render target and compares the center of each quadrant with the expected color
+        auto RenderAndCompare = [&](int threadIndex, long flags, int numFrames) -> int
+        {
+            LLGL::TextureDescriptor colorTextureDesc;
+            {
+                colorTextureDesc.type       = LLGL::TextureType::Texture2D;
+                colorTextureDesc.bindFlags  = LLGL::BindFlags::ColorAttachment;
+                colorTextureDesc.format     = LLGL::Format::RGBA8UNorm;
+                colorTextureDesc.extent     = { resolution.width, resolution.height, 1 };
+                colorTextureDesc.mipLevels  = 1;
+            }
+            auto colorTexture = renderer->CreateTexture(colorTextureDesc);
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.renderPass     = renderPass;
+                renderTargetDesc.resolution     = resolution;
+                renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, colorTexture } };
+            }
+            auto renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+            // Consecutive draw calls are batched, so their indirect arguments are uploaded on the render thread
+            auto commands = renderer->CreateCommandBuffer(LLGL::CommandBufferDescriptor{ flags });
+
+            int numErrors = 0;
+            for (int frame = 0; frame < numFrames; ++frame)
+            {
+                if (frame == 0 || (flags & LLGL::CommandBufferFlags::MultiSubmit) == 0)
+                {
+                    commands->Begin();
+                    {
+                        commands->SetVertexBuffer(*vertexBuffer);
+                        commands->SetIndexBuffer(*indexBuffer);
+                        commands->BeginRenderPass(*renderTarget);
+                        {
+                            commands->Clear(LLGL::ClearFlags::Color);
+                            commands->SetViewport(resolution);
+                            commands->SetPipelineState(*pipeline);
+                            for (std::uint32_t i = 0; i < 4; ++i)
+                                commands->DrawIndexed(6, 0, static_cast<std::int32_t>(i * 4));
+                        }
+                        commands->EndRenderPass();
+                    }
+                    commands->End();
+                }
+
+                commandQueue->Submit(*commands);
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    const std::int32_t x = static_cast<std::int32_t>((i % 2) * resolution.width / 2 + resolution.width / 4);
+                    const std::int32_t y = static_cast<std::int32_t>((i / 2) * resolution.height / 2 + resolution.height / 4);
+
+                    std::uint8_t color[4] = {};
+                    const LLGL::TextureRegion region{ LLGL::Offset3D{ x, y, 0 }, LLGL::Extent3D{ 1, 1, 1 } };
+                    renderer->ReadTexture(*colorTexture, region, LLGL::DstImageDescriptor{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, color, sizeof(color) });
+
+                    if (::memcmp(color, g_quadColors[i], sizeof(color)) != 0)
+                    {
+                        std::lock_guard<std::mutex> guard{ outputMutex };
+                        std::cerr << "quad " << i << " mismatch (thread " << threadIndex << ", frame " << frame << "): expected color ("
+                            << int(g_quadColors[i][0]) << ", " << int(g_quadColors[i][1]) << ", " << int(g_quadColors[i][2]) << ", " << int(g_quadColors[i][3])
+                            << "), but got (" << int(color[0]) << ", " << int(color[1]) << ", " << int(color[2]) << ", " << int(color[3]) << ")" << std::endl;
+                        ++numErrors;
+                    }
+                }
+            }
+
+            renderer->Release(*commands);
+            renderer->Release(*renderTarget);
+            renderer->Release(*colorTexture);
+
+            return numErrors;
+        };
+
+        // Render from several application threads at once; every other thread uses a multi-submit command buffer
+        const int numThreads = 4;
+        const int numFrames = 8;
+
+        std::atomic<int> numThreadErrors{ 0 };
+        std::vector<std::thread> workers;
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            workers.emplace_back(
+                [&, i]()
+                {
+                    try
+                    {
+                        const long flags = (i % 2 == 0 ? 0 : LLGL::CommandBufferFlags::MultiSubmit);
+                        numThreadErrors += RenderAndCompare(i, flags, numFrames);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::lock_guard<std::mutex> guard{ outputMutex };
+                        std::cerr << "thread " << i << ": " << e.what() << std::endl;
+                        ++numThreadErrors;
+                    }
+                }
+            );
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        commandQueue->WaitIdle();
+        numErrors += numThreadErrors;
+
+        if (numErrors == 0)
+            std::cout << "render thread draws match" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Test_NullRasterizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <vector>
+#include <cstring>
+
+
+// Input vertex with clip-space position and color
+struct Vertex
+{
+    float position[4];
+    float color[4];
+};
+
+// Vertex callback that passes the input positions and colors through to the rasterizer
+void ProcessVertices(const LLGL::NullVertexBatch& batch)
+{
+    if (batch.positions == nullptr)
+        return;
+
+    ::memcpy(batch.positions, batch.inputs[0].data, sizeof(float) * 4 * batch.numVertices);
+    ::memcpy(batch.colors,    batch.inputs[1].data, sizeof(float) * 4 * batch.numVertices);
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load Null renderer with software rasterizer
+        LLGL::RendererConfigurationNull config;
+        {
+            config.vertexCallback       = ProcessVertices;
+            config.softwareRasterizer   = true;
+            config.rasterizerThreads    = 4;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = "Null";
+            rendererDesc.rendererConfig     = &config;
+            rendererDesc.rendererConfigSize = sizeof(config);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        // Create vertex buffer with three triangles: red in the background, green in the front, and blue behind the red one
+        const Vertex vertices[] =
+        {
+            { { -1, -1, 0.50f, 1 }, { 1, 0, 0, 1 } }, { {  3, -1, 0.50f, 1 }, { 1, 0, 0, 1 } }, { { -1,  3, 0.50f, 1 }, { 1, 0, 0, 1 } },
+            { { -1, -1, 0.25f, 1 }, { 0, 1, 0, 1 } }, { {  0, -1, 0.25f, 1 }, { 0, 1, 0, 1 } }, { { -1,  0, 0.25f, 1 }, { 0, 1, 0, 1 } },
+            { {  0,  0, 0.75f, 1 }, { 0, 0, 1, 1 } }, { {  1,  0, 0.75f, 1 }, { 0, 0, 1, 1 } }, { {  0,  1, 0.75f, 1 }, { 0, 0, 1, 1 } },
+        };
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(vertices);
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  =
+            {
+                LLGL::VertexAttribute{ "position", LLGL::Format::RGBA32Float, 0, 0,  sizeof(Vertex) },
+                LLGL::VertexAttribute{ "color",    LLGL::Format::RGBA32Float, 1, 16, sizeof(Vertex) },
+            };
+        }
+        auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices);
+
+        // Create render target with color and depth texture, whose size is not a multiple of the tile size
+        const LLGL::Extent2D resolution{ 100, 80 };
+
+        LLGL::TextureDescriptor colorTextureDesc;
+        {
+            colorTextureDesc.type       = LLGL::TextureType::Texture2D;
+            colorTextureDesc.bindFlags  = LLGL::BindFlags::ColorAttachment;
+            colorTextureDesc.format     = LLGL::Format::RGBA8UNorm;
+            colorTextureDesc.extent     = { resolution.width, resolution.height, 1 };
+            colorTextureDesc.mipLevels  = 1;
+        }
+        auto colorTexture = renderer->CreateTexture(colorTextureDesc);
+
+        LLGL::TextureDescriptor depthTextureDesc = colorTextureDesc;
+        {
+            depthTextureDesc.bindFlags  = LLGL::BindFlags::DepthStencilAttachment;
+            depthTextureDesc.format     = LLGL::Format::D32Float;
+        }
+        auto depthTexture = renderer->CreateTexture(depthTextureDesc);
+
+        LLGL::RenderPassDescriptor renderPassDesc;
+        {
+            renderPassDesc.colorAttachments[0]  = LLGL::AttachmentFormatDescriptor{ LLGL::Format::RGBA8UNorm, LLGL::AttachmentLoadOp::Clear };
+            renderPassDesc.depthAttachment      = LLGL::AttachmentFormatDescriptor{ LLGL::Format::D32Float, LLGL::AttachmentLoadOp::Clear };
+        }
+        auto renderPass = renderer->CreateRenderPass(renderPassDesc);
+
+        LLGL::RenderTargetDescriptor renderTargetDesc;
+        {
+            renderTargetDesc.renderPass     = renderPass;
+            renderTargetDesc.resolution     = resolution;
+            renderTargetDesc.attachments    =
+            {
+                LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, colorTexture },
+                LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Depth, depthTexture },
+            };
+        }
+        auto renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+        // Create pipeline state with depth test
+        LLGL::ShaderDescriptor vertexShaderDesc{ LLGL::ShaderType::Vertex, "" };
+        vertexShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+        auto vertexShader = renderer->CreateShader(vertexShaderDesc);
+
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader           = vertexShader;
+            pipelineDesc.renderPass             = renderPass;
+            pipelineDesc.primitiveTopology      = LLGL::PrimitiveTopology::TriangleList;
+            pipelineDesc.depth.testEnabled      = true;
+            pipelineDesc.depth.writeEnabled     = true;
+        }
+        auto pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+        // Render triangles with cleared attachments
+        auto commandQueue = renderer->GetCommandQueue();
+        auto commands = renderer->CreateCommandBuffer();
+
+        const LLGL::ClearValue clearValues[2] = { LLGL::ClearValue{ LLGL::ColorRGBAf{ 0, 0, 0, 1 } }, LLGL::ClearValue{ 1.0f } };
+
+        commands->Begin();
+        {
+            commands->BeginRenderPass(*renderTarget, renderPass, 2, clearValues);
+            {
+                commands->SetViewport(resolution);
+                commands->SetPipelineState(*pipeline);
+                commands->SetVertexBuffer(*vertexBuffer);
+                commands->Draw(9, 0);
+            }
+            commands->EndRenderPass();
+        }
+        commands->End();
+        commandQueue->Submit(*commands);
+        commandQueue->WaitIdle();
+
+        // Read back color and depth attachments
+        std::vector<std::uint8_t> colors(resolution.width * resolution.height * 4);
+        std::vector<float> depths(resolution.width * resolution.height);
+
+        const LLGL::TextureRegion region{ LLGL::Offset3D{}, LLGL::Extent3D{ resolution.width, resolution.height, 1 } };
+        renderer->ReadTexture(*colorTexture, region, LLGL::DstImageDescriptor{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, colors.data(), colors.size() });
+        renderer->ReadTexture(*depthTexture, region, LLGL::DstImageDescriptor{ LLGL::ImageFormat::Depth, LLGL::DataType::Float32, depths.data(), depths.size() * sizeof(float) });
+
+        // Compare pixels with expected values
+        struct ExpectedPixel
+        {
+            std::uint32_t   x, y;
+            std::uint8_t    color[4];
+            float           depth;
+        };
+
+        const ExpectedPixel expectedPixels[] =
+        {
+            {  5, 75, {   0, 255, 0, 255 }, 0.25f }, // Green triangle in the lower-left quadrant
+            { 60, 30, { 255,   0, 0, 255 }, 0.50f }, // Blue triangle is hidden behind the red triangle
+            { 99, 79, { 255,   0, 0, 255 }, 0.50f }, // Last pixel in the partially covered bottom-right tile
+            { 45, 75, { 255,   0, 0, 255 }, 0.50f }, // Outside of the green triangle's hypotenuse
+        };
+
+        int numErrors = 0;
+        for (const auto& expected : expectedPixels)
+        {
+            const auto i = expected.y * resolution.width + expected.x;
+            const auto color = &colors[i * 4];
+            if (::memcmp(color, expected.color, 4) != 0 || depths[i] != expected.depth)
+            {
+                std::cerr << "pixel (" << expected.x << ", " << expected.y << ") mismatch: expected color ("
+                    << int(expected.color[0]) << ", " << int(expected.color[1]) << ", " << int(expected.color[2]) << ", " << int(expected.color[3])
+                    << ") and depth " << expected.depth << ", but got ("
+                    << int(color[0]) << ", " << int(color[1]) << ", " << int(color[2]) << ", " << int(color[3])
+                    << ") and depth " << depths[i] << std::endl;
+                ++numErrors;
+            }
+        }
+
+        if (numErrors == 0)
+            std::cout << "rasterized pixels match" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
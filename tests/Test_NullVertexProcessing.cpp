@@ -0,0 +1,184 @@
+/*
+ * Test_NullVertexProcessing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <cstring>
+
+
+// Output vertex of the vertex callback that is written to the stream-output buffer
+struct OutputVertex
+{
+    float           position[2];
+    std::uint32_t   vertexID;
+    std::uint32_t   instanceID;
+};
+
+// Vertex callback that offsets each position by its per-instance attribute
+void ProcessVertices(const LLGL::NullVertexBatch& batch)
+{
+    auto positions  = reinterpret_cast<const float*>(batch.inputs[0].data);
+    auto offsets    = reinterpret_cast<const float*>(batch.inputs[1].data);
+
+    for (const auto& output : batch.outputs)
+    {
+        if (output.data == nullptr)
+            continue;
+
+        auto dst = reinterpret_cast<char*>(output.data);
+        for (std::uint32_t i = 0; i < batch.numVertices; ++i, dst += output.stride)
+        {
+            OutputVertex vertex;
+            {
+                vertex.position[0]  = positions[i*2    ] + offsets[i];
+                vertex.position[1]  = positions[i*2 + 1];
+                vertex.vertexID     = batch.vertexIDs[i];
+                vertex.instanceID   = batch.instanceID;
+            }
+            ::memcpy(dst, &vertex, sizeof(vertex));
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load Null renderer with CPU vertex processing
+        LLGL::RendererConfigurationNull config;
+        {
+            config.vertexCallback   = ProcessVertices;
+            config.vertexBatchSize  = 4;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = "Null";
+            rendererDesc.rendererConfig     = &config;
+            rendererDesc.rendererConfigSize = sizeof(config);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        // Create vertex buffer with per-vertex positions and vertex buffer with per-instance offsets
+        const float positions[] = { 0,0, 1,0, 0,1, 1,1, 2,2 };
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(positions);
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = { LLGL::VertexAttribute{ "position", LLGL::Format::RG32Float, 0, 0, 8 } };
+        }
+        auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, positions);
+
+        const float offsets[] = { 10, 20 };
+        LLGL::BufferDescriptor instanceBufferDesc;
+        {
+            instanceBufferDesc.size             = sizeof(offsets);
+            instanceBufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer;
+            instanceBufferDesc.vertexAttribs    = { LLGL::VertexAttribute{ "offset", LLGL::Format::R32Float, 1, 0, 4, 1, 1 } };
+        }
+        auto instanceBuffer = renderer->CreateBuffer(instanceBufferDesc, offsets);
+
+        LLGL::Buffer* vertexBuffers[] = { vertexBuffer, instanceBuffer };
+        auto vertexBufferArray = renderer->CreateBufferArray(2, vertexBuffers);
+
+        // Create index buffer with an index that lies outside of the vertex buffer
+        const std::uint16_t indices[] = { 0, 1, 2, 3, 7, 4 };
+        LLGL::BufferDescriptor indexBufferDesc;
+        {
+            indexBufferDesc.size        = sizeof(indices);
+            indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+            indexBufferDesc.format      = LLGL::Format::R16UInt;
+        }
+        auto indexBuffer = renderer->CreateBuffer(indexBufferDesc, indices);
+
+        // Create stream-output buffer with space for 10 vertices, i.e. only 3 whole triangles fit into it
+        const std::uint32_t maxOutputVertices = 10;
+        LLGL::BufferDescriptor streamOutputBufferDesc;
+        {
+            streamOutputBufferDesc.size             = sizeof(OutputVertex) * maxOutputVertices;
+            streamOutputBufferDesc.bindFlags        = LLGL::BindFlags::StreamOutputBuffer;
+            streamOutputBufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read;
+        }
+        auto streamOutputBuffer = renderer->CreateBuffer(streamOutputBufferDesc);
+
+        // Create vertex shader with stream-output layout and pipeline state for triangle strips
+        LLGL::ShaderDescriptor vertexShaderDesc{ LLGL::ShaderType::Vertex, "" };
+        {
+            vertexShaderDesc.sourceType             = LLGL::ShaderSourceType::CodeString;
+            vertexShaderDesc.vertex.outputAttribs   = { LLGL::VertexAttribute{ "output", LLGL::Format::RGBA32Float, 0, 0, sizeof(OutputVertex) } };
+        }
+        auto vertexShader = renderer->CreateShader(vertexShaderDesc);
+
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader       = vertexShader;
+            pipelineDesc.primitiveTopology  = LLGL::PrimitiveTopology::TriangleStrip;
+        }
+        auto pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+        // Draw a strip of 5 indices with 2 instances, which are expanded into 3 triangles per instance
+        auto commandQueue = renderer->GetCommandQueue();
+        auto commands = renderer->CreateCommandBuffer();
+
+        commands->Begin();
+        {
+            commands->SetPipelineState(*pipeline);
+            commands->SetVertexBufferArray(*vertexBufferArray);
+            commands->SetIndexBuffer(*indexBuffer);
+            commands->BeginStreamOutput(1, &streamOutputBuffer);
+            {
+                commands->DrawIndexedInstanced(5, 2, 1);
+            }
+            commands->EndStreamOutput();
+        }
+        commands->End();
+        commandQueue->Submit(*commands);
+        commandQueue->WaitIdle();
+
+        // Compare stream-output with expected vertices
+        const OutputVertex expectedVertices[maxOutputVertices] =
+        {
+            { { 11, 0 }, 1, 0 }, { { 10, 1 }, 2, 0 }, { { 11, 1 }, 3, 0 },
+            { { 11, 1 }, 3, 0 }, { { 10, 1 }, 2, 0 }, { { 10, 0 }, 7, 0 }, // odd triangle with swapped winding and out-of-bounds index
+            { { 11, 1 }, 3, 0 }, { { 10, 0 }, 7, 0 }, { { 12, 2 }, 4, 0 },
+            { {  0, 0 }, 0, 0 },                                           // buffer is full, so the remaining vertex is not written
+        };
+
+        OutputVertex outputVertices[maxOutputVertices] = {};
+        if (auto mappedData = renderer->MapBuffer(*streamOutputBuffer, LLGL::CPUAccess::ReadOnly))
+        {
+            ::memcpy(outputVertices, mappedData, sizeof(outputVertices));
+            renderer->UnmapBuffer(*streamOutputBuffer);
+        }
+
+        int numErrors = 0;
+        for (std::uint32_t i = 0; i < maxOutputVertices; ++i)
+        {
+            const auto& a = outputVertices[i];
+            const auto& b = expectedVertices[i];
+            if (a.position[0] != b.position[0] || a.position[1] != b.position[1] || a.vertexID != b.vertexID || a.instanceID != b.instanceID)
+            {
+                std::cerr << "stream-output vertex " << i << " mismatch: expected ("
+                    << b.position[0] << ", " << b.position[1] << ", id " << b.vertexID << ", instance " << b.instanceID << "), but got ("
+                    << a.position[0] << ", " << a.position[1] << ", id " << a.vertexID << ", instance " << a.instanceID << ")" << std::endl;
+                ++numErrors;
+            }
+        }
+
+        if (numErrors == 0)
+            std::cout << "stream-output vertices match" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return 0;
+}
@@ -7,9 +7,11 @@
 
 #include <LLGL/LLGL.h>
 #include <LLGL/Image.h>
+#include <LLGL/Timer.h>
 #include <vector>
 #include <functional>
 #include <iostream>
+#include <cstring>
 
 
 static unsigned int g_seed;
@@ -150,6 +152,147 @@ class PerformanceTest
             }
         }
 
+        double MeasureCPUTime(const std::function<void()>& callback)
+        {
+            const auto startTime = LLGL::Timer::Tick();
+            callback();
+            const auto endTime = LLGL::Timer::Tick();
+            return (static_cast<double>(endTime - startTime) * 1000.0 / static_cast<double>(LLGL::Timer::Frequency()));
+        }
+
+        void TestTextureReadback(std::uint32_t numFrames)
+        {
+            const LLGL::TextureRegion region{ LLGL::Offset3D{}, LLGL::Extent3D{ config.textureSize, config.textureSize, 1 } };
+
+            std::vector<LLGL::ColorRGBAub> syncImage(config.textureSize * config.textureSize);
+            const LLGL::DstImageDescriptor syncImageDesc
+            {
+                LLGL::ImageFormat::RGBA,
+                LLGL::DataType::UInt8,
+                syncImage.data(),
+                syncImage.size() * sizeof(LLGL::ColorRGBAub)
+            };
+
+            // Read texture synchronously every frame
+            auto syncTime = MeasureCPUTime(
+                [&]()
+                {
+                    for (std::uint32_t i = 0; i < numFrames; ++i)
+                        renderer->ReadTexture(*textures[i % textures.size()], region, syncImageDesc);
+                }
+            );
+
+            // Read texture asynchronously every frame and resolve the result two frames later (triple-buffered)
+            std::uint64_t tickets[3] = {};
+            bool imagesEqual = true;
+
+            auto asyncTime = MeasureCPUTime(
+                [&]()
+                {
+                    for (std::uint32_t i = 0; i < numFrames + 2; ++i)
+                    {
+                        if (i < numFrames)
+                            tickets[i % 3] = renderer->ReadTextureAsync(*textures[i % textures.size()], region, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8);
+                        if (i >= 2)
+                        {
+                            const auto ticket = tickets[(i - 2) % 3];
+                            std::size_t dataSize = 0;
+                            if (auto data = renderer->MapTextureReadback(ticket, true, &dataSize))
+                            {
+                                // Compare last image with synchronous readback
+                                if (i - 2 == numFrames - 1)
+                                    imagesEqual = (dataSize == syncImageDesc.dataSize && std::memcmp(data, syncImage.data(), dataSize) == 0);
+                                renderer->UnmapTextureReadback(ticket);
+                            }
+                            else
+                                imagesEqual = false;
+                        }
+                    }
+                }
+            );
+
+            std::cout << "texture readback of " << numFrames << " frames with size " << config.textureSize << std::endl;
+            std::cout << "\tsynchronous:  " << syncTime << "ms" << std::endl;
+            std::cout << "\tasynchronous: " << asyncTime << "ms" << std::endl;
+            std::cout << "\tresult: " << (imagesEqual ? "equal" : "NOT EQUAL") << "\n\n";
+        }
+
+        void TestResourceHeapBinding(std::uint32_t numSets, std::uint32_t numBinds)
+        {
+            // Create pipeline layout with constant buffer ranges, textures, and samplers
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            for (std::uint32_t i = 0; i < 4; ++i)
+                layoutDesc.bindings.push_back(LLGL::BindingDescriptor{ LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::AllStages, i });
+            for (std::uint32_t i = 0; i < 4; ++i)
+                layoutDesc.bindings.push_back(LLGL::BindingDescriptor{ LLGL::ResourceType::Texture, LLGL::BindFlags::Sampled, LLGL::StageFlags::FragmentStage, i });
+            for (std::uint32_t i = 0; i < 4; ++i)
+                layoutDesc.bindings.push_back(LLGL::BindingDescriptor{ LLGL::ResourceType::Sampler, 0, LLGL::StageFlags::FragmentStage, i });
+            auto pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+            // Create resource heap with multiple descriptor sets
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size         = 1024;
+                bufferDesc.bindFlags    = LLGL::BindFlags::ConstantBuffer;
+            }
+            auto buffer = renderer->CreateBuffer(bufferDesc);
+            auto sampler = renderer->CreateSampler(LLGL::SamplerDescriptor{});
+
+            LLGL::ResourceHeapDescriptor heapDesc;
+            {
+                heapDesc.pipelineLayout = pipelineLayout;
+                for (std::uint32_t i = 0; i < numSets; ++i)
+                {
+                    for (std::uint64_t j = 0; j < 4; ++j)
+                    {
+                        LLGL::BufferViewDescriptor bufferView;
+                        {
+                            bufferView.offset   = 256 * j;
+                            bufferView.size     = 256;
+                        }
+                        heapDesc.resourceViews.push_back(LLGL::ResourceViewDescriptor{ buffer, bufferView });
+                    }
+                    for (std::size_t j = 0; j < 4; ++j)
+                        heapDesc.resourceViews.push_back(textures[(i + j) % textures.size()]);
+                    for (std::size_t j = 0; j < 4; ++j)
+                        heapDesc.resourceViews.push_back(sampler);
+                }
+            }
+            auto resourceHeap = renderer->CreateResourceHeap(heapDesc);
+
+            // Record many resource heap bindings in a multi-submit command buffer
+            LLGL::CommandBufferDescriptor cmdBufferDesc;
+            {
+                cmdBufferDesc.flags = LLGL::CommandBufferFlags::MultiSubmit;
+            }
+            auto bindCommands = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+            bindCommands->Begin();
+            {
+                for (std::uint32_t i = 0; i < numBinds; ++i)
+                    bindCommands->SetResourceHeap(*resourceHeap, (i * 7) % numSets);
+            }
+            bindCommands->End();
+
+            // Measure CPU time of submitting all bindings
+            auto bindTime = MeasureCPUTime(
+                [&]()
+                {
+                    commandQueue->Submit(*bindCommands);
+                    commandQueue->WaitIdle();
+                }
+            );
+
+            std::cout << "resource heap binding of " << numBinds << " descriptor sets out of " << numSets << std::endl;
+            std::cout << "\tduration: " << bindTime << "ms (" << (bindTime * 1000000.0 / numBinds) << "ns per binding)" << "\n\n";
+
+            renderer->Release(*bindCommands);
+            renderer->Release(*resourceHeap);
+            renderer->Release(*sampler);
+            renderer->Release(*buffer);
+            renderer->Release(*pipelineLayout);
+        }
+
     public:
 
         void Load(const std::string& rendererModule, const TestConfig& testConfig)
@@ -201,6 +344,9 @@ class PerformanceTest
             }
             commands->End();
             commandQueue->Submit(*commands);
+
+            TestTextureReadback(60);
+            TestResourceHeapBinding(64, 20000);
         }
 
 };